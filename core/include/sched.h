@@ -212,6 +212,36 @@ NORETURN void sched_task_exit(void);
 void sched_register_cb(void (*callback)(kernel_pid_t, kernel_pid_t));
 #endif /* MODULE_SCHED_CB */
 
+#if defined(MODULE_SCHEDSTATISTICS_EXT) || defined(DOXYGEN)
+/**
+ * @name    Scheduler instrumentation hooks
+ *
+ * Implemented by @ref schedstatistics when `schedstatistics_ext` is used.
+ * @{
+ */
+/**
+ * @brief   Called when a thread is put on its run queue
+ *
+ * @param[in] pid   The thread that became ready to run
+ */
+void sched_statistics_ready(kernel_pid_t pid);
+
+/**
+ * @brief   Called when entering @ref sched_run()
+ *
+ * @return  Time stamp to pass to @ref sched_statistics_run_end()
+ */
+uint32_t sched_statistics_run_start(void);
+
+/**
+ * @brief   Called when leaving @ref sched_run()
+ *
+ * @param[in] start Return value of @ref sched_statistics_run_start()
+ */
+void sched_statistics_run_end(uint32_t start);
+/** @} */
+#endif /* MODULE_SCHEDSTATISTICS_EXT */
+
 #ifdef __cplusplus
 }
 #endif
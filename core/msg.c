@@ -198,6 +198,13 @@ int msg_send_int(msg_t *m, kernel_pid_t target_pid)
     }
 
     m->sender_pid = KERNEL_PID_ISR;
+
+    /* interrupt handlers may be nested, so another one sending to the same
+     * target must not preempt us between the status check and the hand-over
+     * or while a queue slot is claimed */
+    unsigned state = irq_disable();
+    int res;
+
     if (target->status == STATUS_RECEIVE_BLOCKED) {
         DEBUG("msg_send_int: Direct msg copy from %" PRIkernel_pid " to %"
               PRIkernel_pid ".\n", thread_getpid(), target_pid);
@@ -209,12 +216,14 @@ int msg_send_int(msg_t *m, kernel_pid_t target_pid)
         sched_set_status(target, STATUS_PENDING);
 
         sched_context_switch_request = 1;
-        return 1;
+        res = 1;
     }
     else {
         DEBUG("msg_send_int: Receiver not waiting.\n");
-        return (queue_msg(target, m));
+        res = queue_msg(target, m);
     }
+    irq_restore(state);
+    return res;
 }
 
 int msg_send_receive(msg_t *m, msg_t *reply, kernel_pid_t target_pid)
@@ -73,7 +73,7 @@ const uint8_t _tcb_name_offset = offsetof(thread_t, name);
 static void (*sched_cb) (kernel_pid_t active_thread, kernel_pid_t next_thread) = NULL;
 #endif
 
-int __attribute__((used)) sched_run(void)
+static inline int _sched_run(void)
 {
     sched_context_switch_request = 0;
 
@@ -134,6 +134,19 @@ int __attribute__((used)) sched_run(void)
     return 1;
 }
 
+int __attribute__((used)) sched_run(void)
+{
+#ifdef MODULE_SCHEDSTATISTICS_EXT
+    uint32_t start = sched_statistics_run_start();
+    int res = _sched_run();
+
+    sched_statistics_run_end(start);
+    return res;
+#else
+    return _sched_run();
+#endif
+}
+
 void sched_set_status(thread_t *process, thread_status_t status)
 {
     if (status >= STATUS_ON_RUNQUEUE) {
@@ -142,6 +155,9 @@ void sched_set_status(thread_t *process, thread_status_t status)
                   process->pid, process->priority);
             clist_rpush(&sched_runqueues[process->priority], &(process->rq_entry));
             runqueue_bitcache |= 1 << process->priority;
+#ifdef MODULE_SCHEDSTATISTICS_EXT
+            sched_statistics_ready(process->pid);
+#endif
         }
     }
     else {
@@ -35,6 +35,16 @@ extern "C" {
 #include "net/if.h"
 #endif
 
+/**
+ * @brief   Maximum number of buffers a frame is received into
+ *
+ * netdev_driver_t::recv_iol drops the frame and returns -ENOBUFS for an
+ * iolist of more buffers.
+ */
+#ifndef NETDEV_TAP_IOV_MAX
+#define NETDEV_TAP_IOV_MAX      (8U)
+#endif
+
 /**
  * @brief tap interface state
  */
@@ -68,6 +68,7 @@
 static int _init(netdev_t *netdev);
 static int _send(netdev_t *netdev, const iolist_t *iolist);
 static int _recv(netdev_t *netdev, void *buf, size_t n, void *info);
+static int _recv_iol(netdev_t *netdev, const iolist_t *iolist, void *info);
 
 static inline void _get_mac_addr(netdev_t *netdev, uint8_t *dst)
 {
@@ -158,6 +159,7 @@ static int _set(netdev_t *dev, netopt_t opt, const void *value, size_t value_len
 static const netdev_driver_t netdev_driver_tap = {
     .send = _send,
     .recv = _recv,
+    .recv_iol = _recv_iol,
     .init = _init,
     .isr = _isr,
     .get = _get,
@@ -165,13 +167,13 @@ static const netdev_driver_t netdev_driver_tap = {
 };
 
 /* driver implementation */
-static inline bool _is_addr_broadcast(uint8_t *addr)
+static inline bool _is_addr_broadcast(const uint8_t *addr)
 {
     return ((addr[0] == 0xff) && (addr[1] == 0xff) && (addr[2] == 0xff) &&
             (addr[3] == 0xff) && (addr[4] == 0xff) && (addr[5] == 0xff));
 }
 
-static inline bool _is_addr_multicast(uint8_t *addr)
+static inline bool _is_addr_multicast(const uint8_t *addr)
 {
     /* source: http://ieee802.org/secmail/pdfocSP2xXA6d.pdf */
     return (addr[0] & 0x01);
@@ -204,6 +206,43 @@ static void _continue_reading(netdev_tap_t *dev)
     _native_in_syscall--;
 }
 
+static int _recv_done(netdev_tap_t *dev, const ethernet_hdr_t *hdr, int nread)
+{
+    if (nread > 0) {
+        if (!(dev->promiscuous) && !_is_addr_multicast(hdr->dst) &&
+            !_is_addr_broadcast(hdr->dst) &&
+            (memcmp(hdr->dst, dev->addr, ETHERNET_ADDR_LEN) != 0)) {
+            DEBUG("netdev_tap: received for %02x:%02x:%02x:%02x:%02x:%02x\n"
+                  "That's not me => Dropped\n",
+                  hdr->dst[0], hdr->dst[1], hdr->dst[2],
+                  hdr->dst[3], hdr->dst[4], hdr->dst[5]);
+
+            native_async_read_continue(dev->tap_fd);
+
+            return 0;
+        }
+
+        _continue_reading(dev);
+
+        return nread;
+    }
+    else if (nread == -1) {
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+        }
+        else {
+            err(EXIT_FAILURE, "netdev_tap: read");
+        }
+    }
+    else if (nread == 0) {
+        DEBUG("_native_handle_tap_input: ignoring null-event\n");
+    }
+    else {
+        errx(EXIT_FAILURE, "internal error _rx_event");
+    }
+
+    return -1;
+}
+
 static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
 {
     netdev_tap_t *dev = (netdev_tap_t*)netdev;
@@ -237,40 +276,42 @@ static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
     int nread = real_read(dev->tap_fd, buf, len);
     DEBUG("netdev_tap: read %d bytes\n", nread);
 
-    if (nread > 0) {
-        ethernet_hdr_t *hdr = (ethernet_hdr_t *)buf;
-        if (!(dev->promiscuous) && !_is_addr_multicast(hdr->dst) &&
-            !_is_addr_broadcast(hdr->dst) &&
-            (memcmp(hdr->dst, dev->addr, ETHERNET_ADDR_LEN) != 0)) {
-            DEBUG("netdev_tap: received for %02x:%02x:%02x:%02x:%02x:%02x\n"
-                  "That's not me => Dropped\n",
-                  hdr->dst[0], hdr->dst[1], hdr->dst[2],
-                  hdr->dst[3], hdr->dst[4], hdr->dst[5]);
+    return _recv_done(dev, buf, nread);
+}
 
-            native_async_read_continue(dev->tap_fd);
+static int _recv_iol(netdev_t *netdev, const iolist_t *iolist, void *info)
+{
+    netdev_tap_t *dev = (netdev_tap_t*)netdev;
+    /* one more buffer to catch frames that don't fit into iolist */
+    struct iovec iov[NETDEV_TAP_IOV_MAX + 1];
+    size_t size;
+    uint8_t overflow;
+    unsigned n;
 
-            return 0;
-        }
+    /* the header needs to be in one piece for address filtering */
+    assert(iolist->iol_len >= sizeof(ethernet_hdr_t));
+    if (iolist_count(iolist) > NETDEV_TAP_IOV_MAX) {
+        DEBUG("netdev_tap: more than %u buffers => Dropped\n",
+              NETDEV_TAP_IOV_MAX);
+        /* discard the frame */
+        _recv(netdev, NULL, 1, info);
+        return -ENOBUFS;
+    }
+    size = iolist_to_iovec(iolist, iov, &n);
+    iov[n].iov_base = &overflow;
+    iov[n].iov_len = sizeof(overflow);
 
-        _continue_reading(dev);
+    int nread = real_readv(dev->tap_fd, iov, n + 1);
+    DEBUG("netdev_tap: read %d bytes into %u buffers\n", nread, n);
 
-        return nread;
-    }
-    else if (nread == -1) {
-        if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
-        }
-        else {
-            err(EXIT_FAILURE, "netdev_tap: read");
-        }
-    }
-    else if (nread == 0) {
-        DEBUG("_native_handle_tap_input: ignoring null-event\n");
-    }
-    else {
-        errx(EXIT_FAILURE, "internal error _rx_event");
+    if ((nread > 0) && ((size_t)nread > size)) {
+        /* the tap device truncates the frame, so it is lost already */
+        DEBUG("netdev_tap: frame does not fit into %u bytes => Dropped\n",
+              (unsigned)size);
+        _continue_reading(dev);
+        return -ENOBUFS;
     }
-
-    return -1;
+    return _recv_done(dev, iolist->iol_base, nread);
 }
 
 static int _send(netdev_t *netdev, const iolist_t *iolist)
@@ -32,6 +32,13 @@
 extern "C" {
 #endif
 
+/**
+ * @brief   Interval in microseconds between two polls of @ref mtd_async_wait
+ */
+#ifndef MTD_ASYNC_POLL_US
+#define MTD_ASYNC_POLL_US       (100U)
+#endif
+
 /**
  * @brief   MTD power states
  */
@@ -62,6 +69,32 @@ typedef struct {
     uint32_t page_size;        /**< Size of the pages in the MTD */
 } mtd_dev_t;
 
+/**
+ * @brief   Callback that reports the completion of an asynchronous operation
+ *
+ * @param[in] arg   argument given when the operation was started
+ * @param[in] res   result of the operation, as the synchronous variant
+ *                  would have returned it
+ */
+typedef void (*mtd_async_cb_t)(void *arg, int res);
+
+/**
+ * @brief   State of an asynchronous erase or write
+ *
+ * The state is provided by the caller and must stay valid until the
+ * operation completed.
+ */
+typedef struct {
+    mtd_dev_t *mtd;         /**< the device */
+    const uint8_t *src;     /**< remaining data to write, NULL for an erase */
+    uint32_t addr;          /**< start of the remaining range */
+    uint32_t size;          /**< size of the remaining range */
+    int res;                /**< result once completed, -EINPROGRESS before */
+    int count;              /**< result of the operation on success */
+    mtd_async_cb_t cb;      /**< called on completion, may be NULL */
+    void *arg;              /**< argument of mtd_async_t::cb */
+} mtd_async_t;
+
 /**
  * @brief   MTD driver interface
  *
@@ -146,6 +179,60 @@ struct mtd_desc {
      * @return < 0 value on error
      */
     int (*power)(mtd_dev_t *dev, enum mtd_power_state power);
+
+    /**
+     * @brief   Start erasing sector(s) without waiting for the device
+     *
+     * The driver issues a single erase command that starts at @p addr and
+     * covers as much of the range as possible. The device is then polled
+     * with mtd_desc::busy.
+     *
+     * Optional, @ref mtd_erase_async falls back to mtd_desc::erase.
+     *
+     * @param[in] dev       Pointer to the selected driver
+     * @param[in] addr      Starting address, aligned on a sector boundary
+     * @param[in] size      Number of bytes, a multiple of the sector size
+     *
+     * @return the number of bytes the started command erases
+     * @return < 0 value on error
+     */
+    int (*erase_start)(mtd_dev_t *dev,
+                       uint32_t addr,
+                       uint32_t size);
+
+    /**
+     * @brief   Start writing to the device without waiting for the device
+     *
+     * Same requirements as mtd_desc::write. The buffer must stay valid until
+     * mtd_desc::busy reports that the device is idle.
+     *
+     * Optional, @ref mtd_write_async falls back to mtd_desc::write.
+     *
+     * @param[in] dev       Pointer to the selected driver
+     * @param[in] buff      Pointer to the data to be written
+     * @param[in] addr      Starting address
+     * @param[in] size      Number of bytes
+     *
+     * @return the number of bytes the started command writes
+     * @return < 0 value on error
+     */
+    int (*write_start)(mtd_dev_t *dev,
+                       const void *buff,
+                       uint32_t addr,
+                       uint32_t size);
+
+    /**
+     * @brief   Check whether a started erase or write is still in progress
+     *
+     * Optional, the device is considered idle without it.
+     *
+     * @param[in] dev       Pointer to the selected driver
+     *
+     * @return 1 while the device is busy
+     * @return 0 when the device is idle
+     * @return < 0 value on error
+     */
+    int (*busy)(mtd_dev_t *dev);
 };
 
 /**
@@ -231,6 +318,83 @@ int mtd_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t count);
  */
 int mtd_power(mtd_dev_t *mtd, enum mtd_power_state power);
 
+/**
+ * @brief   Start erasing sectors of a MTD device
+ *
+ * Same requirements as @ref mtd_erase. The function issues the first erase
+ * command and returns, the operation is then driven by @ref mtd_async_poll
+ * or @ref mtd_async_wait, which call @p cb once it completed. Drivers that
+ * can not erase in the background erase a part of the range on every step.
+ *
+ * @note    There is no interrupt or event signalling the completion: @p cb is
+ *          only ever called from within @ref mtd_async_poll, in the context
+ *          of its caller. Without polling, the operation does not complete
+ *          and @p cb is never called.
+ *
+ * No other operation must be issued on @p mtd until the erase completed.
+ *
+ * @param      mtd   the device to erase
+ * @param[out] op    state of the operation
+ * @param[in]  addr  the address of the first sector to erase
+ * @param[in]  count the number of bytes to erase
+ * @param[in]  cb    called on completion with the result of @ref mtd_erase,
+ *                   may be NULL
+ * @param[in]  arg   argument of @p cb
+ *
+ * @return 0 if the erase was started
+ * @return < 0 if an error occurred, as @ref mtd_erase, @p cb is not called
+ */
+int mtd_erase_async(mtd_dev_t *mtd, mtd_async_t *op, uint32_t addr,
+                    uint32_t count, mtd_async_cb_t cb, void *arg);
+
+/**
+ * @brief   Start writing data to a MTD device
+ *
+ * Same requirements as @ref mtd_write, @p src must stay valid until the
+ * operation completed. See @ref mtd_erase_async for how the operation is
+ * driven.
+ *
+ * @param      mtd   the device to write to
+ * @param[out] op    state of the operation
+ * @param[in]  src   the buffer to write
+ * @param[in]  addr  the start address to write to
+ * @param[in]  count the number of bytes to write
+ * @param[in]  cb    called on completion with the result of @ref mtd_write,
+ *                   may be NULL
+ * @param[in]  arg   argument of @p cb
+ *
+ * @return 0 if the write was started
+ * @return < 0 if an error occurred, as @ref mtd_write, @p cb is not called
+ */
+int mtd_write_async(mtd_dev_t *mtd, mtd_async_t *op, const void *src,
+                    uint32_t addr, uint32_t count, mtd_async_cb_t cb,
+                    void *arg);
+
+/**
+ * @brief   Drive an asynchronous operation without blocking
+ *
+ * Starts the next step of the operation once the device is idle and calls
+ * the callback of the operation when it completed.
+ *
+ * @param      op    state of the operation
+ *
+ * @return -EINPROGRESS while the operation is in progress
+ * @return the result of the completed operation otherwise
+ */
+int mtd_async_poll(mtd_async_t *op);
+
+/**
+ * @brief   Wait for an asynchronous operation to complete
+ *
+ * Polls the operation with @ref mtd_async_poll and sleeps in between if the
+ * xtimer module is used, otherwise yields.
+ *
+ * @param      op    state of the operation
+ *
+ * @return the result of the completed operation
+ */
+int mtd_async_wait(mtd_async_t *op);
+
 #if defined(MODULE_VFS) || defined(DOXYGEN)
 /**
  * @brief   MTD driver for VFS
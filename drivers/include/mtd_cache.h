@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    drivers_mtd_cache MTD page cache
+ * @ingroup     drivers_mtd
+ * @brief       Write-back page cache on top of another MTD device
+ *
+ * The cache is a MTD device of its own that holds pages of the device below
+ * in RAM. Small and unaligned accesses, as file systems like littlefs and
+ * SPIFFS issue them, are served from the cache:
+ *
+ * - writes are merged into the cached page and written back once the page
+ *   is replaced, on @ref mtd_cache_flush() or before powering the device
+ *   down; only the modified runs of a page are written, each one on its own
+ *   and widened to the write granularity of the device
+ * - sequential reads that miss the cache load several pages with one read
+ *   (@ref MTD_CACHE_READAHEAD), reads of whole pages that are not cached go
+ *   straight to the device
+ * - erases are counted per sector if the application provides the counters
+ *
+ * Pages are replaced in round-robin order. The cache models NOR flash,
+ * writing can only clear bits and only erasing sets them again, so it must
+ * not be used with devices that overwrite data, such as @ref drivers_mtd_sdcard.
+ * For devices that only write aligned blocks, such as
+ * @ref drivers_mtd_flashpage, set mtd_cache_t::write_size to the block size
+ * and align mtd_cache_t::buf accordingly. Bytes that share such a block with
+ * written ones are written back as they are in the cache, so the application
+ * must write whole blocks for devices that can program a block only once.
+ *
+ * ```c
+ * static uint8_t cache_buf[4 * MTD_PAGE_SIZE];
+ * static mtd_cache_slot_t cache_slots[4];
+ * static mtd_cache_t cache = {
+ *     .base.driver = &mtd_cache_driver,
+ *     .mtd = MTD_0,
+ *     .buf = cache_buf,
+ *     .slots = cache_slots,
+ *     .slots_numof = ARRAY_SIZE(cache_slots),
+ * };
+ *
+ * mtd_init(&cache.base);
+ * ```
+ *
+ * @{
+ *
+ * @file
+ * @brief       Interface definition for the MTD page cache
+ */
+
+#ifndef MTD_CACHE_H
+#define MTD_CACHE_H
+
+#include <stdint.h>
+
+#include "mtd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of pages a sequential read loads at once
+ */
+#ifndef MTD_CACHE_READAHEAD
+#define MTD_CACHE_READAHEAD     (4U)
+#endif
+
+/**
+ * @brief   Maximum number of separate modified runs per page
+ *
+ * A write that would need another run writes the page back first.
+ */
+#ifndef MTD_CACHE_DIRTY_RUNS
+#define MTD_CACHE_DIRTY_RUNS    (4U)
+#endif
+
+/**
+ * @brief   A modified run of a page, aligned to the write granularity
+ */
+typedef struct {
+    uint16_t start;         /**< first modified byte */
+    uint16_t end;           /**< end of the modified bytes */
+} mtd_cache_run_t;
+
+/**
+ * @brief   A page buffer of the cache
+ */
+typedef struct {
+    uint32_t page;          /**< page held by the buffer */
+    mtd_cache_run_t dirty[MTD_CACHE_DIRTY_RUNS];
+                            /**< modified runs, sorted and not touching */
+    uint8_t dirty_runs;     /**< number of modified runs */
+    uint8_t flags;          /**< state of the buffer, 0 if unused */
+} mtd_cache_slot_t;
+
+/**
+ * @brief   Operations on the cached device
+ */
+typedef struct {
+    uint32_t reads;         /**< number of reads */
+    uint32_t writes;        /**< number of writes */
+    uint32_t erases;        /**< number of erases */
+} mtd_cache_stats_t;
+
+/**
+ * @brief   Device descriptor for the MTD page cache
+ *
+ * This is an extension of the @c mtd_dev_t struct
+ */
+typedef struct {
+    mtd_dev_t base;             /**< inherit from mtd_dev_t object */
+    mtd_dev_t *mtd;             /**< the cached device */
+    uint8_t *buf;               /**< page buffers, mtd_cache_t::slots_numof
+                                 *   times the page size of the device */
+    mtd_cache_slot_t *slots;    /**< one slot per page buffer */
+    unsigned slots_numof;       /**< number of page buffers */
+    uint16_t write_size;        /**< write granularity of the cached device
+                                 *   in bytes, 0 for single bytes; must
+                                 *   divide its page size */
+    uint32_t *erase_counts;     /**< erases per sector, one counter for every
+                                 *   sector of the device, may be NULL */
+    unsigned hand;              /**< next page buffer to replace */
+    uint32_t next_page;         /**< page after the last read from the device */
+    mtd_cache_stats_t stats;    /**< operations on the cached device */
+} mtd_cache_t;
+
+/**
+ * @brief   MTD page cache operations table for mtd
+ */
+extern const mtd_desc_t mtd_cache_driver;
+
+/**
+ * @brief   Writes all modified pages back to the cached device
+ *
+ * @param[in] cache     The cache
+ *
+ * @return  0 on success
+ * @return  < 0 value on error of the cached device
+ */
+int mtd_cache_flush(mtd_cache_t *cache);
+
+/**
+ * @brief   Returns how often a sector was erased through the cache
+ *
+ * @param[in] cache     The cache
+ * @param[in] sector    The sector
+ *
+ * @return  number of erases, 0 if mtd_cache_t::erase_counts is NULL
+ */
+uint32_t mtd_cache_erase_count(const mtd_cache_t *cache, uint32_t sector);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MTD_CACHE_H */
+/** @} */
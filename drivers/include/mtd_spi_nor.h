@@ -82,6 +82,18 @@ typedef struct __attribute__((packed)) {
  * @brief   Flag to set when the device support 32KiB block erase (block_erase_32k opcode)
  */
 #define SPI_NOR_F_SECT_32K  (2)
+/**
+ * @brief   Flag to set when the block erase opcode erases 64KiB, independent
+ *          of the sector size of the MTD device
+ *
+ * Without this flag, the block erase opcode is expected to erase one sector.
+ */
+#define SPI_NOR_F_SECT_64K  (4)
+/**
+ * @brief   Flag to set when the device supports the fast read opcode
+ *          (read_fast), which is followed by one dummy byte
+ */
+#define SPI_NOR_F_FAST_READ (8)
 
 /**
  * @brief   Device descriptor for serial flash memory devices
@@ -353,6 +353,41 @@ typedef struct netdev_driver {
      */
     int (*recv)(netdev_t *dev, void *buf, size_t len, void *info);
 
+    /**
+     * @brief   Get a received frame scattered over several buffers
+     *
+     * @pre `(dev != NULL) && (iolist != NULL)`
+     *
+     * Optional, may be NULL if not supported by the driver.
+     *
+     * Like @ref netdev_driver_t::recv "recv()" with a buffer given, but the
+     * frame is written to the buffers of @p iolist in order. This allows upper
+     * layers to receive e.g. the link-layer header and the payload into
+     * separate buffers, so the frame does not need to be copied again to
+     * split it up. Drivers that read the frame from a file descriptor or a
+     * FIFO can write it directly to its final destination this way.
+     *
+     * Drivers may require the first element of @p iolist to be large enough
+     * to hold the link-layer header. They may also limit the number of
+     * buffers in @p iolist, and treat a longer @p iolist like one that is too
+     * small.
+     *
+     * If the received frame does not fit into @p iolist:
+     *  - The received frame is dropped
+     *  - The content of the buffers in @p iolist becomes invalid
+     *  - `-ENOBUFS` is returned
+     *
+     * @param[in]   dev     network device descriptor. Must not be NULL.
+     * @param[in]   iolist  buffers to write the frame into. Must not be NULL.
+     * @param[out]  info    status information for the received packet. Might
+     *                      be of different type for different netdev devices.
+     *                      May be NULL if not needed or applicable.
+     *
+     * @return  `-ENOBUFS` if the buffers in @p iolist are too small
+     * @return  number of bytes read
+     */
+    int (*recv_iol)(netdev_t *dev, const iolist_t *iolist, void *info);
+
     /**
      * @brief the driver's initialization function
      *
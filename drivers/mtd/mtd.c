@@ -19,8 +19,14 @@
  */
 
 #include <errno.h>
+#include <stddef.h>
 
 #include "mtd.h"
+#if MODULE_XTIMER
+#include "xtimer.h"
+#else
+#include "thread.h"
+#endif
 
 int mtd_init(mtd_dev_t *mtd)
 {
@@ -92,4 +98,139 @@ int mtd_power(mtd_dev_t *mtd, enum mtd_power_state power)
     }
 }
 
+/* starts the next part of an asynchronous operation */
+static int _async_step(mtd_async_t *op)
+{
+    const mtd_desc_t *driver = op->mtd->driver;
+    int res;
+
+    if (op->src) {
+        if (driver->write_start) {
+            res = driver->write_start(op->mtd, op->src, op->addr, op->size);
+        }
+        else {
+            res = driver->write(op->mtd, op->src, op->addr, op->size);
+        }
+    }
+    else {
+        if (driver->erase_start) {
+            res = driver->erase_start(op->mtd, op->addr, op->size);
+        }
+        else if ((res = driver->erase(op->mtd, op->addr, op->size)) == 0) {
+            res = op->size;
+        }
+    }
+    if (res < 0) {
+        return res;
+    }
+    if ((res == 0) || ((uint32_t)res > op->size)) {
+        /* the driver made no progress or went past the range, do not loop */
+        res = op->size;
+    }
+    op->addr += res;
+    op->size -= res;
+    if (op->src) {
+        op->src += res;
+    }
+    return 0;
+}
+
+static int _async_start(mtd_async_t *op)
+{
+    int res = _async_step(op);
+
+    if (res < 0) {
+        op->res = res;
+        return res;
+    }
+    return 0;
+}
+
+int mtd_erase_async(mtd_dev_t *mtd, mtd_async_t *op, uint32_t addr,
+                    uint32_t count, mtd_async_cb_t cb, void *arg)
+{
+    if (!mtd || !mtd->driver) {
+        return -ENODEV;
+    }
+
+    if (!mtd->driver->erase) {
+        return -ENOTSUP;
+    }
+    op->mtd = mtd;
+    op->src = NULL;
+    op->addr = addr;
+    op->size = count;
+    op->res = -EINPROGRESS;
+    op->count = 0;
+    op->cb = cb;
+    op->arg = arg;
+    return _async_start(op);
+}
+
+int mtd_write_async(mtd_dev_t *mtd, mtd_async_t *op, const void *src,
+                    uint32_t addr, uint32_t count, mtd_async_cb_t cb,
+                    void *arg)
+{
+    if (!mtd || !mtd->driver) {
+        return -ENODEV;
+    }
+
+    if (!mtd->driver->write) {
+        return -ENOTSUP;
+    }
+    op->mtd = mtd;
+    op->src = src;
+    op->addr = addr;
+    op->size = count;
+    op->res = -EINPROGRESS;
+    op->count = count;
+    op->cb = cb;
+    op->arg = arg;
+    if (count == 0) {
+        /* nothing to start, completes on the first poll */
+        return 0;
+    }
+    return _async_start(op);
+}
+
+int mtd_async_poll(mtd_async_t *op)
+{
+    int res = 0;
+
+    if (op->res != -EINPROGRESS) {
+        return op->res;
+    }
+    if (op->mtd->driver->busy) {
+        res = op->mtd->driver->busy(op->mtd);
+    }
+    if (res > 0) {
+        return -EINPROGRESS;
+    }
+    if ((res == 0) && (op->size > 0)) {
+        if ((res = _async_step(op)) == 0) {
+            return -EINPROGRESS;
+        }
+    }
+    op->res = (res < 0) ? res : op->count;
+    /* the only place the callback is called from */
+    if (op->cb) {
+        op->cb(op->arg, op->res);
+    }
+    return op->res;
+}
+
+int mtd_async_wait(mtd_async_t *op)
+{
+    int res;
+
+    while ((res = mtd_async_poll(op)) == -EINPROGRESS) {
+#if MODULE_XTIMER
+        xtimer_usleep(MTD_ASYNC_POLL_US);
+#else
+        thread_yield();
+#endif
+    }
+    return res;
+}
+
 /** @} */
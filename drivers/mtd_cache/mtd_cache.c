@@ -0,0 +1,421 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     drivers_mtd_cache
+ * @{
+ *
+ * @file
+ * @brief       Write-back page cache on top of another MTD device
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "mtd.h"
+#include "mtd_cache.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/* the buffer holds the content of the page */
+#define SLOT_VALID      (0x01)
+/* the buffer holds data that was not written to the device yet */
+#define SLOT_DIRTY      (0x02)
+
+static inline uint8_t *_data(mtd_cache_t *cache, unsigned slot)
+{
+    return &cache->buf[slot * cache->base.page_size];
+}
+
+static inline uint32_t _pages(const mtd_dev_t *dev)
+{
+    return dev->sector_count * dev->pages_per_sector;
+}
+
+static int _find(const mtd_cache_t *cache, uint32_t page)
+{
+    for (unsigned i = 0; i < cache->slots_numof; i++) {
+        if ((cache->slots[i].flags != 0) && (cache->slots[i].page == page)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int _write_back(mtd_cache_t *cache, unsigned slot)
+{
+    mtd_cache_slot_t *s = &cache->slots[slot];
+
+    if (!(s->flags & SLOT_DIRTY)) {
+        return 0;
+    }
+    /* bytes between the runs may already be programmed on the device */
+    while (s->dirty_runs > 0) {
+        const mtd_cache_run_t *run = &s->dirty[s->dirty_runs - 1];
+        int res;
+
+        DEBUG("mtd_cache: write back page %" PRIu32 " [%u, %u)\n", s->page,
+              run->start, run->end);
+        cache->stats.writes++;
+        res = mtd_write(cache->mtd, _data(cache, slot) + run->start,
+                        (s->page * cache->base.page_size) + run->start,
+                        run->end - run->start);
+        if (res < 0) {
+            return res;
+        }
+        s->dirty_runs--;
+    }
+    s->flags &= ~SLOT_DIRTY;
+    return 0;
+}
+
+/* adds [start, end) to the modified runs of a page buffer, returns false if
+ * all runs are taken by others */
+static bool _mark_dirty(mtd_cache_slot_t *s, uint16_t start, uint16_t end)
+{
+    unsigned n = (s->flags & SLOT_DIRTY) ? s->dirty_runs : 0;
+    unsigned first = 0;
+    unsigned last;
+
+    while ((first < n) && (s->dirty[first].end < start)) {
+        first++;
+    }
+    /* merge the runs the range overlaps or touches */
+    for (last = first; (last < n) && (s->dirty[last].start <= end); last++) {
+        if (s->dirty[last].start < start) {
+            start = s->dirty[last].start;
+        }
+        if (s->dirty[last].end > end) {
+            end = s->dirty[last].end;
+        }
+    }
+    if (first == last) {
+        if (n == MTD_CACHE_DIRTY_RUNS) {
+            return false;
+        }
+        memmove(&s->dirty[first + 1], &s->dirty[first],
+                (n - first) * sizeof(s->dirty[0]));
+        n++;
+    }
+    else {
+        memmove(&s->dirty[first + 1], &s->dirty[last],
+                (n - last) * sizeof(s->dirty[0]));
+        n -= last - first - 1;
+    }
+    s->dirty[first].start = start;
+    s->dirty[first].end = end;
+    s->dirty_runs = n;
+    s->flags |= SLOT_DIRTY;
+    return true;
+}
+
+/* frees `n` consecutive page buffers, returns the first of them */
+static int _alloc(mtd_cache_t *cache, unsigned n)
+{
+    unsigned first;
+
+    if ((cache->hand + n) > cache->slots_numof) {
+        cache->hand = 0;
+    }
+    first = cache->hand;
+    for (unsigned i = first; i < (first + n); i++) {
+        int res = _write_back(cache, i);
+
+        if (res < 0) {
+            return res;
+        }
+        cache->slots[i].flags = 0;
+    }
+    cache->hand = (first + n) % cache->slots_numof;
+    return first;
+}
+
+/* loads `n` pages starting at `page` into the cache */
+static int _load(mtd_cache_t *cache, uint32_t page, unsigned n)
+{
+    uint32_t page_size = cache->base.page_size;
+    int slot = _alloc(cache, n);
+    int res;
+
+    if (slot < 0) {
+        return slot;
+    }
+    DEBUG("mtd_cache: load pages %" PRIu32 "..%" PRIu32 "\n", page, page + n - 1);
+    cache->stats.reads++;
+    res = mtd_read(cache->mtd, _data(cache, slot), page * page_size, n * page_size);
+    if (res < 0) {
+        return res;
+    }
+    for (unsigned i = 0; i < n; i++) {
+        cache->slots[slot + i].page = page + i;
+        cache->slots[slot + i].flags = SLOT_VALID;
+    }
+    cache->next_page = page + n;
+    return slot;
+}
+
+/* reads pages that are not cached straight into the buffer of the caller */
+static int _read_pages(mtd_cache_t *cache, uint8_t *dest, uint32_t page,
+                       uint32_t max)
+{
+    uint32_t page_size = cache->base.page_size;
+    uint32_t n = 1;
+    int res;
+
+    while ((n < max) && (_find(cache, page + n) < 0)) {
+        n++;
+    }
+    cache->stats.reads++;
+    res = mtd_read(cache->mtd, dest, page * page_size, n * page_size);
+    if (res < 0) {
+        return res;
+    }
+    cache->next_page = page + n;
+    return n * page_size;
+}
+
+static int _readahead(const mtd_cache_t *cache, uint32_t page)
+{
+    unsigned n = 1;
+    unsigned max = MTD_CACHE_READAHEAD;
+
+    if (page != cache->next_page) {
+        return 1;
+    }
+    if (max > cache->slots_numof) {
+        max = cache->slots_numof;
+    }
+    if (max > (_pages(&cache->base) - page)) {
+        max = _pages(&cache->base) - page;
+    }
+    /* a page must not be in the cache twice */
+    while ((n < max) && (_find(cache, page + n) < 0)) {
+        n++;
+    }
+    return n;
+}
+
+static int _init(mtd_dev_t *dev)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+    int res;
+
+    assert((cache->mtd != NULL) && (cache->buf != NULL));
+    assert((cache->slots != NULL) && (cache->slots_numof > 0));
+
+    if ((res = mtd_init(cache->mtd)) < 0) {
+        return res;
+    }
+    assert(cache->mtd->page_size <= UINT16_MAX);
+    assert((cache->write_size == 0)
+           || ((cache->mtd->page_size % cache->write_size) == 0));
+    dev->sector_count = cache->mtd->sector_count;
+    dev->pages_per_sector = cache->mtd->pages_per_sector;
+    dev->page_size = cache->mtd->page_size;
+    memset(cache->slots, 0, cache->slots_numof * sizeof(mtd_cache_slot_t));
+    memset(&cache->stats, 0, sizeof(cache->stats));
+    cache->hand = 0;
+    cache->next_page = 0;
+    return 0;
+}
+
+static int _read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+    uint32_t page_size = dev->page_size;
+    uint8_t *dest = buff;
+    uint32_t remaining = size;
+
+    DEBUG("mtd_cache: read from 0x%" PRIx32 " count %" PRIu32 "\n", addr, size);
+
+    if ((addr > (_pages(dev) * page_size)) ||
+        (size > ((_pages(dev) * page_size) - addr))) {
+        return -EOVERFLOW;
+    }
+    while (remaining > 0) {
+        uint32_t page = addr / page_size;
+        uint32_t offset = addr % page_size;
+        uint32_t len = page_size - offset;
+        int slot = _find(cache, page);
+        int res;
+
+        if (len > remaining) {
+            len = remaining;
+        }
+        if ((slot >= 0) && !(cache->slots[slot].flags & SLOT_VALID)) {
+            /* only the data written to the page is known */
+            if ((res = _write_back(cache, slot)) < 0) {
+                return res;
+            }
+            cache->slots[slot].flags = 0;
+            slot = -1;
+        }
+        if ((slot < 0) && (offset == 0) && (remaining >= page_size)) {
+            if ((res = _read_pages(cache, dest, page, remaining / page_size)) < 0) {
+                return res;
+            }
+            len = res;
+        }
+        else {
+            if ((slot < 0) &&
+                ((slot = _load(cache, page, _readahead(cache, page))) < 0)) {
+                return slot;
+            }
+            memcpy(dest, _data(cache, slot) + offset, len);
+        }
+        dest += len;
+        addr += len;
+        remaining -= len;
+    }
+    return size;
+}
+
+static int _write(mtd_dev_t *dev, const void *buff, uint32_t addr, uint32_t size)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+    uint32_t page_size = dev->page_size;
+    uint32_t page = addr / page_size;
+    uint32_t offset = addr % page_size;
+    uint32_t write_size = (cache->write_size > 0) ? cache->write_size : 1;
+    const uint8_t *src = buff;
+    mtd_cache_slot_t *s;
+    uint8_t *data;
+    uint16_t start, end;
+    int slot;
+
+    DEBUG("mtd_cache: write from 0x%" PRIx32 " count %" PRIu32 "\n", addr, size);
+
+    if ((addr > (_pages(dev) * page_size)) ||
+        (size > ((_pages(dev) * page_size) - addr))) {
+        return -EOVERFLOW;
+    }
+    if ((offset + size) > page_size) {
+        return -EOVERFLOW;
+    }
+    if (size == 0) {
+        return 0;
+    }
+    if ((slot = _find(cache, page)) < 0) {
+        if ((slot = _alloc(cache, 1)) < 0) {
+            return slot;
+        }
+        /* writing erased bytes does not change the page, so it does not have
+         * to be read first */
+        memset(_data(cache, slot), 0xff, page_size);
+        cache->slots[slot].page = page;
+    }
+    s = &cache->slots[slot];
+    data = _data(cache, slot) + offset;
+    for (uint32_t i = 0; i < size; i++) {
+        data[i] &= src[i];
+    }
+    start = offset - (offset % write_size);
+    end = offset + size + write_size - 1;
+    end -= end % write_size;
+    if (!_mark_dirty(s, start, end)) {
+        int res = _write_back(cache, slot);
+
+        if (res < 0) {
+            return res;
+        }
+        _mark_dirty(s, start, end);
+    }
+    return size;
+}
+
+static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+    uint32_t sector_size = dev->pages_per_sector * dev->page_size;
+    uint32_t first = addr / dev->page_size;
+    uint32_t end = first + (size / dev->page_size);
+    int res;
+
+    DEBUG("mtd_cache: erase from 0x%" PRIx32 " count %" PRIu32 "\n", addr, size);
+
+    if (((addr % sector_size) != 0) || ((size % sector_size) != 0)) {
+        return -EOVERFLOW;
+    }
+    if ((addr > (_pages(dev) * dev->page_size)) ||
+        (size > ((_pages(dev) * dev->page_size) - addr))) {
+        return -EOVERFLOW;
+    }
+    cache->stats.erases++;
+    if ((res = mtd_erase(cache->mtd, addr, size)) < 0) {
+        return res;
+    }
+    /* pending writes to the sectors are void, their pages are known now */
+    for (unsigned i = 0; i < cache->slots_numof; i++) {
+        mtd_cache_slot_t *s = &cache->slots[i];
+
+        if ((s->flags != 0) && (s->page >= first) && (s->page < end)) {
+            memset(_data(cache, i), 0xff, dev->page_size);
+            s->flags = SLOT_VALID;
+        }
+    }
+    if (cache->erase_counts != NULL) {
+        for (uint32_t sector = addr / sector_size;
+             sector < ((addr + size) / sector_size); sector++) {
+            cache->erase_counts[sector]++;
+        }
+    }
+    return 0;
+}
+
+static int _power(mtd_dev_t *dev, enum mtd_power_state power)
+{
+    mtd_cache_t *cache = (mtd_cache_t *)dev;
+
+    if (power == MTD_POWER_DOWN) {
+        int res = mtd_cache_flush(cache);
+
+        if (res < 0) {
+            return res;
+        }
+    }
+    return mtd_power(cache->mtd, power);
+}
+
+const mtd_desc_t mtd_cache_driver = {
+    .init = _init,
+    .read = _read,
+    .write = _write,
+    .erase = _erase,
+    .power = _power,
+};
+
+int mtd_cache_flush(mtd_cache_t *cache)
+{
+    assert(cache != NULL);
+
+    for (unsigned i = 0; i < cache->slots_numof; i++) {
+        int res = _write_back(cache, i);
+
+        if (res < 0) {
+            return res;
+        }
+    }
+    return 0;
+}
+
+uint32_t mtd_cache_erase_count(const mtd_cache_t *cache, uint32_t sector)
+{
+    assert(cache != NULL);
+    assert(sector < cache->base.sector_count);
+
+    if (cache->erase_counts == NULL) {
+        return 0;
+    }
+    return cache->erase_counts[sector];
+}
@@ -85,7 +85,7 @@ static int _write(mtd_dev_t *dev, const void *buf, uint32_t addr, uint32_t size)
     return size;
 }
 
-int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+static int _erase_check(mtd_dev_t *dev, uint32_t addr, uint32_t size)
 {
     size_t sector_size = dev->page_size * dev->pages_per_sector;
 
@@ -99,23 +99,61 @@ int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
         return -EOVERFLOW;
     }
 
+    return 0;
+}
+
+static void _erase_sector(uint32_t addr)
+{
 #if (__SIZEOF_POINTER__ == 2)
     uint16_t dst_addr = addr;
 #else
     uint32_t dst_addr = addr;
 #endif
 
+    flashpage_write(flashpage_page((void *)dst_addr), NULL);
+}
+
+static int _erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    size_t sector_size = dev->page_size * dev->pages_per_sector;
+    int res = _erase_check(dev, addr, size);
+
+    if (res < 0) {
+        return res;
+    }
+
     for (size_t i = 0; i < size; i += sector_size) {
-        flashpage_write(flashpage_page((void *)dst_addr), NULL);
+        _erase_sector(addr + i);
     }
 
     return 0;
 }
 
+/* the CPU stalls while the internal flash is erased, so the erase can not
+ * run in the background, but it is split into one step per sector */
+static int _erase_start(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    size_t sector_size = dev->page_size * dev->pages_per_sector;
+    int res = _erase_check(dev, addr, size);
+
+    if (res < 0) {
+        return res;
+    }
+    if (size == 0) {
+        return 0;
+    }
+
+    _erase_sector(addr);
+
+    return sector_size;
+}
+
 
 const mtd_desc_t mtd_flashpage_driver = {
     .init = _init,
     .read = _read,
     .write = _write,
     .erase = _erase,
+    .erase_start = _erase_start,
+    .write_start = _write,
 };
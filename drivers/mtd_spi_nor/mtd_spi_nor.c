@@ -25,9 +25,9 @@
 #include <errno.h>
 
 #include "mtd.h"
+#include "timex.h"
 #if MODULE_XTIMER
 #include "xtimer.h"
-#include "timex.h"
 #else
 #include "thread.h"
 #endif
@@ -44,11 +44,15 @@
 #define TRACE(...)
 #endif
 
+#define MTD_64K             (65536ul)
 #define MTD_32K             (32768ul)
 #define MTD_32K_ADDR_MASK   (0x7FFF)
 #define MTD_4K              (4096ul)
 #define MTD_4K_ADDR_MASK    (0xFFF)
 
+/* write in progress bit of the status register */
+#define SFLASH_STATUS_WIP   (0x01)
+
 #ifndef MTD_SPI_NOR_WAIT_C_ER
 #define MTD_SPI_NOR_WAIT_C_ER       (16 * US_PER_SEC)
 #endif
@@ -65,11 +69,24 @@
 #define MTD_SPI_NOR_WAIT_4K_ER      (10 * US_PER_MS)
 #endif
 
+#ifndef MTD_SPI_NOR_WAIT_PP
+#define MTD_SPI_NOR_WAIT_PP         (1 * US_PER_MS)
+#endif
+
+/* first interval between two polls of the status register, it doubles with
+ * every poll up to a quarter of the typical duration of the operation */
+#ifndef MTD_SPI_NOR_POLL_MIN
+#define MTD_SPI_NOR_POLL_MIN        (16U)
+#endif
+
 static int mtd_spi_nor_init(mtd_dev_t *mtd);
 static int mtd_spi_nor_read(mtd_dev_t *mtd, void *dest, uint32_t addr, uint32_t size);
 static int mtd_spi_nor_write(mtd_dev_t *mtd, const void *src, uint32_t addr, uint32_t size);
 static int mtd_spi_nor_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size);
 static int mtd_spi_nor_power(mtd_dev_t *mtd, enum mtd_power_state power);
+static int mtd_spi_nor_erase_start(mtd_dev_t *mtd, uint32_t addr, uint32_t size);
+static int mtd_spi_nor_write_start(mtd_dev_t *mtd, const void *src, uint32_t addr, uint32_t size);
+static int mtd_spi_nor_busy(mtd_dev_t *mtd);
 
 const mtd_desc_t mtd_spi_nor_driver = {
     .init = mtd_spi_nor_init,
@@ -77,6 +94,9 @@ const mtd_desc_t mtd_spi_nor_driver = {
     .write = mtd_spi_nor_write,
     .erase = mtd_spi_nor_erase,
     .power = mtd_spi_nor_power,
+    .erase_start = mtd_spi_nor_erase_start,
+    .write_start = mtd_spi_nor_write_start,
+    .busy = mtd_spi_nor_busy,
 };
 
 /**
@@ -86,15 +106,17 @@ const mtd_desc_t mtd_spi_nor_driver = {
  * @param[in]  dev    pointer to device descriptor
  * @param[in]  opcode command opcode
  * @param[in]  addr   address (big endian)
+ * @param[in]  dummy  number of dummy bytes between the address and the data
  * @param[out] dest   read buffer
  * @param[in]  count  number of bytes to read after the address has been sent
  */
 static void mtd_spi_cmd_addr_read(const mtd_spi_nor_t *dev, uint8_t opcode,
-                                  be_uint32_t addr, void *dest, uint32_t count)
+                                  be_uint32_t addr, unsigned dummy,
+                                  void *dest, uint32_t count)
 {
-    TRACE("mtd_spi_cmd_addr_read: %p, %02x, (%02x %02x %02x %02x), %p, %" PRIu32 "\n",
+    TRACE("mtd_spi_cmd_addr_read: %p, %02x, (%02x %02x %02x %02x), %u, %p, %" PRIu32 "\n",
           (void *)dev, (unsigned int)opcode, addr.u8[0], addr.u8[1], addr.u8[2],
-          addr.u8[3], dest, count);
+          addr.u8[3], dummy, dest, count);
 
     uint8_t *addr_buf = &addr.u8[4 - dev->addr_width];
     if (ENABLE_TRACE) {
@@ -109,6 +131,9 @@ static void mtd_spi_cmd_addr_read(const mtd_spi_nor_t *dev, uint8_t opcode,
         /* Send opcode followed by address */
         spi_transfer_byte(dev->spi, dev->cs, true, opcode);
         spi_transfer_bytes(dev->spi, dev->cs, true, (char *)addr_buf, NULL, dev->addr_width);
+        while (dummy--) {
+            spi_transfer_byte(dev->spi, dev->cs, true, 0);
+        }
 
         /* Read data */
         spi_transfer_bytes(dev->spi, dev->cs, false, NULL, dest, count);
@@ -268,43 +293,50 @@ static int mtd_spi_read_jedec_id(const mtd_spi_nor_t *dev, mtd_jedec_id_t *out)
     return status;
 }
 
-static inline void wait_for_write_complete(const mtd_spi_nor_t *dev, uint32_t us)
+/**
+ * @internal
+ * @brief Poll the status register until the device is no longer busy
+ *
+ * The interval between two polls starts at MTD_SPI_NOR_POLL_MIN and doubles
+ * up to a quarter of @p us, so short operations are noticed quickly and long
+ * ones cost only a few polls.
+ *
+ * @param[in]  dev    pointer to device descriptor
+ * @param[in]  us     typical duration of the operation
+ */
+static void wait_for_write_complete(const mtd_spi_nor_t *dev, uint32_t us)
 {
-    unsigned i = 0, j = 0;
-    uint32_t div = 2;
+    unsigned i = 0;
+#if MODULE_XTIMER
+    uint32_t delay = MTD_SPI_NOR_POLL_MIN;
+    uint32_t delay_max = us / 4;
+
+    if (delay_max < delay) {
+        delay_max = delay;
+    }
+#else
+    (void)us;
+#endif
     do {
         uint8_t status;
         mtd_spi_cmd_read(dev, dev->opcode->rdsr, &status, sizeof(status));
 
         TRACE("mtd_spi_nor: wait device status = 0x%02x\n", (unsigned int)status);
-        if ((status & 1) == 0) { /* TODO magic number */
+        if ((status & SFLASH_STATUS_WIP) == 0) {
             break;
         }
         i++;
 #if MODULE_XTIMER
-        if (us) {
-            xtimer_usleep(us);
-            /* reduce the waiting time quickly if the estimate was too short,
-             * but still avoid busy (yield) waiting */
-            if (us > 2 * XTIMER_BACKOFF) {
-                us -= (us / div);
-                div++;
-            }
-            else {
-                us = 2 * XTIMER_BACKOFF;
-            }
-        }
-        else {
-            j++;
-            thread_yield();
+        xtimer_usleep(delay);
+        delay *= 2;
+        if (delay > delay_max) {
+            delay = delay_max;
         }
 #else
-        (void)div;
-        (void) us;
         thread_yield();
 #endif
     } while (1);
-    DEBUG("wait loop %u times, yield %u times\n", i, j);
+    DEBUG("wait loop %u times\n", i);
 }
 
 static int mtd_spi_nor_init(mtd_dev_t *mtd)
@@ -392,39 +424,37 @@ static int mtd_spi_nor_read(mtd_dev_t *mtd, void *dest, uint32_t addr, uint32_t
     if (addr > chipsize) {
         return -EOVERFLOW;
     }
-    if (size > mtd->page_size) {
-        size = mtd->page_size;
-    }
     if ((addr + size) > chipsize) {
         size = chipsize - addr;
     }
-    uint32_t page_addr_mask = dev->page_addr_mask;
-    if ((addr & page_addr_mask) != ((addr + size - 1) & page_addr_mask)) {
-        /* Reads across page boundaries must be split */
-        size = mtd->page_size - (addr & ~(page_addr_mask));
-    }
     if (size == 0) {
         return 0;
     }
     be_uint32_t addr_be = byteorder_htonl(addr);
 
+    /* the address counter of the device only wraps at the end of the memory,
+     * so the whole range is read in a single transfer */
     spi_acquire(dev->spi, dev->cs, dev->mode, dev->clk);
-    mtd_spi_cmd_addr_read(dev, dev->opcode->read, addr_be, dest, size);
+    if (dev->flag & SPI_NOR_F_FAST_READ) {
+        mtd_spi_cmd_addr_read(dev, dev->opcode->read_fast, addr_be, 1, dest, size);
+    }
+    else {
+        mtd_spi_cmd_addr_read(dev, dev->opcode->read, addr_be, 0, dest, size);
+    }
     spi_release(dev->spi);
 
     return size;
 }
 
-static int mtd_spi_nor_write(mtd_dev_t *mtd, const void *src, uint32_t addr, uint32_t size)
+/**
+ * @internal
+ * @brief Check that a page program of @p size bytes at @p addr is valid
+ */
+static int write_check(const mtd_spi_nor_t *dev, uint32_t addr, uint32_t size)
 {
+    const mtd_dev_t *mtd = &dev->base;
     uint32_t total_size = mtd->page_size * mtd->pages_per_sector * mtd->sector_count;
 
-    DEBUG("mtd_spi_nor_write: %p, %p, 0x%" PRIx32 ", 0x%" PRIx32 "\n",
-          (void *)mtd, src, addr, size);
-    if (size == 0) {
-        return 0;
-    }
-    const mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
     if (size > mtd->page_size) {
         DEBUG("mtd_spi_nor_write: ERR: page program >1 page (%" PRIu32 ")!\n", mtd->page_size);
         return -EOVERFLOW;
@@ -437,27 +467,118 @@ static int mtd_spi_nor_write(mtd_dev_t *mtd, const void *src, uint32_t addr, uin
     if (addr + size > total_size) {
         return -EOVERFLOW;
     }
+    return 0;
+}
+
+/**
+ * @internal
+ * @brief Send the page program command, the bus must be acquired
+ */
+static void write_issue(const mtd_spi_nor_t *dev, const void *src, uint32_t addr,
+                        uint32_t size)
+{
     be_uint32_t addr_be = byteorder_htonl(addr);
 
-    spi_acquire(dev->spi, dev->cs, dev->mode, dev->clk);
     /* write enable */
     mtd_spi_cmd(dev, dev->opcode->wren);
 
     /* Page program */
     mtd_spi_cmd_addr_write(dev, dev->opcode->page_program, addr_be, src, size);
+}
+
+static int mtd_spi_nor_write(mtd_dev_t *mtd, const void *src, uint32_t addr, uint32_t size)
+{
+    DEBUG("mtd_spi_nor_write: %p, %p, 0x%" PRIx32 ", 0x%" PRIx32 "\n",
+          (void *)mtd, src, addr, size);
+    if (size == 0) {
+        return 0;
+    }
+    const mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
+    int res = write_check(dev, addr, size);
+    if (res < 0) {
+        return res;
+    }
+
+    spi_acquire(dev->spi, dev->cs, dev->mode, dev->clk);
+    write_issue(dev, src, addr, size);
 
     /* waiting for the command to complete before returning */
-    wait_for_write_complete(dev, 0);
+    wait_for_write_complete(dev, MTD_SPI_NOR_WAIT_PP);
 
     spi_release(dev->spi);
     return size;
 }
 
-static int mtd_spi_nor_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size)
+static int mtd_spi_nor_write_start(mtd_dev_t *mtd, const void *src, uint32_t addr, uint32_t size)
 {
-    DEBUG("mtd_spi_nor_erase: %p, 0x%" PRIx32 ", 0x%" PRIx32 "\n",
-          (void *)mtd, addr, size);
-    mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
+    DEBUG("mtd_spi_nor_write_start: %p, %p, 0x%" PRIx32 ", 0x%" PRIx32 "\n",
+          (void *)mtd, src, addr, size);
+    if (size == 0) {
+        return 0;
+    }
+    const mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
+    int res = write_check(dev, addr, size);
+    if (res < 0) {
+        return res;
+    }
+
+    spi_acquire(dev->spi, dev->cs, dev->mode, dev->clk);
+    write_issue(dev, src, addr, size);
+    spi_release(dev->spi);
+    return size;
+}
+
+/**
+ * @internal
+ * @brief Select the largest erase command that starts at @p addr and does not
+ *        erase beyond @p addr + @p size
+ *
+ * @param[in]  dev    pointer to device descriptor
+ * @param[in]  addr   start of the range to erase
+ * @param[in]  size   size of the range to erase
+ * @param[out] len    number of bytes the command erases
+ * @param[out] us     typical duration of the command
+ *
+ * @return  the opcode of the erase command, 0 if none fits
+ */
+static uint8_t erase_cmd(const mtd_spi_nor_t *dev, uint32_t addr, uint32_t size,
+                         uint32_t *len, uint32_t *us)
+{
+    uint32_t block = (dev->flag & SPI_NOR_F_SECT_64K)
+                   ? MTD_64K
+                   : dev->base.page_size * dev->base.pages_per_sector;
+    uint8_t opcode = 0;
+
+    *len = 0;
+    if ((size >= block) && ((addr % block) == 0)) {
+        opcode = dev->opcode->block_erase;
+        *len = block;
+        *us = MTD_SPI_NOR_WAIT_S_ER;
+    }
+    if ((dev->flag & SPI_NOR_F_SECT_32K) && (MTD_32K > *len) &&
+        (size >= MTD_32K) && ((addr & MTD_32K_ADDR_MASK) == 0)) {
+        /* 32 KiB blocks can be erased with block erase command */
+        opcode = dev->opcode->block_erase_32k;
+        *len = MTD_32K;
+        *us = MTD_SPI_NOR_WAIT_32K_ER;
+    }
+    if ((dev->flag & SPI_NOR_F_SECT_4K) && (MTD_4K > *len) &&
+        (size >= MTD_4K) && ((addr & MTD_4K_ADDR_MASK) == 0)) {
+        /* 4 KiB sectors can be erased with sector erase command */
+        opcode = dev->opcode->sector_erase;
+        *len = MTD_4K;
+        *us = MTD_SPI_NOR_WAIT_4K_ER;
+    }
+    return opcode;
+}
+
+/**
+ * @internal
+ * @brief Check that an erase of @p size bytes at @p addr is valid
+ */
+static int erase_check(const mtd_spi_nor_t *dev, uint32_t addr, uint32_t size)
+{
+    const mtd_dev_t *mtd = &dev->base;
     uint32_t sector_size = mtd->page_size * mtd->pages_per_sector;
     uint32_t total_size = sector_size * mtd->sector_count;
 
@@ -476,48 +597,108 @@ static int mtd_spi_nor_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size)
     if (size % sector_size != 0) {
         return -EOVERFLOW;
     }
+    return 0;
+}
 
-    spi_acquire(dev->spi, dev->cs, dev->mode, dev->clk);
-    while (size) {
-        uint32_t us;
-        be_uint32_t addr_be = byteorder_htonl(addr);
+/**
+ * @internal
+ * @brief Send the largest erase command that fits the range, the bus must be
+ *        acquired
+ *
+ * @param[in]  dev    pointer to device descriptor
+ * @param[in]  addr   start of the range to erase
+ * @param[in]  size   size of the range to erase
+ * @param[out] len    number of bytes the command erases
+ * @param[out] us     typical duration of the command
+ *
+ * @return  0 on success, -EOVERFLOW if no erase command fits
+ */
+static int erase_issue(const mtd_spi_nor_t *dev, uint32_t addr, uint32_t size,
+                       uint32_t *len, uint32_t *us)
+{
+    const mtd_dev_t *mtd = &dev->base;
+    uint32_t total_size = mtd->page_size * mtd->pages_per_sector * mtd->sector_count;
+    be_uint32_t addr_be = byteorder_htonl(addr);
+    uint8_t opcode;
+
+    if (size == total_size) {
         /* write enable */
         mtd_spi_cmd(dev, dev->opcode->wren);
+        mtd_spi_cmd(dev, dev->opcode->chip_erase);
+        *len = total_size;
+        *us = MTD_SPI_NOR_WAIT_C_ER;
+        return 0;
+    }
+    if ((opcode = erase_cmd(dev, addr, size, len, us)) == 0) {
+        DEBUG("mtd_spi_nor_erase: ERR: no erase command fits 0x%" PRIx32 "\n", addr);
+        return -EOVERFLOW;
+    }
+    /* write enable */
+    mtd_spi_cmd(dev, dev->opcode->wren);
+    mtd_spi_cmd_addr_write(dev, opcode, addr_be, NULL, 0);
+    return 0;
+}
 
-        if (size == total_size) {
-            mtd_spi_cmd(dev, dev->opcode->chip_erase);
-            size -= total_size;
-            us = MTD_SPI_NOR_WAIT_C_ER;
-        }
-        else if ((dev->flag & SPI_NOR_F_SECT_32K) && (size >= MTD_32K) &&
-                 ((addr & MTD_32K_ADDR_MASK) == 0)) {
-            /* 32 KiB blocks can be erased with block erase command */
-            mtd_spi_cmd_addr_write(dev, dev->opcode->block_erase_32k, addr_be, NULL, 0);
-            addr += MTD_32K;
-            size -= MTD_32K;
-            us = MTD_SPI_NOR_WAIT_32K_ER;
-        }
-        else if ((dev->flag & SPI_NOR_F_SECT_4K) && (size >= MTD_4K) &&
-                 ((addr & MTD_4K_ADDR_MASK) == 0)) {
-            /* 4 KiB sectors can be erased with sector erase command */
-            mtd_spi_cmd_addr_write(dev, dev->opcode->sector_erase, addr_be, NULL, 0);
-            addr += MTD_4K;
-            size -= MTD_4K;
-            us = MTD_SPI_NOR_WAIT_4K_ER;
-        }
-        else {
-            mtd_spi_cmd_addr_write(dev, dev->opcode->block_erase, addr_be, NULL, 0);
-            addr += sector_size;
-            size -= sector_size;
-            us = MTD_SPI_NOR_WAIT_S_ER;
+static int mtd_spi_nor_erase(mtd_dev_t *mtd, uint32_t addr, uint32_t size)
+{
+    DEBUG("mtd_spi_nor_erase: %p, 0x%" PRIx32 ", 0x%" PRIx32 "\n",
+          (void *)mtd, addr, size);
+    mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
+    int res = erase_check(dev, addr, size);
+    if (res < 0) {
+        return res;
+    }
+
+    spi_acquire(dev->spi, dev->cs, dev->mode, dev->clk);
+    while (size) {
+        uint32_t us, len;
+
+        if ((res = erase_issue(dev, addr, size, &len, &us)) < 0) {
+            break;
         }
+        addr += len;
+        size -= len;
 
         /* waiting for the command to complete before continuing */
         wait_for_write_complete(dev, us);
     }
     spi_release(dev->spi);
 
-    return 0;
+    return res;
+}
+
+static int mtd_spi_nor_erase_start(mtd_dev_t *mtd, uint32_t addr, uint32_t size)
+{
+    DEBUG("mtd_spi_nor_erase_start: %p, 0x%" PRIx32 ", 0x%" PRIx32 "\n",
+          (void *)mtd, addr, size);
+    mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
+    uint32_t us, len;
+    int res = erase_check(dev, addr, size);
+    if (res < 0) {
+        return res;
+    }
+    if (size == 0) {
+        return 0;
+    }
+
+    spi_acquire(dev->spi, dev->cs, dev->mode, dev->clk);
+    res = erase_issue(dev, addr, size, &len, &us);
+    spi_release(dev->spi);
+
+    return (res < 0) ? res : (int)len;
+}
+
+static int mtd_spi_nor_busy(mtd_dev_t *mtd)
+{
+    mtd_spi_nor_t *dev = (mtd_spi_nor_t *)mtd;
+    uint8_t status;
+
+    spi_acquire(dev->spi, dev->cs, dev->mode, dev->clk);
+    mtd_spi_cmd_read(dev, dev->opcode->rdsr, &status, sizeof(status));
+    spi_release(dev->spi);
+
+    TRACE("mtd_spi_nor_busy: device status = 0x%02x\n", (unsigned int)status);
+    return (status & SFLASH_STATUS_WIP);
 }
 
 static int mtd_spi_nor_power(mtd_dev_t *mtd, enum mtd_power_state power)
@@ -11,6 +11,13 @@
  * @ingroup     net
  * @brief       FIB implementation
  *
+ * By default, fib_get_next_hop() compares the destination with every entry
+ * of a table. The `fib_radix` module indexes single hop tables with a radix
+ * tree instead, so the costs of a lookup depend on the address length rather
+ * than the number of entries. A lookup then always picks the entry with the
+ * longest prefix matching the destination. The nodes of the tree are stored
+ * in the entries of the table, see fib_entry_t::radix_nodes.
+ *
  * @{
  *
  * @file
@@ -35,10 +35,34 @@ extern "C" {
  */
 #define FIB_MAX_REGISTERED_RP (5)
 
+#if defined(MODULE_FIB_RADIX) || defined(DOXYGEN)
+/**
+ * @brief Node of the radix tree indexing the entries of a FIB table
+ *
+ * A node stands for the first fib_radix_node_t::len bits of
+ * fib_radix_node_t::key. Nodes without entries only branch, they always
+ * have two children.
+ *
+ * @note    Only available with the `fib_radix` module
+ */
+typedef struct fib_radix_node {
+    /** Parent of the node, NULL for the root */
+    struct fib_radix_node *parent;
+    /** Children for a `0` and a `1` at bit fib_radix_node_t::len */
+    struct fib_radix_node *child[2];
+    /** Entries with this prefix, linked by fib_entry_t::radix_next */
+    struct fib_entry *entry;
+    /** Address the prefix is taken from */
+    const uint8_t *key;
+    /** Prefix length in bits */
+    uint16_t len;
+} fib_radix_node_t;
+#endif
+
 /**
  * @brief Container descriptor for a FIB entry
  */
-typedef struct {
+typedef struct fib_entry {
     /** interface ID */
     kernel_pid_t iface_id;
     /** Lifetime of this entry (an absolute time-point is stored by the FIB) */
@@ -51,6 +75,18 @@ typedef struct {
     uint32_t next_hop_flags;
     /** Pointer to the shared generic address */
     universal_address_container_t *next_hop;
+#if defined(MODULE_FIB_RADIX) || defined(DOXYGEN)
+    /**
+     * @brief   Storage for the radix tree of the table
+     *
+     * An entry needs at most two nodes, one for its prefix and one to branch.
+     * They are taken from a pool of all entries of the table, so they do not
+     * necessarily index this entry.
+     */
+    fib_radix_node_t radix_nodes[2];
+    /** Next entry with the same prefix in the radix tree */
+    struct fib_entry *radix_next;
+#endif
 } fib_entry_t;
 
 /**
@@ -133,6 +169,12 @@ typedef struct {
     *   e.g. when the unreachable destination is covered by the prefix
     */
     universal_address_container_t* prefix_rp[FIB_MAX_REGISTERED_RP];
+#if defined(MODULE_FIB_RADIX) || defined(DOXYGEN)
+    /** Root of the radix tree indexing the single hop entries */
+    fib_radix_node_t *radix_root;
+    /** Unused nodes of fib_entry_t::radix_nodes */
+    fib_radix_node_t *radix_free;
+#endif
 } fib_table_t;
 
 #ifdef __cplusplus
@@ -53,6 +53,11 @@
  * wrapped in a gcoap_listener_t. Also see _Server path matching_ in the base
  * [nanocoap](group__net__nanocoap.html) documentation.
  *
+ * If the resources of a listener are ordered and none of them uses
+ * @ref COAP_MATCH_SUBTREE, gcoap looks up request paths by binary search among
+ * them. Otherwise, it compares the path to each resource in turn, which gets
+ * slow for listeners with many resources.
+ *
  * gcoap itself defines a resource for `/.well-known/core` discovery, which
  * lists all of the registered paths. See the _Resource list creation_ section
  * below for more.
@@ -209,7 +214,8 @@
  *
  * gcoap provides for both server side and client side blockwise messaging for
  * requests and responses. This section outlines how to write a message for
- * each situation.
+ * each situation. A client that transfers a whole body may use the
+ * `gcoap_block` module instead, see @ref net_gcoap_block.
  *
  * ### CoAP server GET handling ###
  *
@@ -424,6 +430,10 @@ extern "C" {
 
 /**
  * @brief   Maximum number of requests awaiting a response
+ *
+ * Responses are matched to requests via a hash index over the token, so this
+ * may be raised to some hundreds. Each request costs about 4 bytes of RAM for
+ * the index in addition to its memo. Values above 65535 are not supported.
  */
 #ifndef CONFIG_GCOAP_REQ_WAITING_MAX
 #define CONFIG_GCOAP_REQ_WAITING_MAX   (2)
@@ -605,11 +615,67 @@ extern "C" {
 /**
  * @ingroup net_gcoap_conf
  * @brief   Count of PDU buffers available for resending confirmable messages
+ *
+ * Only used to size @ref CONFIG_GCOAP_RESEND_POOL_SIZE by default.
  */
 #ifndef CONFIG_GCOAP_RESEND_BUFS_MAX
 #define CONFIG_GCOAP_RESEND_BUFS_MAX      (1)
 #endif
 
+/**
+ * @ingroup net_gcoap_conf
+ * @brief   Size in bytes of the pool for resending confirmable messages
+ *
+ * Each confirmable request occupies its actual length plus 2 bytes (rounded
+ * up to an even count) until it is answered or times out, so more small
+ * requests than @ref CONFIG_GCOAP_RESEND_BUFS_MAX fit into the default size.
+ * Must be below 65536.
+ */
+#ifndef CONFIG_GCOAP_RESEND_POOL_SIZE
+#define CONFIG_GCOAP_RESEND_POOL_SIZE \
+    (CONFIG_GCOAP_RESEND_BUFS_MAX * (CONFIG_GCOAP_PDU_BUF_SIZE + 2))
+#endif
+
+#ifdef DOXYGEN
+/**
+ * @ingroup net_gcoap_conf
+ * @brief   Estimates retransmission timeouts per destination when defined
+ *          (undefined per default)
+ *
+ * Instead of starting from @ref COAP_ACK_TIMEOUT for each confirmable request,
+ * the initial timeout is derived from the round-trip times measured for
+ * earlier requests to the same destination, and the timeout backs off by a
+ * factor depending on its size, as per
+ * [CoCoA](https://tools.ietf.org/html/draft-ietf-core-cocoa-03). Up to
+ * @ref CONFIG_GCOAP_NSTART confirmable requests to a destination may be open
+ * at once; gcoap_req_send() fails for further ones.
+ */
+#define CONFIG_GCOAP_COCOA
+#endif
+
+/**
+ * @ingroup net_gcoap_conf
+ * @brief   Maximum number of open confirmable requests per destination
+ *
+ * @note    Only applicable with @ref CONFIG_GCOAP_COCOA
+ */
+#ifndef CONFIG_GCOAP_NSTART
+#define CONFIG_GCOAP_NSTART               (4)
+#endif
+
+/**
+ * @ingroup net_gcoap_conf
+ * @brief   Number of destinations to estimate retransmission timeouts for
+ *
+ * When all destinations are in use, a new destination replaces the one idle
+ * the longest without open confirmable requests. Must not exceed 256.
+ *
+ * @note    Only applicable with @ref CONFIG_GCOAP_COCOA
+ */
+#ifndef CONFIG_GCOAP_COCOA_DESTS_MAX
+#define CONFIG_GCOAP_COCOA_DESTS_MAX      (2)
+#endif
+
 /**
  * @name Bitwise positional flags for encoding resource links
  * @{
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gcoap_block Gcoap block-wise transfers
+ * @ingroup     net_gcoap
+ * @brief       Block-wise (RFC 7959) transfer of large bodies with gcoap
+ *
+ * Instead of building each Block1 or Block2 request by hand, a client passes
+ * the whole body to gcoap_block1_send() via a source callback, or receives it
+ * from gcoap_block2_get() via a sink callback. Both functions block the
+ * calling thread until the transfer is complete, so they must not be called
+ * from the gcoap thread, e.g. from a response handler.
+ *
+ * ## Block size negotiation ##
+ *
+ * The first block is exchanged alone with the block size requested by the
+ * caller, reduced to fit into @ref CONFIG_GCOAP_PDU_BUF_SIZE. If the server
+ * answers with a smaller block size, all further blocks use that size. For
+ * Block1, a 4.13 (Request Entity Too Large) response to the first block that
+ * names a smaller block size restarts the transfer with that size.
+ *
+ * ## Pipelining ##
+ *
+ * After the first block, up to `window` blocks are in flight at once. Each
+ * block is sent as a confirmable request, so the window is also bounded by
+ * @ref CONFIG_GCOAP_REQ_WAITING_MAX, @ref CONFIG_GCOAP_RESEND_POOL_SIZE and,
+ * with @ref CONFIG_GCOAP_COCOA, @ref CONFIG_GCOAP_NSTART. The engine simply
+ * sends fewer blocks at once while gcoap runs out of these.
+ *
+ * With a window above 1, blocks of a Block2 transfer may reach the sink out of
+ * order, so the sink must handle the offset of each block, e.g. by writing to
+ * flash at that offset. The server must serve the resource for random access,
+ * i.e. return the requested block for each request. Requests beyond the end of
+ * the body are answered with an error that the engine ignores. For Block1, the
+ * last block is only sent once all other blocks are acknowledged, so the
+ * server sees a complete body when it answers the last block.
+ *
+ * Sink and source callbacks run on the gcoap thread and on the calling thread
+ * respectively. A sink that takes long delays all other gcoap messaging.
+ *
+ * @{
+ *
+ * @file
+ * @brief       gcoap block-wise transfer definitions
+ */
+
+#ifndef NET_GCOAP_BLOCK_H
+#define NET_GCOAP_BLOCK_H
+
+#include "net/gcoap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Receives a block of a Block2 transfer
+ *
+ * @param[in] arg       argument passed to gcoap_block2_get()
+ * @param[in] offset    offset of the block in the body
+ * @param[in] buf       payload of the block
+ * @param[in] len       length of @p buf
+ * @param[in] more      false if this is the last block
+ *
+ * @return  0 on success
+ * @return  < 0 to abort the transfer
+ */
+typedef int (*gcoap_block_sink_t)(void *arg, size_t offset, const uint8_t *buf,
+                                  size_t len, bool more);
+
+/**
+ * @brief   Provides a block for a Block1 transfer
+ *
+ * @param[in] arg       argument passed to gcoap_block1_send()
+ * @param[in] offset    offset of the block in the body
+ * @param[out] buf      buffer to write the block to
+ * @param[in] len       length of the block
+ *
+ * @return  @p len on success
+ * @return  < 0 to abort the transfer
+ */
+typedef ssize_t (*gcoap_block_source_t)(void *arg, size_t offset, uint8_t *buf,
+                                        size_t len);
+
+/**
+ * @brief   Gets a resource block-wise
+ *
+ * If the server does not answer with a Block2 option, its response is passed
+ * to @p sink as the only block.
+ *
+ * @param[in] remote    server endpoint
+ * @param[in] path      resource path, must start with `/`
+ * @param[in] szx       block size exponent to request, the block size is
+ *                      `16 << szx` bytes
+ * @param[in] window    maximum number of blocks in flight
+ * @param[in] sink      receives the blocks
+ * @param[in] arg       argument for @p sink
+ *
+ * @return  length of the body on success
+ * @return  -ETIMEDOUT, if a block was not answered
+ * @return  -EPROTO, if the server answered a block with an error code
+ * @return  -EBADMSG, if the server answered with an unexpected block
+ * @return  -ENOMEM, if gcoap has no space for a request
+ * @return  the negative return value of @p sink, if it aborted the transfer
+ */
+ssize_t gcoap_block2_get(const sock_udp_ep_t *remote, const char *path,
+                         unsigned szx, unsigned window,
+                         gcoap_block_sink_t sink, void *arg);
+
+/**
+ * @brief   Sends a request body block-wise
+ *
+ * @param[in] remote    server endpoint
+ * @param[in] path      resource path, must start with `/`
+ * @param[in] method    request method, e.g. COAP_METHOD_PUT
+ * @param[in] len       length of the body
+ * @param[in] szx       block size exponent to start with, the block size is
+ *                      `16 << szx` bytes
+ * @param[in] window    maximum number of blocks in flight
+ * @param[in] source    provides the blocks
+ * @param[in] arg       argument for @p source
+ *
+ * @return  raw code of the response to the last block, e.g.
+ *          COAP_CODE_CHANGED, on success
+ * @return  -ETIMEDOUT, if a block was not answered
+ * @return  -EPROTO, if the server answered a block with an error code
+ * @return  -ENOSPC, if a block does not fit into a request
+ * @return  -ENOMEM, if gcoap has no space for a request
+ * @return  the negative return value of @p source, if it aborted the transfer
+ */
+int gcoap_block1_send(const sock_udp_ep_t *remote, const char *path,
+                      unsigned method, size_t len, unsigned szx,
+                      unsigned window, gcoap_block_source_t source, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GCOAP_BLOCK_H */
+/** @} */
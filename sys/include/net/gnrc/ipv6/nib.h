@@ -29,6 +29,7 @@
 #include "net/gnrc/ipv6/nib/ft.h"
 #include "net/gnrc/ipv6/nib/nc.h"
 #include "net/gnrc/ipv6/nib/pl.h"
+#include "net/gnrc/ipv6/nib/rc.h"
 
 #include "net/icmpv6.h"
 #include "net/ipv6/addr.h"
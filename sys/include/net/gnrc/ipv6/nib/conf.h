@@ -266,6 +266,38 @@ extern "C" {
 #define GNRC_IPV6_NIB_OFFL_NUMOF            (8)
 #endif
 
+/**
+ * @brief   Index the NIB for faster lookups
+ *
+ * When set, on-link entries are looked up via a hash table over their address
+ * and off-link entries via a longest prefix match trie instead of scanning all
+ * entries. This costs about 4 bytes of RAM per on-link and 50 bytes of RAM per
+ * off-link entry, so it only pays off for large NIBs, e.g. on border routers.
+ */
+#ifdef DOXYGEN
+#define CONFIG_GNRC_IPV6_NIB_INDEX
+#endif
+
+/**
+ * @brief   Number of hash buckets for on-link entries
+ *
+ * @note    Only applicable with @ref CONFIG_GNRC_IPV6_NIB_INDEX
+ */
+#ifndef CONFIG_GNRC_IPV6_NIB_INDEX_BUCKETS
+#define CONFIG_GNRC_IPV6_NIB_INDEX_BUCKETS  (16)
+#endif
+
+/**
+ * @brief   Number of destinations in the route cache
+ *
+ * 0 disables the route cache.
+ *
+ * @see @ref net_gnrc_ipv6_nib_rc
+ */
+#ifndef CONFIG_GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF
+#define CONFIG_GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF  (0)
+#endif
+
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C || defined(DOXYGEN)
 /**
  * @brief   Number of authoritative border router entries in NIB
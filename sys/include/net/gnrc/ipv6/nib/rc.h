@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_ipv6_nib_rc    Route cache
+ * @ingroup     net_gnrc_ipv6_nib
+ * @brief       Cache for next hop resolution results of the neighbor
+ *              information base
+ *
+ * The route cache stores the results of
+ * @ref gnrc_ipv6_nib_get_next_hop_l2addr() for recently used destinations,
+ * so packets of a flow don't need to go through route lookup and address
+ * resolution again. When a neighbor cache entry changes, only the entries to
+ * or via that neighbor are removed. Changes of routes, prefixes or default
+ * routers flush the whole cache.
+ *
+ * The number of cached destinations is configured with
+ * @ref CONFIG_GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF. The cache is disabled by
+ * default.
+ * @{
+ *
+ * @file
+ * @brief   Route cache definitions
+ */
+#ifndef NET_GNRC_IPV6_NIB_RC_H
+#define NET_GNRC_IPV6_NIB_RC_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Route cache statistics
+ */
+typedef struct {
+    uint32_t hits;          /**< lookups answered from the cache */
+    uint32_t misses;        /**< lookups that needed to consult the NIB */
+    uint32_t flushes;       /**< number of times the cache was flushed */
+} gnrc_ipv6_nib_rc_stats_t;
+
+/**
+ * @brief   Gets the statistics of the route cache
+ *
+ * @pre `(stats != NULL)`
+ *
+ * @param[out] stats    The statistics of the route cache.
+ */
+void gnrc_ipv6_nib_rc_get_stats(gnrc_ipv6_nib_rc_stats_t *stats);
+
+/**
+ * @brief   Removes all entries from the route cache
+ */
+void gnrc_ipv6_nib_rc_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_IPV6_NIB_RC_H */
+/** @} */
@@ -93,6 +93,17 @@ extern "C" {
  */
 #define GNRC_NETAPI_MSG_TYPE_ACK        (0x0205)
 
+/**
+ * @brief   @ref core_msg type for passing a batch of @ref net_gnrc_pkt up the
+ *          network stack
+ *
+ * The message's content is a packet, whose data is an array of the packets
+ * in the batch. The receiver takes over all of them.
+ *
+ * @see @ref net_gnrc_netif_rx_batch
+ */
+#define GNRC_NETAPI_MSG_TYPE_RCV_BATCH  (0x0207)
+
 /**
  * @brief   Data structure to be send for setting (@ref GNRC_NETAPI_MSG_TYPE_SET)
  *          and getting (@ref GNRC_NETAPI_MSG_TYPE_GET) options
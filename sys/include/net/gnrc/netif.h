@@ -43,6 +43,9 @@
 #if defined(MODULE_GNRC_NETIF_DEDUP) && (GNRC_NETIF_L2ADDR_MAXLEN > 0)
 #include "net/gnrc/netif/dedup.h"
 #endif
+#ifdef MODULE_GNRC_NETIF_RX_BATCH
+#include "net/gnrc/netif/rx_batch.h"
+#endif
 #include "net/gnrc/netif/flags.h"
 #ifdef MODULE_GNRC_IPV6
 #include "net/gnrc/netif/ipv6.h"
@@ -120,6 +123,14 @@ typedef struct {
 #endif
 #if defined(MODULE_GNRC_SIXLOWPAN) || DOXYGEN
     gnrc_netif_6lo_t sixlo;                 /**< 6Lo component */
+#endif
+#if defined(MODULE_GNRC_NETIF_RX_BATCH) || DOXYGEN
+    /**
+     * @brief   Received packets not yet handed to the IPv6 thread
+     *
+     * @note    Only available with @ref net_gnrc_netif_rx_batch.
+     */
+    gnrc_netif_rx_batch_t rx_batch;
 #endif
     uint8_t cur_hl;                         /**< Current hop-limit for out-going packets */
     uint8_t device_type;                    /**< Device type */
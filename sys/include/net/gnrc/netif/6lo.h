@@ -20,6 +20,8 @@
 
 #include <stdint.h>
 
+#include "net/gnrc/sixlowpan/frag/stats.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -35,6 +37,17 @@ typedef struct {
      *          @ref net_gnrc_sixlowpan_frag "gnrc_sixlowpan_frag".
      */
     uint8_t max_frag_size;
+#if (defined(MODULE_GNRC_SIXLOWPAN_FRAG_STATS) && \
+     defined(MODULE_GNRC_SIXLOWPAN_FRAG_VRB)) || defined(DOXYGEN)
+    /**
+     * @brief   Statistics on forwarding fragments via this interface
+     *
+     * @note    Only available with modules
+     *          @ref net_gnrc_sixlowpan_frag_stats "gnrc_sixlowpan_frag_stats"
+     *          and @ref net_gnrc_sixlowpan_frag_vrb "gnrc_sixlowpan_frag_vrb".
+     */
+    gnrc_sixlowpan_frag_vrb_stats_t vrb_stats;
+#endif
 } gnrc_netif_6lo_t;
 
 #ifdef __cplusplus
@@ -148,6 +148,28 @@ extern "C" {
 #define CONFIG_GNRC_NETIF_MIN_WAIT_AFTER_SEND_US   (0U)
 #endif
 
+/**
+ * @brief   Maximum number of received packets handed to the IPv6 thread at
+ *          once
+ *
+ * @note    Only applicable with @ref net_gnrc_netif_rx_batch
+ */
+#ifndef CONFIG_GNRC_NETIF_RX_BATCH_SIZE
+#define CONFIG_GNRC_NETIF_RX_BATCH_SIZE         (8U)
+#endif
+
+/**
+ * @brief   Maximum time in microseconds a received packet is held back for
+ *          a batch
+ *
+ * This is a soft limit, see @ref net_gnrc_netif_rx_batch.
+ *
+ * @note    Only applicable with @ref net_gnrc_netif_rx_batch
+ */
+#ifndef CONFIG_GNRC_NETIF_RX_BATCH_BUDGET_US
+#define CONFIG_GNRC_NETIF_RX_BATCH_BUDGET_US    (1000U)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_netif_rx_batch Batched delivery of received packets
+ * @ingroup     net_gnrc_netif
+ * @brief       Hands received IPv6 packets to @ref net_gnrc_ipv6 in batches
+ *
+ * To activate, use `USEMODULE += gnrc_netif_rx_batch` in your application's
+ * Makefile.
+ *
+ * Usually every received packet is sent to the IPv6 thread in a message of
+ * its own, so the thread is woken up for every single packet. With this
+ * module, an interface collects up to @ref CONFIG_GNRC_NETIF_RX_BATCH_SIZE
+ * received IPv6 packets and sends them in one
+ * @ref GNRC_NETAPI_MSG_TYPE_RCV_BATCH message. A batch is sent as soon as
+ *
+ * - it is full,
+ * - the interface thread has no further messages to handle, or
+ * - its first packet was received @ref CONFIG_GNRC_NETIF_RX_BATCH_BUDGET_US
+ *   or longer ago,
+ *
+ * so a burst of packets only wakes up the IPv6 thread once, while a single
+ * packet is not delayed. The budget is a soft limit: it is checked whenever
+ * the interface thread receives a packet or takes its next message, so a
+ * packet may be held back longer by the time it takes to handle one message.
+ *
+ * Packets are only batched while the IPv6 thread is the only one registered
+ * for IPv6 packets, as other receivers don't handle
+ * @ref GNRC_NETAPI_MSG_TYPE_RCV_BATCH. Otherwise, they are dispatched one by
+ * one as usual.
+ *
+ * @{
+ *
+ * @file
+ * @brief   Definitions for batched delivery of received packets
+ */
+#ifndef NET_GNRC_NETIF_RX_BATCH_H
+#define NET_GNRC_NETIF_RX_BATCH_H
+
+#include <stdint.h>
+
+#include "net/gnrc/netif/conf.h"
+#include "net/gnrc/pkt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Batching statistics of an interface
+ *
+ * The average batch size is gnrc_netif_rx_batch_stats_t::pkts /
+ * gnrc_netif_rx_batch_stats_t::batches.
+ */
+typedef struct {
+    uint32_t batches;   /**< number of batches handed to the IPv6 thread */
+    uint32_t pkts;      /**< number of packets in these batches */
+} gnrc_netif_rx_batch_stats_t;
+
+/**
+ * @brief   Batch of received packets of an interface
+ */
+typedef struct {
+    /**
+     * @brief   Packets collected for the current batch
+     */
+    gnrc_pktsnip_t *pkts[CONFIG_GNRC_NETIF_RX_BATCH_SIZE];
+    uint32_t start;                     /**< reception time of gnrc_netif_rx_batch_t::pkts[0] in us */
+    gnrc_netif_rx_batch_stats_t stats;  /**< batching statistics */
+    uint8_t numof;                      /**< number of packets in gnrc_netif_rx_batch_t::pkts */
+} gnrc_netif_rx_batch_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_NETIF_RX_BATCH_H */
+/** @} */
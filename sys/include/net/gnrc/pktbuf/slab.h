@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_pktbuf_slab    Size-class packet buffer
+ * @ingroup     net_gnrc_pktbuf
+ * @brief       Packet buffer backend based on fixed size classes
+ *
+ * This packet buffer implementation is selected with the
+ * `gnrc_pktbuf_slab` module. Instead of the first-fit free list of
+ * `gnrc_pktbuf_static` it keeps one pool of fixed-size slots for packet snip
+ * descriptors and @ref GNRC_PKTBUF_SLAB_CLASS_NUMOF pools for packet data.
+ * Each pool has its own free list, so allocating and freeing a chunk is O(1)
+ * and the buffer can not fragment. Data is always placed into the smallest
+ * class that fits and falls back to larger classes if that class is
+ * exhausted.
+ *
+ * @ref gnrc_pktbuf_mark() does not copy data: both resulting snips keep
+ * referencing the same slot, which is only returned to its pool when the
+ * last snip referencing it is released.
+ *
+ * @{
+ *
+ * @file
+ * @brief   Size-class packet buffer definitions
+ */
+#ifndef NET_GNRC_PKTBUF_SLAB_H
+#define NET_GNRC_PKTBUF_SLAB_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of packet snip descriptors in the pool
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF
+#define CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF  (48U)
+#endif
+
+/**
+ * @name    Data size classes
+ *
+ * Sizes must be given in ascending order. The largest class limits the
+ * maximum size of a single packet snip's data.
+ *
+ * The defaults roughly match the memory of @ref GNRC_PKTBUF_SIZE and are
+ * geared towards headers (class 0), small payloads like 802.15.4 frames
+ * (class 1), and full-MTU IPv6 or Ethernet frames (classes 2 and 3).
+ * @{
+ */
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_CLASS0_SIZE
+#define CONFIG_GNRC_PKTBUF_SLAB_CLASS0_SIZE     (64U)
+#endif
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_CLASS0_NUMOF
+#define CONFIG_GNRC_PKTBUF_SLAB_CLASS0_NUMOF    (16U)
+#endif
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_CLASS1_SIZE
+#define CONFIG_GNRC_PKTBUF_SLAB_CLASS1_SIZE     (128U)
+#endif
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_CLASS1_NUMOF
+#define CONFIG_GNRC_PKTBUF_SLAB_CLASS1_NUMOF    (8U)
+#endif
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_CLASS2_SIZE
+#define CONFIG_GNRC_PKTBUF_SLAB_CLASS2_SIZE     (512U)
+#endif
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_CLASS2_NUMOF
+#define CONFIG_GNRC_PKTBUF_SLAB_CLASS2_NUMOF    (2U)
+#endif
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_CLASS3_SIZE
+#define CONFIG_GNRC_PKTBUF_SLAB_CLASS3_SIZE     (1536U)
+#endif
+#ifndef CONFIG_GNRC_PKTBUF_SLAB_CLASS3_NUMOF
+#define CONFIG_GNRC_PKTBUF_SLAB_CLASS3_NUMOF    (2U)
+#endif
+/** @} */
+
+/**
+ * @brief   Number of data size classes
+ */
+#define GNRC_PKTBUF_SLAB_CLASS_NUMOF    (4U)
+
+/**
+ * @brief   Statistics of a single size class
+ */
+typedef struct {
+    uint16_t size;          /**< size of one slot in bytes */
+    uint16_t numof;         /**< number of slots */
+    uint16_t used;          /**< slots currently in use */
+    uint16_t max_used;      /**< maximum number of slots used at once */
+    uint32_t allocs;        /**< successful allocations from this class */
+    uint32_t fails;         /**< allocations that found this class exhausted */
+} gnrc_pktbuf_slab_stats_t;
+
+/**
+ * @brief   Gets the statistics of a size class
+ *
+ * @param[in] cls       Size class. `0` to
+ *                      `GNRC_PKTBUF_SLAB_CLASS_NUMOF - 1` are the data
+ *                      classes, @ref GNRC_PKTBUF_SLAB_CLASS_NUMOF is the
+ *                      packet snip descriptor pool.
+ * @param[out] stats    Statistics of @p cls.
+ *
+ * @return  0 on success
+ * @return  -ENOENT, if @p cls does not exist
+ */
+int gnrc_pktbuf_slab_get_stats(unsigned cls, gnrc_pktbuf_slab_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_PKTBUF_SLAB_H */
+/** @} */
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_rpl_sr RPL non-storing mode source routes
+ * @ingroup     net_gnrc_rpl
+ * @brief       Source routes of a DODAG root in non-storing mode
+ * @see <a href="https://tools.ietf.org/html/rfc6550#section-9.7">
+ *          RFC 6550, section 9.7
+ *      </a>
+ * @see <a href="https://tools.ietf.org/html/rfc6554">
+ *          RFC 6554
+ *      </a>
+ *
+ * In non-storing mode the nodes of a DODAG report their parent to the root
+ * with the transit information option of their DAOs. Instead of one
+ * downward route per node in the forwarding table, the root keeps a compact
+ * table of child → parent pointers and computes the path to a destination
+ * by following the pointers up to itself.
+ *
+ * The RPL source routing headers built from these paths are kept in a small
+ * cache, every node refers to the entry of its header. Entries are replaced
+ * in round-robin order. Any change of the topology invalidates all cached
+ * headers at once, refreshing the lifetime of a node does not.
+ *
+ * Together with @ref net_gnrc_rpl, the root inserts the headers into the
+ * unicast packets it sends or forwards into the DODAG. Only the children of
+ * the root, the first hops of all paths, keep a route in the forwarding
+ * table.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Definitions for source routes of non-storing mode DODAG roots
+ */
+#ifndef NET_GNRC_RPL_SR_H
+#define NET_GNRC_RPL_SR_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "net/ipv6/addr.h"
+#include "net/gnrc/rpl/srh.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of nodes in the parent table
+ *
+ * @note    Parents a node announced before they sent a DAO of their own
+ *          occupy an entry, too. The root itself needs one.
+ */
+#ifndef GNRC_RPL_SR_NODES_NUMOF
+#define GNRC_RPL_SR_NODES_NUMOF         (32U)
+#endif
+
+/**
+ * @brief   Number of hash buckets to look up nodes in the parent table
+ *
+ * @note    Must be a power of 2.
+ */
+#ifndef GNRC_RPL_SR_BUCKETS_NUMOF
+#define GNRC_RPL_SR_BUCKETS_NUMOF       (16U)
+#endif
+
+/**
+ * @brief   Maximum number of hops of a source route
+ *
+ * Longer paths are reported as a loop.
+ */
+#ifndef GNRC_RPL_SR_HOPS_MAX
+#define GNRC_RPL_SR_HOPS_MAX            (16U)
+#endif
+
+/**
+ * @brief   Number of source routing headers in the cache
+ *
+ * @note    Set to 0 to disable the cache.
+ */
+#ifndef GNRC_RPL_SR_CACHE_NUMOF
+#define GNRC_RPL_SR_CACHE_NUMOF         (8U)
+#endif
+
+/**
+ * @brief   Maximum size of a cached source routing header in bytes
+ *
+ * Headers that do not fit are built on every request. The default fits
+ * paths of @ref GNRC_RPL_SR_HOPS_MAX hops within one /64 prefix.
+ */
+#ifndef GNRC_RPL_SR_CACHE_SRH_SIZE
+#define GNRC_RPL_SR_CACHE_SRH_SIZE      (sizeof(gnrc_rpl_srh_t) + \
+                                         (GNRC_RPL_SR_HOPS_MAX * 8U))
+#endif
+
+/**
+ * @brief   A node in the parent table
+ *
+ * Node references are indexes + 1 into the table, so 0 is no node.
+ */
+typedef struct {
+    ipv6_addr_t addr;       /**< address of the node */
+    uint32_t expires;       /**< expiry in seconds, 0 if the entry is unused */
+    uint16_t parent;        /**< parent of the node */
+    uint16_t next;          /**< next node in the same hash bucket */
+    uint16_t cache;         /**< cache entry of the node + 1, 0 for none */
+} gnrc_rpl_sr_node_t;
+
+/**
+ * @brief   A cached source routing header
+ */
+typedef struct {
+    uint32_t expires;       /**< first expiry of a node on the path */
+    uint16_t gen;           /**< topology generation of the header */
+    uint16_t dst;           /**< node of the destination */
+    uint16_t len;           /**< size of gnrc_rpl_sr_cache_t::srh */
+    ipv6_addr_t first_hop;  /**< IPv6 destination to send the packet to */
+    /**
+     * @brief   The source routing header
+     */
+    uint8_t srh[GNRC_RPL_SR_CACHE_SRH_SIZE] __attribute__((aligned(4)));
+} gnrc_rpl_sr_cache_t;
+
+/**
+ * @brief   Adds or updates a node in the parent table
+ *
+ * @param[in] target    Address of the node.
+ * @param[in] parent    Address of the parent of @p target, e.g. the
+ *                      address of the DODAG root for its direct children.
+ * @param[in] lifetime  Lifetime of the node in seconds.
+ *
+ * @return  0, on success
+ * @return  -EINVAL, if @p target equals @p parent
+ * @return  -ENOMEM, if the table is full
+ */
+int gnrc_rpl_sr_add(const ipv6_addr_t *target, const ipv6_addr_t *parent,
+                    uint32_t lifetime);
+
+/**
+ * @brief   Removes a node from the parent table
+ *
+ * Paths through @p target are unreachable until its children announce a
+ * new parent.
+ *
+ * @param[in] target    Address of the node.
+ */
+void gnrc_rpl_sr_del(const ipv6_addr_t *target);
+
+/**
+ * @brief   Removes all nodes from the parent table
+ */
+void gnrc_rpl_sr_reset(void);
+
+/**
+ * @brief   Builds the source routing header from the root to a destination
+ *
+ * @param[in] root      Address of the DODAG root, i.e. the source.
+ * @param[in] dst       Destination to build the source routing header for.
+ * @param[out] first_hop The IPv6 destination address to send the packet
+ *                      to, i.e. the first hop of the path.
+ * @param[out] srh      Buffer for the source routing header. The next header
+ *                      field is left 0.
+ * @param[in] srh_len   Size of @p srh.
+ *
+ * @return  size of the source routing header, on success
+ * @return  0, if @p dst is a child of @p root and needs no source routing
+ *          header
+ * @return  -EHOSTUNREACH, if there is no path from @p root to @p dst
+ * @return  -ELOOP, if the path has a loop or is longer than
+ *          @ref GNRC_RPL_SR_HOPS_MAX
+ * @return  -ENOBUFS, if @p srh_len is too small
+ */
+int gnrc_rpl_sr_build_srh(const ipv6_addr_t *root, const ipv6_addr_t *dst,
+                          ipv6_addr_t *first_hop, gnrc_rpl_srh_t *srh,
+                          size_t srh_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_RPL_SR_H */
+/** @} */
@@ -23,8 +23,10 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "bitfield.h"
 #include "net/gnrc/netif/hdr.h"
 #include "net/gnrc/pkt.h"
+#include "net/sixlowpan.h"
 
 #include "net/gnrc/sixlowpan/config.h"
 
@@ -37,23 +39,16 @@ extern "C" {
 #define GNRC_SIXLOWPAN_FRAG_RB_GC_MSG       (0x0226)
 
 /**
- * @brief   Fragment intervals to identify limits of fragments and duplicates.
+ * @brief   Number of 8-octet units a datagram of maximum size spans
  *
- * @note    Fragments MUST NOT overlap and overlapping fragments are to be
- *          discarded
+ * Fragment offsets are given in units of 8 octets, so received fragments are
+ * tracked in a bitmap with one bit per unit.
  *
  * @see <a href="https://tools.ietf.org/html/rfc4944#section-5.3">
  *          RFC 4944, section 5.3
  *      </a>
  */
-typedef struct gnrc_sixlowpan_frag_rb_int {
-    /**
-     * @brief   next element in fragment interval list
-     */
-    struct gnrc_sixlowpan_frag_rb_int *next;
-    uint16_t start;             /**< start byte of the fragment interval */
-    uint16_t end;               /**< end byte of the fragment interval */
-} gnrc_sixlowpan_frag_rb_int_t;
+#define GNRC_SIXLOWPAN_FRAG_RB_UNITS    ((SIXLOWPAN_FRAG_MAX_LEN + 7U) / 8U)
 
 /**
  * @brief   Base class for both reassembly buffer and virtual reassembly buffer
@@ -69,7 +64,6 @@ typedef struct gnrc_sixlowpan_frag_rb_int {
  * @see https://tools.ietf.org/html/draft-ietf-lwig-6lowpan-virtual-reassembly-01
  */
 typedef struct {
-    gnrc_sixlowpan_frag_rb_int_t *ints;         /**< intervals of already received fragments */
     uint8_t src[IEEE802154_LONG_ADDRESS_LEN];   /**< source address */
     uint8_t dst[IEEE802154_LONG_ADDRESS_LEN];   /**< destination address */
     uint8_t src_len;                            /**< length of gnrc_sixlowpan_frag_rb_t::src */
@@ -82,6 +76,14 @@ typedef struct {
     uint16_t current_size;
     uint32_t arrival;                           /**< time in microseconds of arrival of
                                                  *   last received fragment */
+    /**
+     * @brief   8-octet units of the datagram covered by already received
+     *          fragments
+     *
+     * @note    Fragments MUST NOT overlap and overlapping fragments are to be
+     *          discarded
+     */
+    BITFIELD(received, GNRC_SIXLOWPAN_FRAG_RB_UNITS);
 } gnrc_sixlowpan_frag_rb_base_t;
 
 /**
@@ -96,6 +98,7 @@ typedef struct {
      * @brief   The reassembled packet in the packet buffer
      */
     gnrc_pktsnip_t *pkt;
+    uint16_t frags;                             /**< number of fragments received */
 } gnrc_sixlowpan_frag_rb_t;
 
 /**
@@ -229,7 +232,8 @@ int gnrc_sixlowpan_frag_rb_dispatch_when_complete(gnrc_sixlowpan_frag_rb_t *rbuf
  *
  * @pre `rbuf != NULL`
  *
- * This functions sets rbuf_t::super::pkt to NULL and removes all rbuf::ints.
+ * This functions sets rbuf_t::super::pkt to NULL and clears
+ * rbuf_t::super::received.
  *
  * @note    Does nothing if module `gnrc_sixlowpan_frag_rb` is not included.
  *
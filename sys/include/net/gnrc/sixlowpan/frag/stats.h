@@ -43,6 +43,27 @@ typedef struct {
 #endif
 } gnrc_sixlowpan_frag_stats_t;
 
+/**
+ * @brief   Statistics of an interface on forwarding fragments along virtual
+ *          reassembly buffer entries
+ *
+ * Kept in @ref gnrc_netif_6lo_t::vrb_stats of each interface. Forwarded and
+ * dropped fragments are counted on the outgoing interface, reassembled
+ * datagrams on the interface they were received on.
+ *
+ * @note    Only available with the `gnrc_sixlowpan_frag_stats` and
+ *          `gnrc_sixlowpan_frag_vrb` modules
+ */
+typedef struct {
+    unsigned fwd;           /**< fragments forwarded along a virtual
+                             *   reassembly buffer entry (cut-through) */
+    unsigned reasm;         /**< fragmented datagrams that were reassembled
+                             *   instead of forwarded, including those
+                             *   addressed to this node */
+    unsigned drops;         /**< fragments dropped while forwarding along a
+                             *   virtual reassembly buffer entry */
+} gnrc_sixlowpan_frag_vrb_stats_t;
+
 /**
  * @brief   Get the current statistics on fragmentation and reassembly
  *
@@ -117,18 +117,33 @@ void gnrc_sixlowpan_frag_vrb_gc(void);
 gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_get(
         const uint8_t *src, size_t src_len, unsigned src_tag);
 
+/**
+ * @brief   Forwards a fragment to the next hop of a VRB entry
+ *
+ * Replaces the datagram tag in the fragmentation header with
+ * gnrc_sixlowpan_frag_vrb_t::out_tag of @p vrbe and sends the fragment to
+ * gnrc_sixlowpan_frag_rb_base_t::dst via gnrc_sixlowpan_frag_vrb_t::out_netif.
+ * Updating gnrc_sixlowpan_frag_rb_base_t::current_size of @p vrbe is left to
+ * the caller.
+ *
+ * @param[in] vrbe  A VRB entry. Must not be `NULL`.
+ * @param[in] frag  The fragment, starting with its fragmentation header and
+ *                  without a netif header. The first snip must be writable.
+ *                  Is released in any case.
+ *
+ * @return  0 on success.
+ * @return  -ENOMEM, if there is no space for the netif header.
+ * @return  -ENOBUFS, if the interface did not take the fragment.
+ */
+int gnrc_sixlowpan_frag_vrb_forward(gnrc_sixlowpan_frag_vrb_t *vrbe,
+                                    gnrc_pktsnip_t *frag);
+
 /**
  * @brief   Removes an entry from the VRB
  *
  * @param[in] vrb   A VRB entry
  */
-static inline void gnrc_sixlowpan_frag_vrb_rm(gnrc_sixlowpan_frag_vrb_t *vrb)
-{
-    if (IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB)) {
-        gnrc_sixlowpan_frag_rb_base_rm(&vrb->super);
-    }
-    vrb->super.src_len = 0;
-}
+void gnrc_sixlowpan_frag_vrb_rm(gnrc_sixlowpan_frag_vrb_t *vrb);
 
 /**
  * @brief   Determines if a VRB entry is empty
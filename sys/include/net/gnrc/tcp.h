@@ -52,6 +52,49 @@ int gnrc_tcp_init(void);
  */
 void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Assigns a receive buffer to a Transmission Control Block (TCB).
+ *
+ * By default a connection takes one of "GNRC_TCP_RCV_BUFFERS" receive buffers of
+ * "GNRC_TCP_RCV_BUF_SIZE" bytes. A buffer assigned by this function is used
+ * instead, its size determines the receive window of the connection. Buffers
+ * exceeding 65535 bytes are announced using the window scale option.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ * @pre @p buf must not be NULL.
+ *
+ * @note The buffer must remain valid until the connection is closed.
+ *
+ * @param[in,out] tcb    TCB that should use @p buf.
+ * @param[in]     buf    Receive buffer.
+ * @param[in]     size   Size of @p buf in bytes.
+ *
+ * @returns   0 on success.
+ *            -EISCONN if TCB is already in use.
+ *            -EINVAL if @p size is zero.
+ */
+int gnrc_tcp_tcb_set_rcv_buf(gnrc_tcp_tcb_t *tcb, void *buf, size_t size);
+
+/**
+ * @brief Registers an event callback on a Transmission Control Block (TCB).
+ *
+ * @p cb is called from the TCP thread with a mask of @ref gnrc_tcp_event_t
+ * whenever the state of the connection changed. It must neither block nor call
+ * any gnrc_tcp function, the preferred way is to post an event to an event queue
+ * (see @ref sys_event) and do the actual work from there.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ *
+ * @note Callbacks are reset if a TCB of a listening queue is reused for a new connection.
+ *
+ * @param[in,out] tcb   TCB to watch.
+ * @param[in]     cb    Callback, NULL to unregister.
+ * @param[in]     arg   Argument passed to @p cb.
+ */
+void gnrc_tcp_tcb_set_cb(gnrc_tcp_tcb_t *tcb, gnrc_tcp_tcb_cb_t cb, void *arg);
+
 /**
  * @brief Opens a connection actively.
  *
@@ -114,6 +157,132 @@ int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb,  uint8_t address_family,
 int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
                           const char *local_addr, uint16_t local_port);
 
+/**
+ * @brief Listens for incoming connections on TCBs embedded in an array.
+ *
+ * Same as gnrc_tcp_listen(), but the TCBs are @p tcbs_stride bytes apart. This
+ * allows to listen on an array of structures holding a TCB as member, e.g. the
+ * sock objects of @ref net_sock_tcp.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called on every TCB.
+ * @pre @p tcbs_stride is at least sizeof(gnrc_tcp_tcb_t).
+ *
+ * @param[out]    queue            Listening queue to initialize.
+ * @param[in,out] tcbs             First TCB accepting connections.
+ * @param[in]     tcbs_len         Number of TCBs.
+ * @param[in]     tcbs_stride      Distance between two TCBs in bytes.
+ * @param[in]     address_family   Address family of @p local_addr.
+ * @param[in]     local_addr       Local address or NULL, see gnrc_tcp_listen().
+ * @param[in]     local_port       Port number to listen on.
+ *
+ * @returns   See gnrc_tcp_listen().
+ */
+int gnrc_tcp_listen_stride(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t *tcbs, size_t tcbs_len,
+                           size_t tcbs_stride, uint8_t address_family, const char *local_addr,
+                           uint16_t local_port);
+
+/**
+ * @brief Listens for incoming connections on a set of TCBs.
+ *
+ * In contrast to gnrc_tcp_open_passive(), this function does not block.
+ * Every TCB in @p tcbs waits for a connection request to @p local_port and
+ * completes the handshake on its own, connections are picked up with
+ * gnrc_tcp_accept(). The number of TCBs bounds the number of concurrent
+ * connections, including those not accepted yet (backlog). A TCB is put back
+ * into listening state once its connection was closed with gnrc_tcp_close()
+ * or gnrc_tcp_abort(). Connections stuck in the handshake are dropped after
+ * a few retransmissions of the SYN+ACK so they cannot exhaust the backlog.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called on every TCB in @p tcbs.
+ * @pre @p queue must not be NULL.
+ * @pre @p tcbs must not be NULL.
+ * @pre @p tcbs_len must not be zero.
+ * @pre if local_addr is not NULL, local_addr must be assigned to a network interface.
+ * @pre @p local_port is not zero.
+ *
+ * @note Receive buffers assigned with gnrc_tcp_tcb_set_rcv_buf() before calling
+ *       this function are used for all connections of the respective TCB.
+ *
+ * @param[out]    queue            Listening queue to initialize.
+ * @param[in,out] tcbs             TCBs accepting connections.
+ * @param[in]     tcbs_len         Number of TCBs in @p tcbs.
+ * @param[in]     address_family   Address family of @p local_addr.
+ *                                 If local_addr == NULL, address_family is ignored.
+ * @param[in]     local_addr       If not NULL connections are bound to @p local_addr.
+ *                                 If NULL a connection request to all local ip
+ *                                 addresses is valid.
+ * @param[in]     local_port       Port number to listen on.
+ *
+ * @returns   0 on success.
+ *            -EAFNOSUPPORT if local_addr != NULL and @p address_family is not supported.
+ *            -EINVAL if @p address_family is not the same the address_family used in TCB.
+ *                    or @p local_addr is invalid.
+ *            -EISCONN if a TCB is already in use.
+ *            -ENOMEM if the receive buffer for a TCB could not be allocated.
+ *            Hint: Increase "GNRC_TCP_RCV_BUFFERS" or use gnrc_tcp_tcb_set_rcv_buf().
+ */
+static inline int gnrc_tcp_listen(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t *tcbs,
+                                  size_t tcbs_len, uint8_t address_family,
+                                  const char *local_addr, uint16_t local_port)
+{
+    return gnrc_tcp_listen_stride(queue, tcbs, tcbs_len, sizeof(gnrc_tcp_tcb_t),
+                                  address_family, local_addr, local_port);
+}
+
+/**
+ * @brief Accepts an established connection of a listening queue.
+ *
+ * @pre gnrc_tcp_listen() must have been successfully called on @p queue.
+ * @pre @p queue must not be NULL.
+ * @pre @p tcb must not be NULL.
+ *
+ * @note Function blocks if user_timeout_duration_us is not zero.
+ *
+ * @param[in,out] queue                      Listening queue.
+ * @param[out]    tcb                        TCB of the accepted connection.
+ * @param[in]     user_timeout_duration_us   Timeout for accept in microseconds.
+ *                                           If zero and no connection is established,
+ *                                           the function returns immediately. If not
+ *                                           zero the function blocks until a connection
+ *                                           was established or @p user_timeout_duration_us
+ *                                           microseconds passed.
+ *
+ * @returns   0 on success.
+ *            -EAGAIN if user_timeout_duration_us is zero and no connection is established.
+ *            -ETIMEDOUT if @p user_timeout_duration_us expired.
+ */
+int gnrc_tcp_accept(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t **tcb,
+                    const uint32_t user_timeout_duration_us);
+
+/**
+ * @brief Registers an event callback on a listening queue.
+ *
+ * @p cb is called from the TCP thread with @ref GNRC_TCP_EVENT_CONN_RECV whenever
+ * one of the connections of @p queue changed its state. The same restrictions
+ * as for gnrc_tcp_tcb_set_cb() apply.
+ *
+ * @pre gnrc_tcp_listen() must have been successfully called on @p queue.
+ * @pre @p queue must not be NULL.
+ *
+ * @param[in,out] queue   Listening queue to watch.
+ * @param[in]     cb      Callback, NULL to unregister.
+ * @param[in]     arg     Argument passed to @p cb.
+ */
+void gnrc_tcp_tcb_queue_set_cb(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_queue_cb_t cb,
+                               void *arg);
+
+/**
+ * @brief Stops listening on a listening queue.
+ *
+ * Connections that were not accepted yet are aborted. Accepted connections stay
+ * open and must be closed by the user.
+ *
+ * @pre @p queue must not be NULL.
+ *
+ * @param[in,out] queue   Listening queue to stop.
+ */
+void gnrc_tcp_stop_listen(gnrc_tcp_tcb_queue_t *queue);
+
 /**
  * @brief Transmit data to connected peer.
  *
@@ -139,6 +308,31 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
 ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                       const uint32_t user_timeout_duration_us);
 
+/**
+ * @brief Transmit data to connected peer without blocking.
+ *
+ * Hands over at most one segment if the previously sent data was acknowledged
+ * and the peer announced an open window. Use @ref GNRC_TCP_EVENT_MSG_SENT to learn
+ * when the next call might succeed.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ * @pre @p data must not be NULL.
+ *
+ * @note Unlike gnrc_tcp_send() this function neither probes a zero window nor
+ *       enforces "GNRC_TCP_CONNECTION_TIMEOUT_DURATION". Retransmissions are
+ *       handled by the TCP thread.
+ *
+ * @param[in,out] tcb    TCB holding the connection information.
+ * @param[in]     data   Pointer to the data that should be transmitted.
+ * @param[in]     len    Number of bytes that should be transmitted.
+ *
+ * @returns   The number of bytes handed over for transmission.
+ *            -ENOTCONN if connection is not established.
+ *            -EAGAIN if no data can be transmitted right now.
+ */
+ssize_t gnrc_tcp_try_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len);
+
 /**
  * @brief Receive Data from the peer.
  *
@@ -173,6 +367,8 @@ ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
 /**
  * @brief Close a TCP connection.
  *
+ * If @p tcb belongs to a listening queue, it listens for the next connection afterwards.
+ *
  * @pre gnrc_tcp_tcb_init() must have been successfully called.
  * @pre @p tcb must not be NULL.
  *
@@ -183,6 +379,8 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb);
 /**
  * @brief Abort a TCP connection.
  *
+ * If @p tcb belongs to a listening queue, it listens for the next connection afterwards.
+ *
  * @pre gnrc_tcp_tcb_init() must have been successfully called.
  * @pre @p tcb must not be NULL.
  *
@@ -190,6 +388,43 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb);
  */
 void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb);
 
+#if defined(MODULE_GNRC_IPV6) || defined(DOXYGEN)
+/**
+ * @brief Gets the local end point of a connection.
+ *
+ * @pre @p tcb must not be NULL.
+ * @pre @p addr must not be NULL.
+ * @pre @p port must not be NULL.
+ *
+ * @param[in]  tcb    TCB holding the connection information.
+ * @param[out] addr   Local address, unspecified if a listening TCB accepts any address.
+ * @param[out] port   Local port number.
+ *
+ * @returns   0 on success.
+ *            -EADDRNOTAVAIL if @p tcb is closed.
+ */
+int gnrc_tcp_get_local(gnrc_tcp_tcb_t *tcb, ipv6_addr_t *addr, uint16_t *port);
+
+/**
+ * @brief Gets the remote end point of a connection.
+ *
+ * @pre @p tcb must not be NULL.
+ * @pre @p addr must not be NULL.
+ * @pre @p port must not be NULL.
+ *
+ * @param[in]  tcb       TCB holding the connection information.
+ * @param[out] addr      Peer address.
+ * @param[out] port      Peer port number.
+ * @param[out] ll_iface  Interface of a link-local peer address, zero if unknown.
+ *                       May be NULL.
+ *
+ * @returns   0 on success.
+ *            -ENOTCONN if @p tcb is not connected to a peer.
+ */
+int gnrc_tcp_get_remote(gnrc_tcp_tcb_t *tcb, ipv6_addr_t *addr, uint16_t *port,
+                        int8_t *ll_iface);
+#endif
+
 /**
  * @brief Calculate and set checksum in TCP header.
  *
@@ -135,6 +135,33 @@ extern "C" {
 #define GNRC_TCP_PROBE_UPPER_BOUND (60U * US_PER_SEC)
 #endif
 
+/**
+ * @brief Size of the message queue of the GNRC TCP thread
+ *
+ * @note  Must be a power of two. Increase it with the number of concurrently
+ *        active connections: every connection can have a timer message pending.
+ */
+#ifndef GNRC_TCP_EVENTLOOP_MSG_QUEUE_SIZE
+#define GNRC_TCP_EVENTLOOP_MSG_QUEUE_SIZE (8U)
+#endif
+
+/**
+ * @brief Number of out-of-order blocks remembered per connection and
+ *        reported to the peer in the SACK option (see RFC 2018)
+ *
+ * @note  At most four blocks fit into the TCP option space.
+ */
+#ifndef GNRC_TCP_SACK_BLOCKS
+#define GNRC_TCP_SACK_BLOCKS (3U)
+#endif
+
+/**
+ * @brief Number of duplicate ACKs that trigger a fast retransmit (see RFC 5681)
+ */
+#ifndef GNRC_TCP_DUPACK_THRESHOLD
+#define GNRC_TCP_DUPACK_THRESHOLD (3U)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
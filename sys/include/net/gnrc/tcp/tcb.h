@@ -43,6 +43,56 @@ extern "C" {
  */
 #define GNRC_TCP_TCB_MBOX_SIZE (8U)
 
+/**
+ * @brief Block of out-of-order data held in the receive buffer.
+ */
+typedef struct {
+    uint32_t left;      /**< Sequence number of the first byte of the block */
+    uint32_t right;     /**< Sequence number following the last byte of the block */
+} gnrc_tcp_sack_block_t;
+
+/**
+ * @brief Events signaled to the callback of a TCB or TCB queue.
+ *
+ * @note The values match the ones of @ref sock_async_flags_t.
+ */
+typedef enum {
+    GNRC_TCP_EVENT_CONN_RDY  = 0x0001,  /**< Connection was established */
+    GNRC_TCP_EVENT_CONN_FIN  = 0x0002,  /**< Peer closed or reset the connection */
+    GNRC_TCP_EVENT_CONN_RECV = 0x0004,  /**< Queue holds a connection to accept */
+    GNRC_TCP_EVENT_MSG_RECV  = 0x0010,  /**< Data can be read from the connection */
+    GNRC_TCP_EVENT_MSG_SENT  = 0x0020,  /**< Sent data was acknowledged, data can be sent */
+} gnrc_tcp_event_t;
+
+struct _transmission_control_block;
+struct _gnrc_tcp_tcb_queue;
+
+/**
+ * @brief Event callback of a TCB.
+ *
+ * Called from the GNRC TCP thread. The callback must not block and must not call
+ * GNRC TCP functions, it is meant to hand the events over to the user thread,
+ * e.g. by posting an @ref event_t.
+ *
+ * @param[in] tcb      TCB the events happened on.
+ * @param[in] events   Combination of @ref gnrc_tcp_event_t.
+ * @param[in] arg      Argument given to gnrc_tcp_tcb_set_cb().
+ */
+typedef void (*gnrc_tcp_tcb_cb_t)(struct _transmission_control_block *tcb,
+                                  gnrc_tcp_event_t events, void *arg);
+
+/**
+ * @brief Event callback of a TCB queue.
+ *
+ * The same restrictions as for @ref gnrc_tcp_tcb_cb_t apply.
+ *
+ * @param[in] queue    Queue the event happened on.
+ * @param[in] events   Always @ref GNRC_TCP_EVENT_CONN_RECV.
+ * @param[in] arg      Argument given to gnrc_tcp_tcb_queue_set_cb().
+ */
+typedef void (*gnrc_tcp_tcb_queue_cb_t)(struct _gnrc_tcp_tcb_queue *queue,
+                                        gnrc_tcp_event_t events, void *arg);
+
 /**
  * @brief Transmission control block of GNRC TCP.
  */
@@ -59,11 +109,17 @@ typedef struct _transmission_control_block {
     uint8_t status;        /**< A connections status flags */
     uint32_t snd_una;      /**< Send unacknowledged */
     uint32_t snd_nxt;      /**< Send next */
-    uint16_t snd_wnd;      /**< Send window */
+    uint32_t snd_wnd;      /**< Send window */
     uint32_t snd_wl1;      /**< SeqNo. from last window update */
     uint32_t snd_wl2;      /**< AckNo. from last window update */
     uint32_t rcv_nxt;      /**< Receive next */
-    uint16_t rcv_wnd;      /**< Receive window */
+    uint32_t rcv_wnd;      /**< Receive window */
+    uint8_t snd_wnd_scale; /**< Shift count applied to the peers window */
+    uint8_t rcv_wnd_scale; /**< Shift count applied to the announced window */
+    uint8_t dup_acks;      /**< Number of duplicate ACKs received in a row */
+    uint8_t rcv_sack_num;  /**< Number of valid entries in rcv_sack */
+    gnrc_tcp_sack_block_t rcv_sack[GNRC_TCP_SACK_BLOCKS]; /**< Out-of-order blocks,
+                                                               most recent first */
     uint32_t iss;          /**< Initial sequence sumber */
     uint32_t irs;          /**< Initial received sequence number */
     uint16_t mss;          /**< The peers MSS */
@@ -78,12 +134,34 @@ typedef struct _transmission_control_block {
     msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
     mbox_t mbox;             /**< TCB mbox for synchronization */
     uint8_t *rcv_buf_raw;    /**< Pointer to the receive buffer */
+    uint8_t *rcv_buf_user;   /**< Receive buffer supplied by the user, if any */
+    size_t rcv_buf_user_size; /**< Size of rcv_buf_user */
     ringbuffer_t rcv_buf;    /**< Receive buffer data structure */
     mutex_t fsm_lock;        /**< Mutex for FSM access synchronization */
     mutex_t function_lock;   /**< Mutex for function call synchronization */
+    gnrc_tcp_tcb_cb_t cb;    /**< Event callback, may be NULL */
+    void *cb_arg;            /**< Argument of the event callback */
+    struct _gnrc_tcp_tcb_queue *queue;          /**< Listening queue owning this TCB */
     struct _transmission_control_block *next;   /**< Pointer next TCB */
 } gnrc_tcp_tcb_t;
 
+/**
+ * @brief Queue of TCBs listening on the same port.
+ *
+ * Incoming connections are established without involvement of the user and
+ * handed out by gnrc_tcp_accept().
+ */
+typedef struct _gnrc_tcp_tcb_queue {
+    mutex_t lock;                 /**< Mutex for accept synchronization */
+    gnrc_tcp_tcb_t *tcbs;         /**< TCBs used for incoming connections */
+    size_t tcbs_len;              /**< Number of TCBs in tcbs */
+    size_t tcbs_stride;           /**< Distance between two TCBs in bytes */
+    gnrc_tcp_tcb_queue_cb_t cb;   /**< Event callback, may be NULL */
+    void *cb_arg;                 /**< Argument of the event callback */
+    msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
+    mbox_t mbox;                  /**< Mbox to wake up a waiting gnrc_tcp_accept() */
+} gnrc_tcp_tcb_queue_t;
+
 #ifdef __cplusplus
 }
 #endif
@@ -64,6 +64,10 @@
  * and exact matching should be register, and then a second one with the path
  * `/resource01/` and subtree matching.
  *
+ * Resources using only exact matching are looked up by binary search, as long
+ * as they are ordered by path. A single resource with subtree matching falls
+ * back to comparing the URI-path to each resource in turn.
+ *
  * @{
  *
  * @file
@@ -1479,6 +1483,46 @@ extern ssize_t coap_well_known_core_default_handler(coap_pkt_t *pkt, \
  */
 int coap_match_path(const coap_resource_t *resource, uint8_t *uri);
 
+/**
+ * @brief   Checks if an array of resources can be searched with
+ *          coap_resources_bsearch()
+ *
+ * This is the case, if the resources are sorted by path and none of them
+ * uses @ref COAP_MATCH_SUBTREE, as a subtree resource may match a URI that
+ * sorts well after it.
+ *
+ * @note This function is not intended for application use.
+ * @internal
+ *
+ * @param[in] resources Array of CoAP resources
+ * @param[in] numof     Number of elements in @p resources
+ *
+ * @return  true, if @p resources can be searched with coap_resources_bsearch()
+ * @return  false, if @p resources must be searched linearly
+ */
+bool coap_resources_indexable(const coap_resource_t *resources, size_t numof);
+
+/**
+ * @brief   Finds the first resource that may match a given URI
+ *
+ * All resources before the returned index sort before @p uri, so matching can
+ * start at the returned index instead of at the first resource.
+ *
+ * @note This function is not intended for application use.
+ * @internal
+ *
+ * @pre coap_resources_indexable() returned true for @p resources
+ *
+ * @param[in] resources Array of CoAP resources
+ * @param[in] numof     Number of elements in @p resources
+ * @param[in] uri       Null-terminated string URI to search
+ *
+ * @return  index of the first resource whose path does not sort before @p uri
+ * @return  @p numof if all resource paths sort before @p uri
+ */
+size_t coap_resources_bsearch(const coap_resource_t *resources, size_t numof,
+                              const uint8_t *uri);
+
 #if defined(MODULE_GCOAP) || defined(DOXYGEN)
 /**
  * @name    Functions -- gcoap specific
@@ -253,6 +253,12 @@
  * Finally, we wait a second before sending out the next "Hello!" with
  * `xtimer_sleep(1)`.
  *
+ * Zero-copy and Batch Functions
+ * -----------------------------
+ * sock_udp_recv_buf(), sock_udp_recv_batch() and sock_udp_send_batch() are
+ * optional and need the `sock_udp_batch` module. Currently only
+ * `gnrc_sock_udp` implements them, so the module pulls in GNRC.
+ *
  * @{
  *
  * @file
@@ -413,6 +419,89 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *ep);
 ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
                       uint32_t timeout, sock_udp_ep_t *remote);
 
+#if defined(MODULE_SOCK_UDP_BATCH) || defined(DOXYGEN)
+/**
+ * @brief   Provides stack-internal buffer space containing a UDP message from
+ *          a remote end point
+ *
+ * @note    Only available with the `sock_udp_batch` module.
+ *
+ * This avoids copying the payload: @p data points into the network stack's
+ * buffer until the function is called again with the same @p buf_ctx, which
+ * releases the buffer and returns 0. Always call the function a second time,
+ * otherwise the buffer is never released.
+ *
+ * @pre `(sock != NULL) && (data != NULL) && (buf_ctx != NULL)`
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[out] data     Pointer to the stack-internal buffer space containing
+ *                      the received data. NULL on the releasing call.
+ * @param[in,out] buf_ctx  Stack-internal buffer context. Must point to NULL
+ *                      on the first call and is passed unchanged to the
+ *                      releasing call.
+ * @param[in] timeout   Timeout for receive in microseconds, as in
+ *                      sock_udp_recv().
+ * @param[out] remote   Remote end point of the received data.
+ *                      May be `NULL`, if it is not required by the application.
+ *
+ * @note    Function blocks if no packet is currently waiting.
+ *
+ * @return  The number of bytes received on success.
+ * @return  0, if the buffer of the previous call was released.
+ * @return  Otherwise the errors of sock_udp_recv(), except -ENOBUFS.
+ */
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote);
+
+/**
+ * @brief   A UDP message for sock_udp_recv_batch() and sock_udp_send_batch()
+ */
+typedef struct {
+    void *data;             /**< Data of the message */
+    /**
+     * @brief   Length of sock_udp_msg_t::data
+     *
+     * On sock_udp_recv_batch() the space available at sock_udp_msg_t::data,
+     * overwritten with the number of bytes received.
+     */
+    size_t len;
+    /**
+     * @brief   Remote end point of the message
+     *
+     * May be `NULL`, if it is not required by the application or, for
+     * sock_udp_send_batch(), if the sock has a remote end point.
+     */
+    sock_udp_ep_t *remote;
+} sock_udp_msg_t;
+
+/**
+ * @brief   Receives multiple UDP messages with one call
+ *
+ * @note    Only available with the `sock_udp_batch` module.
+ *
+ * Waits up to @p timeout for the first message, then takes further messages
+ * that are already queued without blocking. Messages that do not fit into
+ * their slot or come from a remote other than the one of @p sock are
+ * dropped after the first message.
+ *
+ * @pre `(sock != NULL) && (msgs != NULL) && (msgs_len > 0)`
+ * @pre Every message in @p msgs has a buffer with `len > 0`.
+ *
+ * @param[in] sock      A UDP sock object.
+ * @param[in,out] msgs  Slots for the received messages.
+ * @param[in] msgs_len  Number of slots in @p msgs.
+ * @param[in] timeout   Timeout for the first message in microseconds, as in
+ *                      sock_udp_recv().
+ *
+ * @return  The number of messages received on success. sock_udp_msg_t::len
+ *          and sock_udp_msg_t::remote of the first messages in @p msgs are
+ *          updated accordingly.
+ * @return  The errors of sock_udp_recv(), if the first message failed.
+ */
+int sock_udp_recv_batch(sock_udp_t *sock, sock_udp_msg_t *msgs,
+                        unsigned msgs_len, uint32_t timeout);
+#endif  /* MODULE_SOCK_UDP_BATCH || DOXYGEN */
+
 /**
  * @brief   Sends a UDP message to remote end point
  *
@@ -449,6 +538,28 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                       const sock_udp_ep_t *remote);
 
+#if defined(MODULE_SOCK_UDP_BATCH) || defined(DOXYGEN)
+/**
+ * @brief   Sends multiple UDP messages with one call
+ *
+ * @note    Only available with the `sock_udp_batch` module.
+ *
+ * @pre `(msgs != NULL)`
+ * @pre Every message in @p msgs satisfies the preconditions of
+ *      sock_udp_send().
+ *
+ * @param[in] sock      A UDP sock object. May be `NULL`, see sock_udp_send().
+ * @param[in] msgs      Messages to send, in order.
+ * @param[in] msgs_len  Number of messages in @p msgs.
+ *
+ * @return  The number of messages sent on success. Sending stops at the
+ *          first message that fails.
+ * @return  The errors of sock_udp_send(), if the first message failed.
+ */
+int sock_udp_send_batch(sock_udp_t *sock, const sock_udp_msg_t *msgs,
+                        unsigned msgs_len);
+#endif  /* MODULE_SOCK_UDP_BATCH || DOXYGEN */
+
 #include "sock_types.h"
 
 #ifdef __cplusplus
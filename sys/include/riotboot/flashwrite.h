@@ -41,6 +41,15 @@
  * 2. write image starting at second block
  * 3. write first block
  *
+ * With the `riotboot_flashwrite_mtd` module, the image can also be written to
+ * a slot on a @ref drivers_mtd device, e.g. an external SPI NOR flash,
+ * initialized with riotboot_flashwrite_init_mtd(). Its sectors are erased
+ * with @ref mtd_erase_async: the erase of the next sector is started as soon
+ * as the previous one is about to be filled, and it runs in the background
+ * on devices such as @ref drivers_mtd_spi_nor while the next chunk of the
+ * image is received. riotboot_flashwrite_putbytes() drives the erase with
+ * @ref mtd_async_poll and only waits for it before it writes to the device.
+ *
  * @author      Kaspar Schleiser <kaspar@schleiser.de>
  * @author      Koen Zandberg <koen@bergzand.net>
  *
@@ -56,6 +65,9 @@ extern "C" {
 
 #include "riotboot/slot.h"
 #include "periph/flashpage.h"
+#if MODULE_RIOTBOOT_FLASHWRITE_MTD
+#include "mtd.h"
+#endif
 
 /**
  * @brief   firmware update state structure
@@ -64,6 +76,15 @@ typedef struct {
     int target_slot;                        /**< update targets this slot     */
     size_t offset;                          /**< update is at this position   */
     unsigned flashpage;                     /**< update is at this flashpage  */
+#if MODULE_RIOTBOOT_FLASHWRITE_MTD || DOXYGEN
+    mtd_dev_t *mtd;                         /**< MTD holding the slot, NULL
+                                                 for a slot in internal flash */
+    uint32_t mtd_addr;                      /**< start of the slot on mtd     */
+    uint32_t mtd_size;                      /**< size of the slot on mtd      */
+    uint32_t erased;                        /**< end of the range of the slot
+                                                 erased or being erased      */
+    mtd_async_t erase;                      /**< erase of the last sector     */
+#endif
     uint8_t flashpage_buf[FLASHPAGE_SIZE];  /**< flash writing buffer         */
 } riotboot_flashwrite_t;
 
@@ -91,6 +112,29 @@ typedef struct {
 int riotboot_flashwrite_init_raw(riotboot_flashwrite_t *state, int target_slot,
                                  size_t offset);
 
+#if MODULE_RIOTBOOT_FLASHWRITE_MTD || DOXYGEN
+/**
+ * @brief   Initialize firmware update to a slot on a MTD device
+ *
+ * Works as @ref riotboot_flashwrite_init_raw(), but the image is written to
+ * @p size bytes at @p addr on @p mtd. The erase of the first sector of the
+ * slot is started right away.
+ *
+ * The first @p offset bytes of the slot are left erased, so
+ * @ref riotboot_flashwrite_finish_raw() can write them in place afterwards.
+ *
+ * @param[in,out]   state   ptr to preallocated state structure
+ * @param[in]       mtd     MTD device holding the slot, must be initialized
+ * @param[in]       addr    start of the slot on @p mtd, aligned to a sector
+ * @param[in]       size    size of the slot, a multiple of the sector size
+ * @param[in]       offset  Bytes offset to start write at
+ *
+ * @returns         0 on success, <0 otherwise
+ */
+int riotboot_flashwrite_init_mtd(riotboot_flashwrite_t *state, mtd_dev_t *mtd,
+                                 uint32_t addr, uint32_t size, size_t offset);
+#endif
+
 /**
  * @brief   Initialize firmware update (riotboot version)
  *
@@ -135,6 +179,10 @@ int riotboot_flashwrite_putbytes(riotboot_flashwrite_t *state,
  *
  * This function finishes a firmware update by re-writing the first header
  *
+ * For a slot on a MTD device, only the first @p len bytes are written, which
+ * must have been skipped by the offset given to
+ * @ref riotboot_flashwrite_init_mtd().
+ *
  * @param[in]   state       ptr to previously used state structure
  * @param[in]   bytes       data to re-write in the first page
  * @param[in]   len         size of data in bytes (must be <=FLASHPAGE_SIZE)
@@ -14,6 +14,23 @@
  *              (@ref schedstat_t) for a thread will be updated on every
  *              @ref sched_run().
  *
+ * With the `schedstatistics_ext` module, the scheduler additionally
+ * records for every thread how often it was preempted by a thread of higher
+ * priority or gave up the CPU voluntarily (by blocking or by
+ * @ref thread_yield()), and the longest time it had to wait on its run queue
+ * before running. The same figures, the runtime and the longest run queue are
+ * also aggregated per priority (@ref schedstat_prio_t).
+ *
+ * It also records the longest time spent in @ref sched_run(). Ports that call
+ * @ref sched_run() with interrupts disabled, e.g. native, AVR, MSP430 or
+ * RISC-V, keep them disabled for this long on every context switch. On
+ * Cortex-M, @ref sched_run() runs in the PendSV handler at the lowest
+ * priority, so interrupts stay enabled and this is only the time no thread
+ * could run. Other sections between @ref irq_disable() and
+ * @ref irq_restore(), e.g. in msg or mutex, are not covered: both functions
+ * are implemented by every CPU separately, and reading xtimer for the time
+ * stamps disables interrupts itself, so they can't be timed generically.
+ *
  * @note        If auto_init is disabled `init_schedstatistics()` needs to be
  *              called as well as xtimer_init().
  * @{
@@ -31,6 +48,9 @@
 
 #include <stdint.h>
 #include "kernel_types.h"
+#if defined(MODULE_SCHEDSTATISTICS_EXT) || defined(DOXYGEN)
+#include "sched.h"
+#endif
 
 #ifdef __cplusplus
  extern "C" {
@@ -44,6 +64,15 @@ typedef struct {
                                   scheduled to run */
     unsigned int schedules;  /**< How often the thread was scheduled to run */
     uint64_t runtime_ticks;  /**< The total runtime of this thread in ticks */
+#if defined(MODULE_SCHEDSTATISTICS_EXT) || defined(DOXYGEN)
+    uint32_t readystart;     /**< Time stamp of the last time this thread
+                                  became ready to run */
+    uint32_t max_latency_ticks; /**< Longest time in ticks this thread waited
+                                     on its run queue */
+    unsigned int preemptions; /**< How often a thread of higher priority
+                                   took over */
+    unsigned int voluntary;  /**< How often the thread blocked or yielded */
+#endif
 } schedstat_t;
 
 /**
@@ -51,12 +80,74 @@ typedef struct {
  */
 extern schedstat_t sched_pidlist[KERNEL_PID_LAST + 1];
 
+#if defined(MODULE_SCHEDSTATISTICS_EXT) || defined(DOXYGEN)
+/**
+ * @brief   Scheduler statistics of all threads of a priority
+ *
+ * @note    Only available with `schedstatistics_ext`
+ */
+typedef struct {
+    uint64_t runtime_ticks;  /**< The total runtime of the threads in ticks */
+    unsigned int schedules;  /**< How often a thread was scheduled to run */
+    unsigned int preemptions; /**< How often a thread of higher priority
+                                   took over */
+    unsigned int voluntary;  /**< How often a thread blocked or yielded */
+    uint32_t max_latency_ticks; /**< Longest time in ticks a thread waited
+                                     on the run queue */
+    unsigned int max_depth;  /**< Most threads on the run queue at once,
+                                  including a running one */
+} schedstat_prio_t;
+
+/**
+ *  Priority statistics table
+ */
+extern schedstat_prio_t sched_priolist[SCHED_PRIO_LEVELS];
+#endif
+
 /**
  *  @brief  Registers the sched statistics callback and sets laststart for
  *          caller thread
  */
 void init_schedstatistics(void);
 
+/**
+ * @brief   Get a consistent copy of the statistics of a thread
+ *
+ * @param[in]  pid      The thread to get the statistics of
+ * @param[out] stat     The statistics of @p pid
+ */
+void schedstatistics_get(kernel_pid_t pid, schedstat_t *stat);
+
+#if defined(MODULE_SCHEDSTATISTICS_EXT) || defined(DOXYGEN)
+/**
+ * @brief   Get a consistent copy of the statistics of a priority
+ *
+ * @note    Only available with `schedstatistics_ext`
+ *
+ * @param[in]  prio     The priority to get the statistics of, must be
+ *                      lower than @ref SCHED_PRIO_LEVELS
+ * @param[out] stat     The statistics of @p prio
+ */
+void schedstatistics_get_prio(uint8_t prio, schedstat_prio_t *stat);
+
+/**
+ * @brief   Get the longest time spent in @ref sched_run()
+ *
+ * @note    Only available with `schedstatistics_ext`
+ *
+ * @return  Longest time spent in @ref sched_run() in ticks
+ */
+uint32_t schedstatistics_sched_run_max(void);
+
+/**
+ * @brief   Reset the maximum latencies and run queue depths of all threads
+ *          and priorities and @ref schedstatistics_sched_run_max()
+ *
+ * @note    Only available with `schedstatistics_ext`
+ */
+void schedstatistics_reset_max(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
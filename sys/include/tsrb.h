@@ -15,6 +15,13 @@
  * @note        This ringbuffer implementation can be used without locking if
  *              there's only one producer and one consumer.
  *
+ * Besides copying bytes in and out, the ringbuffer can hand out contiguous
+ * regions of its buffer: tsrb_peek_write() returns where the producer can
+ * write to directly (e.g. via `memcpy()` or DMA) and tsrb_commit_write()
+ * makes the written bytes available to the consumer. Likewise,
+ * tsrb_peek_read() and tsrb_commit_read() let the consumer process bytes in
+ * place.
+ *
  * @attention   Buffer size must be a power of two!
  *
  * @file
@@ -154,6 +161,58 @@ int tsrb_add_one(tsrb_t *rb, uint8_t c);
  */
 int tsrb_add(tsrb_t *rb, const uint8_t *src, size_t n);
 
+/**
+ * @brief       Get the contiguous region of readable bytes at the start of
+ *              the ringbuffer
+ *
+ * The bytes stay in the ringbuffer until they are released with
+ * @ref tsrb_commit_read(). Since the region ends at the end of the buffer, it
+ * might not cover all bytes available for reading.
+ *
+ * @param[in]   rb      Ringbuffer to operate on
+ * @param[out]  data    Start of the readable region
+ * @return      nr of bytes readable at @p data
+ * @return      0 if the ringbuffer is empty
+ */
+unsigned tsrb_peek_read(const tsrb_t *rb, const uint8_t **data);
+
+/**
+ * @brief       Release bytes read via @ref tsrb_peek_read()
+ *
+ * @pre         @p n is not larger than the region returned by
+ *              @ref tsrb_peek_read()
+ *
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[in]   n   nr of bytes to release
+ */
+void tsrb_commit_read(tsrb_t *rb, unsigned n);
+
+/**
+ * @brief       Get the contiguous region of free space at the end of the
+ *              ringbuffer
+ *
+ * Bytes written to the region become available to the consumer with
+ * @ref tsrb_commit_write(). Since the region ends at the end of the buffer, it
+ * might not cover all free space.
+ *
+ * @param[in]   rb      Ringbuffer to operate on
+ * @param[out]  data    Start of the writable region
+ * @return      nr of bytes writable at @p data
+ * @return      0 if the ringbuffer is full
+ */
+unsigned tsrb_peek_write(tsrb_t *rb, uint8_t **data);
+
+/**
+ * @brief       Add bytes written via @ref tsrb_peek_write() to the ringbuffer
+ *
+ * @pre         @p n is not larger than the region returned by
+ *              @ref tsrb_peek_write()
+ *
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[in]   n   nr of bytes to add
+ */
+void tsrb_commit_write(tsrb_t *rb, unsigned n);
+
 #ifdef __cplusplus
 }
 #endif
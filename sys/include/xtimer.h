@@ -20,6 +20,12 @@
  * number of active timers.  The reason for this is that multiplexing is
  * realized by next-first singly linked lists.
  *
+ * With the `xtimer_wheel` module, timers are instead kept in a hierarchical
+ * timer wheel (see @ref XTIMER_WHEEL_LEVELS). Insertion, removal and the
+ * timer interrupt then only touch the timers of a single wheel slot, which
+ * keeps the time spent with interrupts disabled independent of the number of
+ * active timers at the cost of slightly more RAM per timer and for the wheel.
+ *
  * @{
  * @file
  * @brief   xtimer interface definitions
@@ -80,6 +86,9 @@ typedef struct xtimer {
     xtimer_callback_t callback;  /**< callback function to call when timer
                                      expires */
     void *arg;                   /**< argument to pass to callback function */
+#if defined(MODULE_XTIMER_WHEEL) || defined(DOXYGEN)
+    uint16_t wheel_loc;          /**< wheel slot the timer is stored in */
+#endif
 } xtimer_t;
 
 /**
@@ -510,6 +519,30 @@ static inline int xtimer_msg_receive_timeout64(msg_t *msg, uint64_t timeout);
 #define XTIMER_ISR_BACKOFF 20
 #endif
 
+#ifndef XTIMER_WHEEL_SLOT_SHIFT
+/**
+ * @brief   Width of a level 0 slot of the timer wheel, as power of two ticks
+ *
+ * Only used with the `xtimer_wheel` module. Timers firing within the same
+ * level 0 slot are kept in a sorted list, so this should be small compared
+ * to the typical timeouts, but large enough to not cause unnecessary timer
+ * interrupts for cascading slots.
+ */
+#define XTIMER_WHEEL_SLOT_SHIFT     (10U)
+#endif
+
+#ifndef XTIMER_WHEEL_LEVELS
+/**
+ * @brief   Number of levels of the timer wheel
+ *
+ * Only used with the `xtimer_wheel` module. Each level has 32 slots, each
+ * spanning all slots of the level below. With the default values and a 1 MHz
+ * timer, the wheel covers ~17.9 minutes, timers further in the future are
+ * re-examined every ~33.5 seconds.
+ */
+#define XTIMER_WHEEL_LEVELS         (4U)
+#endif
+
 /*
  * Default xtimer configuration
  */
@@ -0,0 +1,381 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gcoap_block
+ * @{
+ *
+ * @file
+ * @brief       gcoap block-wise transfer engine
+ *
+ * The calling thread sends block requests while the transfer has room in its
+ * window, then waits on a semaphore that the response handler posts for each
+ * answered or timed out block.
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/gcoap.h"
+#include "net/gcoap_block.h"
+#include "sema.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/* Room for Block2, Content-Format, Size2 and a short ETag option in a
+ * response */
+#define BLOCK2_OPTS_LEN     (20U)
+
+/* Room for the Block1 option and the payload marker in a request */
+#define BLOCK1_OPTS_LEN     (5U)
+
+/* Block number not known yet, or no block failed */
+#define BLKNUM_NONE         (UINT32_MAX)
+
+typedef struct {
+    mutex_t lock;                       /* Protects the attributes below */
+    sema_t answered;                    /* Posted for each answered block */
+    const sock_udp_ep_t *remote;
+    const char *path;
+    unsigned method;
+    uint16_t option;                    /* COAP_OPT_BLOCK1 or COAP_OPT_BLOCK2 */
+    gcoap_block_sink_t sink;
+    gcoap_block_source_t source;
+    void *arg;
+    size_t len;                         /* Body length */
+    unsigned szx;                       /* Negotiated block size exponent */
+    uint32_t next;                      /* Next block to send */
+    uint32_t last;                      /* Last block, BLKNUM_NONE if unknown */
+    uint32_t acked;                     /* Number of answered blocks */
+    unsigned inflight;                  /* Blocks sent, but not answered */
+    uint32_t failed;                    /* Lowest failed block */
+    int res;                            /* Error of the failed block, or
+                                           code of the final response */
+} _xfer_t;
+
+static void _resp_handler(const gcoap_request_memo_t *memo, coap_pkt_t *pdu,
+                          const sock_udp_ep_t *remote);
+
+/* Returns the largest block size exponent up to szx for blocks of up to room
+ * bytes */
+static unsigned _fit_szx(unsigned szx, size_t room)
+{
+    if (szx > (NANOCOAP_BLOCK_SIZE_EXP_MAX - 4)) {
+        szx = NANOCOAP_BLOCK_SIZE_EXP_MAX - 4;
+    }
+    while ((szx > 0) && (coap_szx2size(szx) > room)) {
+        szx--;
+    }
+    return szx;
+}
+
+static uint32_t _last_block(size_t len, unsigned szx)
+{
+    return (len > 0) ? (uint32_t)((len - 1) >> (szx + 4)) : 0;
+}
+
+/* Records a failed block, keeping the error of the lowest one.
+ * Caller must hold xfer->lock. */
+static void _fail(_xfer_t *xfer, uint32_t num, int res)
+{
+    if ((xfer->failed == BLKNUM_NONE) || (num < xfer->failed)) {
+        xfer->failed = num;
+        xfer->res = res;
+    }
+}
+
+/* Tells whether block num may be sent now. Caller must hold xfer->lock. */
+static bool _may_send(_xfer_t *xfer, uint32_t num)
+{
+    if (xfer->failed != BLKNUM_NONE) {
+        return false;
+    }
+    if (xfer->option == COAP_OPT_BLOCK2) {
+        return (xfer->last == BLKNUM_NONE) || (num <= xfer->last);
+    }
+    /* the last block completes the body, so it must go last */
+    return (num < xfer->last)
+           || ((num == xfer->last) && (xfer->acked == xfer->last));
+}
+
+static int _send_block(_xfer_t *xfer, uint32_t num, unsigned szx)
+{
+    uint8_t buf[CONFIG_GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    size_t chunk = 0;
+    bool more = false;
+    ssize_t len;
+
+    if (gcoap_req_init(&pdu, buf, sizeof(buf), xfer->method, xfer->path) < 0) {
+        return -ENOSPC;
+    }
+    coap_hdr_set_type(pdu.hdr, COAP_TYPE_CON);
+    if (xfer->option == COAP_OPT_BLOCK1) {
+        size_t offset = (size_t)num << (szx + 4);
+
+        chunk = xfer->len - offset;
+        if (chunk > coap_szx2size(szx)) {
+            chunk = coap_szx2size(szx);
+            more = true;
+        }
+    }
+    if (coap_opt_add_uint(&pdu, xfer->option,
+                          (num << 4) | (more ? 0x8 : 0) | szx) < 0) {
+        return -ENOSPC;
+    }
+    len = coap_opt_finish(&pdu, chunk ? COAP_OPT_FINISH_PAYLOAD
+                                      : COAP_OPT_FINISH_NONE);
+    if ((len < 0) || (pdu.payload_len < chunk)) {
+        return -ENOSPC;
+    }
+    if (chunk) {
+        ssize_t res = xfer->source(xfer->arg, (size_t)num << (szx + 4),
+                                   pdu.payload, chunk);
+        if (res < 0) {
+            return res;
+        }
+        len += chunk;
+    }
+    if (gcoap_req_send(buf, len, xfer->remote, _resp_handler, xfer) == 0) {
+        return -ENOMEM;
+    }
+    return 0;
+}
+
+/* Handles the response to block num, requested with exponent szx */
+static int _block2_resp(_xfer_t *xfer, uint32_t num, unsigned szx,
+                        coap_pkt_t *pdu)
+{
+    coap_block1_t block;
+
+    if (coap_get_code_class(pdu) != COAP_CLASS_SUCCESS) {
+        return -EPROTO;
+    }
+    if (!coap_get_block2(pdu, &block)) {
+        /* not block-wise, so the response holds the whole body */
+        if (num != 0) {
+            return -EBADMSG;
+        }
+        block.blknum = 0;
+        block.szx = szx;
+        block.more = 0;
+        block.offset = 0;
+    }
+    if ((block.szx > szx)
+            || (block.offset != ((size_t)num << (szx + 4)))) {
+        return -EBADMSG;
+    }
+
+    int res = xfer->sink(xfer->arg, block.offset, pdu->payload,
+                         pdu->payload_len, block.more);
+    if (res < 0) {
+        return res;
+    }
+
+    mutex_lock(&xfer->lock);
+    if (block.szx < xfer->szx) {
+        /* server chose a smaller block size; only the first block is in
+         * flight, so just continue with the next smaller block */
+        xfer->szx = block.szx;
+        xfer->next = block.blknum + 1;
+    }
+    if (!block.more) {
+        xfer->last = block.blknum;
+    }
+    xfer->len += pdu->payload_len;
+    xfer->acked++;
+    mutex_unlock(&xfer->lock);
+    return 0;
+}
+
+/* Handles the response to block num, sent with exponent szx */
+static int _block1_resp(_xfer_t *xfer, uint32_t num, unsigned szx,
+                        coap_pkt_t *pdu)
+{
+    coap_block1_t block;
+    bool has_block = coap_get_block1(pdu, &block);
+    int res = 0;
+
+    mutex_lock(&xfer->lock);
+    if (coap_get_code_class(pdu) != COAP_CLASS_SUCCESS) {
+        if ((coap_get_code_raw(pdu) == COAP_CODE_REQUEST_ENTITY_TOO_LARGE)
+                && (num == 0) && has_block && (block.szx < szx)) {
+            /* retry the first block with the block size of the server */
+            xfer->szx = block.szx;
+            xfer->next = 0;
+            xfer->last = _last_block(xfer->len, block.szx);
+        }
+        else {
+            res = -EPROTO;
+        }
+    }
+    else if (has_block && (block.szx < szx)) {
+        if ((num != 0) || (block.blknum != 0)) {
+            res = -EBADMSG;
+        }
+        else {
+            /* server took the first block with its smaller block size */
+            xfer->szx = block.szx;
+            xfer->next = 1;
+            xfer->acked = 1;
+            xfer->last = _last_block(xfer->len, block.szx);
+        }
+    }
+    else {
+        xfer->acked++;
+    }
+    if ((res == 0) && (xfer->acked > xfer->last)) {
+        xfer->res = coap_get_code_raw(pdu);
+    }
+    mutex_unlock(&xfer->lock);
+    return res;
+}
+
+static void _resp_handler(const gcoap_request_memo_t *memo, coap_pkt_t *pdu,
+                          const sock_udp_ep_t *remote)
+{
+    (void)remote;
+    _xfer_t *xfer = memo->context;
+    coap_pkt_t req;
+    uint32_t num = 0;
+    unsigned szx = 0;
+    int res;
+
+    /* the block option of the request, kept for resending, tells which block
+     * was answered */
+    if ((coap_parse(&req, memo->msg.data.pdu_buf,
+                    memo->msg.data.pdu_len) < 0)
+            || (coap_get_blockopt(&req, xfer->option, &num, &szx) < 0)) {
+        res = -EBADMSG;
+    }
+    else if (memo->state != GCOAP_MEMO_RESP) {
+        res = -ETIMEDOUT;
+    }
+    else if (xfer->option == COAP_OPT_BLOCK2) {
+        res = _block2_resp(xfer, num, szx, pdu);
+    }
+    else {
+        res = _block1_resp(xfer, num, szx, pdu);
+    }
+
+    mutex_lock(&xfer->lock);
+    if (res < 0) {
+        DEBUG("gcoap_block: block %" PRIu32 " failed: %d\n", num, res);
+        _fail(xfer, num, res);
+    }
+    xfer->inflight--;
+    /* post while locked, xfer is gone once the caller sees no block left */
+    sema_post(&xfer->answered);
+    mutex_unlock(&xfer->lock);
+}
+
+/* Runs a transfer until no block is in flight anymore */
+static void _run(_xfer_t *xfer, unsigned window)
+{
+    /* the first block negotiates the block size, so it goes alone */
+    unsigned limit = 1;
+
+    mutex_lock(&xfer->lock);
+    while (1) {
+        while ((xfer->inflight < limit) && _may_send(xfer, xfer->next)) {
+            uint32_t num = xfer->next++;
+            unsigned szx = xfer->szx;
+
+            xfer->inflight++;
+            mutex_unlock(&xfer->lock);
+            int res = _send_block(xfer, num, szx);
+            mutex_lock(&xfer->lock);
+            if (res < 0) {
+                xfer->inflight--;
+                if ((res == -ENOMEM) && (xfer->inflight > 0)) {
+                    /* gcoap is busy, retry once a block is answered */
+                    xfer->next = num;
+                }
+                else {
+                    _fail(xfer, num, res);
+                }
+                break;
+            }
+        }
+        if (xfer->inflight == 0) {
+            break;
+        }
+        mutex_unlock(&xfer->lock);
+        sema_wait(&xfer->answered);
+        mutex_lock(&xfer->lock);
+        limit = (window > 0) ? window : 1;
+    }
+    mutex_unlock(&xfer->lock);
+}
+
+static void _init(_xfer_t *xfer, const sock_udp_ep_t *remote, const char *path,
+                  unsigned method, uint16_t option, void *arg)
+{
+    memset(xfer, 0, sizeof(*xfer));
+    mutex_init(&xfer->lock);
+    sema_create(&xfer->answered, 0);
+    xfer->remote = remote;
+    xfer->path = path;
+    xfer->method = method;
+    xfer->option = option;
+    xfer->arg = arg;
+    xfer->failed = BLKNUM_NONE;
+}
+
+ssize_t gcoap_block2_get(const sock_udp_ep_t *remote, const char *path,
+                         unsigned szx, unsigned window,
+                         gcoap_block_sink_t sink, void *arg)
+{
+    _xfer_t xfer;
+
+    _init(&xfer, remote, path, COAP_METHOD_GET, COAP_OPT_BLOCK2, arg);
+    xfer.sink = sink;
+    xfer.szx = _fit_szx(szx, CONFIG_GCOAP_PDU_BUF_SIZE - GCOAP_HEADER_MAXLEN
+                             - BLOCK2_OPTS_LEN);
+    xfer.last = BLKNUM_NONE;
+    _run(&xfer, window);
+    sema_destroy(&xfer.answered);
+
+    /* requests beyond the last block fail, but don't matter */
+    if ((xfer.last != BLKNUM_NONE) && (xfer.acked == (xfer.last + 1))
+            && ((xfer.failed == BLKNUM_NONE) || (xfer.failed > xfer.last))) {
+        return xfer.len;
+    }
+    return (xfer.failed != BLKNUM_NONE) ? xfer.res : -EBADMSG;
+}
+
+int gcoap_block1_send(const sock_udp_ep_t *remote, const char *path,
+                      unsigned method, size_t len, unsigned szx,
+                      unsigned window, gcoap_block_source_t source, void *arg)
+{
+    _xfer_t xfer;
+    /* each Uri-Path option takes at most one byte more than its '/' */
+    size_t path_len = strlen(path);
+
+    for (const char *c = path; *c; c++) {
+        path_len += (*c == '/');
+    }
+    _init(&xfer, remote, path, method, COAP_OPT_BLOCK1, arg);
+    xfer.source = source;
+    xfer.len = len;
+    xfer.szx = _fit_szx(szx, CONFIG_GCOAP_PDU_BUF_SIZE - GCOAP_HEADER_MAXLEN
+                             - path_len - BLOCK1_OPTS_LEN);
+    xfer.last = _last_block(len, xfer.szx);
+    _run(&xfer, window);
+    sema_destroy(&xfer.answered);
+
+    if (xfer.failed != BLKNUM_NONE) {
+        return xfer.res;
+    }
+    return (xfer.acked > xfer.last) ? xfer.res : -EBADMSG;
+}
@@ -26,6 +26,7 @@
 #include <string.h>
 
 #include "assert.h"
+#include "kernel_defines.h"
 #include "net/gcoap.h"
 #include "net/sock/util.h"
 #include "mutex.h"
@@ -43,6 +44,22 @@
 /* End of the range to pick a random timeout */
 #define TIMEOUT_RANGE_END (COAP_ACK_TIMEOUT * COAP_RANDOM_FACTOR_1000 / 1000)
 
+/* Size of the resend pool in 16-bit words */
+#define RESEND_POOL_WORDS ((CONFIG_GCOAP_RESEND_POOL_SIZE + 1) / 2)
+#if RESEND_POOL_WORDS > 0x7fff
+#error "CONFIG_GCOAP_RESEND_POOL_SIZE must be below 65536"
+#endif
+
+/* Number of listeners whose resources may be binary searched; later ones are
+ * always scanned linearly */
+#define LISTENERS_INDEXED_MAX   (32U)
+
+/* Upper bound for a retransmission timeout estimated by CoCoA [in usec] */
+#define COCOA_RTO_MAX     (60U * US_PER_SEC)
+#if IS_ACTIVE(CONFIG_GCOAP_COCOA) && (CONFIG_GCOAP_COCOA_DESTS_MAX > 256)
+#error "CONFIG_GCOAP_COCOA_DESTS_MAX must not exceed 256"
+#endif
+
 /* Internal functions */
 static void *_event_loop(void *arg);
 static void _listen(sock_udp_t *sock);
@@ -52,11 +69,21 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 static void _expire_request(gcoap_request_memo_t *memo);
 static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *pdu,
                            const sock_udp_ep_t *remote);
+static void _release_req_memo(gcoap_request_memo_t *memo);
+static uint32_t _con_open(gcoap_request_memo_t *memo);
+static uint32_t _con_backoff(gcoap_request_memo_t *memo);
+static void _con_sample(gcoap_request_memo_t *memo);
+static void _con_close(gcoap_request_memo_t *memo);
 static int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
                                             gcoap_listener_t **listener_ptr);
-static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote);
-static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
-                                                       coap_pkt_t *pdu);
+static void _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote);
+static sock_udp_ep_t *_add_observer(const sock_udp_ep_t *remote);
+static void _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
+                                                        coap_pkt_t *pdu);
+static gcoap_observe_memo_t *_empty_obs_memo(void);
+static void _set_obs_memo(gcoap_observe_memo_t *memo, sock_udp_ep_t *observer,
+                          const coap_resource_t *resource, coap_pkt_t *pdu);
+static void _clear_obs_memo(gcoap_observe_memo_t *memo);
 static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
                                    const coap_resource_t *resource);
 
@@ -72,10 +99,33 @@ static gcoap_listener_t _default_listener = {
     NULL
 };
 
+/* Chained hash indexes over the memo arrays below: bucket heads and links hold
+ * the index of an array entry plus one, so a zeroed index is empty. Each index
+ * has as many buckets as its array has entries. */
+typedef uint16_t _hidx_t;
+
+#if IS_ACTIVE(CONFIG_GCOAP_COCOA)
+/* Retransmission timeout estimation for a destination, as per CoCoA. The
+ * smoothed round-trip times are zero until the first sample. */
+typedef struct {
+    sock_udp_ep_t remote;               /* Destination; unused if AF_UNSPEC */
+    uint32_t rto;                       /* Overall estimate [in usec] */
+    uint32_t updated;                   /* Time rto last changed [in usec] */
+    uint32_t strong_srtt;               /* For exchanges without resends */
+    uint32_t strong_rttvar;
+    uint32_t weak_srtt;                 /* For exchanges with 1 or 2 resends */
+    uint32_t weak_rttvar;
+    unsigned open;                      /* Open confirmable requests */
+} _cocoa_dest_t;
+#endif
+
 /* Container for the state of gcoap itself */
 typedef struct {
     mutex_t lock;                       /* Shares state attributes safely */
     gcoap_listener_t *listeners;        /* List of registered listeners */
+    uint32_t listeners_indexed;         /* Bit n set if the resources of the
+                                           n-th listener can be binary
+                                           searched */
     gcoap_request_memo_t open_reqs[CONFIG_GCOAP_REQ_WAITING_MAX];
                                         /* Storage for open requests; if first
                                            byte of an entry is zero, the entry
@@ -86,10 +136,35 @@ typedef struct {
                                            observe memos */
     gcoap_observe_memo_t observe_memos[CONFIG_GCOAP_OBS_REGISTRATIONS_MAX];
                                         /* Observed resource registrations */
-    uint8_t resend_bufs[CONFIG_GCOAP_RESEND_BUFS_MAX][CONFIG_GCOAP_PDU_BUF_SIZE];
-                                        /* Buffers for PDU for request resends;
-                                           if first byte of an entry is zero,
-                                           the entry is available */
+    uint16_t resend_pool[RESEND_POOL_WORDS];
+                                        /* Blocks with PDUs for request resends;
+                                           see _resend_alloc() */
+    unsigned open_reqs_numof;           /* Number of open requests */
+    _hidx_t req_free;                   /* Unused open_reqs, linked by req_next */
+    _hidx_t req_buckets[CONFIG_GCOAP_REQ_WAITING_MAX];
+                                        /* Open requests by token */
+    _hidx_t req_next[CONFIG_GCOAP_REQ_WAITING_MAX];
+    _hidx_t observer_buckets[CONFIG_GCOAP_OBS_CLIENTS_MAX];
+                                        /* Observers by endpoint */
+    _hidx_t observer_next[CONFIG_GCOAP_OBS_CLIENTS_MAX];
+    uint16_t observer_refs[CONFIG_GCOAP_OBS_CLIENTS_MAX];
+                                        /* Observe memos per observer */
+    _hidx_t obs_token_buckets[CONFIG_GCOAP_OBS_REGISTRATIONS_MAX];
+                                        /* Observe memos by token */
+    _hidx_t obs_token_next[CONFIG_GCOAP_OBS_REGISTRATIONS_MAX];
+    _hidx_t obs_resource_buckets[CONFIG_GCOAP_OBS_REGISTRATIONS_MAX];
+                                        /* Observe memos by resource */
+    _hidx_t obs_resource_next[CONFIG_GCOAP_OBS_REGISTRATIONS_MAX];
+#if IS_ACTIVE(CONFIG_GCOAP_COCOA)
+    _cocoa_dest_t cocoa_dests[CONFIG_GCOAP_COCOA_DESTS_MAX];
+    uint8_t req_dest[CONFIG_GCOAP_REQ_WAITING_MAX];
+                                        /* cocoa_dests entry of a confirmable
+                                           open request */
+    uint32_t req_sent[CONFIG_GCOAP_REQ_WAITING_MAX];
+                                        /* First transmission [in usec] */
+    uint32_t req_timeout[CONFIG_GCOAP_REQ_WAITING_MAX];
+                                        /* Current timeout [in usec] */
+#endif
 } gcoap_state_t;
 
 static gcoap_state_t _coap_state = {
@@ -139,16 +214,7 @@ static void *_event_loop(void *arg)
                 /* reduce retries remaining, double timeout and resend */
                 else {
                     memo->send_limit--;
-#ifdef CONFIG_GCOAP_NO_RETRANS_BACKOFF
-                    unsigned i        = 0;
-#else
-                    unsigned i        = COAP_MAX_RETRANSMIT - memo->send_limit;
-#endif
-                    uint32_t timeout  = ((uint32_t)COAP_ACK_TIMEOUT << i) * US_PER_SEC;
-#if COAP_RANDOM_FACTOR_1000 > 1000
-                    uint32_t end = ((uint32_t)TIMEOUT_RANGE_END << i) * US_PER_SEC;
-                    timeout = random_uint32_range(timeout, end);
-#endif
+                    uint32_t timeout  = _con_backoff(memo);
 
                     ssize_t bytes = sock_udp_send(&_sock, memo->msg.data.pdu_buf,
                                                   memo->msg.data.pdu_len,
@@ -243,15 +309,14 @@ static void _listen(sock_udp_t *sock)
             case COAP_TYPE_NON:
             case COAP_TYPE_ACK:
                 xtimer_remove(&memo->response_timer);
+                if (memo->send_limit != GCOAP_SEND_LIMIT_NON) {
+                    _con_sample(memo);
+                }
                 memo->state = GCOAP_MEMO_RESP;
                 if (memo->resp_handler) {
                     memo->resp_handler(memo, &pdu, &remote);
                 }
-
-                if (memo->send_limit >= 0) {        /* if confirmable */
-                    *memo->msg.data.pdu_buf = 0;    /* clear resend PDU buffer */
-                }
-                memo->state = GCOAP_MEMO_UNUSED;
+                _release_req_memo(memo);
                 break;
             case COAP_TYPE_CON:
                 DEBUG("gcoap: separate CON response not handled yet\n");
@@ -299,7 +364,7 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 
     if (coap_get_observe(pdu) == COAP_OBS_REGISTER) {
         /* lookup remote+token */
-        int empty_slot = _find_obs_memo(&memo, remote, pdu);
+        _find_obs_memo(&memo, remote, pdu);
         /* validate re-registration request */
         if (resource_memo != NULL) {
             if (memo != NULL) {
@@ -318,21 +383,21 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
         }
         /* initialize new registration request */
         if ((memo == NULL) && coap_has_observe(pdu)) {
+            gcoap_observe_memo_t *empty_memo = NULL;
+
             /* verify resource not already registered (for another endpoint) */
-            if ((empty_slot >= 0) && (resource_memo == NULL)) {
-                int obs_slot = _find_observer(&observer, remote);
+            if ((resource_memo == NULL)
+                    && ((empty_memo = _empty_obs_memo()) != NULL)) {
+                _find_observer(&observer, remote);
                 /* cache new observer */
                 if (observer == NULL) {
-                    if (obs_slot >= 0) {
-                        observer = &_coap_state.observers[obs_slot];
-                        memcpy(observer, remote, sizeof(sock_udp_ep_t));
-                    } else {
+                    observer = _add_observer(remote);
+                    if (observer == NULL) {
                         DEBUG("gcoap: can't register observer\n");
                     }
                 }
                 if (observer != NULL) {
-                    memo = &_coap_state.observe_memos[empty_slot];
-                    memo->observer = observer;
+                    memo = empty_memo;
                 }
             }
             if (memo == NULL) {
@@ -343,11 +408,8 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
         /* finish registration */
         if (memo != NULL) {
             /* resource may be assigned here if it is not already registered */
-            memo->resource = resource;
-            memo->token_len = coap_get_token_len(pdu);
-            if (memo->token_len) {
-                memcpy(&memo->token[0], pdu->token, memo->token_len);
-            }
+            _set_obs_memo(memo, (observer != NULL) ? observer : memo->observer,
+                          resource, pdu);
             DEBUG("gcoap: Registered observer for: %s\n", memo->resource->path);
         }
 
@@ -356,15 +418,8 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
         /* clear memo, and clear observer if no other memos */
         if (memo != NULL) {
             DEBUG("gcoap: Deregistering observer for: %s\n", memo->resource->path);
-            memo->observer = NULL;
-            memo           = NULL;
-            _find_obs_memo(&memo, remote, NULL);
-            if (memo == NULL) {
-                _find_observer(&observer, remote);
-                if (observer != NULL) {
-                    observer->family = AF_UNSPEC;
-                }
-            }
+            _clear_obs_memo(memo);
+            memo = NULL;
         }
         coap_clear_observe(pdu);
 
@@ -406,12 +461,17 @@ static int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
         return GCOAP_RESOURCE_NO_PATH;
     }
 
-    while (listener) {
-        const coap_resource_t *resource = listener->resources;
-        for (size_t i = 0; i < listener->resources_len; i++) {
-            if (i) {
-                resource++;
-            }
+    for (unsigned n = 0; listener; listener = listener->next, n++) {
+        size_t i = 0;
+
+        if ((n < LISTENERS_INDEXED_MAX) &&
+            (_coap_state.listeners_indexed & (1UL << n))) {
+            /* skip all resources sorting before the URI */
+            i = coap_resources_bsearch(listener->resources,
+                                       listener->resources_len, uri);
+        }
+        for (; i < listener->resources_len; i++) {
+            const coap_resource_t *resource = &listener->resources[i];
 
             int res = coap_match_path(resource, uri);
             if (res > 0) {
@@ -432,12 +492,386 @@ static int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
                 return GCOAP_RESOURCE_FOUND;
             }
         }
-        listener = listener->next;
     }
 
     return ret;
 }
 
+/*
+ * Allocates a resend buffer from _coap_state.resend_pool. Caller must hold
+ * _coap_state.lock.
+ *
+ * The pool is a sequence of blocks. The first word of a block holds the block
+ * length in words, including this header, shifted left by one; bit 0 is set
+ * while the block is in use. Adjacent unused blocks are merged on the way.
+ *
+ * return buffer of at least len bytes, or NULL if no space
+ */
+static uint8_t *_resend_alloc(size_t len)
+{
+    uint16_t *pool = _coap_state.resend_pool;
+    unsigned need = 1 + ((len + 1) / 2);
+    unsigned i = 0;
+
+    while (i < RESEND_POOL_WORDS) {
+        unsigned size = pool[i] >> 1;
+
+        if (!(pool[i] & 1)) {
+            while (((i + size) < RESEND_POOL_WORDS)
+                    && !(pool[i + size] & 1)) {
+                size += pool[i + size] >> 1;
+            }
+            pool[i] = size << 1;
+            if (size >= need) {
+                if (size > need) {
+                    pool[i + need] = (size - need) << 1;
+                }
+                pool[i] = (need << 1) | 1;
+                return (uint8_t *)&pool[i + 1];
+            }
+        }
+        i += size;
+    }
+    return NULL;
+}
+
+/* Frees a buffer from _resend_alloc(). Caller must hold _coap_state.lock. */
+static void _resend_free(uint8_t *buf)
+{
+    ((uint16_t *)(void *)buf)[-1] &= ~1U;
+}
+
+#if IS_ACTIVE(CONFIG_GCOAP_COCOA)
+/* Returns how long a destination is idle, unused ones the longest */
+static uint32_t _cocoa_idle(const _cocoa_dest_t *dest, uint32_t now)
+{
+    return (dest->remote.family == AF_UNSPEC) ? UINT32_MAX
+                                              : (now - dest->updated);
+}
+
+/* Ages the estimate of a destination that was not updated for long */
+static uint32_t _cocoa_rto(_cocoa_dest_t *dest, uint32_t now)
+{
+    uint32_t idle = now - dest->updated;
+
+    if ((dest->rto < US_PER_SEC) && (idle > (16 * dest->rto))) {
+        dest->rto *= 2;
+        dest->updated = now;
+    }
+    else if ((dest->rto > (3 * US_PER_SEC)) && (idle > (4 * dest->rto))) {
+        dest->rto = US_PER_SEC + (dest->rto / 2);
+        dest->updated = now;
+    }
+    return dest->rto;
+}
+
+/* Adds an RTT sample to an estimator as per RFC 6298, returns its RTO */
+static uint32_t _cocoa_estimate(uint32_t *srtt, uint32_t *rttvar, unsigned k,
+                                uint32_t rtt)
+{
+    if (rtt == 0) {
+        rtt = 1;
+    }
+    if (*srtt == 0) {
+        *srtt = rtt;
+        *rttvar = rtt / 2;
+    }
+    else {
+        uint32_t delta = (rtt > *srtt) ? (rtt - *srtt) : (*srtt - rtt);
+
+        *rttvar = ((3 * *rttvar) + delta) / 4;
+        *srtt = ((7 * *srtt) + rtt) / 8;
+    }
+    return *srtt + (k * *rttvar);
+}
+#endif
+
+/*
+ * Sets up retransmission of a confirmable request, once its remote endpoint
+ * is set. Caller must hold _coap_state.lock.
+ *
+ * return initial timeout in usec, or 0 if too many requests are open already
+ */
+static uint32_t _con_open(gcoap_request_memo_t *memo)
+{
+#if IS_ACTIVE(CONFIG_GCOAP_COCOA)
+    unsigned idx = memo - _coap_state.open_reqs;
+    uint32_t now = xtimer_now_usec();
+    _cocoa_dest_t *dest = NULL;
+    _cocoa_dest_t *idle = NULL;
+
+    for (unsigned i = 0; i < CONFIG_GCOAP_COCOA_DESTS_MAX; i++) {
+        _cocoa_dest_t *d = &_coap_state.cocoa_dests[i];
+
+        if ((d->remote.family != AF_UNSPEC)
+                && sock_udp_ep_equal(&d->remote, &memo->remote_ep)) {
+            dest = d;
+            break;
+        }
+        /* track unused destination or the one idle the longest */
+        if ((d->open == 0) && ((idle == NULL)
+                || (_cocoa_idle(d, now) > _cocoa_idle(idle, now)))) {
+            idle = d;
+        }
+    }
+    if (dest == NULL) {
+        if (idle == NULL) {
+            DEBUG("gcoap: no space for destination RTO\n");
+            return 0;
+        }
+        dest = idle;
+        memset(dest, 0, sizeof(*dest));
+        memcpy(&dest->remote, &memo->remote_ep, sizeof(sock_udp_ep_t));
+        dest->rto = (uint32_t)COAP_ACK_TIMEOUT * US_PER_SEC;
+        dest->updated = now;
+    }
+    if (dest->open >= CONFIG_GCOAP_NSTART) {
+        DEBUG("gcoap: NSTART reached for destination\n");
+        return 0;
+    }
+    dest->open++;
+
+    uint32_t timeout = _cocoa_rto(dest, now);
+#if COAP_RANDOM_FACTOR_1000 > 1000
+    timeout = random_uint32_range(timeout, (uint32_t)(((uint64_t)timeout *
+                                           COAP_RANDOM_FACTOR_1000) / 1000));
+#endif
+    _coap_state.req_dest[idx] = dest - _coap_state.cocoa_dests;
+    _coap_state.req_sent[idx] = now;
+    _coap_state.req_timeout[idx] = timeout;
+    return timeout;
+#else
+    (void)memo;
+    uint32_t timeout = (uint32_t)COAP_ACK_TIMEOUT * US_PER_SEC;
+#if COAP_RANDOM_FACTOR_1000 > 1000
+    timeout = random_uint32_range(timeout, TIMEOUT_RANGE_END * US_PER_SEC);
+#endif
+    return timeout;
+#endif
+}
+
+/*
+ * Returns the timeout for the next resend of a confirmable request, after
+ * its send_limit was decremented.
+ */
+static uint32_t _con_backoff(gcoap_request_memo_t *memo)
+{
+#if IS_ACTIVE(CONFIG_GCOAP_COCOA)
+    unsigned idx = memo - _coap_state.open_reqs;
+    uint32_t timeout = _coap_state.req_timeout[idx];
+#ifndef CONFIG_GCOAP_NO_RETRANS_BACKOFF
+    /* variable backoff factor: 3 for a short, 1.5 for a long RTO, else 2 */
+    mutex_lock(&_coap_state.lock);
+    uint32_t rto = _coap_state.cocoa_dests[_coap_state.req_dest[idx]].rto;
+    mutex_unlock(&_coap_state.lock);
+
+    if (rto < US_PER_SEC) {
+        timeout *= 3;
+    }
+    else if (rto > (3 * US_PER_SEC)) {
+        timeout += timeout / 2;
+    }
+    else {
+        timeout *= 2;
+    }
+    if (timeout > COCOA_RTO_MAX) {
+        timeout = COCOA_RTO_MAX;
+    }
+#endif
+    _coap_state.req_timeout[idx] = timeout;
+    return timeout;
+#else
+#ifdef CONFIG_GCOAP_NO_RETRANS_BACKOFF
+    unsigned i        = 0;
+#else
+    unsigned i        = COAP_MAX_RETRANSMIT - memo->send_limit;
+#endif
+    uint32_t timeout  = ((uint32_t)COAP_ACK_TIMEOUT << i) * US_PER_SEC;
+#if COAP_RANDOM_FACTOR_1000 > 1000
+    uint32_t end = ((uint32_t)TIMEOUT_RANGE_END << i) * US_PER_SEC;
+    timeout = random_uint32_range(timeout, end);
+#endif
+    return timeout;
+#endif
+}
+
+/* Updates the RTO estimate on the response to a confirmable request */
+static void _con_sample(gcoap_request_memo_t *memo)
+{
+#if IS_ACTIVE(CONFIG_GCOAP_COCOA)
+    unsigned idx = memo - _coap_state.open_reqs;
+    unsigned resends = COAP_MAX_RETRANSMIT - memo->send_limit;
+    uint32_t now = xtimer_now_usec();
+    uint32_t rtt = now - _coap_state.req_sent[idx];
+
+    mutex_lock(&_coap_state.lock);
+    _cocoa_dest_t *dest = &_coap_state.cocoa_dests[_coap_state.req_dest[idx]];
+
+    /* the strong estimator only takes unambiguous samples, the weak one
+     * measures from the first transmission and ignores long exchanges */
+    if (resends == 0) {
+        uint32_t rto = _cocoa_estimate(&dest->strong_srtt,
+                                       &dest->strong_rttvar, 4, rtt);
+        dest->rto = (rto / 2) + (dest->rto / 2);
+    }
+    else if (resends <= 2) {
+        uint32_t rto = _cocoa_estimate(&dest->weak_srtt,
+                                       &dest->weak_rttvar, 1, rtt);
+        dest->rto = (rto / 4) + ((dest->rto / 4) * 3);
+    }
+    if (dest->rto > COCOA_RTO_MAX) {
+        dest->rto = COCOA_RTO_MAX;
+    }
+    dest->updated = now;
+    mutex_unlock(&_coap_state.lock);
+#else
+    (void)memo;
+#endif
+}
+
+/*
+ * Ends retransmission of a confirmable request. Caller must hold
+ * _coap_state.lock.
+ */
+static void _con_close(gcoap_request_memo_t *memo)
+{
+#if IS_ACTIVE(CONFIG_GCOAP_COCOA)
+    unsigned idx = memo - _coap_state.open_reqs;
+
+    _coap_state.cocoa_dests[_coap_state.req_dest[idx]].open--;
+#else
+    (void)memo;
+#endif
+}
+
+/* Adds entry idx to a hash index */
+static void _hidx_add(_hidx_t *buckets, _hidx_t *next, unsigned bucket,
+                      unsigned idx)
+{
+    next[idx] = buckets[bucket];
+    buckets[bucket] = idx + 1;
+}
+
+/* Removes entry idx from a hash index */
+static void _hidx_del(_hidx_t *buckets, _hidx_t *next, unsigned bucket,
+                      unsigned idx)
+{
+    _hidx_t *link = &buckets[bucket];
+
+    while (*link) {
+        if (*link == idx + 1) {
+            *link = next[idx];
+            return;
+        }
+        link = &next[*link - 1];
+    }
+}
+
+static unsigned _hash_token(const uint8_t *token, unsigned len)
+{
+    unsigned hash = len;
+
+    for (unsigned i = 0; i < len; i++) {
+        hash = (hash * 31) + token[i];
+    }
+    return hash;
+}
+
+static unsigned _hash_ep(const sock_udp_ep_t *ep)
+{
+    /* use the end of the address, i.e. the interface identifier for IPv6 */
+    const uint8_t *addr = ep->addr.ipv4;
+#ifdef SOCK_HAS_IPV6
+    if (ep->family == AF_INET6) {
+        addr = &ep->addr.ipv6[12];
+    }
+#endif
+    return _hash_token(addr, 4) + ep->port;
+}
+
+/* Returns the header of the request a memo is tracking */
+static coap_hdr_t *_req_memo_hdr(gcoap_request_memo_t *memo)
+{
+    if (memo->send_limit == GCOAP_SEND_LIMIT_NON) {
+        return (coap_hdr_t *)&memo->msg.hdr_buf[0];
+    }
+    return (coap_hdr_t *)memo->msg.data.pdu_buf;
+}
+
+static unsigned _req_bucket(const uint8_t *token, unsigned len)
+{
+    return _hash_token(token, len) % CONFIG_GCOAP_REQ_WAITING_MAX;
+}
+
+static unsigned _req_memo_bucket(gcoap_request_memo_t *memo)
+{
+    coap_hdr_t *hdr = _req_memo_hdr(memo);
+
+    return _req_bucket(coap_hdr_data_ptr(hdr), hdr->ver_t_tkl & 0xf);
+}
+
+/*
+ * Takes a request memo from the unused ones. Caller must hold
+ * _coap_state.lock.
+ *
+ * return unused memo in state GCOAP_MEMO_WAIT, or NULL if none left
+ */
+static gcoap_request_memo_t *_alloc_req_memo(void)
+{
+    unsigned idx = _coap_state.req_free;
+
+    if (idx == 0) {
+        return NULL;
+    }
+    _coap_state.req_free = _coap_state.req_next[idx - 1];
+    _coap_state.open_reqs_numof++;
+
+    gcoap_request_memo_t *memo = &_coap_state.open_reqs[idx - 1];
+    memo->state = GCOAP_MEMO_WAIT;
+    return memo;
+}
+
+/*
+ * Returns a request memo, that was not yet added with _add_req_memo(), to the
+ * unused ones. Caller must hold _coap_state.lock.
+ */
+static void _free_req_memo(gcoap_request_memo_t *memo)
+{
+    unsigned idx = memo - _coap_state.open_reqs;
+
+    memo->state = GCOAP_MEMO_UNUSED;
+    _coap_state.req_next[idx] = _coap_state.req_free;
+    _coap_state.req_free = idx + 1;
+    _coap_state.open_reqs_numof--;
+}
+
+/*
+ * Makes a request memo findable by _find_req_memo(), once the header of its
+ * request is stored. Caller must hold _coap_state.lock.
+ */
+static void _add_req_memo(gcoap_request_memo_t *memo)
+{
+    _hidx_add(_coap_state.req_buckets, _coap_state.req_next,
+              _req_memo_bucket(memo), memo - _coap_state.open_reqs);
+}
+
+/*
+ * Returns a request memo added with _add_req_memo() to the unused ones and
+ * frees its resend buffer, if any.
+ */
+static void _release_req_memo(gcoap_request_memo_t *memo)
+{
+    mutex_lock(&_coap_state.lock);
+    _hidx_del(_coap_state.req_buckets, _coap_state.req_next,
+              _req_memo_bucket(memo), memo - _coap_state.open_reqs);
+    if (memo->send_limit != GCOAP_SEND_LIMIT_NON) {
+        _resend_free(memo->msg.data.pdu_buf);
+        _con_close(memo);
+    }
+    _free_req_memo(memo);
+    mutex_unlock(&_coap_state.lock);
+}
+
 /*
  * Finds the memo for an outstanding request within the _coap_state.open_reqs
  * array. Matches on remote endpoint and token.
@@ -450,32 +884,23 @@ static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *src_pdu,
                            const sock_udp_ep_t *remote)
 {
     *memo_ptr = NULL;
-    /* no need to initialize struct; we only care about buffer contents below */
-    coap_pkt_t memo_pdu_data;
-    coap_pkt_t *memo_pdu = &memo_pdu_data;
-    unsigned cmplen      = coap_get_token_len(src_pdu);
-
-    for (int i = 0; i < CONFIG_GCOAP_REQ_WAITING_MAX; i++) {
-        if (_coap_state.open_reqs[i].state == GCOAP_MEMO_UNUSED)
-            continue;
-
-        gcoap_request_memo_t *memo = &_coap_state.open_reqs[i];
-        if (memo->send_limit == GCOAP_SEND_LIMIT_NON) {
-            memo_pdu->hdr = (coap_hdr_t *) &memo->msg.hdr_buf[0];
-        }
-        else {
-            memo_pdu->hdr = (coap_hdr_t *) memo->msg.data.pdu_buf;
-        }
-
-        if (coap_get_token_len(memo_pdu) == cmplen) {
-            memo_pdu->token = coap_hdr_data_ptr(memo_pdu->hdr);
-            if ((memcmp(src_pdu->token, memo_pdu->token, cmplen) == 0)
-                    && sock_udp_ep_equal(&memo->remote_ep, remote)) {
-                *memo_ptr = memo;
-                break;
-            }
+    unsigned cmplen = coap_get_token_len(src_pdu);
+    unsigned bucket = _req_bucket(src_pdu->token, cmplen);
+
+    mutex_lock(&_coap_state.lock);
+    for (unsigned i = _coap_state.req_buckets[bucket]; i;
+         i = _coap_state.req_next[i - 1]) {
+        gcoap_request_memo_t *memo = &_coap_state.open_reqs[i - 1];
+        coap_hdr_t *hdr = _req_memo_hdr(memo);
+
+        if (((hdr->ver_t_tkl & 0xf) == cmplen)
+                && (memcmp(src_pdu->token, coap_hdr_data_ptr(hdr), cmplen) == 0)
+                && sock_udp_ep_equal(&memo->remote_ep, remote)) {
+            *memo_ptr = memo;
+            break;
         }
     }
+    mutex_unlock(&_coap_state.lock);
 }
 
 /* Calls handler callback on receipt of a timeout message. */
@@ -495,10 +920,7 @@ static void _expire_request(gcoap_request_memo_t *memo)
             }
             memo->resp_handler(memo, &req, NULL);
         }
-        if (memo->send_limit != GCOAP_SEND_LIMIT_NON) {
-            *memo->msg.data.pdu_buf = 0;    /* clear resend buffer */
-        }
-        memo->state = GCOAP_MEMO_UNUSED;
+        _release_req_memo(memo);
     }
     else {
         /* Response already handled; timeout must have fired while response */
@@ -529,25 +951,51 @@ static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t le
  *
  * observer[out] -- Registered observer, or NULL if not found
  * remote[in] -- Endpoint to match
+ */
+static void _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote)
+{
+    unsigned bucket = _hash_ep(remote) % CONFIG_GCOAP_OBS_CLIENTS_MAX;
+
+    *observer = NULL;
+    for (unsigned i = _coap_state.observer_buckets[bucket]; i;
+         i = _coap_state.observer_next[i - 1]) {
+        if (sock_udp_ep_equal(&_coap_state.observers[i - 1], remote)) {
+            *observer = &_coap_state.observers[i - 1];
+            break;
+        }
+    }
+}
+
+/*
+ * Register a new observer for a remote address and port.
  *
- * return Index of empty slot, suitable for registering new observer; or -1
- *        if no empty slots. Undefined if observer found.
+ * remote[in] -- Endpoint of the observer
+ *
+ * return New observer, or NULL if no empty slots
  */
-static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote)
+static sock_udp_ep_t *_add_observer(const sock_udp_ep_t *remote)
 {
-    int empty_slot = -1;
-    *observer      = NULL;
     for (unsigned i = 0; i < CONFIG_GCOAP_OBS_CLIENTS_MAX; i++) {
-
         if (_coap_state.observers[i].family == AF_UNSPEC) {
-            empty_slot = i;
-        }
-        else if (sock_udp_ep_equal(&_coap_state.observers[i], remote)) {
-            *observer = &_coap_state.observers[i];
-            break;
+            memcpy(&_coap_state.observers[i], remote, sizeof(sock_udp_ep_t));
+            _coap_state.observer_refs[i] = 0;
+            _hidx_add(_coap_state.observer_buckets, _coap_state.observer_next,
+                      _hash_ep(remote) % CONFIG_GCOAP_OBS_CLIENTS_MAX, i);
+            return &_coap_state.observers[i];
         }
     }
-    return empty_slot;
+    return NULL;
+}
+
+static unsigned _obs_token_bucket(const uint8_t *token, unsigned len)
+{
+    return _hash_token(token, len) % CONFIG_GCOAP_OBS_REGISTRATIONS_MAX;
+}
+
+static unsigned _obs_resource_bucket(const coap_resource_t *resource)
+{
+    return ((uintptr_t)resource / sizeof(*resource))
+           % CONFIG_GCOAP_OBS_REGISTRATIONS_MAX;
 }
 
 /*
@@ -555,44 +1003,108 @@ static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote)
  *
  * memo[out] -- Registered observe memo, or NULL if not found
  * remote[in] -- Endpoint for address to match
- * pdu[in] -- PDU for token to match, or NULL to match only on remote address
- *
- * return Index of empty slot, suitable for registering new memo; or -1 if no
- *        empty slots. Undefined if memo found.
+ * pdu[in] -- PDU for token to match
  */
-static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
-                                                       coap_pkt_t *pdu)
+static void _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
+                                                        coap_pkt_t *pdu)
 {
-    int empty_slot = -1;
-    *memo          = NULL;
-
+    unsigned token_len = coap_get_token_len(pdu);
     sock_udp_ep_t *remote_observer = NULL;
+
+    *memo = NULL;
     _find_observer(&remote_observer, remote);
+    if ((remote_observer == NULL) || (token_len == 0)) {
+        return;
+    }
+
+    unsigned bucket = _obs_token_bucket(pdu->token, token_len);
 
+    for (unsigned i = _coap_state.obs_token_buckets[bucket]; i;
+         i = _coap_state.obs_token_next[i - 1]) {
+        gcoap_observe_memo_t *candidate = &_coap_state.observe_memos[i - 1];
+
+        if ((candidate->observer == remote_observer)
+                && (candidate->token_len == token_len)
+                && (memcmp(&candidate->token[0], pdu->token, token_len) == 0)) {
+            *memo = candidate;
+            break;
+        }
+    }
+}
+
+/*
+ * Find an unused observe memo.
+ *
+ * return Unused observe memo, or NULL if no empty slots
+ */
+static gcoap_observe_memo_t *_empty_obs_memo(void)
+{
     for (unsigned i = 0; i < CONFIG_GCOAP_OBS_REGISTRATIONS_MAX; i++) {
         if (_coap_state.observe_memos[i].observer == NULL) {
-            empty_slot = i;
-            continue;
+            return &_coap_state.observe_memos[i];
         }
+    }
+    return NULL;
+}
 
-        if (_coap_state.observe_memos[i].observer == remote_observer) {
-            if (pdu == NULL) {
-                *memo = &_coap_state.observe_memos[i];
-                break;
-            }
+/* Removes a registered observe memo from the hash indexes */
+static void _unlink_obs_memo(gcoap_observe_memo_t *memo)
+{
+    unsigned idx = memo - _coap_state.observe_memos;
 
-            if (_coap_state.observe_memos[i].token_len == coap_get_token_len(pdu)) {
-                unsigned cmplen = _coap_state.observe_memos[i].token_len;
-                if (cmplen &&
-                        memcmp(&_coap_state.observe_memos[i].token[0], &pdu->token[0],
-                                                                       cmplen) == 0) {
-                    *memo = &_coap_state.observe_memos[i];
-                    break;
-                }
-            }
-        }
+    _hidx_del(_coap_state.obs_token_buckets, _coap_state.obs_token_next,
+              _obs_token_bucket(&memo->token[0], memo->token_len), idx);
+    _hidx_del(_coap_state.obs_resource_buckets, _coap_state.obs_resource_next,
+              _obs_resource_bucket(memo->resource), idx);
+    _coap_state.observer_refs[memo->observer - _coap_state.observers]--;
+}
+
+/*
+ * (Re-)register an observe memo.
+ *
+ * memo[in] -- Unused or registered observe memo
+ * observer[in] -- Registered observer
+ * resource[in] -- Resource to observe
+ * pdu[in] -- PDU for token of the registration
+ */
+static void _set_obs_memo(gcoap_observe_memo_t *memo, sock_udp_ep_t *observer,
+                          const coap_resource_t *resource, coap_pkt_t *pdu)
+{
+    unsigned idx = memo - _coap_state.observe_memos;
+
+    if (memo->observer != NULL) {
+        _unlink_obs_memo(memo);
+    }
+    memo->observer = observer;
+    memo->resource = resource;
+    memo->token_len = coap_get_token_len(pdu);
+    if (memo->token_len) {
+        memcpy(&memo->token[0], pdu->token, memo->token_len);
+    }
+    _hidx_add(_coap_state.obs_token_buckets, _coap_state.obs_token_next,
+              _obs_token_bucket(&memo->token[0], memo->token_len), idx);
+    _hidx_add(_coap_state.obs_resource_buckets, _coap_state.obs_resource_next,
+              _obs_resource_bucket(resource), idx);
+    _coap_state.observer_refs[observer - _coap_state.observers]++;
+}
+
+/*
+ * Deregister an observe memo, and its observer if it has no other memos.
+ *
+ * memo[in] -- Registered observe memo
+ */
+static void _clear_obs_memo(gcoap_observe_memo_t *memo)
+{
+    sock_udp_ep_t *observer = memo->observer;
+    unsigned obs_idx = observer - _coap_state.observers;
+
+    _unlink_obs_memo(memo);
+    memo->observer = NULL;
+    if (_coap_state.observer_refs[obs_idx] == 0) {
+        _hidx_del(_coap_state.observer_buckets, _coap_state.observer_next,
+                  _hash_ep(observer) % CONFIG_GCOAP_OBS_CLIENTS_MAX, obs_idx);
+        observer->family = AF_UNSPEC;
     }
-    return empty_slot;
 }
 
 /*
@@ -604,11 +1116,13 @@ static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
 static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
                                    const coap_resource_t *resource)
 {
+    unsigned bucket = _obs_resource_bucket(resource);
+
     *memo = NULL;
-    for (int i = 0; i < CONFIG_GCOAP_OBS_REGISTRATIONS_MAX; i++) {
-        if (_coap_state.observe_memos[i].observer != NULL
-                && _coap_state.observe_memos[i].resource == resource) {
-            *memo = &_coap_state.observe_memos[i];
+    for (unsigned i = _coap_state.obs_resource_buckets[bucket]; i;
+         i = _coap_state.obs_resource_next[i - 1]) {
+        if (_coap_state.observe_memos[i - 1].resource == resource) {
+            *memo = &_coap_state.observe_memos[i - 1];
             break;
         }
     }
@@ -631,7 +1145,24 @@ kernel_pid_t gcoap_init(void)
     memset(&_coap_state.open_reqs[0], 0, sizeof(_coap_state.open_reqs));
     memset(&_coap_state.observers[0], 0, sizeof(_coap_state.observers));
     memset(&_coap_state.observe_memos[0], 0, sizeof(_coap_state.observe_memos));
-    memset(&_coap_state.resend_bufs[0], 0, sizeof(_coap_state.resend_bufs));
+    /* resend pool is a single unused block */
+    _coap_state.resend_pool[0] = RESEND_POOL_WORDS << 1;
+#if IS_ACTIVE(CONFIG_GCOAP_COCOA)
+    memset(&_coap_state.cocoa_dests[0], 0, sizeof(_coap_state.cocoa_dests));
+#endif
+    /* all request memos are unused, all hash indexes empty */
+    _coap_state.open_reqs_numof = CONFIG_GCOAP_REQ_WAITING_MAX;
+    _coap_state.req_free = 0;
+    for (unsigned i = 0; i < CONFIG_GCOAP_REQ_WAITING_MAX; i++) {
+        _free_req_memo(&_coap_state.open_reqs[i]);
+    }
+    memset(&_coap_state.req_buckets[0], 0, sizeof(_coap_state.req_buckets));
+    memset(&_coap_state.observer_buckets[0], 0,
+           sizeof(_coap_state.observer_buckets));
+    memset(&_coap_state.obs_token_buckets[0], 0,
+           sizeof(_coap_state.obs_token_buckets));
+    memset(&_coap_state.obs_resource_buckets[0], 0,
+           sizeof(_coap_state.obs_resource_buckets));
     /* randomize initial value */
     atomic_init(&_coap_state.next_message_id, (unsigned)random_uint32());
 
@@ -642,11 +1173,18 @@ void gcoap_register_listener(gcoap_listener_t *listener)
 {
     /* Add the listener to the end of the linked list. */
     gcoap_listener_t *_last = _coap_state.listeners;
+    unsigned n = 1;
     while (_last->next) {
         _last = _last->next;
+        n++;
     }
 
     listener->next = NULL;
+    if ((n < LISTENERS_INDEXED_MAX) &&
+        coap_resources_indexable(listener->resources,
+                                 listener->resources_len)) {
+        _coap_state.listeners_indexed |= (1UL << n);
+    }
     if (!listener->link_encoder) {
         listener->link_encoder = gcoap_encode_link;
     }
@@ -738,14 +1276,8 @@ size_t gcoap_req_send(const uint8_t *buf, size_t len,
      * response or request is confirmable) */
     if ((resp_handler != NULL) || (msg_type == COAP_TYPE_CON)) {
         mutex_lock(&_coap_state.lock);
-        /* Find empty slot in list of open requests. */
-        for (int i = 0; i < CONFIG_GCOAP_REQ_WAITING_MAX; i++) {
-            if (_coap_state.open_reqs[i].state == GCOAP_MEMO_UNUSED) {
-                memo = &_coap_state.open_reqs[i];
-                memo->state = GCOAP_MEMO_WAIT;
-                break;
-            }
-        }
+        /* Take an unused memo for the open request. */
+        memo = _alloc_req_memo();
         if (!memo) {
             mutex_unlock(&_coap_state.lock);
             DEBUG("gcoap: dropping request; no space for response tracking\n");
@@ -758,27 +1290,22 @@ size_t gcoap_req_send(const uint8_t *buf, size_t len,
 
         switch (msg_type) {
         case COAP_TYPE_CON:
-            /* copy buf to resend_bufs record */
-            memo->msg.data.pdu_buf = NULL;
-            for (int i = 0; i < CONFIG_GCOAP_RESEND_BUFS_MAX; i++) {
-                if (!_coap_state.resend_bufs[i][0]) {
-                    memo->msg.data.pdu_buf = &_coap_state.resend_bufs[i][0];
-                    memcpy(memo->msg.data.pdu_buf, buf,
-                           CONFIG_GCOAP_PDU_BUF_SIZE);
-                    memo->msg.data.pdu_len = len;
-                    break;
-                }
+            /* copy buf to resend pool */
+            memo->msg.data.pdu_buf = _resend_alloc(len);
+            if (memo->msg.data.pdu_buf == NULL) {
+                DEBUG("gcoap: no space for PDU in resend bufs\n");
+            }
+            else if ((timeout = _con_open(memo)) == 0) {
+                _resend_free(memo->msg.data.pdu_buf);
             }
-            if (memo->msg.data.pdu_buf) {
+            if (timeout) {
+                memcpy(memo->msg.data.pdu_buf, buf, len);
+                memo->msg.data.pdu_len = len;
                 memo->send_limit  = COAP_MAX_RETRANSMIT;
-                timeout           = (uint32_t)COAP_ACK_TIMEOUT * US_PER_SEC;
-#if COAP_RANDOM_FACTOR_1000 > 1000
-                timeout = random_uint32_range(timeout, TIMEOUT_RANGE_END * US_PER_SEC);
-#endif
             }
             else {
-                memo->state = GCOAP_MEMO_UNUSED;
-                DEBUG("gcoap: no space for PDU in resend bufs\n");
+                _free_req_memo(memo);
+                memo = NULL;
             }
             break;
 
@@ -788,21 +1315,24 @@ size_t gcoap_req_send(const uint8_t *buf, size_t len,
             timeout = CONFIG_GCOAP_NON_TIMEOUT;
             break;
         default:
-            memo->state = GCOAP_MEMO_UNUSED;
+            _free_req_memo(memo);
+            memo = NULL;
             DEBUG("gcoap: illegal msg type %u\n", msg_type);
             break;
         }
+        if (memo != NULL) {
+            _add_req_memo(memo);
+        }
         mutex_unlock(&_coap_state.lock);
-        if (memo->state == GCOAP_MEMO_UNUSED) {
+        if (memo == NULL) {
             return 0;
         }
     }
 
-    /* Memos complete; send msg and start timer */
-    ssize_t res = sock_udp_send(&_sock, buf, len, remote);
-
+    /* Memos complete; start timer and send msg. The timer is started first,
+     * as the response may be handled before sock_udp_send() returns. */
     /* timeout may be zero for non-confirmable */
-    if ((memo != NULL) && (res > 0) && (timeout > 0)) {
+    if ((memo != NULL) && (timeout > 0)) {
         /* We assume gcoap_req_send() is called on some thread other than
          * gcoap's. First, put a message in the mbox for the sock udp object,
          * which will interrupt listening on the gcoap thread. (When there are
@@ -821,16 +1351,18 @@ size_t gcoap_req_send(const uint8_t *buf, size_t len,
             xtimer_set_msg(&memo->response_timer, timeout, &memo->timeout_msg, _pid);
         }
         else {
-            res = 0;
             DEBUG("gcoap: can't wake up mbox; no timeout for msg\n");
+            _release_req_memo(memo);
+            return 0;
         }
     }
+
+    ssize_t res = sock_udp_send(&_sock, buf, len, remote);
+
     if (res <= 0) {
         if (memo != NULL) {
-            if (msg_type == COAP_TYPE_CON) {
-                *memo->msg.data.pdu_buf = 0;    /* clear resend buffer */
-            }
-            memo->state = GCOAP_MEMO_UNUSED;
+            xtimer_remove(&memo->response_timer);
+            _release_req_memo(memo);
         }
         DEBUG("gcoap: sock send failed: %d\n", (int)res);
     }
@@ -909,13 +1441,9 @@ size_t gcoap_obs_send(const uint8_t *buf, size_t len,
 
 uint8_t gcoap_op_state(void)
 {
-    uint8_t count = 0;
-    for (int i = 0; i < CONFIG_GCOAP_REQ_WAITING_MAX; i++) {
-        if (_coap_state.open_reqs[i].state != GCOAP_MEMO_UNUSED) {
-            count++;
-        }
-    }
-    return count;
+    unsigned count = _coap_state.open_reqs_numof;
+
+    return (count > UINT8_MAX) ? UINT8_MAX : count;
 }
 
 int gcoap_get_resource_list(void *buf, size_t maxlen, uint8_t cf)
@@ -163,6 +163,37 @@ int coap_match_path(const coap_resource_t *resource, uint8_t *uri)
     return res;
 }
 
+bool coap_resources_indexable(const coap_resource_t *resources, size_t numof)
+{
+    for (size_t i = 0; i < numof; i++) {
+        if (resources[i].methods & COAP_MATCH_SUBTREE) {
+            return false;
+        }
+        if (i && (strcmp(resources[i - 1].path, resources[i].path) > 0)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t coap_resources_bsearch(const coap_resource_t *resources, size_t numof,
+                              const uint8_t *uri)
+{
+    size_t lo = 0, hi = numof;
+
+    while (lo < hi) {
+        size_t mid = lo + ((hi - lo) / 2);
+
+        if (strcmp(resources[mid].path, (const char *)uri) < 0) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
 uint8_t *coap_find_option(const coap_pkt_t *pkt, unsigned opt_num)
 {
     const coap_optpos_t *optpos = pkt->options;
@@ -393,7 +424,23 @@ ssize_t coap_handle_req(coap_pkt_t *pkt, uint8_t *resp_buf, unsigned resp_buf_le
     }
     DEBUG("nanocoap: URI path: \"%s\"\n", uri);
 
-    for (unsigned i = 0; i < coap_resources_numof; i++) {
+    static enum {
+        _INDEX_UNKNOWN = 0,
+        _INDEX_USABLE,
+        _INDEX_UNUSABLE,
+    } _index;
+    unsigned i = 0;
+
+    if (_index == _INDEX_UNKNOWN) {
+        _index = coap_resources_indexable(coap_resources, coap_resources_numof)
+               ? _INDEX_USABLE : _INDEX_UNUSABLE;
+    }
+    if (_index == _INDEX_USABLE) {
+        /* skip all resources sorting before the URI */
+        i = coap_resources_bsearch(coap_resources, coap_resources_numof, uri);
+    }
+
+    for (; i < coap_resources_numof; i++) {
         const coap_resource_t *resource = &coap_resources[i];
         if (!(resource->methods & method_flag)) {
             continue;
@@ -13,13 +13,97 @@
  */
 
 #include <inttypes.h>
+#include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
+#include "byteorder.h"
 #include "od.h"
 #include "net/inet_csum.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/* aligned words are read straight from the (byte) buffer */
+typedef uint32_t __attribute__((may_alias)) _word_t;
+
+/**
+ * @brief   Returns the 16-bit word formed by @p a and @p b in host byte order
+ */
+static inline uint16_t _host16(uint8_t a, uint8_t b)
+{
+    uint8_t bytes[] = { a, b };
+    uint16_t res;
+
+    memcpy(&res, bytes, sizeof(res));
+    return res;
+}
+
+/**
+ * @brief   Folds a sum of 16-bit words to 16 bit with end-around carry
+ */
+static inline uint16_t _fold(uint64_t sum)
+{
+    /* 2^16 is congruent to 1 modulo 0xffff, so all 16-bit parts add up */
+    uint32_t res = (uint32_t)(sum & 0xffff) + (uint32_t)((sum >> 16) & 0xffff) +
+                   (uint32_t)((sum >> 32) & 0xffff) + (uint32_t)(sum >> 48);
+
+    res = (res & 0xffff) + (res >> 16);
+    res = (res & 0xffff) + (res >> 16);
+    return res;
+}
+
+/**
+ * @brief   Sums up @p buf as 16-bit words in host byte order
+ *
+ * The one's complement sum does not depend on byte order, as long as the
+ * result is converted accordingly (see RFC 1071, section 2 (B)), so the bulk of
+ * the buffer is summed up as aligned 32-bit words with a 64-bit accumulator,
+ * whose carries are folded back in only once at the end.
+ */
+static uint16_t _sum(const uint8_t *buf, size_t len)
+{
+    uint64_t sum = 0;
+    /* a buffer on an odd address is summed up from the next even address,
+     * shifting the bytes into the other half of the words they belong to */
+    bool odd = ((uintptr_t)buf & 1);
+
+    if (odd) {
+        sum = _host16(0, *buf);
+        buf++;
+        len--;
+    }
+    if (((uintptr_t)buf & 2) && (len >= 2)) {
+        sum += _host16(buf[0], buf[1]);
+        buf += 2;
+        len -= 2;
+    }
+
+    const _word_t *words = (const _word_t *)(uintptr_t)buf;
+
+    for (; len >= 4 * sizeof(*words); len -= 4 * sizeof(*words)) {
+        sum += words[0];
+        sum += words[1];
+        sum += words[2];
+        sum += words[3];
+        words += 4;
+    }
+    for (; len >= sizeof(*words); len -= sizeof(*words)) {
+        sum += *(words++);
+    }
+
+    buf = (const uint8_t *)words;
+    if (len >= 2) {
+        sum += _host16(buf[0], buf[1]);
+        buf += 2;
+        len -= 2;
+    }
+    if (len) {
+        sum += _host16(*buf, 0);
+    }
+
+    return (odd) ? byteorder_swaps(_fold(sum)) : _fold(sum);
+}
+
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len)
 {
     uint32_t csum = sum;
@@ -37,25 +121,14 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
     if (len == 0)
         return csum;
 
-    if (accum_len & 1) {      /* if accumulated length is odd */
-        csum += *buf;         /* add first byte as bottom half of 16-byte word */
-        buf++;
-        len--;
-        accum_len++;
-    }
-
-    for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
-        csum += (uint16_t)(*buf << 8) + *(buf + 1); /* group bytes by 16-byte words */
-                                                    /* and add them */
-    }
-
-    if ((accum_len + len) & 1)          /* if accumulated length is odd */
-        csum += (uint16_t)(*buf << 8);  /* add last byte as top half of 16-byte word */
+    uint16_t part = ntohs(_sum(buf, len));
 
-    while (csum >> 16) {
-        uint16_t carry = csum >> 16;
-        csum = (csum & 0xffff) + carry;
+    if (accum_len & 1) {    /* if accumulated length is odd */
+        /* buf starts with the bottom half of a 16-bit word */
+        part = byteorder_swaps(part);
     }
+    csum += part;
+    csum = (csum & 0xffff) + (csum >> 16);
 
     DEBUG("inet_sum: new sum = 0x%04" PRIx32 "\n", csum);
 
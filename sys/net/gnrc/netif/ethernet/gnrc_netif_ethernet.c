@@ -17,6 +17,7 @@
 
 #include <string.h>
 
+#include "net/ethernet.h"
 #include "net/ethernet/hdr.h"
 #include "net/gnrc.h"
 #include "net/gnrc/netif/ethernet.h"
@@ -166,91 +167,160 @@ static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
     return res;
 }
 
-static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
+/**
+ * @brief   Receives the frame into a single snip and splits off the header
+ */
+static gnrc_pktsnip_t *_recv_frame(netdev_t *dev, ethernet_hdr_t *hdr,
+                                   int *nread)
+{
+    int bytes_expected = dev->driver->recv(dev, NULL, 0, NULL);
+    gnrc_pktsnip_t *pkt, *eth_hdr;
+
+    if (bytes_expected <= 0) {
+        return NULL;
+    }
+    pkt = gnrc_pktbuf_add(NULL, NULL, bytes_expected, GNRC_NETTYPE_UNDEF);
+    if (!pkt) {
+        DEBUG("gnrc_netif_ethernet: cannot allocate pktsnip.\n");
+
+        /* drop the packet */
+        dev->driver->recv(dev, NULL, bytes_expected, NULL);
+        return NULL;
+    }
+
+    *nread = dev->driver->recv(dev, pkt->data, bytes_expected, NULL);
+    if (*nread <= 0) {
+        DEBUG("gnrc_netif_ethernet: read error.\n");
+        goto safe_out;
+    }
+
+    if (*nread < bytes_expected) {
+        /* we've got less than the expected packet size,
+         * so free the unused space.*/
+
+        DEBUG("gnrc_netif_ethernet: reallocating.\n");
+        gnrc_pktbuf_realloc_data(pkt, *nread);
+    }
+
+    /* mark ethernet header */
+    eth_hdr = gnrc_pktbuf_mark(pkt, sizeof(ethernet_hdr_t), GNRC_NETTYPE_UNDEF);
+    if (!eth_hdr) {
+        DEBUG("gnrc_netif_ethernet: no space left in packet buffer\n");
+        goto safe_out;
+    }
+    memcpy(hdr, eth_hdr->data, sizeof(ethernet_hdr_t));
+    gnrc_pktbuf_remove_snip(pkt, eth_hdr);
+    return pkt;
+
+safe_out:
+    gnrc_pktbuf_release(pkt);
+    return NULL;
+}
+
+/**
+ * @brief   Receives the header into @p hdr and the payload directly into its
+ *          snip, so the frame doesn't need to be split up afterwards
+ */
+static gnrc_pktsnip_t *_recv_scattered(netdev_t *dev, ethernet_hdr_t *hdr,
+                                       int *nread)
 {
-    netdev_t *dev = netif->dev;
     int bytes_expected = dev->driver->recv(dev, NULL, 0, NULL);
     gnrc_pktsnip_t *pkt = NULL;
 
-    if (bytes_expected > 0) {
+    if (bytes_expected < (int)sizeof(ethernet_hdr_t)) {
+        DEBUG("gnrc_netif_ethernet: received frame too short.\n");
+    }
+    else {
         pkt = gnrc_pktbuf_add(NULL, NULL,
-                              bytes_expected,
+                              bytes_expected - sizeof(ethernet_hdr_t),
                               GNRC_NETTYPE_UNDEF);
-
         if (!pkt) {
             DEBUG("gnrc_netif_ethernet: cannot allocate pktsnip.\n");
-
-            /* drop the packet */
+        }
+    }
+    if (!pkt) {
+        /* drop the packet */
+        if (bytes_expected > 0) {
             dev->driver->recv(dev, NULL, bytes_expected, NULL);
-
-            goto out;
         }
+        return NULL;
+    }
 
-        int nread = dev->driver->recv(dev, pkt->data, bytes_expected, NULL);
-        if (nread <= 0) {
-            DEBUG("gnrc_netif_ethernet: read error.\n");
-            goto safe_out;
-        }
-#ifdef MODULE_NETSTATS_L2
-        netif->stats.rx_count++;
-        netif->stats.rx_bytes += nread;
-#endif
+    iolist_t payload = {
+        .iol_base = pkt->data,
+        .iol_len = pkt->size,
+    };
+    iolist_t frame = {
+        .iol_next = &payload,
+        .iol_base = hdr,
+        .iol_len = sizeof(ethernet_hdr_t),
+    };
 
-        if (nread < bytes_expected) {
-            /* we've got less than the expected packet size,
-             * so free the unused space.*/
+    *nread = dev->driver->recv_iol(dev, &frame, NULL);
+    if (*nread < (int)sizeof(ethernet_hdr_t)) {
+        DEBUG("gnrc_netif_ethernet: read error.\n");
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    /* some drivers only report an upper bound of the frame length */
+    gnrc_pktbuf_realloc_data(pkt, *nread - sizeof(ethernet_hdr_t));
+    return pkt;
+}
 
-            DEBUG("gnrc_netif_ethernet: reallocating.\n");
-            gnrc_pktbuf_realloc_data(pkt, nread);
-        }
+static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
+{
+    netdev_t *dev = netif->dev;
+    ethernet_hdr_t hdr;
+    gnrc_pktsnip_t *pkt, *netif_hdr;
+    int nread = 0;
 
-        DEBUG("gnrc_netif_ethernet: received packet from %s of length %d\n",
-              gnrc_netif_addr_to_str(pkt->data, ETHERNET_ADDR_LEN, addr_str),
-              nread);
-#if defined(MODULE_OD) && ENABLE_DEBUG
-        od_hex_dump(pkt->data, nread, OD_WIDTH_DEFAULT);
+    if (dev->driver->recv_iol) {
+        pkt = _recv_scattered(dev, &hdr, &nread);
+    }
+    else {
+        pkt = _recv_frame(dev, &hdr, &nread);
+    }
+    if (!pkt) {
+        return NULL;
+    }
+#ifdef MODULE_NETSTATS_L2
+    netif->stats.rx_count++;
+    netif->stats.rx_bytes += nread;
 #endif
-        /* mark ethernet header */
-        gnrc_pktsnip_t *eth_hdr = gnrc_pktbuf_mark(pkt, sizeof(ethernet_hdr_t), GNRC_NETTYPE_UNDEF);
-        if (!eth_hdr) {
-            DEBUG("gnrc_netif_ethernet: no space left in packet buffer\n");
-            goto safe_out;
-        }
 
-        ethernet_hdr_t *hdr = (ethernet_hdr_t *)eth_hdr->data;
+    DEBUG("gnrc_netif_ethernet: received packet from %s of length %d\n",
+          gnrc_netif_addr_to_str(hdr.src, ETHERNET_ADDR_LEN, addr_str),
+          nread);
+#if defined(MODULE_OD) && ENABLE_DEBUG
+    od_hex_dump(pkt->data, pkt->size, OD_WIDTH_DEFAULT);
+#endif
 
 #ifdef MODULE_L2FILTER
-        if (!l2filter_pass(dev->filter, hdr->src, ETHERNET_ADDR_LEN)) {
-            DEBUG("gnrc_netif_ethernet: incoming packet filtered by l2filter\n");
-            goto safe_out;
-        }
+    if (!l2filter_pass(dev->filter, hdr.src, ETHERNET_ADDR_LEN)) {
+        DEBUG("gnrc_netif_ethernet: incoming packet filtered by l2filter\n");
+        goto safe_out;
+    }
 #endif
 
-        /* set payload type from ethertype */
-        pkt->type = gnrc_nettype_from_ethertype(byteorder_ntohs(hdr->type));
+    /* set payload type from ethertype */
+    pkt->type = gnrc_nettype_from_ethertype(byteorder_ntohs(hdr.type));
 
-        /* create netif header */
-        gnrc_pktsnip_t *netif_hdr;
-        netif_hdr = gnrc_pktbuf_add(NULL, NULL,
-                                    sizeof(gnrc_netif_hdr_t) + (2 * ETHERNET_ADDR_LEN),
-                                    GNRC_NETTYPE_NETIF);
+    /* create netif header */
+    netif_hdr = gnrc_pktbuf_add(NULL, NULL,
+                                sizeof(gnrc_netif_hdr_t) + (2 * ETHERNET_ADDR_LEN),
+                                GNRC_NETTYPE_NETIF);
 
-        if (netif_hdr == NULL) {
-            DEBUG("gnrc_netif_ethernet: no space left in packet buffer\n");
-            pkt = eth_hdr;
-            goto safe_out;
-        }
-
-        gnrc_netif_hdr_init(netif_hdr->data, ETHERNET_ADDR_LEN, ETHERNET_ADDR_LEN);
-        gnrc_netif_hdr_set_src_addr(netif_hdr->data, hdr->src, ETHERNET_ADDR_LEN);
-        gnrc_netif_hdr_set_dst_addr(netif_hdr->data, hdr->dst, ETHERNET_ADDR_LEN);
-        gnrc_netif_hdr_set_netif(netif_hdr->data, netif);
-
-        gnrc_pktbuf_remove_snip(pkt, eth_hdr);
-        LL_APPEND(pkt, netif_hdr);
+    if (netif_hdr == NULL) {
+        DEBUG("gnrc_netif_ethernet: no space left in packet buffer\n");
+        goto safe_out;
     }
 
-out:
+    gnrc_netif_hdr_init(netif_hdr->data, ETHERNET_ADDR_LEN, ETHERNET_ADDR_LEN);
+    gnrc_netif_hdr_set_src_addr(netif_hdr->data, hdr.src, ETHERNET_ADDR_LEN);
+    gnrc_netif_hdr_set_dst_addr(netif_hdr->data, hdr.dst, ETHERNET_ADDR_LEN);
+    gnrc_netif_hdr_set_netif(netif_hdr->data, netif);
+
+    LL_APPEND(pkt, netif_hdr);
     return pkt;
 
 safe_out:
@@ -45,6 +45,10 @@ static void _update_l2addr_from_dev(gnrc_netif_t *netif);
 static void _configure_netdev(netdev_t *dev);
 static void *_gnrc_netif_thread(void *args);
 static void _event_cb(netdev_t *dev, netdev_event_t event);
+#ifdef MODULE_GNRC_NETIF_RX_BATCH
+static bool _rx_batch_expired(gnrc_netif_t *netif);
+static void _rx_batch_flush(gnrc_netif_t *netif);
+#endif
 
 gnrc_netif_t *gnrc_netif_create(char *stack, int stacksize, char priority,
                                 const char *name, netdev_t *netdev,
@@ -1397,6 +1401,13 @@ static void *_gnrc_netif_thread(void *args)
 #endif
 
     while (1) {
+#ifdef MODULE_GNRC_NETIF_RX_BATCH
+        /* don't hold back received packets when there is nothing else to
+         * handle or the budget of the batch is used up */
+        if ((msg_avail() == 0) || _rx_batch_expired(netif)) {
+            _rx_batch_flush(netif);
+        }
+#endif
         DEBUG("gnrc_netif: waiting for incoming messages\n");
         msg_receive(&msg);
         /* dispatch netdev, MAC and gnrc_netapi messages */
@@ -1472,7 +1483,7 @@ static void *_gnrc_netif_thread(void *args)
     return NULL;
 }
 
-static void _pass_on_packet(gnrc_pktsnip_t *pkt)
+static void _dispatch_packet(gnrc_pktsnip_t *pkt)
 {
     /* throw away packet if no one is interested */
     if (!gnrc_netapi_dispatch_receive(pkt->type, GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
@@ -1482,6 +1493,100 @@ static void _pass_on_packet(gnrc_pktsnip_t *pkt)
     }
 }
 
+#ifdef MODULE_GNRC_NETIF_RX_BATCH
+/**
+ * @brief   Checks if IPv6 packets only go to the IPv6 thread, which is the
+ *          only one to understand GNRC_NETAPI_MSG_TYPE_RCV_BATCH
+ */
+static bool _ipv6_takes_batches(void)
+{
+    gnrc_netreg_entry_t *entry;
+
+    if (gnrc_netreg_num(GNRC_NETTYPE_IPV6, GNRC_NETREG_DEMUX_CTX_ALL) != 1) {
+        return false;
+    }
+    entry = gnrc_netreg_lookup(GNRC_NETTYPE_IPV6, GNRC_NETREG_DEMUX_CTX_ALL);
+#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
+    if (entry->type != GNRC_NETREG_TYPE_DEFAULT) {
+        return false;
+    }
+#endif
+    return (entry->target.pid == gnrc_ipv6_pid);
+}
+
+static bool _rx_batch_expired(gnrc_netif_t *netif)
+{
+    gnrc_netif_rx_batch_t *batch = &netif->rx_batch;
+
+    return (batch->numof > 0) && ((xtimer_now_usec() - batch->start)
+                                  >= CONFIG_GNRC_NETIF_RX_BATCH_BUDGET_US);
+}
+
+static void _rx_batch_flush(gnrc_netif_t *netif)
+{
+    gnrc_netif_rx_batch_t *batch = &netif->rx_batch;
+
+    if (batch->numof == 0) {
+        return;
+    }
+    batch->stats.batches++;
+    batch->stats.pkts += batch->numof;
+    if (batch->numof > 1) {
+        gnrc_pktsnip_t *snip = gnrc_pktbuf_add(NULL, batch->pkts,
+                                               batch->numof *
+                                               sizeof(gnrc_pktsnip_t *),
+                                               GNRC_NETTYPE_UNDEF);
+
+        if (snip != NULL) {
+            msg_t msg = { .type = GNRC_NETAPI_MSG_TYPE_RCV_BATCH,
+                          .content = { .ptr = snip } };
+
+            DEBUG("gnrc_netif: passing batch of %u packets\n",
+                  (unsigned)batch->numof);
+            if (msg_try_send(&msg, gnrc_ipv6_pid) > 0) {
+                batch->numof = 0;
+                return;
+            }
+            gnrc_pktbuf_release(snip);
+        }
+    }
+    /* single packet or no way to send the batch, dispatch one by one */
+    for (unsigned i = 0; i < batch->numof; i++) {
+        _dispatch_packet(batch->pkts[i]);
+    }
+    batch->numof = 0;
+}
+
+static void _rx_batch_add(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_rx_batch_t *batch = &netif->rx_batch;
+
+    if (batch->numof == 0) {
+        batch->start = xtimer_now_usec();
+    }
+    batch->pkts[batch->numof++] = pkt;
+    if ((batch->numof >= CONFIG_GNRC_NETIF_RX_BATCH_SIZE) ||
+        _rx_batch_expired(netif)) {
+        _rx_batch_flush(netif);
+    }
+}
+#endif /* MODULE_GNRC_NETIF_RX_BATCH */
+
+static void _pass_on_packet(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+#ifdef MODULE_GNRC_NETIF_RX_BATCH
+    if ((pkt->type == GNRC_NETTYPE_IPV6) && _ipv6_takes_batches()) {
+        _rx_batch_add(netif, pkt);
+        return;
+    }
+    /* keep the order of packets */
+    _rx_batch_flush(netif);
+#else
+    (void)netif;
+#endif
+    _dispatch_packet(pkt);
+}
+
 static void _event_cb(netdev_t *dev, netdev_event_t event)
 {
     gnrc_netif_t *netif = (gnrc_netif_t *) dev->context;
@@ -1501,7 +1606,7 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
             case NETDEV_EVENT_RX_COMPLETE:
                 pkt = netif->ops->recv(netif);
                 if (pkt) {
-                    _pass_on_packet(pkt);
+                    _pass_on_packet(netif, pkt);
                 }
                 break;
 #ifdef MODULE_NETSTATS_L2
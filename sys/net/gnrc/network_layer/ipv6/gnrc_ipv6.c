@@ -36,6 +36,11 @@
 #include "net/gnrc/ipv6/ext/frag.h"
 #endif
 
+#if defined(MODULE_GNRC_RPL) && defined(MODULE_GNRC_RPL_SR)
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/sr.h"
+#endif
+
 #include "net/gnrc/ipv6.h"
 
 #define ENABLE_DEBUG    (0)
@@ -69,6 +74,8 @@ kernel_pid_t gnrc_ipv6_pid = KERNEL_PID_UNDEF;
 
 /* handles GNRC_NETAPI_MSG_TYPE_RCV commands */
 static void _receive(gnrc_pktsnip_t *pkt);
+/* handles GNRC_NETAPI_MSG_TYPE_RCV_BATCH commands */
+static void _receive_batch(gnrc_pktsnip_t *batch);
 /* Sends packet over the appropriate interface(s).
  * prep_hdr: prepare header for sending (call to _fill_ipv6_hdr()), otherwise
  * assume it is already prepared */
@@ -200,6 +207,11 @@ static void *_event_loop(void *args)
                 _receive(msg.content.ptr);
                 break;
 
+            case GNRC_NETAPI_MSG_TYPE_RCV_BATCH:
+                DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_RCV_BATCH received\n");
+                _receive_batch(msg.content.ptr);
+                break;
+
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("ipv6: GNRC_NETAPI_MSG_TYPE_SND received\n");
                 _send(msg.content.ptr, true);
@@ -481,7 +493,7 @@ static void _send_by_netif_hdr(gnrc_pktsnip_t *pkt)
 }
 #endif  /* MODULE_GNRC_IPV6_EXT_FRAG */
 
-static void _send_unicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
+static void _send_unicast(gnrc_pktsnip_t *pkt, bool prep_hdr, bool from_me,
                           gnrc_netif_t *netif, ipv6_hdr_t *ipv6_hdr,
                           uint8_t netif_hdr_flags)
 {
@@ -503,8 +515,7 @@ static void _send_unicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
                                      netif_hdr_flags)) == NULL) {
             return;
         }
-        /* prep_hdr => The packet is from me */
-        if (_fragment_pkt_if_needed(pkt, netif, prep_hdr)) {
+        if (_fragment_pkt_if_needed(pkt, netif, from_me)) {
             DEBUG("ipv6: packet is fragmented\n");
             return;
         }
@@ -518,6 +529,82 @@ static void _send_unicast(gnrc_pktsnip_t *pkt, bool prep_hdr,
     }
 }
 
+#if defined(MODULE_GNRC_RPL) && defined(MODULE_GNRC_RPL_SR)
+/* a non-storing mode root has no downward routes, see RFC 6550, section 9.7,
+ * so it inserts a source routing header into packets into its DODAG.
+ * If the header of the packet was still to be prepared, it is prepared here
+ * and *prep_hdr is cleared; the packet is still from this node.
+ * Returns false if the packet was dropped */
+static bool _add_srh(gnrc_pktsnip_t *pkt, bool *prep_hdr)
+{
+    ipv6_hdr_t *hdr = pkt->data;
+    gnrc_pktsnip_t *srh_snip;
+    gnrc_rpl_srh_t *srh;
+    gnrc_rpl_dodag_t *dodag = NULL;
+    ipv6_addr_t first_hop;
+    int res;
+
+    if (ipv6_addr_is_link_local(&hdr->dst) ||
+        (hdr->nh == PROTNUM_IPV6_EXT_RH)) {
+        return true;
+    }
+    for (unsigned i = 0; i < GNRC_RPL_INSTANCES_NUMOF; i++) {
+        gnrc_rpl_instance_t *inst = &gnrc_rpl_instances[i];
+
+        if ((inst->state != 0) &&
+            (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE) &&
+            (inst->dodag.node_status == GNRC_RPL_ROOT_NODE)) {
+            dodag = &inst->dodag;
+            /* probe first, most destinations are not in the DODAG */
+            if (gnrc_rpl_sr_build_srh(&dodag->dodag_id, &hdr->dst, &first_hop,
+                                      NULL, 0) == -ENOBUFS) {
+                break;
+            }
+            dodag = NULL;
+        }
+    }
+    if (dodag == NULL) {
+        /* no source route needed, the routes of the NIB apply */
+        return true;
+    }
+    /* the upper layer checksum and the source address are based on the final
+     * destination */
+    if (*prep_hdr) {
+        if (_fill_ipv6_hdr(gnrc_netif_get_by_pid(dodag->iface), pkt) < 0) {
+            gnrc_pktbuf_release(pkt);
+            return false;
+        }
+        *prep_hdr = false;
+    }
+    srh_snip = gnrc_pktbuf_add(pkt->next, NULL, sizeof(gnrc_rpl_srh_t) +
+                               (GNRC_RPL_SR_HOPS_MAX * sizeof(ipv6_addr_t)),
+                               GNRC_NETTYPE_IPV6_EXT);
+    if (srh_snip == NULL) {
+        DEBUG("ipv6: no space left in packet buffer for source routing header\n");
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+    pkt->next = srh_snip;
+    srh = srh_snip->data;
+    res = gnrc_rpl_sr_build_srh(&dodag->dodag_id, &hdr->dst, &first_hop, srh,
+                                srh_snip->size);
+    if (res <= 0) {
+        DEBUG("ipv6: unable to build source routing header to %s\n",
+              ipv6_addr_to_str(addr_str, &hdr->dst, sizeof(addr_str)));
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+    gnrc_pktbuf_realloc_data(srh_snip, res);
+    srh->nh = hdr->nh;
+    hdr->nh = PROTNUM_IPV6_EXT_RH;
+    hdr->len = byteorder_htons(byteorder_ntohs(hdr->len) + res);
+    hdr->dst = first_hop;
+    DEBUG("ipv6: inserted source routing header, first hop %s\n",
+          ipv6_addr_to_str(addr_str, &first_hop, sizeof(addr_str)));
+    return true;
+}
+#endif  /* MODULE_GNRC_RPL && MODULE_GNRC_RPL_SR */
+
 static inline void _send_multicast_over_iface(gnrc_pktsnip_t *pkt,
                                               bool prep_hdr,
                                               gnrc_netif_t *netif,
@@ -703,7 +790,16 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
             _send_to_self(pkt, prep_hdr, tmp_netif);
         }
         else {
-            _send_unicast(pkt, prep_hdr, netif, ipv6_hdr, netif_hdr_flags);
+            /* prep_hdr => The packet is from me */
+            bool from_me = prep_hdr;
+
+#if defined(MODULE_GNRC_RPL) && defined(MODULE_GNRC_RPL_SR)
+            if (!_add_srh(pkt, &prep_hdr)) {
+                return;
+            }
+#endif
+            _send_unicast(pkt, prep_hdr, from_me, netif, ipv6_hdr,
+                          netif_hdr_flags);
         }
     }
 }
@@ -724,6 +820,16 @@ static inline bool _pkt_not_for_me(gnrc_netif_t **netif, ipv6_hdr_t *hdr)
     }
 }
 
+static void _receive_batch(gnrc_pktsnip_t *batch)
+{
+    gnrc_pktsnip_t **pkts = batch->data;
+
+    for (unsigned i = 0; i < (batch->size / sizeof(gnrc_pktsnip_t *)); i++) {
+        _receive(pkts[i]);
+    }
+    gnrc_pktbuf_release(batch);
+}
+
 static void _receive(gnrc_pktsnip_t *pkt)
 {
     gnrc_netif_t *netif = NULL;
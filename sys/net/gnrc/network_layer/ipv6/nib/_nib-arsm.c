@@ -154,6 +154,10 @@ void _handle_sl2ao(gnrc_netif_t *netif, const ipv6_hdr_t *ipv6,
         /* a 6LR MUST NOT modify an existing NCE based on an SL2AO in an RS
          * see https://tools.ietf.org/html/rfc6775#section-6.3 */
         if (!_rtr_sol_on_6lr(netif, icmpv6)) {
+            if ((nce->l2addr_len != l2addr_len) ||
+                (memcmp(nce->l2addr, sl2ao + 1, l2addr_len) != 0)) {
+                _nib_rc_del(&nce->ipv6);
+            }
             nce->l2addr_len = l2addr_len;
             memcpy(nce->l2addr, sl2ao + 1, l2addr_len);
         }
@@ -346,6 +350,7 @@ void _handle_adv_l2(gnrc_netif_t *netif, _nib_onl_entry_t *nce,
         _tl2ao_changes_nce(nce, tl2ao, netif, l2addr_len)) {
         bool nce_was_incomplete =
             (_get_nud_state(nce) == GNRC_IPV6_NIB_NC_INFO_NUD_STATE_INCOMPLETE);
+        _nib_rc_del(&nce->ipv6);
         if (tl2ao != NULL) {
             nce->l2addr_len = l2addr_len;
             memcpy(nce->l2addr, tl2ao + 1, l2addr_len);
@@ -430,6 +435,9 @@ void _set_reachable(gnrc_netif_t *netif, _nib_onl_entry_t *nce)
 void _set_nud_state(gnrc_netif_t *netif, _nib_onl_entry_t *nce,
                     uint16_t state)
 {
+    if (_get_nud_state(nce) != state) {
+        _nib_rc_del(&nce->ipv6);
+    }
     nce->info &= ~GNRC_IPV6_NIB_NC_INFO_NUD_STATE_MASK;
     nce->info |= state;
 
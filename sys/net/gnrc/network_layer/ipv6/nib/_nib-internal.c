@@ -46,6 +46,69 @@ static rmutex_t _nib_mutex = RMUTEX_INIT;
 
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_INDEX)
+#define _IDX_NONE       (UINT16_MAX)
+
+/**
+ * @brief   Node of the longest prefix match trie over the off-link entries
+ *
+ * A node without entries always has two children, so the trie never needs
+ * more than 2 * GNRC_IPV6_NIB_OFFL_NUMOF nodes.
+ */
+typedef struct {
+    ipv6_addr_t pfx;            /**< prefix of the node */
+    uint16_t child[2];          /**< children by next bit after prefix */
+    uint16_t entry;             /**< first off-link entry with this prefix */
+    uint8_t pfx_len;            /**< length of the prefix in bits */
+} _offl_trie_node_t;
+
+/* on-link entries are chained per hash bucket of their address */
+static uint16_t _onl_buckets[CONFIG_GNRC_IPV6_NIB_INDEX_BUCKETS];
+static uint16_t _onl_bucket[GNRC_IPV6_NIB_NUMOF];
+static uint16_t _onl_next[GNRC_IPV6_NIB_NUMOF];
+/* off-link entries with the same prefix are chained at their trie node */
+static _offl_trie_node_t _offl_trie[2 * GNRC_IPV6_NIB_OFFL_NUMOF];
+static uint16_t _offl_next[GNRC_IPV6_NIB_OFFL_NUMOF];
+static uint16_t _offl_trie_root;
+static uint16_t _offl_trie_free;
+
+static void _index_init(void);
+static void _nib_offl_index(const _nib_offl_entry_t *dst);
+static void _nib_offl_unindex(const _nib_offl_entry_t *dst);
+
+static inline unsigned _onl_hash(const ipv6_addr_t *addr)
+{
+    uint32_t hash = addr->u32[0].u32 ^ addr->u32[1].u32 ^
+                    addr->u32[2].u32 ^ addr->u32[3].u32;
+
+    /* mix in upper bits, so also the interface identifier of addresses
+     * sharing a prefix spreads over all buckets */
+    hash ^= hash >> 16;
+    hash *= 0x45d9f3bU;
+    hash ^= hash >> 16;
+    return hash % CONFIG_GNRC_IPV6_NIB_INDEX_BUCKETS;
+}
+
+static inline unsigned _addr_bit(const ipv6_addr_t *addr, unsigned bit)
+{
+    return (addr->u8[bit / 8] >> (7 - (bit % 8))) & 1;
+}
+#else
+static inline void _index_init(void)
+{
+}
+
+static inline void _nib_offl_index(const _nib_offl_entry_t *dst)
+{
+    (void)dst;
+}
+
+static inline void _nib_offl_unindex(const _nib_offl_entry_t *dst)
+{
+    (void)dst;
+}
+#endif  /* CONFIG_GNRC_IPV6_NIB_INDEX */
+
 evtimer_msg_t _nib_evtimer;
 
 static void _override_node(const ipv6_addr_t *addr, unsigned iface,
@@ -64,6 +127,8 @@ void _nib_init(void)
     memset(_abrs, 0, sizeof(_abrs));
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
 #endif  /* TEST_SUITES */
+    _index_init();
+    _nib_rc_flush();
     evtimer_init_msg(&_nib_evtimer);
     /* TODO: load ABR information from persistent memory */
 }
@@ -214,20 +279,40 @@ _nib_onl_entry_t *_nib_onl_iter(const _nib_onl_entry_t *last)
     return NULL;
 }
 
+static inline bool _onl_matches(const _nib_onl_entry_t *node,
+                                const ipv6_addr_t *addr, unsigned iface)
+{
+    return (node->mode != _EMPTY) &&
+           /* either requested or current interface undefined or
+            * interfaces equal */
+           ((_nib_onl_get_if(node) == 0) || (iface == 0) ||
+            (_nib_onl_get_if(node) == iface)) &&
+           ipv6_addr_equal(&node->ipv6, addr);
+}
+
 _nib_onl_entry_t *_nib_onl_get(const ipv6_addr_t *addr, unsigned iface)
 {
     assert(addr != NULL);
     DEBUG("nib: Getting on-link node entry (addr = %s, iface = %u)\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_INDEX)
+    /* entries with unspecified address are not indexed */
+    if (!ipv6_addr_is_unspecified(addr)) {
+        for (unsigned i = _onl_buckets[_onl_hash(addr)]; i != _IDX_NONE;
+             i = _onl_next[i]) {
+            if (_onl_matches(&_nodes[i], addr, iface)) {
+                DEBUG("  Found %p\n", (void *)&_nodes[i]);
+                return &_nodes[i];
+            }
+        }
+        DEBUG("  No suitable entry found\n");
+        return NULL;
+    }
+#endif  /* CONFIG_GNRC_IPV6_NIB_INDEX */
     for (unsigned i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
         _nib_onl_entry_t *node = &_nodes[i];
 
-        if ((node->mode != _EMPTY) &&
-            /* either requested or current interface undefined or
-             * interfaces equal */
-            ((_nib_onl_get_if(node) == 0) || (iface == 0) ||
-             (_nib_onl_get_if(node) == iface)) &&
-            ipv6_addr_equal(&node->ipv6, addr)) {
+        if (_onl_matches(node, addr, iface)) {
             DEBUG("  Found %p\n", (void *)node);
             return node;
         }
@@ -264,6 +349,7 @@ void _nib_nc_remove(_nib_onl_entry_t *node)
     DEBUG("nib: remove from neighbor cache (addr = %s, iface = %u)\n",
           ipv6_addr_to_str(addr_str, &node->ipv6, sizeof(addr_str)),
           _nib_onl_get_if(node));
+    _nib_rc_del(&node->ipv6);
     node->mode &= ~(_NC);
     evtimer_del((evtimer_t *)&_nib_evtimer, &node->snd_na.event);
 #if GNRC_IPV6_NIB_CONF_ARSM
@@ -362,6 +448,7 @@ _nib_dr_entry_t *_nib_drl_add(const ipv6_addr_t *router_addr, unsigned iface)
     }
     if (def_router != NULL) {
         DEBUG("  using %p\n", (void *)def_router);
+        _nib_rc_flush();
         def_router->next_hop = _nib_onl_alloc(router_addr, iface);
 
         if (def_router->next_hop == NULL) {
@@ -376,6 +463,7 @@ _nib_dr_entry_t *_nib_drl_add(const ipv6_addr_t *router_addr, unsigned iface)
 void _nib_drl_remove(_nib_dr_entry_t *nib_dr)
 {
     if (nib_dr->next_hop != NULL) {
+        _nib_rc_flush();
         nib_dr->next_hop->mode &= ~(_DRL);
         _nib_onl_clear(nib_dr->next_hop);
         memset(nib_dr, 0, sizeof(_nib_dr_entry_t));
@@ -491,7 +579,11 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
             /* exact match (or next hop address was previously unset) */
             DEBUG("  %p is an exact match\n", (void *)tmp);
             if (next_hop != NULL) {
+                if (!ipv6_addr_equal(&tmp_node->ipv6, next_hop)) {
+                    _nib_rc_flush();
+                }
                 memcpy(&tmp_node->ipv6, next_hop, sizeof(tmp_node->ipv6));
+                _nib_onl_reindex(tmp_node);
             }
             tmp->next_hop->mode |= _DST;
             return tmp;
@@ -512,6 +604,7 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
         dst->next_hop->mode |= _DST;
         ipv6_addr_init_prefix(&dst->pfx, pfx, pfx_len);
         dst->pfx_len = pfx_len;
+        _nib_offl_index(dst);
     }
     return dst;
 }
@@ -532,6 +625,10 @@ void _nib_offl_clear(_nib_offl_entry_t *dst)
 {
     if (dst->next_hop != NULL) {
         _nib_offl_entry_t *ptr;
+
+        if (dst->mode & ~_DC) {
+            _nib_rc_flush();
+        }
         for (ptr = _dsts; _in_dsts(ptr); ptr++) {
             /* there is another dst pointing to next-hop => only remove dst */
             if ((dst != ptr) && (dst->next_hop == ptr->next_hop)) {
@@ -543,6 +640,7 @@ void _nib_offl_clear(_nib_offl_entry_t *dst)
             dst->next_hop->mode &= ~(_DST);
             _nib_onl_clear(dst->next_hop);
         }
+        _nib_offl_unindex(dst);
         memset(dst, 0, sizeof(_nib_offl_entry_t));
     }
 }
@@ -569,10 +667,34 @@ bool _nib_offl_is_entry(const _nib_offl_entry_t *entry)
 static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
 {
     _nib_offl_entry_t *res = NULL;
-    uint8_t best_match = 0;
 
     DEBUG("nib: get match for destination %s from NIB\n",
           ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_INDEX)
+    for (unsigned n = _offl_trie_root; n != _IDX_NONE;) {
+        const _offl_trie_node_t *node = &_offl_trie[n];
+
+        if (ipv6_addr_match_prefix(&node->pfx, dst) < node->pfx_len) {
+            break;
+        }
+        /* prefix matches: first used entry is best match so far */
+        for (unsigned i = node->entry; i != _IDX_NONE; i = _offl_next[i]) {
+            if (_dsts[i].mode != _EMPTY) {
+                DEBUG("nib: best match %s/%u\n",
+                      ipv6_addr_to_str(addr_str, &node->pfx, sizeof(addr_str)),
+                      node->pfx_len);
+                res = &_dsts[i];
+                break;
+            }
+        }
+        if (node->pfx_len >= IPV6_ADDR_BIT_LEN) {
+            break;
+        }
+        n = node->child[_addr_bit(dst, node->pfx_len)];
+    }
+#else   /* CONFIG_GNRC_IPV6_NIB_INDEX */
+    uint8_t best_match = 0;
+
     for (_nib_offl_entry_t *entry = _dsts; _in_dsts(entry); entry++) {
         if (entry->mode != _EMPTY) {
             uint8_t match = ipv6_addr_match_prefix(&entry->pfx, dst);
@@ -592,6 +714,7 @@ static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
             }
         }
     }
+#endif  /* CONFIG_GNRC_IPV6_NIB_INDEX */
     return res;
 }
 
@@ -818,11 +941,18 @@ _nib_offl_entry_t *_nib_pl_add(unsigned iface,
 static void _override_node(const ipv6_addr_t *addr, unsigned iface,
                            _nib_onl_entry_t *node)
 {
+    /* a new entry may turn a destination cached as off-link on-link */
+    if ((addr != NULL) &&
+        ((node->mode == _EMPTY) || (_nib_onl_get_if(node) != iface) ||
+         !ipv6_addr_equal(&node->ipv6, addr))) {
+        _nib_rc_del(addr);
+    }
     _nib_onl_clear(node);
     if (addr != NULL) {
         memcpy(&node->ipv6, addr, sizeof(node->ipv6));
     }
     _nib_onl_set_if(node, iface);
+    _nib_onl_reindex(node);
 }
 
 static inline bool _node_unreachable(_nib_onl_entry_t *node)
@@ -854,4 +984,181 @@ uint32_t _evtimer_lookup(const void *ctx, uint16_t type)
     return UINT32_MAX;
 }
 
+
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_INDEX)
+static void _index_init(void)
+{
+    for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_INDEX_BUCKETS; i++) {
+        _onl_buckets[i] = _IDX_NONE;
+    }
+    for (unsigned i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
+        _onl_bucket[i] = _IDX_NONE;
+        _onl_next[i] = _IDX_NONE;
+    }
+    /* free trie nodes are chained via their first child */
+    for (unsigned i = 0; i < ARRAY_SIZE(_offl_trie); i++) {
+        _offl_trie[i].child[0] = (i + 1 < ARRAY_SIZE(_offl_trie)) ? (i + 1)
+                                                                  : _IDX_NONE;
+    }
+    _offl_trie_free = 0;
+    _offl_trie_root = _IDX_NONE;
+    for (unsigned i = 0; i < GNRC_IPV6_NIB_OFFL_NUMOF; i++) {
+        _offl_next[i] = _IDX_NONE;
+    }
+}
+
+/**
+ * @brief   Inserts @p idx into the index-sorted list at @p head
+ *
+ * Keeping the lists sorted makes indexed lookups return the same entry as a
+ * linear scan over the tables.
+ */
+static void _list_add(uint16_t *head, uint16_t *next, unsigned idx)
+{
+    while ((*head != _IDX_NONE) && (*head < idx)) {
+        head = &next[*head];
+    }
+    next[idx] = *head;
+    *head = idx;
+}
+
+static bool _list_remove(uint16_t *head, uint16_t *next, unsigned idx)
+{
+    while (*head != _IDX_NONE) {
+        if (*head == idx) {
+            *head = next[idx];
+            next[idx] = _IDX_NONE;
+            return true;
+        }
+        head = &next[*head];
+    }
+    return false;
+}
+
+void _nib_onl_reindex(const _nib_onl_entry_t *node)
+{
+    unsigned idx = node - _nodes;
+
+    assert(idx < GNRC_IPV6_NIB_NUMOF);
+    if (_onl_bucket[idx] != _IDX_NONE) {
+        _list_remove(&_onl_buckets[_onl_bucket[idx]], _onl_next, idx);
+        _onl_bucket[idx] = _IDX_NONE;
+    }
+    if (!ipv6_addr_is_unspecified(&node->ipv6)) {
+        _onl_bucket[idx] = _onl_hash(&node->ipv6);
+        _list_add(&_onl_buckets[_onl_bucket[idx]], _onl_next, idx);
+    }
+}
+
+static unsigned _offl_trie_node_alloc(const ipv6_addr_t *pfx, unsigned pfx_len)
+{
+    unsigned n = _offl_trie_free;
+    _offl_trie_node_t *node = &_offl_trie[n];
+
+    /* can't run out: every node without entries has two children */
+    assert(n != _IDX_NONE);
+    _offl_trie_free = node->child[0];
+    ipv6_addr_init_prefix(&node->pfx, pfx, pfx_len);
+    node->pfx_len = pfx_len;
+    node->child[0] = _IDX_NONE;
+    node->child[1] = _IDX_NONE;
+    node->entry = _IDX_NONE;
+    return n;
+}
+
+static void _offl_trie_node_free(unsigned n)
+{
+    _offl_trie[n].child[0] = _offl_trie_free;
+    _offl_trie_free = n;
+}
+
+static void _nib_offl_index(const _nib_offl_entry_t *dst)
+{
+    uint16_t *slot = &_offl_trie_root;
+    unsigned idx = dst - _dsts;
+
+    if (!_in_dsts(dst)) {
+        return;
+    }
+    while (*slot != _IDX_NONE) {
+        _offl_trie_node_t *node = &_offl_trie[*slot];
+        unsigned common = ipv6_addr_match_prefix(&node->pfx, &dst->pfx);
+        unsigned n;
+
+        if (common > dst->pfx_len) {
+            common = dst->pfx_len;
+        }
+        if (common >= node->pfx_len) {
+            if (node->pfx_len == dst->pfx_len) {
+                _list_add(&node->entry, _offl_next, idx);
+                return;
+            }
+            slot = &node->child[_addr_bit(&dst->pfx, node->pfx_len)];
+            continue;
+        }
+        /* prefixes diverge before the end of node's prefix: put a node with
+         * the common prefix in front of it */
+        n = _offl_trie_node_alloc(&dst->pfx, common);
+        _offl_trie[n].child[_addr_bit(&node->pfx, common)] = *slot;
+        *slot = n;
+        if (common == dst->pfx_len) {
+            _offl_trie[n].entry = idx;
+            _offl_next[idx] = _IDX_NONE;
+            return;
+        }
+        slot = &_offl_trie[n].child[_addr_bit(&dst->pfx, common)];
+        break;
+    }
+    *slot = _offl_trie_node_alloc(&dst->pfx, dst->pfx_len);
+    _offl_trie[*slot].entry = idx;
+    _offl_next[idx] = _IDX_NONE;
+}
+
+/**
+ * @brief   Removes the node at @p slot if it has no entries and less than two
+ *          children
+ */
+static void _offl_trie_prune(uint16_t *slot)
+{
+    _offl_trie_node_t *node = &_offl_trie[*slot];
+    unsigned n = *slot;
+
+    if ((node->entry != _IDX_NONE) ||
+        ((node->child[0] != _IDX_NONE) && (node->child[1] != _IDX_NONE))) {
+        return;
+    }
+    *slot = (node->child[0] != _IDX_NONE) ? node->child[0] : node->child[1];
+    _offl_trie_node_free(n);
+}
+
+static void _nib_offl_unindex(const _nib_offl_entry_t *dst)
+{
+    uint16_t *parent = NULL;
+    uint16_t *slot = &_offl_trie_root;
+
+    if (!_in_dsts(dst)) {
+        return;
+    }
+    while (*slot != _IDX_NONE) {
+        _offl_trie_node_t *node = &_offl_trie[*slot];
+
+        if ((node->pfx_len > dst->pfx_len) ||
+            (ipv6_addr_match_prefix(&node->pfx, &dst->pfx) < node->pfx_len)) {
+            return;
+        }
+        if (node->pfx_len == dst->pfx_len) {
+            if (_list_remove(&node->entry, _offl_next, dst - _dsts)) {
+                _offl_trie_prune(slot);
+                if (parent != NULL) {
+                    _offl_trie_prune(parent);
+                }
+            }
+            return;
+        }
+        parent = slot;
+        slot = &node->child[_addr_bit(&dst->pfx, node->pfx_len)];
+    }
+}
+#endif  /* CONFIG_GNRC_IPV6_NIB_INDEX */
+
 /** @} */
@@ -26,6 +26,7 @@
 
 #include "bitfield.h"
 #include "evtimer_msg.h"
+#include "kernel_defines.h"
 #include "kernel_types.h"
 #include "mutex.h"
 #include "net/eui64.h"
@@ -309,6 +310,23 @@ static inline void _nib_onl_set_if(_nib_onl_entry_t *node, unsigned iface)
  */
 _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface);
 
+#if IS_ACTIVE(CONFIG_GNRC_IPV6_NIB_INDEX) || defined(DOXYGEN)
+/**
+ * @brief   Updates the lookup index of an on-link entry after its address
+ *          changed
+ *
+ * @note    Only available with @ref CONFIG_GNRC_IPV6_NIB_INDEX
+ *
+ * @param[in] node  An entry.
+ */
+void _nib_onl_reindex(const _nib_onl_entry_t *node);
+#else
+static inline void _nib_onl_reindex(const _nib_onl_entry_t *node)
+{
+    (void)node;
+}
+#endif
+
 /**
  * @brief   Clears out a NIB entry (on-link version)
  *
@@ -321,6 +339,7 @@ static inline bool _nib_onl_clear(_nib_onl_entry_t *node)
 {
     if (node->mode == _EMPTY) {
         memset(node, 0, sizeof(_nib_onl_entry_t));
+        _nib_onl_reindex(node);
         return true;
     }
     return false;
@@ -542,6 +561,86 @@ _nib_offl_entry_t *_nib_offl_iter(const _nib_offl_entry_t *last);
  */
 bool _nib_offl_is_entry(const _nib_offl_entry_t *entry);
 
+#if CONFIG_GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF || defined(DOXYGEN)
+/**
+ * @brief   Gets the cached next hop for @p dst from the route cache
+ *
+ * @pre `(dst != NULL) && (nce != NULL)`
+ *
+ * @param[in] dst   Destination address.
+ * @param[in] iface Interface the look-up is restricted to. 0 for any.
+ * @param[out] nce  The next hop to @p dst.
+ *
+ * @return  true, if @p dst was found in the route cache.
+ * @return  false, if @p dst was not found in the route cache.
+ */
+bool _nib_rc_get(const ipv6_addr_t *dst, unsigned iface,
+                 gnrc_ipv6_nib_nc_t *nce);
+
+/**
+ * @brief   Adds the next hop resolved for @p dst to the route cache
+ *
+ * @pre `(dst != NULL) && (nce != NULL)`
+ *
+ * @param[in] dst   Destination address.
+ * @param[in] iface Interface the look-up was restricted to. 0 for any.
+ * @param[in] nce   The next hop to @p dst.
+ * @param[in] node  The on-link entry @p nce was resolved from. May be NULL.
+ * @param[in] route The route used to reach @p dst. NULL if @p dst is on-link.
+ */
+void _nib_rc_add(const ipv6_addr_t *dst, unsigned iface,
+                 const gnrc_ipv6_nib_nc_t *nce, _nib_onl_entry_t *node,
+                 const gnrc_ipv6_nib_ft_t *route);
+
+/**
+ * @brief   Removes the route cache entries to or via an address
+ *
+ * Needs to be called whenever the neighbor cache entry of @p addr changes.
+ *
+ * @pre `(addr != NULL)`
+ *
+ * @param[in] addr  Address of an on-link node.
+ */
+void _nib_rc_del(const ipv6_addr_t *addr);
+
+/**
+ * @brief   Removes all entries from the route cache
+ *
+ * Needs to be called whenever a route, prefix or default router changes.
+ */
+void _nib_rc_flush(void);
+#else   /* CONFIG_GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF || defined(DOXYGEN) */
+static inline bool _nib_rc_get(const ipv6_addr_t *dst, unsigned iface,
+                               gnrc_ipv6_nib_nc_t *nce)
+{
+    (void)dst;
+    (void)iface;
+    (void)nce;
+    return false;
+}
+
+static inline void _nib_rc_add(const ipv6_addr_t *dst, unsigned iface,
+                               const gnrc_ipv6_nib_nc_t *nce,
+                               _nib_onl_entry_t *node,
+                               const gnrc_ipv6_nib_ft_t *route)
+{
+    (void)dst;
+    (void)iface;
+    (void)nce;
+    (void)node;
+    (void)route;
+}
+
+static inline void _nib_rc_del(const ipv6_addr_t *addr)
+{
+    (void)addr;
+}
+
+static inline void _nib_rc_flush(void)
+{
+}
+#endif  /* CONFIG_GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF || defined(DOXYGEN) */
+
 /**
  * @brief   Helper function for view-level add-functions below
  *
@@ -568,6 +667,11 @@ static inline _nib_offl_entry_t *_nib_offl_add(const ipv6_addr_t *next_hop,
     _nib_offl_entry_t *nib_offl = _nib_offl_alloc(next_hop, iface, pfx, pfx_len);
 
     if (nib_offl != NULL) {
+        /* destination cache entries don't change the result of a route
+         * look-up */
+        if (!(nib_offl->mode & mode) && (mode != _DC)) {
+            _nib_rc_flush();
+        }
         nib_offl->mode |= mode;
     }
     return nib_offl;
@@ -580,8 +684,10 @@ static inline _nib_offl_entry_t *_nib_offl_add(const ipv6_addr_t *next_hop,
  */
 static inline void _nib_offl_remove(_nib_offl_entry_t *nib_offl, uint8_t mode)
 {
-    nib_offl->mode &= ~mode;
+    /* _nib_offl_clear() removes the entry in all its modes, so it flushes the
+     * route cache by the modes the entry had before */
     _nib_offl_clear(nib_offl);
+    nib_offl->mode &= ~mode;
 }
 
 #if GNRC_IPV6_NIB_CONF_DC || DOXYGEN
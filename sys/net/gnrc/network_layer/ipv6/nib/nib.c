@@ -188,15 +188,20 @@ int gnrc_ipv6_nib_get_next_hop_l2addr(const ipv6_addr_t *dst,
                                       gnrc_ipv6_nib_nc_t *nce)
 {
     int res = 0;
+    const unsigned req_iface = (netif == NULL) ? 0 : netif->pid;
 
     DEBUG("nib: get next hop link-layer address of %s%%%u\n",
-          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)),
-          (netif != NULL) ? (unsigned)netif->pid : 0U);
+          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)), req_iface);
     gnrc_netif_acquire(netif);
     _nib_acquire();
     do {    /* XXX: hidden goto ;-) */
-        _nib_onl_entry_t *node = _nib_onl_get(dst,
-                                              (netif == NULL) ? 0 : netif->pid);
+        if (_nib_rc_get(dst, req_iface, nce)) {
+            DEBUG("nib: next hop for %s found in route cache\n",
+                  ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+            break;
+        }
+
+        _nib_onl_entry_t *node = _nib_onl_get(dst, req_iface);
         /* consider neighbor cache entries first */
         unsigned iface = (node == NULL) ? 0 : _nib_onl_get_if(node);
 
@@ -224,6 +229,7 @@ int gnrc_ipv6_nib_get_next_hop_l2addr(const ipv6_addr_t *dst,
                 res = -EHOSTUNREACH;
                 break;
             }
+            _nib_rc_add(dst, req_iface, nce, node, NULL);
         }
         else {
             gnrc_ipv6_nib_ft_t route;
@@ -271,6 +277,7 @@ int gnrc_ipv6_nib_get_next_hop_l2addr(const ipv6_addr_t *dst,
 #if GNRC_IPV6_NIB_CONF_DC
                 _nib_dc_add(&route.next_hop, netif->pid, dst);
 #endif  /* GNRC_IPV6_NIB_CONF_DC */
+                _nib_rc_add(dst, req_iface, nce, node, &route);
             }
             else {
                 /* _resolve_addr releases pkt if not queued (in which case
@@ -1509,7 +1516,9 @@ static uint32_t _handle_pio(gnrc_netif_t *netif, const icmpv6_hdr_t *icmpv6,
                 _nib_abr_add_pfx(abr, pfx);
             }
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
-            if (pio->flags & NDP_OPT_PI_FLAGS_L) {
+            if ((pio->flags & NDP_OPT_PI_FLAGS_L) &&
+                !(pfx->flags & _PFX_ON_LINK)) {
+                _nib_rc_flush();
                 pfx->flags |= _PFX_ON_LINK;
             }
             if (pio->flags & NDP_OPT_PI_FLAGS_A) {
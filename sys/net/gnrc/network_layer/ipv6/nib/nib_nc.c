@@ -38,6 +38,7 @@ int gnrc_ipv6_nib_nc_set(const ipv6_addr_t *ipv6, unsigned iface,
         _nib_release();
         return -ENOMEM;
     }
+    _nib_rc_del(ipv6);
 #if GNRC_IPV6_NIB_CONF_ARSM
     if ((l2addr != NULL) && (l2addr_len > 0)) {
         memcpy(node->l2addr, l2addr, l2addr_len);
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "net/gnrc/ipv6/nib/rc.h"
+#include "net/gnrc/netif/internal.h"
+
+#include "_nib-arsm.h"
+#include "_nib-internal.h"
+#include "_nib-router.h"
+
+#if CONFIG_GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF
+#define _RC_OFFL            (0x01)  /**< destination was reached via a route */
+
+typedef struct {
+    ipv6_addr_t dst;            /**< destination, unspecified for empty entry */
+    gnrc_ipv6_nib_nc_t nce;     /**< resolved next hop */
+#if GNRC_IPV6_NIB_CONF_ROUTER
+    ipv6_addr_t route_dst;      /**< prefix of the route used */
+    uint8_t route_dst_len;      /**< length of _rc_entry_t::route_dst */
+#endif  /* GNRC_IPV6_NIB_CONF_ROUTER */
+    uint8_t flags;              /**< flags */
+    uint16_t iface;             /**< interface the lookup was restricted to */
+} _rc_entry_t;
+
+static _rc_entry_t _rc[CONFIG_GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF];
+static unsigned _rc_next;
+static bool _rc_empty = true;
+#endif  /* CONFIG_GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF */
+
+static gnrc_ipv6_nib_rc_stats_t _rc_stats;
+
+#if CONFIG_GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF
+bool _nib_rc_get(const ipv6_addr_t *dst, unsigned iface,
+                 gnrc_ipv6_nib_nc_t *nce)
+{
+    /* empty entries have an unspecified destination */
+    if (ipv6_addr_is_unspecified(dst)) {
+        _rc_stats.misses++;
+        return false;
+    }
+    for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF; i++) {
+        const _rc_entry_t *entry = &_rc[i];
+
+        if ((entry->iface == iface) && ipv6_addr_equal(&entry->dst, dst)) {
+#if GNRC_IPV6_NIB_CONF_ROUTER
+            if (entry->flags & _RC_OFFL) {
+                gnrc_netif_t *netif = gnrc_netif_get_by_pid(
+                        gnrc_ipv6_nib_nc_get_iface(&entry->nce)
+                    );
+
+                if (netif != NULL) {
+                    gnrc_netif_acquire(netif);
+                    _call_route_info_cb(netif,
+                                        GNRC_IPV6_NIB_ROUTE_INFO_TYPE_RN,
+                                        &entry->route_dst,
+                                        (void *)((intptr_t)entry->route_dst_len));
+                    gnrc_netif_release(netif);
+                }
+            }
+#endif  /* GNRC_IPV6_NIB_CONF_ROUTER */
+            memcpy(nce, &entry->nce, sizeof(*nce));
+            _rc_stats.hits++;
+            return true;
+        }
+    }
+    _rc_stats.misses++;
+    return false;
+}
+
+void _nib_rc_add(const ipv6_addr_t *dst, unsigned iface,
+                 const gnrc_ipv6_nib_nc_t *nce, _nib_onl_entry_t *node,
+                 const gnrc_ipv6_nib_ft_t *route)
+{
+    _rc_entry_t *entry = &_rc[_rc_next];
+
+    /* only cache results that don't depend on neighbor unreachability
+     * detection, any change of the neighbor removes its entries anyway */
+    if (ipv6_addr_is_unspecified(dst) ||
+        ((node != NULL) && (node->mode & _NC) &&
+         (_get_nud_state(node) != GNRC_IPV6_NIB_NC_INFO_NUD_STATE_REACHABLE) &&
+         (_get_nud_state(node) != GNRC_IPV6_NIB_NC_INFO_NUD_STATE_UNMANAGED))) {
+        return;
+    }
+    _rc_next = (_rc_next + 1) % CONFIG_GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF;
+    memcpy(&entry->dst, dst, sizeof(entry->dst));
+    memcpy(&entry->nce, nce, sizeof(entry->nce));
+    entry->iface = iface;
+    entry->flags = 0;
+    if (route != NULL) {
+        entry->flags |= _RC_OFFL;
+#if GNRC_IPV6_NIB_CONF_ROUTER
+        memcpy(&entry->route_dst, &route->dst, sizeof(entry->route_dst));
+        entry->route_dst_len = route->dst_len;
+#endif  /* GNRC_IPV6_NIB_CONF_ROUTER */
+    }
+    _rc_empty = false;
+}
+
+void _nib_rc_del(const ipv6_addr_t *addr)
+{
+    if (_rc_empty) {
+        return;
+    }
+    for (unsigned i = 0; i < CONFIG_GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF; i++) {
+        _rc_entry_t *entry = &_rc[i];
+
+        if (ipv6_addr_equal(&entry->dst, addr) ||
+            ipv6_addr_equal(&entry->nce.ipv6, addr)) {
+            memset(entry, 0, sizeof(*entry));
+        }
+    }
+}
+
+void _nib_rc_flush(void)
+{
+    if (!_rc_empty) {
+        memset(_rc, 0, sizeof(_rc));
+        _rc_empty = true;
+        _rc_stats.flushes++;
+    }
+}
+#endif  /* CONFIG_GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF */
+
+void gnrc_ipv6_nib_rc_get_stats(gnrc_ipv6_nib_rc_stats_t *stats)
+{
+    assert(stats != NULL);
+    _nib_acquire();
+    memcpy(stats, &_rc_stats, sizeof(*stats));
+    _nib_release();
+}
+
+void gnrc_ipv6_nib_rc_flush(void)
+{
+    _nib_acquire();
+    _nib_rc_flush();
+    _nib_release();
+}
+
+/** @} */
@@ -13,6 +13,7 @@
  * @author  Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include <errno.h>
 #include <inttypes.h>
 #include <stdbool.h>
 
@@ -38,22 +39,6 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
-/* estimated fragment payload size to determinate RBUF_INT_SIZE, default to
- * MAC payload size - fragment header. */
-#ifndef GNRC_SIXLOWPAN_FRAG_SIZE
-/* assuming 64-bit source/destination address, source PAN ID omitted */
-#define GNRC_SIXLOWPAN_FRAG_SIZE (104 - 5)
-#endif
-
-#ifndef RBUF_INT_SIZE
-/* same as ((int) ceil((double) N / D)) */
-#define DIV_CEIL(N, D) (((N) + (D) - 1) / (D))
-#define RBUF_INT_SIZE (DIV_CEIL(IPV6_MIN_MTU, GNRC_SIXLOWPAN_FRAG_SIZE) * \
-                       CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE)
-#endif
-
-static gnrc_sixlowpan_frag_rb_int_t rbuf_int[RBUF_INT_SIZE];
-
 static gnrc_sixlowpan_frag_rb_t rbuf[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
 
 static char l2addr_str[3 * IEEE802154_LONG_ADDRESS_LEN];
@@ -64,14 +49,9 @@ static msg_t _gc_timer_msg = { .type = GNRC_SIXLOWPAN_FRAG_RB_GC_MSG };
 /* ------------------------------------
  * internal function definitions
  * ------------------------------------*/
-/* checks whether start and end overlaps, but not identical to, given interval i */
-static inline bool _rbuf_int_overlap_partially(gnrc_sixlowpan_frag_rb_int_t *i,
-                                               uint16_t start, uint16_t end);
-/* gets a free entry from interval buffer */
-static gnrc_sixlowpan_frag_rb_int_t *_rbuf_int_get_free(void);
-/* update interval buffer of entry */
-static bool _rbuf_update_ints(gnrc_sixlowpan_frag_rb_base_t *entry,
-                              uint16_t offset, size_t frag_size);
+/* marks the 8-octet units of a fragment as received in entry */
+static void _rbuf_mark_received(gnrc_sixlowpan_frag_rb_base_t *entry,
+                                uint16_t offset, size_t frag_size);
 /* gets an entry identified by its tuple */
 static int _rbuf_get(const void *src, size_t src_len,
                      const void *dst, size_t dst_len,
@@ -90,32 +70,37 @@ enum {
     RBUF_ADD_ERROR = -1,
     RBUF_ADD_REPEAT = -2,
     RBUF_ADD_DUPLICATE = -3,
+    RBUF_ADD_FORWARDED = -4,
 };
 
 static int _check_fragments(gnrc_sixlowpan_frag_rb_base_t *entry,
                             size_t frag_size, size_t offset)
 {
-    gnrc_sixlowpan_frag_rb_int_t *ptr = entry->ints;
-
+    /* fragment offsets are multiples of 8 octets, so a fragment either covers
+     * units no other fragment covered yet or overlaps another fragment */
+    unsigned first = offset / 8U;
+    unsigned last = (offset + frag_size - 1) / 8U;
+    unsigned received = 0;
+
+    assert(last < GNRC_SIXLOWPAN_FRAG_RB_UNITS);
+    for (unsigned i = first; i <= last; i++) {
+        received += bf_isset(entry->received, i);
+    }
+    if (received == 0) {
+        return RBUF_ADD_SUCCESS;
+    }
+    if (received == (last - first + 1)) {
+        DEBUG("6lo rbuf: fragment already in reassembly buffer\n");
+        return RBUF_ADD_DUPLICATE;
+    }
     /* If the fragment overlaps another fragment and differs in either the size
      * or the offset of the overlapped fragment, discards the datagram
      * https://tools.ietf.org/html/rfc4944#section-5.3 */
-    while (ptr != NULL) {
-        if (_rbuf_int_overlap_partially(ptr, offset, offset + frag_size - 1)) {
 
-            /* "A fresh reassembly may be commenced with the most recently
-             * received link fragment"
-             * https://tools.ietf.org/html/rfc4944#section-5.3 */
-            return RBUF_ADD_REPEAT;
-        }
-        /* End was already checked in overlap check */
-        if (ptr->start == offset) {
-            DEBUG("6lo rbuf: fragment already in reassembly buffer\n");
-            return RBUF_ADD_DUPLICATE;
-        }
-        ptr = ptr->next;
-    }
-    return RBUF_ADD_SUCCESS;
+    /* "A fresh reassembly may be commenced with the most recently
+     * received link fragment"
+     * https://tools.ietf.org/html/rfc4944#section-5.3 */
+    return RBUF_ADD_REPEAT;
 }
 
 gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_add(gnrc_netif_hdr_t *netif_hdr,
@@ -197,13 +182,75 @@ static uint8_t *_6lo_frag_payload(gnrc_pktsnip_t *pkt)
     }
 }
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+static int _vrb_forward(gnrc_sixlowpan_frag_vrb_t *vrbe, gnrc_pktsnip_t *pkt,
+                        size_t offset, size_t frag_size)
+{
+    int res;
+
+    if ((offset + frag_size) > vrbe->super.datagram_size) {
+        DEBUG("6lo rbuf: fragment too big for datagram, discarding VRB entry\n");
+        res = RBUF_ADD_REPEAT;
+    }
+    else {
+        res = _check_fragments(&vrbe->super, frag_size, offset);
+    }
+    if (res == RBUF_ADD_REPEAT) {
+        DEBUG("6lo rbuf: overlapping fragment, discarding VRB entry\n");
+        gnrc_sixlowpan_frag_vrb_rm(vrbe);
+    }
+    if (res != RBUF_ADD_SUCCESS) {
+        gnrc_pktbuf_release(pkt);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+        vrbe->out_netif->sixlo.vrb_stats.drops++;
+#endif
+        return RBUF_ADD_ERROR;
+    }
+    _rbuf_mark_received(&vrbe->super, offset, frag_size);
+    vrbe->super.current_size += frag_size;
+    vrbe->super.arrival = xtimer_now_usec();
+    if (pkt->users > 1) {
+        /* the netif header is still referenced by the original, so copy */
+        gnrc_pktsnip_t *tmp = gnrc_pktbuf_add(NULL, pkt->data, pkt->size,
+                                              GNRC_NETTYPE_SIXLOWPAN);
+
+        gnrc_pktbuf_release(pkt);
+        pkt = tmp;
+    }
+    else {
+        /* netif header is rebuilt from VRB entry */
+        pkt = gnrc_pktbuf_remove_snip(pkt, pkt->next);
+    }
+    if (pkt == NULL) {
+        DEBUG("6lo rbuf: unable to copy fragment for forwarding\n");
+        res = -ENOMEM;
+    }
+    else {
+        res = gnrc_sixlowpan_frag_vrb_forward(vrbe, pkt);
+    }
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+    if (res == 0) {
+        vrbe->out_netif->sixlo.vrb_stats.fwd++;
+    }
+    else {
+        vrbe->out_netif->sixlo.vrb_stats.drops++;
+    }
+#endif
+    if (vrbe->super.current_size >= vrbe->super.datagram_size) {
+        DEBUG("6lo rbuf: datagram forwarded completely\n");
+        gnrc_sixlowpan_frag_vrb_rm(vrbe);
+    }
+    return (res == 0) ? RBUF_ADD_FORWARDED : RBUF_ADD_ERROR;
+}
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+
 static size_t _6lo_frag_size(gnrc_pktsnip_t *pkt, size_t offset, uint8_t *data)
 {
     size_t frag_size;
 
     if (offset == 0) {
         frag_size = pkt->size - sizeof(sixlowpan_frag_t);
-        if (data[0] == SIXLOWPAN_UNCOMP) {
+        if ((frag_size > 0) && (data[0] == SIXLOWPAN_UNCOMP)) {
             /* subtract SIXLOWPAN_UNCOMP byte from fragment size,
              * data pointer must be changed by caller (see _rbuf_add()) */
             frag_size--;
@@ -232,7 +279,25 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     datagram_size = sixlowpan_frag_datagram_size(pkt->data);
     datagram_tag = sixlowpan_frag_datagram_tag(pkt->data);
 
+    if (frag_size == 0) {
+        /* covers no unit of the datagram, nothing to mark as received */
+        DEBUG("6lo rbuf: fragment without payload, discarding\n");
+        gnrc_pktbuf_release(pkt);
+        return RBUF_ADD_ERROR;
+    }
     gnrc_sixlowpan_frag_rb_gc();
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    gnrc_sixlowpan_frag_vrb_t *vrbe;
+
+    /* cut-through: subsequent fragments of a datagram with a VRB entry are
+     * forwarded right away */
+    if ((offset > 0) &&
+        (vrbe = gnrc_sixlowpan_frag_vrb_get(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                                            netif_hdr->src_l2addr_len,
+                                            datagram_tag))) {
+        return _vrb_forward(vrbe, pkt, offset, frag_size);
+    }
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
     res = _rbuf_get(gnrc_netif_hdr_get_src_addr(netif_hdr), netif_hdr->src_l2addr_len,
                     gnrc_netif_hdr_get_dst_addr(netif_hdr), netif_hdr->dst_l2addr_len,
                     datagram_size, datagram_tag, page);
@@ -264,102 +329,64 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
             break;
     }
 
-    if (_rbuf_update_ints(&entry->super, offset, frag_size)) {
-        DEBUG("6lo rbuf: add fragment data\n");
-        entry->super.current_size += (uint16_t)frag_size;
-        if (offset == 0) {
+    DEBUG("6lo rbuf: add fragment data\n");
+    _rbuf_mark_received(&entry->super, offset, frag_size);
+    entry->super.current_size += (uint16_t)frag_size;
+    entry->frags++;
+    if (offset == 0) {
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC
-            if (sixlowpan_iphc_is(data)) {
-                DEBUG("6lo rbuf: detected IPHC header.\n");
-                gnrc_pktsnip_t *frag_hdr = gnrc_pktbuf_mark(pkt,
-                        sizeof(sixlowpan_frag_t), GNRC_NETTYPE_SIXLOWPAN);
-                if (frag_hdr == NULL) {
-                    DEBUG("6lo rbuf: unable to mark fragment header. "
-                          "aborting reassembly.\n");
-                    gnrc_pktbuf_release(entry->pkt);
-                    gnrc_pktbuf_release(pkt);
-                    gnrc_sixlowpan_frag_rb_remove(entry);
-                    return RBUF_ADD_ERROR;
-                }
-                else {
-                    DEBUG("6lo rbuf: handing over to IPHC reception.\n");
-                    /* `pkt` released in IPHC */
-                    gnrc_sixlowpan_iphc_recv(pkt, entry, 0);
-                    /* check if entry was deleted in IPHC (error case) */
-                    if (gnrc_sixlowpan_frag_rb_entry_empty(entry)) {
-                        res = RBUF_ADD_ERROR;
-                    }
-                    return res;
+        if (sixlowpan_iphc_is(data)) {
+            DEBUG("6lo rbuf: detected IPHC header.\n");
+            gnrc_pktsnip_t *frag_hdr = gnrc_pktbuf_mark(pkt,
+                    sizeof(sixlowpan_frag_t), GNRC_NETTYPE_SIXLOWPAN);
+            if (frag_hdr == NULL) {
+                DEBUG("6lo rbuf: unable to mark fragment header. "
+                      "aborting reassembly.\n");
+                gnrc_pktbuf_release(entry->pkt);
+                gnrc_pktbuf_release(pkt);
+                gnrc_sixlowpan_frag_rb_remove(entry);
+                return RBUF_ADD_ERROR;
+            }
+            else {
+                DEBUG("6lo rbuf: handing over to IPHC reception.\n");
+                /* `pkt` released in IPHC */
+                gnrc_sixlowpan_iphc_recv(pkt, entry, 0);
+                /* check if entry was deleted in IPHC (error case) */
+                if (gnrc_sixlowpan_frag_rb_entry_empty(entry)) {
+                    res = RBUF_ADD_ERROR;
                 }
+                return res;
             }
-            else
+        }
+        else
 #endif
-            if (data[0] == SIXLOWPAN_UNCOMP) {
-                DEBUG("6lo rbuf: detected uncompressed datagram\n");
-                data++;
-            }
+        if (data[0] == SIXLOWPAN_UNCOMP) {
+            DEBUG("6lo rbuf: detected uncompressed datagram\n");
+            data++;
         }
-        memcpy(((uint8_t *)entry->pkt->data) + offset, data,
-               frag_size);
-    }
-    else {
-        /* no space left in rbuf interval buffer*/
-        gnrc_pktbuf_release(entry->pkt);
-        gnrc_sixlowpan_frag_rb_remove(entry);
-        res = RBUF_ADD_ERROR;
     }
+    memcpy(((uint8_t *)entry->pkt->data) + offset, data,
+           frag_size);
     /* no errors and not consumed => release packet */
     gnrc_pktbuf_release(pkt);
     return res;
 }
 
-static inline bool _rbuf_int_overlap_partially(gnrc_sixlowpan_frag_rb_int_t *i,
-                                               uint16_t start, uint16_t end)
+static void _rbuf_mark_received(gnrc_sixlowpan_frag_rb_base_t *entry,
+                                uint16_t offset, size_t frag_size)
 {
-    /* start and ends are both inclusive, so using <= for both */
-    return ((i->start <= end) && (start <= i->end)) && /* overlaps */
-        ((start != i->start) || (end != i->end)); /* not identical */
-}
-
-static gnrc_sixlowpan_frag_rb_int_t *_rbuf_int_get_free(void)
-{
-    for (unsigned int i = 0; i < RBUF_INT_SIZE; i++) {
-        if (rbuf_int[i].end == 0) { /* start must be smaller than end anyways*/
-            return rbuf_int + i;
-        }
-    }
+    unsigned last = (offset + frag_size - 1) / 8U;
 
-    return NULL;
-}
-
-static bool _rbuf_update_ints(gnrc_sixlowpan_frag_rb_base_t *entry,
-                              uint16_t offset, size_t frag_size)
-{
-    gnrc_sixlowpan_frag_rb_int_t *new;
-    uint16_t end = (uint16_t)(offset + frag_size - 1);
-
-    new = _rbuf_int_get_free();
-
-    if (new == NULL) {
-        DEBUG("6lo rfrag: no space left in rbuf interval buffer.\n");
-        return false;
-    }
-
-    new->start = offset;
-    new->end = end;
-
-    DEBUG("6lo rfrag: add interval (%" PRIu16 ", %" PRIu16 ") to entry (%s, ",
-          new->start, new->end, gnrc_netif_addr_to_str(entry->src,
-                                                       entry->src_len,
-                                                       l2addr_str));
+    DEBUG("6lo rfrag: add interval (%" PRIu16 ", %u) to entry (%s, ",
+          offset, (unsigned)(offset + frag_size - 1),
+          gnrc_netif_addr_to_str(entry->src, entry->src_len, l2addr_str));
     DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(entry->dst,
                                                   entry->dst_len,
                                                   l2addr_str),
           entry->datagram_size, entry->tag);
-
-    LL_PREPEND(entry->ints, new);
-
-    return true;
+    for (unsigned i = offset / 8U; i <= last; i++) {
+        bf_set(entry->received, i);
+    }
 }
 
 static void _gc_pkt(gnrc_sixlowpan_frag_rb_t *rbuf)
@@ -514,6 +541,7 @@ static int _rbuf_get(const void *src, size_t src_len,
     res->super.dst_len = dst_len;
     res->super.tag = tag;
     res->super.current_size = 0;
+    res->frags = 0;
 
     DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
           gnrc_netif_addr_to_str(res->super.src, res->super.src_len,
@@ -532,7 +560,6 @@ static int _rbuf_get(const void *src, size_t src_len,
 void gnrc_sixlowpan_frag_rb_reset(void)
 {
     xtimer_remove(&_gc_timer);
-    memset(rbuf_int, 0, sizeof(rbuf_int));
     for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
         if ((rbuf[i].pkt != NULL) &&
             (rbuf[i].pkt->users > 0)) {
@@ -550,14 +577,7 @@ const gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_array(void)
 
 void gnrc_sixlowpan_frag_rb_base_rm(gnrc_sixlowpan_frag_rb_base_t *entry)
 {
-    while (entry->ints != NULL) {
-        gnrc_sixlowpan_frag_rb_int_t *next = entry->ints->next;
-
-        entry->ints->start = 0;
-        entry->ints->end = 0;
-        entry->ints->next = NULL;
-        entry->ints = next;
-    }
+    memset(entry->received, 0, sizeof(entry->received));
     entry->datagram_size = 0;
 }
 
@@ -580,20 +600,6 @@ static void _tmp_rm(gnrc_sixlowpan_frag_rb_t *rbuf)
 #endif  /* CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER */
 }
 
-#if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_STATS)
-static inline unsigned _count_frags(gnrc_sixlowpan_frag_rb_t *rbuf)
-{
-    unsigned frags = 0;
-    gnrc_sixlowpan_frag_rb_int_t *frag = rbuf->super.ints;
-
-    while (frag) {
-        frag = frag->next;
-        frags++;
-    }
-    return frags;
-}
-#endif
-
 int gnrc_sixlowpan_frag_rb_dispatch_when_complete(gnrc_sixlowpan_frag_rb_t *rbuf,
                                                    gnrc_netif_hdr_t *netif_hdr)
 {
@@ -625,7 +631,7 @@ int gnrc_sixlowpan_frag_rb_dispatch_when_complete(gnrc_sixlowpan_frag_rb_t *rbuf
         new_netif_hdr->rssi = netif_hdr->rssi;
         LL_APPEND(rbuf->pkt, netif);
 #if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_STATS)
-        gnrc_sixlowpan_frag_stats_get()->fragments += _count_frags(rbuf);
+        gnrc_sixlowpan_frag_stats_get()->fragments += rbuf->frags;
         gnrc_sixlowpan_frag_stats_get()->datagrams++;
 #endif
         gnrc_sixlowpan_dispatch_recv(rbuf->pkt, NULL, 0);
@@ -13,12 +13,18 @@
  * @author  Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include <errno.h>
+
 #include "net/ieee802154.h"
 #ifdef MODULE_GNRC_IPV6_NIB
 #include "net/ipv6/addr.h"
 #include "net/gnrc/ipv6/nib.h"
 #endif  /* MODULE_GNRC_IPV6_NIB */
+#include "net/gnrc/netapi.h"
 #include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/sixlowpan.h"
 #include "xtimer.h"
 
 #include "net/gnrc/sixlowpan/frag/fb.h"
@@ -30,7 +36,21 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/* entries are chained into hash buckets by (src, tag), so the lookup for
+ * every forwarded fragment only compares the entries of one bucket */
+#if CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE < UINT8_MAX
+typedef uint8_t _vrb_idx_t;
+#else
+typedef uint16_t _vrb_idx_t;
+#endif
+
+#define _BUCKETS        (CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE)
+
 static gnrc_sixlowpan_frag_vrb_t _vrb[CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
+/* bucket heads and chain links hold the index of an entry + 1, 0 ends a
+ * chain, so all chains are empty after a reset */
+static _vrb_idx_t _bucket[_BUCKETS];
+static _vrb_idx_t _next[CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE];
 #ifdef MODULE_GNRC_IPV6_NIB
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #else   /* MODULE_GNRC_IPV6_NIB */
@@ -46,6 +66,66 @@ static inline bool _equal_index(const gnrc_sixlowpan_frag_vrb_t *vrbe,
             (memcmp(vrbe->super.src, src, src_len) == 0));
 }
 
+static unsigned _hash(const uint8_t *src, size_t src_len, unsigned tag)
+{
+    unsigned hash = tag;
+
+    for (unsigned i = 0; i < src_len; i++) {
+        hash = (hash * 31U) + src[i];
+    }
+    return hash % _BUCKETS;
+}
+
+static gnrc_sixlowpan_frag_vrb_t *_find(const uint8_t *src, size_t src_len,
+                                        unsigned tag)
+{
+    for (_vrb_idx_t idx = _bucket[_hash(src, src_len, tag)]; idx != 0;
+         idx = _next[idx - 1]) {
+        gnrc_sixlowpan_frag_vrb_t *vrbe = &_vrb[idx - 1];
+
+        if (_equal_index(vrbe, src, src_len, tag)) {
+            return vrbe;
+        }
+    }
+    return NULL;
+}
+
+static gnrc_sixlowpan_frag_vrb_t *_alloc(void)
+{
+    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
+        if (gnrc_sixlowpan_frag_vrb_entry_empty(&_vrb[i])) {
+            return &_vrb[i];
+        }
+    }
+    return NULL;
+}
+
+static void _link(gnrc_sixlowpan_frag_vrb_t *vrbe)
+{
+    _vrb_idx_t *head = &_bucket[_hash(vrbe->super.src, vrbe->super.src_len,
+                                      vrbe->super.tag)];
+    unsigned i = vrbe - _vrb;
+
+    _next[i] = *head;
+    *head = i + 1;
+}
+
+static void _unlink(gnrc_sixlowpan_frag_vrb_t *vrbe)
+{
+    _vrb_idx_t *ptr = &_bucket[_hash(vrbe->super.src, vrbe->super.src_len,
+                                     vrbe->super.tag)];
+    unsigned i = vrbe - _vrb;
+
+    while (*ptr != 0) {
+        if (*ptr == (i + 1)) {
+            *ptr = _next[i];
+            _next[i] = 0;
+            return;
+        }
+        ptr = &_next[*ptr - 1];
+    }
+}
+
 
 gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_add(
         const gnrc_sixlowpan_frag_rb_base_t *base,
@@ -57,63 +137,33 @@ gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_add(
     assert(out_netif != NULL);
     assert(out_dst != NULL);
     assert(out_dst_len > 0);
-    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
-        gnrc_sixlowpan_frag_vrb_t *ptr = &_vrb[i];
-
-        if (gnrc_sixlowpan_frag_vrb_entry_empty(ptr) ||
-            _equal_index(ptr, base->src, base->src_len, base->tag)) {
-            vrbe = ptr;
-            if (gnrc_sixlowpan_frag_vrb_entry_empty(vrbe)) {
-                vrbe->super = *base;
-                vrbe->out_netif = out_netif;
-                memcpy(vrbe->super.dst, out_dst, out_dst_len);
-                vrbe->out_tag = gnrc_sixlowpan_frag_fb_next_tag();
-                vrbe->super.dst_len = out_dst_len;
-                DEBUG("6lo vrb: creating entry (%s, ",
-                      gnrc_netif_addr_to_str(vrbe->super.src,
-                                             vrbe->super.src_len,
-                                             addr_str));
-                DEBUG("%s, %u, %u) => ",
-                      gnrc_netif_addr_to_str(vrbe->super.dst,
-                                             vrbe->super.dst_len,
-                                             addr_str),
-                      (unsigned)vrbe->super.datagram_size, vrbe->super.tag);
-                DEBUG("(%s, %u)\n",
-                      gnrc_netif_addr_to_str(vrbe->super.dst,
-                                             vrbe->super.dst_len,
-                                             addr_str), vrbe->out_tag);
-            }
-            /* _equal_index() => append intervals of `base`, so they don't get
-             * lost. We use append, so we don't need to change base! */
-            else if (base->ints != NULL) {
-                gnrc_sixlowpan_frag_rb_int_t *tmp = vrbe->super.ints;
-
-                if (tmp != base->ints) {
-                    /* base->ints is not already vrbe->super.ints */
-                    if (tmp != NULL) {
-                        /* iterate before appending and check if `base->ints` is
-                         * not already part of list */
-                        while (tmp->next != NULL) {
-                            if (tmp == base->ints) {
-                                tmp = NULL;
-                            }
-                            /* cppcheck-suppress nullPointer
-                             * (reason: possible bug in cppcheck, tmp can't
-                             * clearly be a NULL pointer here) */
-                            tmp = tmp->next;
-                        }
-                        if (tmp != NULL) {
-                            tmp->next = base->ints;
-                        }
-                    }
-                    else {
-                        vrbe->super.ints = base->ints;
-                    }
-                }
-            }
-            break;
+    if ((vrbe = _find(base->src, base->src_len, base->tag)) != NULL) {
+        /* merge fragments received for `base`, so they don't get lost */
+        for (unsigned i = 0; i < sizeof(vrbe->super.received); i++) {
+            vrbe->super.received[i] |= base->received[i];
         }
     }
+    else if ((vrbe = _alloc()) != NULL) {
+        vrbe->super = *base;
+        vrbe->out_netif = out_netif;
+        memcpy(vrbe->super.dst, out_dst, out_dst_len);
+        vrbe->out_tag = gnrc_sixlowpan_frag_fb_next_tag();
+        vrbe->super.dst_len = out_dst_len;
+        _link(vrbe);
+        DEBUG("6lo vrb: creating entry (%s, ",
+              gnrc_netif_addr_to_str(vrbe->super.src,
+                                     vrbe->super.src_len,
+                                     addr_str));
+        DEBUG("%s, %u, %u) => ",
+              gnrc_netif_addr_to_str(vrbe->super.dst,
+                                     vrbe->super.dst_len,
+                                     addr_str),
+              (unsigned)vrbe->super.datagram_size, vrbe->super.tag);
+        DEBUG("(%s, %u)\n",
+              gnrc_netif_addr_to_str(vrbe->super.dst,
+                                     vrbe->super.dst_len,
+                                     addr_str), vrbe->out_tag);
+    }
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
     if (vrbe == NULL) {
         gnrc_sixlowpan_frag_stats_get()->vrb_full++;
@@ -171,21 +221,67 @@ gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_get(
 {
     DEBUG("6lo vrb: trying to get entry for (%s, %u)\n",
           gnrc_netif_addr_to_str(src, src_len, addr_str), src_tag);
-    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE; i++) {
-        gnrc_sixlowpan_frag_vrb_t *vrbe = &_vrb[i];
+    gnrc_sixlowpan_frag_vrb_t *vrbe = _find(src, src_len, src_tag);
 
-        if (_equal_index(vrbe, src, src_len, src_tag)) {
-            DEBUG("6lo vrb: got VRB to (%s, %u)\n",
-                  gnrc_netif_addr_to_str(vrbe->super.dst,
-                                         vrbe->super.dst_len,
-                                         addr_str), vrbe->out_tag);
-            return vrbe;
-        }
+    if (vrbe != NULL) {
+        DEBUG("6lo vrb: got VRB to (%s, %u)\n",
+              gnrc_netif_addr_to_str(vrbe->super.dst,
+                                     vrbe->super.dst_len,
+                                     addr_str), vrbe->out_tag);
+        return vrbe;
     }
     DEBUG("6lo vrb: no entry found\n");
     return NULL;
 }
 
+int gnrc_sixlowpan_frag_vrb_forward(gnrc_sixlowpan_frag_vrb_t *vrbe,
+                                    gnrc_pktsnip_t *frag)
+{
+    gnrc_pktsnip_t *netif;
+    sixlowpan_frag_t *frag_hdr;
+
+    assert((vrbe != NULL) && (frag != NULL));
+    assert(frag->size >= sizeof(sixlowpan_frag_t));
+    assert(frag->users == 1);
+    netif = gnrc_netif_hdr_build(NULL, 0, vrbe->super.dst, vrbe->super.dst_len);
+    if (netif == NULL) {
+        DEBUG("6lo vrb: unable to allocate netif header\n");
+        gnrc_pktbuf_release(frag);
+        return -ENOMEM;
+    }
+    gnrc_netif_hdr_set_netif(netif->data, vrbe->out_netif);
+    /* dispatch and size are the same for first and subsequent fragments, only
+     * the tag changes from hop to hop */
+    frag_hdr = frag->data;
+    frag_hdr->tag = byteorder_htons(vrbe->out_tag);
+    netif->next = frag;
+    DEBUG("6lo vrb: forwarding fragment (%s, %u) ",
+          gnrc_netif_addr_to_str(vrbe->super.src, vrbe->super.src_len,
+                                 addr_str), vrbe->super.tag);
+    DEBUG("to (%s, %u)\n",
+          gnrc_netif_addr_to_str(vrbe->super.dst, vrbe->super.dst_len,
+                                 addr_str), vrbe->out_tag);
+    if (gnrc_netapi_send(vrbe->out_netif->pid, netif) < 1) {
+        DEBUG("6lo vrb: unable to send fragment over interface %u\n",
+              vrbe->out_netif->pid);
+        gnrc_pktbuf_release(netif);
+        return -ENOBUFS;
+    }
+    return 0;
+}
+
+void gnrc_sixlowpan_frag_vrb_rm(gnrc_sixlowpan_frag_vrb_t *vrb)
+{
+    if (gnrc_sixlowpan_frag_vrb_entry_empty(vrb)) {
+        return;
+    }
+    _unlink(vrb);
+    if (IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_RB)) {
+        gnrc_sixlowpan_frag_rb_base_rm(&vrb->super);
+    }
+    vrb->super.src_len = 0;
+}
+
 void gnrc_sixlowpan_frag_vrb_gc(void)
 {
     uint32_t now_usec = xtimer_now_usec();
@@ -211,6 +307,8 @@ void gnrc_sixlowpan_frag_vrb_gc(void)
 void gnrc_sixlowpan_frag_vrb_reset(void)
 {
     memset(_vrb, 0, sizeof(_vrb));
+    memset(_bucket, 0, sizeof(_bucket));
+    memset(_next, 0, sizeof(_next));
 }
 #endif
 
@@ -26,6 +26,9 @@
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/ctx.h"
 #include "net/gnrc/sixlowpan/frag/rb.h"
+#ifdef  MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+#include "net/gnrc/sixlowpan/frag/stats.h"
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_STATS */
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
 #include "net/gnrc/sixlowpan/frag/vrb.h"
 #endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
@@ -843,19 +846,30 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
                 if ((res = _forward_frag(ipv6, sixlo->next, vrbe, page)) == 0) {
                     DEBUG("6lo iphc: successfully recompressed and forwarded "
                           "1st fragment\n");
-                    /* empty list, as it should be in VRB now */
-                    rbuf->super.ints = NULL;
                 }
             }
             if ((ipv6 == NULL) || (res < 0)) {
                 gnrc_sixlowpan_frag_vrb_rm(vrbe);
             }
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+            if (res == 0) {
+                vrbe->out_netif->sixlo.vrb_stats.fwd++;
+            }
+            else {
+                vrbe->out_netif->sixlo.vrb_stats.drops++;
+            }
+#endif
             gnrc_pktbuf_release(sixlo);
             /* don't remove `rbuf->pkt` (aka ipv6) as it was forwarded */
             gnrc_sixlowpan_frag_rb_remove(rbuf);
             return;
         }
         DEBUG("6lo iphc: no route found, reassemble datagram normally\n");
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_STATS
+        if (iface != NULL) {
+            iface->sixlo.vrb_stats.reasm++;
+        }
+#endif
 #endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
     }
     else {
@@ -909,31 +923,22 @@ static gnrc_pktsnip_t *_encode_frag_for_forwarding(gnrc_pktsnip_t *decoded_pkt,
 static int _forward_frag(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *frag_hdr,
                          gnrc_sixlowpan_frag_vrb_t *vrbe, unsigned page)
 {
-    /* remove rewritten netif header (forwarding implementation must do this
-     * anyway) */
+    gnrc_pktsnip_t *frag;
+
+    (void)page;
+    /* remove rewritten netif header, gnrc_sixlowpan_frag_vrb_forward() builds
+     * its own from the VRB entry */
     pkt = gnrc_pktbuf_remove_snip(pkt, pkt);
-    /* the following is just debug output for testing without any forwarding
-     * scheme */
-    DEBUG("6lo iphc: Do not know how to forward fragment from (%s, %u) ",
-          gnrc_netif_addr_to_str(vrbe->super.src, vrbe->super.src_len,
-                                 addr_str), vrbe->super.tag);
-    DEBUG("to (%s, %u)\n",
-          gnrc_netif_addr_to_str(vrbe->super.dst, vrbe->super.dst_len,
-                                 addr_str), vrbe->out_tag);
-#if ENABLE_DEBUG && defined(MODULE_OD)
-    DEBUG("Original fragmentation header:\n");
-    od_hex_dump(frag_hdr->data, frag_hdr->size, OD_WIDTH_DEFAULT);
-    DEBUG("IPHC headers + payload:\n");
-    frag_hdr = pkt;
-    while (frag_hdr) {
-        od_hex_dump(frag_hdr->data, frag_hdr->size, OD_WIDTH_DEFAULT);
-        frag_hdr = frag_hdr->next;
+    /* the original fragmentation header is released with `sixlo`, so put a
+     * copy in front of the recompressed headers */
+    frag = gnrc_pktbuf_add(pkt, frag_hdr->data, frag_hdr->size,
+                           GNRC_NETTYPE_SIXLOWPAN);
+    if (frag == NULL) {
+        DEBUG("6lo iphc: unable to copy fragmentation header\n");
+        gnrc_pktbuf_release(pkt);
+        return -ENOMEM;
     }
-#endif
-    gnrc_pktbuf_release(pkt);
-    (void)frag_hdr;
-    (void)page;
-    return -ENOTSUP;
+    return gnrc_sixlowpan_frag_vrb_forward(vrbe, frag);
 }
 #endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
 
@@ -0,0 +1,482 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf_slab
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/types.h>
+
+#include "mutex.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/pktbuf/slab.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define _ALIGNMENT          (sizeof(void *))
+/* fits size to slot alignment */
+#define _ALIGN(size)        (((size) + _ALIGNMENT - 1) & ~(_ALIGNMENT - 1))
+
+#define _CLASS0_SIZE        _ALIGN(CONFIG_GNRC_PKTBUF_SLAB_CLASS0_SIZE)
+#define _CLASS1_SIZE        _ALIGN(CONFIG_GNRC_PKTBUF_SLAB_CLASS1_SIZE)
+#define _CLASS2_SIZE        _ALIGN(CONFIG_GNRC_PKTBUF_SLAB_CLASS2_SIZE)
+#define _CLASS3_SIZE        _ALIGN(CONFIG_GNRC_PKTBUF_SLAB_CLASS3_SIZE)
+#define _SNIP_CLASS         (GNRC_PKTBUF_SLAB_CLASS_NUMOF)
+
+typedef struct _slot {
+    struct _slot *next;
+} _slot_t;
+
+typedef struct {
+    uint8_t *pool;          /**< first slot of the class */
+    uint8_t *refs;          /**< snips referencing each slot (NULL for snips) */
+    _slot_t *free;          /**< free list of the class */
+    gnrc_pktbuf_slab_stats_t stats;
+} _class_t;
+
+static mutex_t _mutex = MUTEX_INIT;
+
+static gnrc_pktsnip_t _snips[CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF];
+static uint8_t _pool0[_CLASS0_SIZE * CONFIG_GNRC_PKTBUF_SLAB_CLASS0_NUMOF]
+    __attribute__((aligned(sizeof(void *))));
+static uint8_t _pool1[_CLASS1_SIZE * CONFIG_GNRC_PKTBUF_SLAB_CLASS1_NUMOF]
+    __attribute__((aligned(sizeof(void *))));
+static uint8_t _pool2[_CLASS2_SIZE * CONFIG_GNRC_PKTBUF_SLAB_CLASS2_NUMOF]
+    __attribute__((aligned(sizeof(void *))));
+static uint8_t _pool3[_CLASS3_SIZE * CONFIG_GNRC_PKTBUF_SLAB_CLASS3_NUMOF]
+    __attribute__((aligned(sizeof(void *))));
+static uint8_t _refs0[CONFIG_GNRC_PKTBUF_SLAB_CLASS0_NUMOF];
+static uint8_t _refs1[CONFIG_GNRC_PKTBUF_SLAB_CLASS1_NUMOF];
+static uint8_t _refs2[CONFIG_GNRC_PKTBUF_SLAB_CLASS2_NUMOF];
+static uint8_t _refs3[CONFIG_GNRC_PKTBUF_SLAB_CLASS3_NUMOF];
+
+static _class_t _classes[GNRC_PKTBUF_SLAB_CLASS_NUMOF + 1] = {
+    { .pool = _pool0, .refs = _refs0,
+      .stats = { .size = _CLASS0_SIZE,
+                 .numof = CONFIG_GNRC_PKTBUF_SLAB_CLASS0_NUMOF } },
+    { .pool = _pool1, .refs = _refs1,
+      .stats = { .size = _CLASS1_SIZE,
+                 .numof = CONFIG_GNRC_PKTBUF_SLAB_CLASS1_NUMOF } },
+    { .pool = _pool2, .refs = _refs2,
+      .stats = { .size = _CLASS2_SIZE,
+                 .numof = CONFIG_GNRC_PKTBUF_SLAB_CLASS2_NUMOF } },
+    { .pool = _pool3, .refs = _refs3,
+      .stats = { .size = _CLASS3_SIZE,
+                 .numof = CONFIG_GNRC_PKTBUF_SLAB_CLASS3_NUMOF } },
+    { .pool = (uint8_t *)_snips, .refs = NULL,
+      .stats = { .size = sizeof(gnrc_pktsnip_t),
+                 .numof = CONFIG_GNRC_PKTBUF_SLAB_SNIP_NUMOF } },
+};
+
+static_assert((_CLASS0_SIZE < _CLASS1_SIZE) && (_CLASS1_SIZE < _CLASS2_SIZE) &&
+              (_CLASS2_SIZE < _CLASS3_SIZE),
+              "size classes must be given in ascending order");
+
+/* internal gnrc_pktbuf functions */
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type);
+static void *_data_alloc(size_t size);
+static void _data_release(void *data);
+
+static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
+                                void *data, size_t size, gnrc_nettype_t type)
+{
+    pkt->next = next;
+    pkt->data = data;
+    pkt->size = size;
+    pkt->type = type;
+    pkt->users = 1;
+#ifdef MODULE_GNRC_NETERR
+    pkt->err_sub = KERNEL_PID_UNDEF;
+#endif
+}
+
+static inline bool _class_contains(const _class_t *c, const void *ptr)
+{
+    return (size_t)((uint8_t *)ptr - c->pool) <
+           ((size_t)c->stats.size * c->stats.numof);
+}
+
+static inline unsigned _slot_idx(const _class_t *c, const void *ptr)
+{
+    return (unsigned)((uint8_t *)ptr - c->pool) / c->stats.size;
+}
+
+static void _class_init(_class_t *c)
+{
+    c->free = NULL;
+    /* build free list backwards, so slots are handed out in ascending order */
+    for (int i = c->stats.numof - 1; i >= 0; i--) {
+        _slot_t *slot = (_slot_t *)&c->pool[i * c->stats.size];
+
+        slot->next = c->free;
+        c->free = slot;
+    }
+    c->stats.used = 0;
+}
+
+static void *_class_alloc(_class_t *c)
+{
+    _slot_t *slot = c->free;
+
+    if (slot == NULL) {
+        c->stats.fails++;
+        return NULL;
+    }
+    c->free = slot->next;
+    c->stats.allocs++;
+    if (++c->stats.used > c->stats.max_used) {
+        c->stats.max_used = c->stats.used;
+    }
+    return slot;
+}
+
+static void _class_free(_class_t *c, void *ptr)
+{
+    _slot_t *slot = (_slot_t *)ptr;
+
+    assert(c->stats.used > 0);
+    slot->next = c->free;
+    c->free = slot;
+    c->stats.used--;
+}
+
+/* returns data class of ptr or NULL if ptr is not in the packet buffer */
+static _class_t *_data_class(const void *ptr)
+{
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_CLASS_NUMOF; i++) {
+        if (_class_contains(&_classes[i], ptr)) {
+            return &_classes[i];
+        }
+    }
+    return NULL;
+}
+
+static inline gnrc_pktsnip_t *_snip_alloc(void)
+{
+    return _class_alloc(&_classes[_SNIP_CLASS]);
+}
+
+static inline void _snip_free(gnrc_pktsnip_t *pkt)
+{
+    assert(_class_contains(&_classes[_SNIP_CLASS], pkt));
+    _class_free(&_classes[_SNIP_CLASS], pkt);
+}
+
+void gnrc_pktbuf_init(void)
+{
+    mutex_lock(&_mutex);
+    for (unsigned i = 0; i <= GNRC_PKTBUF_SLAB_CLASS_NUMOF; i++) {
+        _class_init(&_classes[i]);
+    }
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (size > _CLASS3_SIZE) {
+        DEBUG("pktbuf: size (%u) > largest size class (%u)\n",
+              (unsigned)size, (unsigned)_CLASS3_SIZE);
+        return NULL;
+    }
+    mutex_lock(&_mutex);
+    pkt = _create_snip(next, data, size, type);
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *marked_snip;
+    _class_t *c;
+
+    mutex_lock(&_mutex);
+    if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
+        DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
+              "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
+              (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
+              (pkt ? pkt->data : NULL));
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    /* create new snip descriptor for marked data */
+    marked_snip = _snip_alloc();
+    if (marked_snip == NULL) {
+        DEBUG("pktbuf: could not allocate marked snip.\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    _set_pktsnip(marked_snip, pkt->next, pkt->data, size, type);
+    if (pkt->size == size) {
+        /* marked snip takes over the reference of pkt */
+        pkt->data = NULL;
+    }
+    else {
+        /* both snips reference the same slot now */
+        c = _data_class(pkt->data);
+        if (c != NULL) {
+            unsigned idx = _slot_idx(c, pkt->data);
+
+            assert(c->refs[idx] < UINT8_MAX);
+            c->refs[idx]++;
+        }
+        pkt->data = ((uint8_t *)pkt->data) + size;
+    }
+    pkt->size -= size;
+    pkt->next = marked_snip;
+    mutex_unlock(&_mutex);
+    return marked_snip;
+}
+
+int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    _class_t *c;
+
+    mutex_lock(&_mutex);
+    assert(pkt != NULL);
+    assert(((pkt->size == 0) && (pkt->data == NULL)) ||
+           ((pkt->size > 0) && (pkt->data != NULL) && _data_class(pkt->data)));
+    /* new size and old size are equal */
+    if (size == pkt->size) {
+        /* nothing to do */
+        mutex_unlock(&_mutex);
+        return 0;
+    }
+    /* new size is 0 and data pointer isn't already NULL */
+    if ((size == 0) && (pkt->data != NULL)) {
+        /* set data pointer to NULL */
+        _data_release(pkt->data);
+        pkt->data = NULL;
+    }
+    else if ((pkt->data != NULL) && ((c = _data_class(pkt->data)) != NULL) &&
+             /* can't grow into data of other snips sharing the slot */
+             ((size < pkt->size) || (c->refs[_slot_idx(c, pkt->data)] == 1)) &&
+             /* new size fits into the remainder of the slot */
+             (size <= (size_t)(c->stats.size -
+                               (((uint8_t *)pkt->data - c->pool) % c->stats.size)))) {
+        /* resize in place */
+    }
+    else {
+        void *new_data = _data_alloc(size);
+
+        if (new_data == NULL) {
+            DEBUG("pktbuf: error allocating new data section\n");
+            mutex_unlock(&_mutex);
+            return ENOMEM;
+        }
+        if (pkt->data != NULL) {            /* if old data exist */
+            memcpy(new_data, pkt->data, (pkt->size < size) ? pkt->size : size);
+            _data_release(pkt->data);
+        }
+        pkt->data = new_data;
+    }
+    pkt->size = size;
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
+{
+    mutex_lock(&_mutex);
+    while (pkt) {
+        pkt->users += num;
+        pkt = pkt->next;
+    }
+    mutex_unlock(&_mutex);
+}
+
+static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    while (pkt) {
+        gnrc_pktsnip_t *tmp;
+        assert(pkt->users > 0);
+        tmp = pkt->next;
+        if (pkt->users == 1) {
+            pkt->users = 0; /* not necessary but to be on the safe side */
+            _data_release(pkt->data);
+            _snip_free(pkt);
+        }
+        else {
+            pkt->users--;
+        }
+        DEBUG("pktbuf: report status code %" PRIu32 "\n", err);
+        gnrc_neterr_report(pkt, err);
+        pkt = tmp;
+    }
+}
+
+void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    mutex_lock(&_mutex);
+    _release_error_locked(pkt, err);
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
+{
+    mutex_lock(&_mutex);
+    if (pkt == NULL) {
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (pkt->users > 1) {
+        gnrc_pktsnip_t *new;
+        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
+        if (new != NULL) {
+            pkt->users--;
+        }
+        mutex_unlock(&_mutex);
+        return new;
+    }
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+int gnrc_pktbuf_slab_get_stats(unsigned cls, gnrc_pktbuf_slab_stats_t *stats)
+{
+    if (cls > GNRC_PKTBUF_SLAB_CLASS_NUMOF) {
+        return -ENOENT;
+    }
+    mutex_lock(&_mutex);
+    *stats = _classes[cls].stats;
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+#ifdef DEVELHELP
+void gnrc_pktbuf_stats(void)
+{
+    gnrc_pktbuf_slab_stats_t stats;
+
+    puts("class  size  numof   used    max     allocs      fails");
+    for (unsigned i = 0; i <= GNRC_PKTBUF_SLAB_CLASS_NUMOF; i++) {
+        gnrc_pktbuf_slab_get_stats(i, &stats);
+        if (i == _SNIP_CLASS) {
+            printf(" snip");
+        }
+        else {
+            printf("%5u", i);
+        }
+        printf(" %5u  %5u  %5u  %5u %10" PRIu32 " %10" PRIu32 "\n",
+               stats.size, stats.numof, stats.used, stats.max_used,
+               stats.allocs, stats.fails);
+    }
+}
+#endif
+
+#ifdef TEST_SUITES
+bool gnrc_pktbuf_is_empty(void)
+{
+    for (unsigned i = 0; i <= GNRC_PKTBUF_SLAB_CLASS_NUMOF; i++) {
+        if (_classes[i].stats.used > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool gnrc_pktbuf_is_sane(void)
+{
+    /* Invariants of this implementation:
+     *  - forall classes: length of free list == numof - used
+     *  - forall slot in free list: slot is at a slot boundary of its class
+     */
+    for (unsigned i = 0; i <= GNRC_PKTBUF_SLAB_CLASS_NUMOF; i++) {
+        _class_t *c = &_classes[i];
+        unsigned free = 0;
+
+        for (_slot_t *ptr = c->free; ptr != NULL; ptr = ptr->next) {
+            if (!_class_contains(c, ptr) ||
+                ((((uint8_t *)ptr) - c->pool) % c->stats.size) != 0 ||
+                (++free > c->stats.numof)) {
+                return false;
+            }
+        }
+        if (free != (unsigned)(c->stats.numof - c->stats.used)) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = _snip_alloc();
+    void *_data = NULL;
+
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        return NULL;
+    }
+    if (size > 0) {
+        _data = _data_alloc(size);
+        if (_data == NULL) {
+            DEBUG("pktbuf: error allocating data for new packet snip\n");
+            _snip_free(pkt);
+            return NULL;
+        }
+        if (data != NULL) {
+            memcpy(_data, data, size);
+        }
+    }
+    _set_pktsnip(pkt, next, _data, size, type);
+    return pkt;
+}
+
+static void *_data_alloc(size_t size)
+{
+    /* take smallest class that fits, fall back to larger ones if exhausted */
+    for (unsigned i = 0; i < GNRC_PKTBUF_SLAB_CLASS_NUMOF; i++) {
+        _class_t *c = &_classes[i];
+        uint8_t *data;
+
+        if (size > c->stats.size) {
+            continue;
+        }
+        if ((data = _class_alloc(c)) != NULL) {
+            c->refs[_slot_idx(c, data)] = 1;
+            return data;
+        }
+    }
+    DEBUG("pktbuf: no slot left for %u bytes\n", (unsigned)size);
+    return NULL;
+}
+
+static void _data_release(void *data)
+{
+    _class_t *c;
+
+    if ((data == NULL) || ((c = _data_class(data)) == NULL)) {
+        return;
+    }
+    unsigned idx = _slot_idx(c, data);
+
+    assert(c->refs[idx] > 0);
+    if (--c->refs[idx] == 0) {
+        _class_free(c, &c->pool[idx * c->stats.size]);
+    }
+}
+
+/** @} */
@@ -43,6 +43,10 @@
 #include "net/gnrc/rpl/p2p.h"
 #endif
 
+#ifdef MODULE_GNRC_RPL_SR
+#include "net/gnrc/rpl/sr.h"
+#endif
+
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
@@ -496,6 +500,44 @@ static inline uint32_t _sec_to_ms(uint32_t sec)
     }
 }
 
+#ifdef MODULE_GNRC_RPL_SR
+/* a non-storing mode root keeps the parents of the targets instead of routes */
+static inline bool _is_sr_root(gnrc_rpl_instance_t *inst)
+{
+    return (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE) &&
+           (inst->dodag.node_status == GNRC_RPL_ROOT_NODE);
+}
+
+static void _sr_update(gnrc_rpl_dodag_t *dodag, gnrc_rpl_opt_target_t *target,
+                       gnrc_rpl_opt_transit_t *transit, ipv6_addr_t *src)
+{
+    ipv6_addr_t parent;
+
+    /* the validation ensured that the transit option has a parent address */
+    memcpy(&parent, transit + 1, sizeof(parent));
+    do {
+        DEBUG("RPL: updating parent of %s/%d\n",
+              ipv6_addr_to_str(addr_str, &(target->target), sizeof(addr_str)),
+              target->prefix_length);
+
+        gnrc_rpl_sr_add(&(target->target), &parent,
+                        transit->path_lifetime * dodag->lifetime_unit);
+        if (ipv6_addr_equal(&parent, &dodag->dodag_id)) {
+            /* the children of the root are the first hops of all source
+             * routes, so they keep their FT entry */
+            gnrc_ipv6_nib_ft_del(&(target->target), target->prefix_length);
+            gnrc_ipv6_nib_ft_add(&(target->target), target->prefix_length, src,
+                                 dodag->iface,
+                                 transit->path_lifetime * dodag->lifetime_unit);
+        }
+
+        target = (gnrc_rpl_opt_target_t *) (((uint8_t *) (target)) +
+                 sizeof(gnrc_rpl_opt_t) + target->length);
+    }
+    while (target->type == GNRC_RPL_OPT_TARGET);
+}
+#endif
+
 /** @todo allow target prefixes in target options to be of variable length */
 bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt, uint16_t len,
                     ipv6_addr_t *src, uint32_t *included_opts)
@@ -620,6 +662,13 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                     first_target = target;
                 }
 
+#ifdef MODULE_GNRC_RPL_SR
+                if (_is_sr_root(inst)) {
+                    /* the parent of the target follows in the transit option */
+                    break;
+                }
+#endif
+
                 DEBUG("RPL: adding FT entry %s/%d\n",
                       ipv6_addr_to_str(addr_str, &(target->target), (unsigned)sizeof(addr_str)),
                       target->prefix_length);
@@ -640,6 +689,14 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                     break;
                 }
 
+#ifdef MODULE_GNRC_RPL_SR
+                if (_is_sr_root(inst)) {
+                    _sr_update(dodag, first_target, transit, src);
+                    first_target = NULL;
+                    break;
+                }
+#endif
+
                 do {
                     DEBUG("RPL: updating FT entry %s/%d\n",
                           ipv6_addr_to_str(addr_str, &(first_target->target), sizeof(addr_str)),
@@ -936,11 +993,13 @@ gnrc_pktsnip_t *_dao_target_build(gnrc_pktsnip_t *pkt, ipv6_addr_t *addr, uint8_
     return opt_snip;
 }
 
-gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool external)
+gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool external,
+                                   const ipv6_addr_t *parent)
 {
     gnrc_rpl_opt_transit_t *transit;
     gnrc_pktsnip_t *opt_snip;
-    if ((opt_snip = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_opt_transit_t),
+    size_t parent_len = (parent != NULL) ? sizeof(ipv6_addr_t) : 0;
+    if ((opt_snip = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_opt_transit_t) + parent_len,
                                GNRC_NETTYPE_UNDEF)) == NULL) {
         DEBUG("RPL: Send DAO - no space left in packet buffer\n");
         gnrc_pktbuf_release(pkt);
@@ -949,11 +1008,15 @@ gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool e
     transit = opt_snip->data;
     transit->type = GNRC_RPL_OPT_TRANSIT;
     transit->length = sizeof(transit->e_flags) + sizeof(transit->path_control) +
-                      sizeof(transit->path_sequence) + sizeof(transit->path_lifetime);
+                      sizeof(transit->path_sequence) + sizeof(transit->path_lifetime) +
+                      parent_len;
     transit->e_flags = (external) << GNRC_RPL_OPT_TRANSIT_E_FLAG_SHIFT;
     transit->path_control = 0;
     transit->path_sequence = 0;
     transit->path_lifetime = lifetime;
+    if (parent != NULL) {
+        memcpy(transit + 1, parent, sizeof(ipv6_addr_t));
+    }
     return opt_snip;
 }
 
@@ -984,7 +1047,9 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
             return;
         }
 
-        destination = &(dodag->parents->addr);
+        /* in non-storing mode the DAOs go straight to the root */
+        destination = (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE) ?
+                      &dodag->dodag_id : &(dodag->parents->addr);
     }
 
     gnrc_pktsnip_t *pkt = NULL, *tmp = NULL;
@@ -1002,14 +1067,44 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
     idx = gnrc_netif_ipv6_addr_match(netif, &dodag->dodag_id);
     me = &netif->ipv6.addrs[idx];
 
+    if (inst->mop == GNRC_RPL_MOP_NON_STORING_MODE) {
+        /* announce the preferred parent to the root, see RFC 6550, section 9.7 */
+        ipv6_addr_t parent;
+
+        if (dodag->parents == NULL) {
+            DEBUG("RPL: dodag has no preferred parent\n");
+            return;
+        }
+        if (dodag->parents->rank == GNRC_RPL_ROOT_RANK) {
+            /* the root may use any address as DODAG ID, not only one derived
+             * from its link-local address */
+            parent = dodag->dodag_id;
+        }
+        else {
+            parent = dodag->parents->addr;
+            if (ipv6_addr_is_link_local(&parent)) {
+                /* the root only knows the nodes by their addresses of the
+                 * DODAG prefix */
+                memcpy(&parent, &dodag->dodag_id, sizeof(parent.u64[0]));
+            }
+        }
+        DEBUG("RPL: Send DAO - building transit option with parent %s\n",
+              ipv6_addr_to_str(addr_str, &parent, sizeof(addr_str)));
+        if ((pkt = _dao_transit_build(pkt, lifetime, false, &parent)) == NULL) {
+            DEBUG("RPL: Send DAO - no space left in packet buffer\n");
+            return;
+        }
+    }
+
     /* add external and RPL FT entries */
     /* TODO: nib: dropped support for external transit options for now */
     void *ft_state = NULL;
     gnrc_ipv6_nib_ft_t fte;
-    while(gnrc_ipv6_nib_ft_iter(NULL, dodag->iface, &ft_state, &fte)) {
+    while((inst->mop != GNRC_RPL_MOP_NON_STORING_MODE) &&
+          gnrc_ipv6_nib_ft_iter(NULL, dodag->iface, &ft_state, &fte)) {
         DEBUG("RPL: Send DAO - building transit option\n");
 
-        if ((pkt = _dao_transit_build(pkt, lifetime, false)) == NULL) {
+        if ((pkt = _dao_transit_build(pkt, lifetime, false, NULL)) == NULL) {
             DEBUG("RPL: Send DAO - no space left in packet buffer\n");
             return;
         }
@@ -0,0 +1,342 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "xtimer.h"
+#include "net/ipv6/ext/rh.h"
+#include "net/gnrc/rpl/sr.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if ((GNRC_RPL_SR_BUCKETS_NUMOF - 1) & GNRC_RPL_SR_BUCKETS_NUMOF) != 0
+#error "GNRC_RPL_SR_BUCKETS_NUMOF must be a power of 2"
+#endif
+
+#if GNRC_RPL_SR_NODES_NUMOF >= UINT16_MAX
+#error "GNRC_RPL_SR_NODES_NUMOF is too large"
+#endif
+
+/* node references are indexes + 1 so that a zeroed table is empty */
+#define _NONE           (0U)
+
+static gnrc_rpl_sr_node_t _nodes[GNRC_RPL_SR_NODES_NUMOF];
+static uint16_t _buckets[GNRC_RPL_SR_BUCKETS_NUMOF];
+static uint16_t _alloc_next;
+#if GNRC_RPL_SR_CACHE_NUMOF
+static gnrc_rpl_sr_cache_t _cache[GNRC_RPL_SR_CACHE_NUMOF];
+static ipv6_addr_t _cache_root;
+static uint16_t _cache_next;
+#endif
+/* generation of the topology, cache entries of older generations are stale */
+static uint16_t _gen = 1;
+static mutex_t _mutex = MUTEX_INIT;
+
+static inline gnrc_rpl_sr_node_t *_node(uint16_t ref)
+{
+    return &_nodes[ref - 1];
+}
+
+static uint32_t _now(void)
+{
+    return (uint32_t)(xtimer_now_usec64() / US_PER_SEC);
+}
+
+static unsigned _hash(const ipv6_addr_t *addr)
+{
+    uint32_t hash = addr->u32[0].u32 ^ addr->u32[1].u32 ^ addr->u32[2].u32 ^
+                    addr->u32[3].u32;
+
+    hash ^= hash >> 16;
+    hash ^= hash >> 8;
+    return hash & (GNRC_RPL_SR_BUCKETS_NUMOF - 1);
+}
+
+static void _gen_bump(void)
+{
+    if (++_gen == 0) {
+        /* entries of the previous round of generations must not match */
+        _gen = 1;
+#if GNRC_RPL_SR_CACHE_NUMOF
+        memset(_cache, 0, sizeof(_cache));
+#endif
+    }
+}
+
+static uint16_t _find(const ipv6_addr_t *addr)
+{
+    uint16_t ref = _buckets[_hash(addr)];
+
+    while ((ref != _NONE) && !ipv6_addr_equal(&_node(ref)->addr, addr)) {
+        ref = _node(ref)->next;
+    }
+    return ref;
+}
+
+static void _remove(uint16_t ref)
+{
+    uint16_t *ptr = &_buckets[_hash(&_node(ref)->addr)];
+
+    DEBUG("rpl_sr: removing node %u\n", (unsigned)ref);
+    while (*ptr != ref) {
+        ptr = &_node(*ptr)->next;
+    }
+    *ptr = _node(ref)->next;
+    for (unsigned i = 0; i < GNRC_RPL_SR_NODES_NUMOF; i++) {
+        if (_nodes[i].parent == ref) {
+            _nodes[i].parent = _NONE;
+        }
+    }
+    memset(_node(ref), 0, sizeof(gnrc_rpl_sr_node_t));
+    _gen_bump();
+}
+
+static uint16_t _alloc(const ipv6_addr_t *addr, uint32_t expires, uint32_t now)
+{
+    for (unsigned i = 0; i < GNRC_RPL_SR_NODES_NUMOF; i++) {
+        uint16_t ref = ((_alloc_next + i) % GNRC_RPL_SR_NODES_NUMOF) + 1;
+        gnrc_rpl_sr_node_t *node = _node(ref);
+
+        if ((node->expires != 0) && (node->expires <= now)) {
+            _remove(ref);
+        }
+        if (node->expires == 0) {
+            unsigned bucket = _hash(addr);
+
+            node->addr = *addr;
+            node->expires = expires;
+            node->parent = _NONE;
+            node->next = _buckets[bucket];
+            _buckets[bucket] = ref;
+            _alloc_next = ref % GNRC_RPL_SR_NODES_NUMOF;
+            return ref;
+        }
+    }
+    return _NONE;
+}
+
+int gnrc_rpl_sr_add(const ipv6_addr_t *target, const ipv6_addr_t *parent,
+                    uint32_t lifetime)
+{
+    assert((target != NULL) && (parent != NULL));
+
+    uint32_t now, expires;
+    uint16_t t, p;
+    int res = 0;
+
+    if (ipv6_addr_equal(target, parent)) {
+        return -EINVAL;
+    }
+    if (lifetime == 0) {
+        gnrc_rpl_sr_del(target);
+        return 0;
+    }
+    mutex_lock(&_mutex);
+    now = _now();
+    expires = now + lifetime;
+    if (expires < now) {
+        expires = UINT32_MAX;
+    }
+    if ((t = _find(target)) == _NONE) {
+        t = _alloc(target, expires, now);
+    }
+    else {
+        _node(t)->expires = expires;
+    }
+    /* the parent may not have sent a DAO of its own yet */
+    if ((p = _find(parent)) == _NONE) {
+        p = _alloc(parent, expires, now);
+    }
+    else if (_node(p)->expires < expires) {
+        _node(p)->expires = expires;
+    }
+    if ((t == _NONE) || (p == _NONE)) {
+        DEBUG("rpl_sr: parent table is full\n");
+        res = -ENOMEM;
+    }
+    else if (_node(t)->parent != p) {
+        _node(t)->parent = p;
+        _gen_bump();
+    }
+    mutex_unlock(&_mutex);
+    return res;
+}
+
+void gnrc_rpl_sr_del(const ipv6_addr_t *target)
+{
+    assert(target != NULL);
+
+    uint16_t ref;
+
+    mutex_lock(&_mutex);
+    if ((ref = _find(target)) != _NONE) {
+        _remove(ref);
+    }
+    mutex_unlock(&_mutex);
+}
+
+void gnrc_rpl_sr_reset(void)
+{
+    mutex_lock(&_mutex);
+    memset(_nodes, 0, sizeof(_nodes));
+    memset(_buckets, 0, sizeof(_buckets));
+    _alloc_next = 0;
+    _gen_bump();
+    mutex_unlock(&_mutex);
+}
+
+static unsigned _common_prefix(const ipv6_addr_t *a, const ipv6_addr_t *b,
+                               unsigned max)
+{
+    unsigned i = 0;
+
+    while ((i < max) && (a->u8[i] == b->u8[i])) {
+        i++;
+    }
+    return i;
+}
+
+static int _build(const ipv6_addr_t *root, uint16_t dst, uint32_t now,
+                  ipv6_addr_t *first_hop, gnrc_rpl_srh_t *srh, size_t srh_len,
+                  uint32_t *expires)
+{
+    uint16_t path[GNRC_RPL_SR_HOPS_MAX];
+    unsigned hops = 0, compr, addr_len, size, pad;
+    uint8_t *addr_vec = (uint8_t *)(srh + 1);
+    uint16_t ref = dst;
+
+    /* collects the path from the destination up to the root */
+    *expires = UINT32_MAX;
+    while (!ipv6_addr_equal(&_node(ref)->addr, root)) {
+        gnrc_rpl_sr_node_t *node = _node(ref);
+
+        if (node->expires <= now) {
+            _remove(ref);
+            return -EHOSTUNREACH;
+        }
+        if (hops == GNRC_RPL_SR_HOPS_MAX) {
+            DEBUG("rpl_sr: path to node %u too long or looped\n", (unsigned)dst);
+            return -ELOOP;
+        }
+        if (node->expires < *expires) {
+            *expires = node->expires;
+        }
+        path[hops++] = ref;
+        if ((ref = node->parent) == _NONE) {
+            return -EHOSTUNREACH;
+        }
+    }
+    if (hops == 0) {
+        return -EHOSTUNREACH;
+    }
+    *first_hop = _node(path[hops - 1])->addr;
+    if (hops == 1) {
+        return 0;
+    }
+    /* the addresses are restored from the IPv6 destination of every hop on
+     * the way, so only the prefix common to all of them can be elided */
+    compr = sizeof(ipv6_addr_t) - 1;
+    for (unsigned i = 0; i < (hops - 1); i++) {
+        compr = _common_prefix(first_hop, &_node(path[i])->addr, compr);
+    }
+    addr_len = sizeof(ipv6_addr_t) - compr;
+    size = sizeof(gnrc_rpl_srh_t) + ((hops - 1) * addr_len);
+    pad = (8 - (size & 0x7)) & 0x7;
+    if ((size + pad) > srh_len) {
+        return -ENOBUFS;
+    }
+    memset(srh, 0, sizeof(gnrc_rpl_srh_t));
+    srh->len = (size + pad - 8) / 8;
+    srh->type = IPV6_EXT_RH_TYPE_RPL_SRH;
+    srh->seg_left = hops - 1;
+    srh->compr = (compr << 4) | compr;
+    srh->pad_resv = pad << 4;
+    /* the address vector lists the hops after the first up to the destination */
+    for (unsigned i = hops - 1; i > 0; i--) {
+        memcpy(addr_vec, &_node(path[i - 1])->addr.u8[compr], addr_len);
+        addr_vec += addr_len;
+    }
+    memset(addr_vec, 0, pad);
+    return size + pad;
+}
+
+int gnrc_rpl_sr_build_srh(const ipv6_addr_t *root, const ipv6_addr_t *dst,
+                          ipv6_addr_t *first_hop, gnrc_rpl_srh_t *srh,
+                          size_t srh_len)
+{
+    assert((root != NULL) && (dst != NULL) && (first_hop != NULL));
+    assert((srh != NULL) || (srh_len == 0));
+
+    uint32_t now, expires;
+    uint16_t ref;
+    int res;
+
+    mutex_lock(&_mutex);
+    now = _now();
+    if ((ref = _find(dst)) == _NONE) {
+        mutex_unlock(&_mutex);
+        return -EHOSTUNREACH;
+    }
+#if GNRC_RPL_SR_CACHE_NUMOF
+    gnrc_rpl_sr_cache_t *entry = NULL;
+
+    if (!ipv6_addr_equal(&_cache_root, root)) {
+        _cache_root = *root;
+        _gen_bump();
+    }
+    if (_node(ref)->cache != 0) {
+        entry = &_cache[_node(ref)->cache - 1];
+        if (entry->dst != ref) {
+            /* the entry was handed to another destination */
+            entry = NULL;
+        }
+    }
+    if ((entry != NULL) && (entry->gen == _gen) && (entry->expires > now)) {
+        if (entry->len > srh_len) {
+            res = -ENOBUFS;
+        }
+        else {
+            memcpy(srh, entry->srh, entry->len);
+            *first_hop = entry->first_hop;
+            res = entry->len;
+        }
+        mutex_unlock(&_mutex);
+        return res;
+    }
+#endif
+    res = _build(root, ref, now, first_hop, srh, srh_len, &expires);
+#if GNRC_RPL_SR_CACHE_NUMOF
+    if ((res >= 0) && ((size_t)res <= sizeof(entry->srh))) {
+        if (entry == NULL) {
+            entry = &_cache[_cache_next];
+            _node(ref)->cache = _cache_next + 1;
+            _cache_next = (_cache_next + 1) % GNRC_RPL_SR_CACHE_NUMOF;
+        }
+        entry->expires = expires;
+        entry->gen = _gen;
+        entry->dst = ref;
+        entry->len = res;
+        entry->first_hop = *first_hop;
+        memcpy(entry->srh, srh, res);
+    }
+#endif
+    mutex_unlock(&_mutex);
+    return res;
+}
+
+/** @} */
@@ -34,6 +34,9 @@
 #endif
 #include "net/sock/ip.h"
 #include "net/sock/udp.h"
+#ifdef MODULE_GNRC_SOCK_TCP
+#include "net/gnrc/tcp/tcb.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -114,6 +117,37 @@ struct sock_udp {
     uint16_t flags;                     /**< option flags */
 };
 
+#ifdef MODULE_GNRC_SOCK_TCP
+/**
+ * @brief   TCP sock type
+ * @internal
+ */
+struct sock_tcp {
+    gnrc_tcp_tcb_t tcb;                 /**< TCB of the connection */
+#ifdef SOCK_HAS_ASYNC
+    sock_tcp_cb_t async_cb;             /**< asynchronous upper layer callback */
+#ifdef SOCK_HAS_ASYNC_CTX
+    sock_async_ctx_t async_ctx;         /**< asynchronous event context */
+#endif
+#endif  /* SOCK_HAS_ASYNC */
+};
+
+/**
+ * @brief   TCP queue type
+ * @internal
+ */
+struct sock_tcp_queue {
+    gnrc_tcp_tcb_queue_t tcb_queue;     /**< listening queue of the TCBs */
+    struct _sock_tl_ep local;           /**< local end-point */
+#ifdef SOCK_HAS_ASYNC
+    sock_tcp_queue_cb_t async_cb;       /**< asynchronous upper layer callback */
+#ifdef SOCK_HAS_ASYNC_CTX
+    sock_async_ctx_t async_ctx;         /**< asynchronous event context */
+#endif
+#endif  /* SOCK_HAS_ASYNC */
+};
+#endif  /* MODULE_GNRC_SOCK_TCP */
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,287 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_sock
+ * @{
+ *
+ * @file
+ * @brief       GNRC implementation of @ref net_sock_tcp
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "net/af.h"
+#include "net/gnrc/tcp.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/tcp.h"
+
+#ifdef SOCK_HAS_ASYNC
+#include "net/sock/async.h"
+#endif
+
+/* address, interface separator and interface number */
+#define _ADDR_STR_LEN   (IPV6_ADDR_MAX_STR_LEN + 6)
+
+/**
+ * @brief   Converts an end point to the address string used by GNRC TCP
+ *
+ * @return  0 on success
+ * @return  -EAFNOSUPPORT, if the family of @p ep is not supported
+ */
+static int _ep_to_str(const sock_tcp_ep_t *ep, char *str)
+{
+    const ipv6_addr_t *addr = (const ipv6_addr_t *)&ep->addr.ipv6;
+
+    if (ep->family != AF_INET6) {
+        return -EAFNOSUPPORT;
+    }
+    ipv6_addr_to_str(str, addr, IPV6_ADDR_MAX_STR_LEN);
+    if ((ep->netif != SOCK_ADDR_ANY_NETIF) && ipv6_addr_is_link_local(addr)) {
+        size_t len = strlen(str);
+
+        snprintf(&str[len], _ADDR_STR_LEN - len, "%%%u", (unsigned)ep->netif);
+    }
+    return 0;
+}
+
+static void _sock_init(sock_tcp_t *sock)
+{
+    gnrc_tcp_tcb_init(&sock->tcb);
+#ifdef SOCK_HAS_ASYNC
+    sock->async_cb = NULL;
+#endif
+}
+
+int sock_tcp_connect(sock_tcp_t *sock, const sock_tcp_ep_t *remote,
+                     uint16_t local_port, uint16_t flags)
+{
+    assert(sock != NULL);
+    assert((remote != NULL) && (remote->port != 0));
+
+    char addr[_ADDR_STR_LEN];
+    int res;
+
+    /* GNRC TCP never shares a port between connections */
+    (void)flags;
+    if ((res = _ep_to_str(remote, addr)) < 0) {
+        return res;
+    }
+    _sock_init(sock);
+    return gnrc_tcp_open_active(&sock->tcb, AF_INET6, addr, remote->port, local_port);
+}
+
+int sock_tcp_listen(sock_tcp_queue_t *queue, const sock_tcp_ep_t *local,
+                    sock_tcp_t *queue_array, unsigned queue_len,
+                    uint16_t flags)
+{
+    assert(queue != NULL);
+    assert((local != NULL) && (local->port != 0));
+    assert((queue_array != NULL) && (queue_len != 0));
+
+    char addr[_ADDR_STR_LEN];
+    const char *local_addr = NULL;
+    int res;
+
+    (void)flags;
+    if ((local->family != AF_INET6) && (local->family != AF_UNSPEC)) {
+        return -EAFNOSUPPORT;
+    }
+    /* Bind to an address only if one was given */
+    if (!ipv6_addr_is_unspecified((const ipv6_addr_t *)&local->addr.ipv6)) {
+        if ((res = _ep_to_str(local, addr)) < 0) {
+            return res;
+        }
+        local_addr = addr;
+    }
+    for (unsigned i = 0; i < queue_len; i++) {
+        _sock_init(&queue_array[i]);
+    }
+    queue->local = *local;
+    queue->local.family = AF_INET6;
+#ifdef SOCK_HAS_ASYNC
+    queue->async_cb = NULL;
+#endif
+    return gnrc_tcp_listen_stride(&queue->tcb_queue, &queue_array[0].tcb, queue_len,
+                                  sizeof(sock_tcp_t), AF_INET6, local_addr, local->port);
+}
+
+void sock_tcp_disconnect(sock_tcp_t *sock)
+{
+    assert(sock != NULL);
+
+#ifdef SOCK_HAS_ASYNC
+    /* A sock of a listening queue is reused for the next connection */
+    sock->async_cb = NULL;
+#endif
+    gnrc_tcp_close(&sock->tcb);
+}
+
+void sock_tcp_stop_listen(sock_tcp_queue_t *queue)
+{
+    assert(queue != NULL);
+
+    gnrc_tcp_stop_listen(&queue->tcb_queue);
+}
+
+int sock_tcp_get_local(sock_tcp_t *sock, sock_tcp_ep_t *ep)
+{
+    assert((sock != NULL) && (ep != NULL));
+
+    int res;
+
+    memset(ep, 0, sizeof(*ep));
+    res = gnrc_tcp_get_local(&sock->tcb, (ipv6_addr_t *)&ep->addr.ipv6, &ep->port);
+    if (res == 0) {
+        ep->family = AF_INET6;
+    }
+    return res;
+}
+
+int sock_tcp_get_remote(sock_tcp_t *sock, sock_tcp_ep_t *ep)
+{
+    assert((sock != NULL) && (ep != NULL));
+
+    int8_t ll_iface = 0;
+    int res;
+
+    memset(ep, 0, sizeof(*ep));
+    res = gnrc_tcp_get_remote(&sock->tcb, (ipv6_addr_t *)&ep->addr.ipv6, &ep->port,
+                              &ll_iface);
+    if (res == 0) {
+        ep->family = AF_INET6;
+        ep->netif = (ll_iface > 0) ? (uint16_t)ll_iface : SOCK_ADDR_ANY_NETIF;
+    }
+    return res;
+}
+
+int sock_tcp_queue_get_local(sock_tcp_queue_t *queue, sock_tcp_ep_t *ep)
+{
+    assert((queue != NULL) && (ep != NULL));
+
+    if (queue->tcb_queue.tcbs == NULL) {
+        return -EADDRNOTAVAIL;
+    }
+    *ep = queue->local;
+    return 0;
+}
+
+int sock_tcp_accept(sock_tcp_queue_t *queue, sock_tcp_t **sock,
+                    uint32_t timeout)
+{
+    assert((queue != NULL) && (sock != NULL));
+
+    gnrc_tcp_tcb_t *tcb;
+    int res;
+
+    if (queue->tcb_queue.tcbs == NULL) {
+        return -EINVAL;
+    }
+    /* GNRC TCP has no notion of an infinite timeout: wait in rounds */
+    do {
+        res = gnrc_tcp_accept(&queue->tcb_queue, &tcb, timeout);
+    } while ((res == -ETIMEDOUT) && (timeout == SOCK_NO_TIMEOUT));
+
+    if (res == 0) {
+        *sock = container_of(tcb, sock_tcp_t, tcb);
+#ifdef SOCK_HAS_ASYNC
+        (*sock)->async_cb = NULL;
+#endif
+    }
+    return res;
+}
+
+ssize_t sock_tcp_read(sock_tcp_t *sock, void *data, size_t max_len,
+                      uint32_t timeout)
+{
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+
+    ssize_t res;
+
+    do {
+        res = gnrc_tcp_recv(&sock->tcb, data, max_len, timeout);
+    } while ((res == -ETIMEDOUT) && (timeout == SOCK_NO_TIMEOUT));
+    return res;
+}
+
+ssize_t sock_tcp_write(sock_tcp_t *sock, const void *data, size_t len)
+{
+    assert(sock != NULL);
+    assert((len == 0) || (data != NULL));
+
+    const uint8_t *ptr = data;
+    size_t sent = 0;
+
+    /* gnrc_tcp_send() transmits one segment at a time */
+    while (sent < len) {
+        ssize_t res = gnrc_tcp_send(&sock->tcb, &ptr[sent], len - sent, 0);
+
+        if (res <= 0) {
+            return (sent > 0) ? (ssize_t)sent : ((res < 0) ? res : -ENOTCONN);
+        }
+        sent += res;
+    }
+    return sent;
+}
+
+#ifdef SOCK_HAS_ASYNC
+static void _tcb_cb(gnrc_tcp_tcb_t *tcb, gnrc_tcp_event_t events, void *arg)
+{
+    sock_tcp_t *sock = arg;
+    sock_tcp_cb_t cb = sock->async_cb;
+
+    (void)tcb;
+    if (cb != NULL) {
+        /* gnrc_tcp_event_t uses the values of sock_async_flags_t */
+        cb(sock, (sock_async_flags_t)events);
+    }
+}
+
+static void _tcb_queue_cb(gnrc_tcp_tcb_queue_t *tcb_queue, gnrc_tcp_event_t events,
+                          void *arg)
+{
+    sock_tcp_queue_t *queue = arg;
+    sock_tcp_queue_cb_t cb = queue->async_cb;
+
+    (void)tcb_queue;
+    if (cb != NULL) {
+        cb(queue, (sock_async_flags_t)events);
+    }
+}
+
+void sock_tcp_set_cb(sock_tcp_t *sock, sock_tcp_cb_t cb)
+{
+    sock->async_cb = cb;
+    gnrc_tcp_tcb_set_cb(&sock->tcb, (cb != NULL) ? _tcb_cb : NULL, sock);
+}
+
+void sock_tcp_queue_set_cb(sock_tcp_queue_t *queue, sock_tcp_queue_cb_t cb)
+{
+    queue->async_cb = cb;
+    gnrc_tcp_tcb_queue_set_cb(&queue->tcb_queue, (cb != NULL) ? _tcb_queue_cb : NULL,
+                              queue);
+}
+
+#ifdef SOCK_HAS_ASYNC_CTX
+sock_async_ctx_t *sock_tcp_get_async_ctx(sock_tcp_t *sock)
+{
+    return &sock->async_ctx;
+}
+
+sock_async_ctx_t *sock_tcp_queue_get_async_ctx(sock_tcp_queue_t *queue)
+{
+    return &queue->async_ctx;
+}
+#endif  /* SOCK_HAS_ASYNC_CTX */
+#endif  /* SOCK_HAS_ASYNC */
+
+/** @} */
@@ -175,15 +175,20 @@ int sock_udp_get_remote(sock_udp_t *sock, sock_udp_ep_t *remote)
     return 0;
 }
 
-ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
-                      uint32_t timeout, sock_udp_ep_t *remote)
+/**
+ * @brief   Receives a datagram into the packet buffer and checks its origin
+ *
+ * @return  0 on success, @p pkt_out holds the payload snip of the datagram
+ * @return  a negative errno as sock_udp_recv() otherwise
+ */
+static int _recv(sock_udp_t *sock, gnrc_pktsnip_t **pkt_out, uint32_t timeout,
+                 sock_udp_ep_t *remote)
 {
     gnrc_pktsnip_t *pkt, *udp;
     udp_hdr_t *hdr;
     sock_ip_ep_t tmp;
     int res;
 
-    assert((sock != NULL) && (data != NULL) && (max_len > 0));
     if (sock->local.family == AF_UNSPEC) {
         return -EADDRNOTAVAIL;
     }
@@ -192,10 +197,6 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
     if (res < 0) {
         return res;
     }
-    if (pkt->size > max_len) {
-        gnrc_pktbuf_release(pkt);
-        return -ENOBUFS;
-    }
     udp = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_UDP);
     assert(udp);
     hdr = udp->data;
@@ -214,12 +215,96 @@ ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
         gnrc_pktbuf_release(pkt);
         return -EPROTO;
     }
-    memcpy(data, pkt->data, pkt->size);
-    res = (int)pkt->size;
+    *pkt_out = pkt;
+    return 0;
+}
+
+/**
+ * @brief   Copies the payload of a received datagram and releases it
+ */
+static ssize_t _copy_payload(gnrc_pktsnip_t *pkt, void *data, size_t max_len)
+{
+    ssize_t res = -ENOBUFS;
+
+    if (pkt->size <= max_len) {
+        memcpy(data, pkt->data, pkt->size);
+        res = (ssize_t)pkt->size;
+    }
     gnrc_pktbuf_release(pkt);
     return res;
 }
 
+ssize_t sock_udp_recv(sock_udp_t *sock, void *data, size_t max_len,
+                      uint32_t timeout, sock_udp_ep_t *remote)
+{
+    gnrc_pktsnip_t *pkt;
+    int res;
+
+    assert((sock != NULL) && (data != NULL) && (max_len > 0));
+    res = _recv(sock, &pkt, timeout, remote);
+    if (res < 0) {
+        return res;
+    }
+    return _copy_payload(pkt, data, max_len);
+}
+
+#ifdef MODULE_SOCK_UDP_BATCH
+ssize_t sock_udp_recv_buf(sock_udp_t *sock, void **data, void **buf_ctx,
+                          uint32_t timeout, sock_udp_ep_t *remote)
+{
+    gnrc_pktsnip_t *pkt;
+    int res;
+
+    assert((sock != NULL) && (data != NULL) && (buf_ctx != NULL));
+    /* second call: hand the datagram back to the packet buffer */
+    if (*buf_ctx != NULL) {
+        *data = NULL;
+        gnrc_pktbuf_release(*buf_ctx);
+        *buf_ctx = NULL;
+        return 0;
+    }
+    res = _recv(sock, &pkt, timeout, remote);
+    if (res < 0) {
+        return res;
+    }
+    *data = pkt->data;
+    *buf_ctx = pkt;
+    return (ssize_t)pkt->size;
+}
+
+int sock_udp_recv_batch(sock_udp_t *sock, sock_udp_msg_t *msgs,
+                        unsigned msgs_len, uint32_t timeout)
+{
+    unsigned received = 0;
+
+    assert((sock != NULL) && (msgs != NULL) && (msgs_len > 0));
+    /* only wait for the first datagram, take what is queued after it */
+    while (received < msgs_len) {
+        sock_udp_msg_t *msg = &msgs[received];
+        gnrc_pktsnip_t *pkt;
+        ssize_t res;
+
+        assert((msg->data != NULL) && (msg->len > 0));
+        res = _recv(sock, &pkt, (received == 0) ? timeout : 0, msg->remote);
+        if (res == 0) {
+            res = _copy_payload(pkt, msg->data, msg->len);
+        }
+        if (res >= 0) {
+            msg->len = res;
+            received++;
+        }
+        else if (received == 0) {
+            return res;
+        }
+        /* datagrams that don't fit or come from the wrong remote are dropped */
+        else if ((res != -ENOBUFS) && (res != -EPROTO)) {
+            break;
+        }
+    }
+    return received;
+}
+#endif  /* MODULE_SOCK_UDP_BATCH */
+
 ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
                       const sock_udp_ep_t *remote)
 {
@@ -325,6 +410,25 @@ ssize_t sock_udp_send(sock_udp_t *sock, const void *data, size_t len,
     return res;
 }
 
+#ifdef MODULE_SOCK_UDP_BATCH
+int sock_udp_send_batch(sock_udp_t *sock, const sock_udp_msg_t *msgs,
+                        unsigned msgs_len)
+{
+    unsigned sent = 0;
+
+    assert(msgs != NULL);
+    for (; sent < msgs_len; sent++) {
+        ssize_t res = sock_udp_send(sock, msgs[sent].data, msgs[sent].len,
+                                    msgs[sent].remote);
+
+        if (res < 0) {
+            return (sent == 0) ? res : (int)sent;
+        }
+    }
+    return sent;
+}
+#endif  /* MODULE_SOCK_UDP_BATCH */
+
 #ifdef SOCK_HAS_ASYNC
 void sock_udp_set_cb(sock_udp_t *sock, sock_udp_cb_t cb)
 {
@@ -98,6 +98,74 @@ static void _setup_timeout(xtimer_t *timer, const uint32_t duration, const xtime
     xtimer_set(timer, duration);
 }
 
+/**
+ * @brief Puts a closed TCB of a listening queue back into LISTEN state.
+ *
+ * @note Must be called with the TCBs function_lock held.
+ *
+ * @param[in,out] tcb   TCB to reuse for the next incoming connection.
+ */
+static void _relisten(gnrc_tcp_tcb_t *tcb)
+{
+    mutex_lock(&(tcb->fsm_lock));
+    tcb->status &= ~STATUS_ACCEPTED;
+    tcb->cb = NULL;
+    tcb->cb_arg = NULL;
+    mutex_unlock(&(tcb->fsm_lock));
+
+    /* If no receive buffer is free, gnrc_tcp_accept() tries again later */
+    _fsm(tcb, FSM_EVENT_CALL_OPEN, NULL, NULL, 0);
+}
+
+/**
+ * @brief Gets a TCB of a listening queue.
+ *
+ * @param[in] queue   Listening queue.
+ * @param[in] i       Index of the TCB.
+ *
+ * @returns   Pointer to the TCB.
+ */
+static inline gnrc_tcp_tcb_t *_queue_tcb(const gnrc_tcp_tcb_queue_t *queue, size_t i)
+{
+    return (gnrc_tcp_tcb_t *)((uint8_t *)queue->tcbs + (i * queue->tcbs_stride));
+}
+
+/**
+ * @brief Searches a listening queue for an established connection that was not accepted yet.
+ *
+ * @note Must be called with the queue locked.
+ *
+ * @param[in,out] queue   Queue to search.
+ *
+ * @returns   TCB of the connection, which is marked as accepted.
+ *            NULL if there is no such connection.
+ */
+static gnrc_tcp_tcb_t *_accept_one(gnrc_tcp_tcb_queue_t *queue)
+{
+    for (size_t i = 0; i < queue->tcbs_len; ++i) {
+        gnrc_tcp_tcb_t *tcb = _queue_tcb(queue, i);
+
+        if (tcb->queue != queue || (tcb->status & STATUS_ACCEPTED)) {
+            continue;
+        }
+        /* Connection was reset before it was accepted: Listen again */
+        if (tcb->state == FSM_STATE_CLOSED) {
+            mutex_lock(&(tcb->function_lock));
+            if (tcb->state == FSM_STATE_CLOSED && !(tcb->status & STATUS_ACCEPTED)) {
+                _fsm(tcb, FSM_EVENT_CALL_OPEN, NULL, NULL, 0);
+            }
+            mutex_unlock(&(tcb->function_lock));
+        }
+        else if (tcb->state == FSM_STATE_ESTABLISHED || tcb->state == FSM_STATE_CLOSE_WAIT) {
+            mutex_lock(&(tcb->fsm_lock));
+            tcb->status |= STATUS_ACCEPTED;
+            mutex_unlock(&(tcb->fsm_lock));
+            return tcb;
+        }
+    }
+    return NULL;
+}
+
 /**
  * @brief   Establishes a new TCP connection
  *
@@ -284,6 +352,36 @@ void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb)
     mutex_init(&(tcb->function_lock));
 }
 
+int gnrc_tcp_tcb_set_rcv_buf(gnrc_tcp_tcb_t *tcb, void *buf, size_t size)
+{
+    assert(tcb != NULL);
+    assert(buf != NULL);
+
+    if (size == 0) {
+        return -EINVAL;
+    }
+
+    mutex_lock(&(tcb->function_lock));
+    if (tcb->state != FSM_STATE_CLOSED) {
+        mutex_unlock(&(tcb->function_lock));
+        return -EISCONN;
+    }
+    tcb->rcv_buf_user = buf;
+    tcb->rcv_buf_user_size = size;
+    mutex_unlock(&(tcb->function_lock));
+    return 0;
+}
+
+void gnrc_tcp_tcb_set_cb(gnrc_tcp_tcb_t *tcb, gnrc_tcp_tcb_cb_t cb, void *arg)
+{
+    assert(tcb != NULL);
+
+    mutex_lock(&(tcb->fsm_lock));
+    tcb->cb = cb;
+    tcb->cb_arg = arg;
+    mutex_unlock(&(tcb->fsm_lock));
+}
+
 int gnrc_tcp_open_active(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
                          char *target_addr, uint16_t target_port,
                          uint16_t local_port)
@@ -333,6 +431,170 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, uint8_t address_family,
     return _gnrc_tcp_open(tcb, NULL, 0, local_addr, local_port, 1);
 }
 
+int gnrc_tcp_listen_stride(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t *tcbs, size_t tcbs_len,
+                           size_t tcbs_stride, uint8_t address_family, const char *local_addr,
+                           uint16_t local_port)
+{
+    assert(queue != NULL);
+    assert(tcbs != NULL);
+    assert(tcbs_len > 0);
+    assert(tcbs_stride >= sizeof(gnrc_tcp_tcb_t));
+    assert(local_port != PORT_UNSPEC);
+
+    int ret = 0;
+#ifdef MODULE_GNRC_IPV6
+    ipv6_addr_t addr = IPV6_ADDR_UNSPECIFIED;
+
+    /* Check AF-Family support and parse local address if it was supplied */
+    if (local_addr != NULL) {
+        if (address_family != AF_INET6) {
+            return -EAFNOSUPPORT;
+        }
+        if (ipv6_addr_from_str(&addr, local_addr) == NULL) {
+            DEBUG("gnrc_tcp.c : gnrc_tcp_listen_stride() : Invalid local addr\n");
+            return -EINVAL;
+        }
+    }
+#else
+    if (local_addr != NULL) {
+        return -EAFNOSUPPORT;
+    }
+#endif
+
+    /* Setup queue */
+    mutex_init(&(queue->lock));
+    queue->tcbs = tcbs;
+    queue->tcbs_len = tcbs_len;
+    queue->tcbs_stride = tcbs_stride;
+    queue->cb = NULL;
+    queue->cb_arg = NULL;
+    mbox_init(&(queue->mbox), queue->mbox_raw, GNRC_TCP_TCB_MBOX_SIZE);
+
+    /* Let each TCB listen. Connections are established without blocking anyone */
+    for (size_t i = 0; i < tcbs_len && ret == 0; ++i) {
+        gnrc_tcp_tcb_t *tcb = _queue_tcb(queue, i);
+
+        mutex_lock(&(tcb->function_lock));
+        if (tcb->state != FSM_STATE_CLOSED) {
+            ret = -EISCONN;
+        }
+        else if (local_addr != NULL && tcb->address_family != address_family) {
+            ret = -EINVAL;
+        }
+        else {
+            tcb->status |= STATUS_PASSIVE;
+            tcb->status &= ~STATUS_ACCEPTED;
+            if (local_addr == NULL) {
+                tcb->status |= STATUS_ALLOW_ANY_ADDR;
+            }
+#ifdef MODULE_GNRC_IPV6
+            else {
+                memcpy(tcb->local_addr, &addr, sizeof(addr));
+            }
+#endif
+            tcb->local_port = local_port;
+            tcb->queue = queue;
+            ret = _fsm(tcb, FSM_EVENT_CALL_OPEN, NULL, NULL, 0);
+        }
+        mutex_unlock(&(tcb->function_lock));
+    }
+
+    /* Release all TCBs if one of them could not listen */
+    if (ret < 0) {
+        DEBUG("gnrc_tcp.c : gnrc_tcp_listen_stride() : Can't listen on all TCBs: %d\n", ret);
+        gnrc_tcp_stop_listen(queue);
+    }
+    return (ret < 0) ? ret : 0;
+}
+
+int gnrc_tcp_accept(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_t **tcb,
+                    const uint32_t user_timeout_duration_us)
+{
+    assert(queue != NULL);
+    assert(tcb != NULL);
+
+    msg_t msg;
+    xtimer_t user_timeout;
+    cb_arg_t user_timeout_arg = {MSG_TYPE_USER_SPEC_TIMEOUT, &(queue->mbox)};
+    int ret = -EAGAIN;
+
+    /* Lock the queue for this function call */
+    mutex_lock(&(queue->lock));
+
+    /* 'Flush' mbox: Connections established from here on are announced */
+    while (mbox_try_get(&(queue->mbox), &msg) != 0) {
+    }
+
+    /* Setup user specified timeout if timeout_us is greater than zero */
+    if (user_timeout_duration_us > 0) {
+        _setup_timeout(&user_timeout, user_timeout_duration_us, _cb_mbox_put_msg,
+                       &user_timeout_arg);
+    }
+
+    /* Wait until a connection was established, non-blocking calls return directly */
+    while ((*tcb = _accept_one(queue)) == NULL) {
+        if (user_timeout_duration_us == 0) {
+            break;
+        }
+        mbox_get(&(queue->mbox), &msg);
+        if (msg.type == MSG_TYPE_USER_SPEC_TIMEOUT) {
+            DEBUG("gnrc_tcp.c : gnrc_tcp_accept() : USER_SPEC_TIMEOUT\n");
+            ret = -ETIMEDOUT;
+            break;
+        }
+    }
+    if (*tcb != NULL) {
+        ret = 0;
+    }
+
+    /* Cleanup */
+    if (user_timeout_duration_us > 0) {
+        xtimer_remove(&user_timeout);
+    }
+    mutex_unlock(&(queue->lock));
+    return ret;
+}
+
+void gnrc_tcp_tcb_queue_set_cb(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_tcb_queue_cb_t cb,
+                               void *arg)
+{
+    assert(queue != NULL);
+
+    /* Keep the TCP thread from seeing half of the update */
+    for (size_t i = 0; i < queue->tcbs_len; ++i) {
+        mutex_lock(&(_queue_tcb(queue, i)->fsm_lock));
+    }
+    queue->cb = cb;
+    queue->cb_arg = arg;
+    for (size_t i = 0; i < queue->tcbs_len; ++i) {
+        mutex_unlock(&(_queue_tcb(queue, i)->fsm_lock));
+    }
+}
+
+void gnrc_tcp_stop_listen(gnrc_tcp_tcb_queue_t *queue)
+{
+    assert(queue != NULL);
+
+    mutex_lock(&(queue->lock));
+    for (size_t i = 0; i < queue->tcbs_len; ++i) {
+        gnrc_tcp_tcb_t *tcb = _queue_tcb(queue, i);
+
+        if (tcb->queue != queue) {
+            continue;
+        }
+        /* Detach TCB: Accepted connections stay with their user, all others are aborted */
+        mutex_lock(&(tcb->fsm_lock));
+        tcb->queue = NULL;
+        mutex_unlock(&(tcb->fsm_lock));
+        if (!(tcb->status & STATUS_ACCEPTED)) {
+            gnrc_tcp_abort(tcb);
+        }
+    }
+    queue->tcbs = NULL;
+    queue->tcbs_len = 0;
+    mutex_unlock(&(queue->lock));
+}
+
 ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
                       const uint32_t timeout_duration_us)
 {
@@ -458,6 +720,31 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
     return ret;
 }
 
+ssize_t gnrc_tcp_try_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len)
+{
+    assert(tcb != NULL);
+    assert(data != NULL);
+
+    ssize_t ret = 0;
+
+    /* Lock the TCB for this function call */
+    mutex_lock(&(tcb->function_lock));
+
+    /* Check if connection is in a valid state */
+    if (tcb->state != FSM_STATE_ESTABLISHED && tcb->state != FSM_STATE_CLOSE_WAIT) {
+        mutex_unlock(&(tcb->function_lock));
+        return -ENOTCONN;
+    }
+
+    /* Hand over one segment, if the previous one was acknowledged and the window is open */
+    ret = _fsm(tcb, FSM_EVENT_CALL_SEND, NULL, (void *) data, len);
+    if (ret == 0) {
+        ret = -EAGAIN;
+    }
+    mutex_unlock(&(tcb->function_lock));
+    return ret;
+}
+
 ssize_t gnrc_tcp_recv(gnrc_tcp_tcb_t *tcb, void *data, const size_t max_len,
                       const uint32_t timeout_duration_us)
 {
@@ -576,6 +863,9 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
 
     /* Return if connection is closed */
     if (tcb->state == FSM_STATE_CLOSED) {
+        if (tcb->queue != NULL) {
+            _relisten(tcb);
+        }
         mutex_unlock(&(tcb->function_lock));
         return;
     }
@@ -615,6 +905,11 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb)
     /* Cleanup */
     xtimer_remove(&connection_timeout);
     tcb->status &= ~STATUS_WAIT_FOR_MSG;
+
+    /* TCB belongs to a listening queue: Wait for the next connection */
+    if (tcb->queue != NULL) {
+        _relisten(tcb);
+    }
     mutex_unlock(&(tcb->function_lock));
 }
 
@@ -628,9 +923,62 @@ void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb)
         /* Call FSM ABORT event */
         _fsm(tcb, FSM_EVENT_CALL_ABORT, NULL, NULL, 0);
     }
+
+    /* TCB belongs to a listening queue: Wait for the next connection */
+    if (tcb->queue != NULL) {
+        _relisten(tcb);
+    }
     mutex_unlock(&(tcb->function_lock));
 }
 
+#ifdef MODULE_GNRC_IPV6
+int gnrc_tcp_get_local(gnrc_tcp_tcb_t *tcb, ipv6_addr_t *addr, uint16_t *port)
+{
+    assert(tcb != NULL);
+    assert(addr != NULL);
+    assert(port != NULL);
+
+    int ret = 0;
+
+    mutex_lock(&(tcb->fsm_lock));
+    if (tcb->state == FSM_STATE_CLOSED) {
+        ret = -EADDRNOTAVAIL;
+    }
+    else {
+        memcpy(addr, tcb->local_addr, sizeof(ipv6_addr_t));
+        *port = tcb->local_port;
+    }
+    mutex_unlock(&(tcb->fsm_lock));
+    return ret;
+}
+
+int gnrc_tcp_get_remote(gnrc_tcp_tcb_t *tcb, ipv6_addr_t *addr, uint16_t *port,
+                        int8_t *ll_iface)
+{
+    assert(tcb != NULL);
+    assert(addr != NULL);
+    assert(port != NULL);
+
+    int ret = 0;
+
+    mutex_lock(&(tcb->fsm_lock));
+    /* The peer is unknown until the handshake made progress */
+    if (tcb->state == FSM_STATE_CLOSED || tcb->state == FSM_STATE_LISTEN ||
+        tcb->state == FSM_STATE_SYN_SENT) {
+        ret = -ENOTCONN;
+    }
+    else {
+        memcpy(addr, tcb->peer_addr, sizeof(ipv6_addr_t));
+        *port = tcb->peer_port;
+        if (ll_iface != NULL) {
+            *ll_iface = tcb->ll_iface;
+        }
+    }
+    mutex_unlock(&(tcb->fsm_lock));
+    return ret;
+}
+#endif
+
 int gnrc_tcp_calc_csum(const gnrc_pktsnip_t *hdr, const gnrc_pktsnip_t *pseudo_hdr)
 {
     uint16_t csum;
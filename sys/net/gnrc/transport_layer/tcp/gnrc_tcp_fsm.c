@@ -107,6 +107,27 @@ static int _restart_timewait_timer(gnrc_tcp_tcb_t *tcb)
     return 0;
 }
 
+/**
+ * @brief Resets the receive state of a connection that is about to be opened.
+ *
+ * @pre The receive buffer must have been assigned.
+ *
+ * @param[in,out] tcb   TCB holding the receive state.
+ */
+static void _reset_rcv_state(gnrc_tcp_tcb_t *tcb)
+{
+    /* Open the window to the whole receive buffer. Use the smallest shift that
+     * allows to announce it, until the peer turns window scaling down. */
+    tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
+    tcb->rcv_wnd_scale = 0;
+    while ((tcb->rcv_wnd >> tcb->rcv_wnd_scale) > UINT16_MAX &&
+           tcb->rcv_wnd_scale < TCP_OPTION_WND_SCALE_MAX) {
+        tcb->rcv_wnd_scale += 1;
+    }
+    tcb->rcv_sack_num = 0;
+    tcb->dup_acks = 0;
+}
+
 /**
  * @brief Transition from current FSM state into another state.
  *
@@ -152,6 +173,7 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
                 return -ENOMEM;
             }
+            _reset_rcv_state(tcb);
 
             /* Add connection to active connections (if not already active) */
             mutex_lock(&_list_tcb_lock);
@@ -167,6 +189,7 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
                 return -ENOMEM;
             }
+            _reset_rcv_state(tcb);
 
             /* Add connection to active connections (if not already active) */
             mutex_lock(&_list_tcb_lock);
@@ -222,7 +245,6 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
     int ret = 0;
 
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_open()\n");
-    tcb->rcv_wnd = GNRC_TCP_DEFAULT_WINDOW;
 
     if (tcb->status & STATUS_PASSIVE) {
         /* Passive open, T: CLOSED -> LISTEN */
@@ -421,6 +443,11 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
     seg_ack = byteorder_ntohl(tcp_hdr->ack_num);
     seg_wnd = byteorder_ntohs(tcp_hdr->window);
 
+    /* Window field in SYN segments is never scaled (see RFC 7323) */
+    if (!(ctl & MSK_SYN)) {
+        seg_wnd <<= tcb->snd_wnd_scale;
+    }
+
     /* Extract network layer header */
 #ifdef MODULE_GNRC_IPV6
     LL_SEARCH_SCALAR(in_pkt, snp, type, GNRC_NETTYPE_IPV6);
@@ -507,6 +534,11 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             tcb->snd_nxt = tcb->iss;
             tcb->snd_wnd = seg_wnd;
 
+            /* Window scaling applies only if both sides offered it */
+            if (!(tcb->status & STATUS_WND_SCALE)) {
+                tcb->rcv_wnd_scale = 0;
+            }
+
             /* Send SYN+ACK: seq_no = iss, ack_no = rcv_nxt, T: LISTEN -> SYN_RCVD */
             _pkt_build(tcb, &out_pkt, &seq_con, MSK_SYN_ACK, tcb->iss, tcb->rcv_nxt, NULL, 0);
             _pkt_setup_retransmit(tcb, out_pkt, false);
@@ -541,6 +573,11 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
         if (ctl & MSK_SYN) {
             tcb->rcv_nxt = seg_seq + 1;
             tcb->irs = seg_seq;
+
+            /* Window scaling applies only if both sides offered it */
+            if (!(tcb->status & STATUS_WND_SCALE)) {
+                tcb->rcv_wnd_scale = 0;
+            }
             if (ctl & MSK_ACK) {
                 tcb->snd_una = seg_ack;
                 _pkt_acknowledge(tcb, seg_ack);
@@ -633,6 +670,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 /* Acknowledge previously sent data */
                 if (LSS_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
                     tcb->snd_una = seg_ack;
+                    tcb->dup_acks = 0;
                     _pkt_acknowledge(tcb, seg_ack);
                 }
                 /* ACK received for something not yet sent: Reply with pure ACK */
@@ -642,6 +680,17 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                     _pkt_send(tcb, out_pkt, seq_con, false);
                     return 0;
                 }
+                /* Duplicate ACK for outstanding data: the peer received something behind
+                 * a lost segment. Retransmit without waiting for the timer (RFC 5681) */
+                else if (seg_ack == tcb->snd_una && pay_len == 0 && !(ctl & MSK_FIN) &&
+                         seg_wnd == tcb->snd_wnd && tcb->pkt_retransmit != NULL) {
+                    tcb->dup_acks += 1;
+                    if (tcb->dup_acks == GNRC_TCP_DUPACK_THRESHOLD) {
+                        DEBUG("gnrc_tcp_fsm.c : _fsm_rcvd_pkt() : Fast retransmit\n");
+                        gnrc_pktbuf_hold(tcb->pkt_retransmit, 1);
+                        _pkt_send(tcb, tcb->pkt_retransmit, 0, true);
+                    }
+                }
                 /* Update receive window */
                 if (LEQ_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
                     if (LSS_32_BIT(tcb->snd_wl1, seg_seq) || (tcb->snd_wl1 == seg_seq &&
@@ -693,19 +742,16 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 /* Search for begin of payload */
                 LL_SEARCH_SCALAR(in_pkt, snp, type, GNRC_NETTYPE_UNDEF);
 
-                /* Accept only data that is expected, to be received */
-                if (tcb->rcv_nxt == seg_seq) {
-                    /* Copy contents into receive buffer */
-                    while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
-                        tcb->rcv_nxt += ringbuffer_add(&(tcb->rcv_buf), snp->data, snp->size);
-                        snp = snp->next;
-                    }
+                /* Copy contents into receive buffer, data behind a gap is held back */
+                if (_rcvbuf_add_segment(tcb, seg_seq, snp) > 0) {
                     /* Shrink receive window */
                     tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
                     /* Notify owner because new data is available */
                     tcb->status |= STATUS_NOTIFY_USER;
                 }
-                /* Send ACK, if FIN processing sends ACK already */
+                /* Send ACK, if FIN processing sends ACK already. Out-of-order data is
+                 * acknowledged immediately as well: the duplicate ACK (with SACK blocks)
+                 * allows the peer to retransmit the missing data fast. */
                 /* NOTE: this is the place to add payload piggybagging in the future */
                 if (!(ctl & MSK_FIN)) {
                     _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt,
@@ -720,6 +766,13 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 tcb->state == FSM_STATE_SYN_SENT) {
                 return 0;
             }
+            /* Process FIN only after all data in front of it was received */
+            if (tcb->rcv_nxt != seg_seq + pay_len) {
+                _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt,
+                           NULL, 0);
+                _pkt_send(tcb, out_pkt, seq_con, false);
+                return 0;
+            }
             /* Advance rcv_nxt over FIN bit */
             tcb->rcv_nxt = seg_seq + seg_len;
             _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt, NULL, 0);
@@ -771,6 +824,17 @@ static int _fsm_timeout_timewait(gnrc_tcp_tcb_t *tcb)
 static int _fsm_timeout_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit()\n");
+
+    /* Nobody waits for a half-open connection of a listening queue: give up on it */
+    if (tcb->state == FSM_STATE_SYN_RCVD && tcb->queue != NULL &&
+        tcb->retries >= SYN_RCVD_RETRIES_MAX) {
+        DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit() : SYN_RCVD timed out\n");
+        _clear_retransmit(tcb);
+        if (_transition_to(tcb, FSM_STATE_LISTEN) == -ENOMEM) {
+            _transition_to(tcb, FSM_STATE_CLOSED);
+        }
+        return 0;
+    }
     if (tcb->pkt_retransmit != NULL) {
         _pkt_setup_retransmit(tcb, tcb->pkt_retransmit, true);
         _pkt_send(tcb, tcb->pkt_retransmit, 0, true);
@@ -887,11 +951,74 @@ static int _fsm_unprotected(gnrc_tcp_tcb_t *tcb, fsm_event_t event, gnrc_pktsnip
     return ret;
 }
 
+/**
+ * @brief Determines the events caused by the peer or a timer for the callbacks.
+ *
+ * @param[in] tcb         TCB after the FSM was called.
+ * @param[in] state       FSM state before the FSM was called.
+ * @param[in] avail       Readable bytes in receive buffer before the FSM was called.
+ * @param[in] unacked     Whether data was in flight before the FSM was called.
+ *
+ * @returns   Combination of gnrc_tcp_event_t.
+ */
+static gnrc_tcp_event_t _fsm_events(const gnrc_tcp_tcb_t *tcb, fsm_state_t state,
+                                    unsigned avail, bool unacked)
+{
+    unsigned events = 0;
+
+    /* Signal the end of a connection once: on the peers FIN, a reset or a timeout */
+    if (tcb->state != state) {
+        switch (tcb->state) {
+            case FSM_STATE_ESTABLISHED:
+                events |= GNRC_TCP_EVENT_CONN_RDY;
+                break;
+
+            case FSM_STATE_CLOSE_WAIT:
+            case FSM_STATE_CLOSING:
+                events |= GNRC_TCP_EVENT_CONN_FIN;
+                break;
+
+            case FSM_STATE_TIME_WAIT:
+                if (state != FSM_STATE_CLOSING) {
+                    events |= GNRC_TCP_EVENT_CONN_FIN;
+                }
+                break;
+
+            case FSM_STATE_CLOSED:
+                if (state != FSM_STATE_TIME_WAIT && state != FSM_STATE_LAST_ACK) {
+                    events |= GNRC_TCP_EVENT_CONN_FIN;
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+    if (tcb->rcv_buf_raw != NULL && tcb->rcv_buf.avail > avail) {
+        events |= GNRC_TCP_EVENT_MSG_RECV;
+    }
+    if (unacked && tcb->pkt_retransmit == NULL && tcb->state != FSM_STATE_CLOSED) {
+        events |= GNRC_TCP_EVENT_MSG_SENT;
+    }
+    return (gnrc_tcp_event_t)events;
+}
+
 int _fsm(gnrc_tcp_tcb_t *tcb, fsm_event_t event, gnrc_pktsnip_t *in_pkt, void *buf, size_t len)
 {
+    gnrc_tcp_event_t events = 0;
+    gnrc_tcp_tcb_cb_t cb = NULL;
+    gnrc_tcp_tcb_queue_t *queue = NULL;
+    gnrc_tcp_tcb_queue_cb_t queue_cb = NULL;
+    void *cb_arg = NULL;
+
     /* Lock FSM */
     mutex_lock(&(tcb->fsm_lock));
 
+    /* Remember state to detect events caused by the peer or timers */
+    fsm_state_t state = tcb->state;
+    unsigned avail = tcb->rcv_buf.avail;
+    bool unacked = (tcb->pkt_retransmit != NULL);
+
     /* Call FSM */
     tcb->status &= ~STATUS_NOTIFY_USER;
     int32_t result = _fsm_unprotected(tcb, event, in_pkt, buf, len);
@@ -902,7 +1029,35 @@ int _fsm(gnrc_tcp_tcb_t *tcb, fsm_event_t event, gnrc_pktsnip_t *in_pkt, void *b
         msg.type = MSG_TYPE_NOTIFY_USER;
         mbox_try_put(&(tcb->mbox), &msg);
     }
+
+    /* User calls report their outcome directly, everything else is signaled */
+    if (event >= FSM_EVENT_RCVD_PKT) {
+        events = _fsm_events(tcb, state, avail, unacked);
+
+        /* A listening queue learns about connections that were not accepted yet */
+        if (tcb->queue != NULL && !(tcb->status & STATUS_ACCEPTED) &&
+            (events & GNRC_TCP_EVENT_CONN_RDY)) {
+            msg_t msg;
+            msg.type = MSG_TYPE_NOTIFY_QUEUE;
+            mbox_try_put(&(tcb->queue->mbox), &msg);
+            queue = tcb->queue;
+            queue_cb = queue->cb;
+            cb_arg = queue->cb_arg;
+        }
+        else if (events) {
+            cb = tcb->cb;
+            cb_arg = tcb->cb_arg;
+        }
+    }
     /* Unlock FSM */
     mutex_unlock(&(tcb->fsm_lock));
+
+    /* Call callbacks without holding the lock */
+    if (queue_cb != NULL) {
+        queue_cb(queue, GNRC_TCP_EVENT_CONN_RECV, cb_arg);
+    }
+    else if (cb != NULL) {
+        cb(tcb, events, cb_arg);
+    }
     return result;
 }
@@ -24,6 +24,13 @@
 
 int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
 {
+    /* Window scale and SACK permitted options are only valid in SYN segments */
+    uint16_t syn = byteorder_ntohs(hdr->off_ctl) & MSK_SYN;
+    if (syn) {
+        tcb->status &= ~(STATUS_WND_SCALE | STATUS_SACK_PERMITTED);
+        tcb->snd_wnd_scale = 0;
+    }
+
     /* Extract offset value. Return if no options are set */
     uint8_t offset = GET_OFFSET(byteorder_ntohs(hdr->off_ctl));
     if (offset <= TCP_HDR_OFFSET_MIN) {
@@ -62,6 +69,52 @@ int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
                       tcb->mss);
                 break;
 
+            case TCP_OPTION_KIND_WND_SCALE:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length != TCP_OPTION_LENGTH_WND_SCALE) {
+
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid WS Option length.\n");
+                    return -1;
+                }
+                if (syn) {
+                    tcb->snd_wnd_scale = option->value[0];
+                    if (tcb->snd_wnd_scale > TCP_OPTION_WND_SCALE_MAX) {
+                        tcb->snd_wnd_scale = TCP_OPTION_WND_SCALE_MAX;
+                    }
+                    tcb->status |= STATUS_WND_SCALE;
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : WS option found. "
+                          "SHIFT=%"PRIu8"\n", tcb->snd_wnd_scale);
+                }
+                break;
+
+            case TCP_OPTION_KIND_SACK_PERM:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length != TCP_OPTION_LENGTH_SACK_PERM) {
+
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid SACK-Permitted Option"
+                          " length.\n");
+                    return -1;
+                }
+                if (syn) {
+                    tcb->status |= STATUS_SACK_PERMITTED;
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : SACK-Permitted option found\n");
+                }
+                break;
+
+            case TCP_OPTION_KIND_SACK:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length < TCP_OPTION_LENGTH_MIN + TCP_OPTION_LENGTH_SACK_BLOCK ||
+                    (option->length - TCP_OPTION_LENGTH_MIN) % TCP_OPTION_LENGTH_SACK_BLOCK) {
+
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid SACK Option length.\n");
+                    return -1;
+                }
+                /* Only one segment is in flight at any time: a SACK block can never cover
+                 * data that has not been acknowledged cumulatively. Nothing to do here. */
+                DEBUG("gnrc_tcp_option.c : _option_parse() : SACK option found. BLOCKS=%d\n",
+                      (option->length - TCP_OPTION_LENGTH_MIN) / TCP_OPTION_LENGTH_SACK_BLOCK);
+                break;
+
             default:
                 if (opt_left >= TCP_OPTION_LENGTH_MIN) {
                     DEBUG("gnrc_tcp_option.c : _option_parse() : Unsupported option found.\
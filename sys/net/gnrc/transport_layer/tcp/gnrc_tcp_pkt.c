@@ -164,14 +164,42 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
     tcp_hdr.checksum = byteorder_htons(0);
     tcp_hdr.seq_num = byteorder_htonl(seq_num);
     tcp_hdr.ack_num = byteorder_htonl(ack_num);
-    tcp_hdr.window = byteorder_htons(tcb->rcv_wnd);
     tcp_hdr.urgent_ptr = byteorder_htons(0);
 
+    /* Window field in SYN segments is never scaled (see RFC 7323) */
+    uint32_t wnd = tcb->rcv_wnd;
+    if (!(ctl & MSK_SYN)) {
+        wnd >>= tcb->rcv_wnd_scale;
+    }
+    tcp_hdr.window = byteorder_htons((wnd > UINT16_MAX) ? UINT16_MAX : wnd);
+
     /* Calculate option field size. */
+    /* Window scaling and SACK are offered in a SYN, and confirmed in a SYN+ACK if offered */
+    bool wnd_scale = false;
+    bool sack_perm = false;
+    uint8_t sack_num = 0;
+    if (ctl & MSK_SYN) {
+        wnd_scale = !(ctl & MSK_ACK) || (tcb->status & STATUS_WND_SCALE);
+        sack_perm = !(ctl & MSK_ACK) || (tcb->status & STATUS_SACK_PERMITTED);
+    }
+    /* Report out-of-order data to the peer if it understands SACK */
+    else if ((ctl & MSK_ACK) && !(ctl & MSK_RST) && (tcb->status & STATUS_SACK_PERMITTED)) {
+        sack_num = tcb->rcv_sack_num;
+    }
+
     /* Add MSS option if SYN is sent */
     if (ctl & MSK_SYN) {
         offset += 1;
     }
+    if (wnd_scale) {
+        offset += 1;
+    }
+    if (sack_perm) {
+        offset += 1;
+    }
+    if (sack_num > 0) {
+        offset += 1 + 2 * sack_num;
+    }
     /* Set offset and control bit accordingly */
     tcp_hdr.off_ctl = byteorder_htons(_option_build_offset_control(offset, ctl));
 
@@ -203,8 +231,32 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
             if (ctl & MSK_SYN) {
                 network_uint32_t mss_option = byteorder_htonl(_option_build_mss(GNRC_TCP_MSS));
                 memcpy(opt_ptr, &mss_option, sizeof(mss_option));
+                opt_ptr += sizeof(mss_option);
+            }
+            if (wnd_scale) {
+                network_uint32_t ws_option =
+                    byteorder_htonl(_option_build_wnd_scale(tcb->rcv_wnd_scale));
+                memcpy(opt_ptr, &ws_option, sizeof(ws_option));
+                opt_ptr += sizeof(ws_option);
+            }
+            if (sack_perm) {
+                network_uint32_t sp_option = byteorder_htonl(_option_build_sack_perm());
+                memcpy(opt_ptr, &sp_option, sizeof(sp_option));
+                opt_ptr += sizeof(sp_option);
+            }
+            if (sack_num > 0) {
+                network_uint32_t sack_option = byteorder_htonl(_option_build_sack(sack_num));
+                memcpy(opt_ptr, &sack_option, sizeof(sack_option));
+                opt_ptr += sizeof(sack_option);
+                for (uint8_t i = 0; i < sack_num; ++i) {
+                    network_uint32_t edge = byteorder_htonl(tcb->rcv_sack[i].left);
+                    memcpy(opt_ptr, &edge, sizeof(edge));
+                    opt_ptr += sizeof(edge);
+                    edge = byteorder_htonl(tcb->rcv_sack[i].right);
+                    memcpy(opt_ptr, &edge, sizeof(edge));
+                    opt_ptr += sizeof(edge);
+                }
             }
-            /* Increase opt_ptr and decrease opt_left, if other options are added */
             /* NOTE: Add additional options here */
         }
         *(out_pkt) = tcp_snp;
@@ -267,11 +319,15 @@ int _pkt_send(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *out_pkt, const uint16_t seq_c
         return -EINVAL;
     }
 
-    /* If this is no retransmission, advance sequence number and measure time */
+    /* If this is no retransmission, advance sequence number and measure time.
+     * Segments that consume no sequence space (pure ACKs, window updates) must
+     * not restart the measurement of a segment that is still in flight. */
     if (!retransmit) {
-        tcb->retries = 0;
+        if (seq_con > 0) {
+            tcb->retries = 0;
+            tcb->rtt_start = xtimer_now_usec();
+        }
         tcb->snd_nxt += seq_con;
-        tcb->rtt_start = xtimer_now().ticks32;
     }
     else {
         tcb->retries += 1;
@@ -443,7 +499,7 @@ int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
         tcb->pkt_retransmit = NULL;
 
         /* Measure round trip time */
-        int32_t rtt = xtimer_now().ticks32 - tcb->rtt_start;
+        int32_t rtt = xtimer_now_usec() - tcb->rtt_start;
 
         /* Use time only if there was no timer overflow and no retransmission (Karns Algorithm) */
         if (tcb->retries == 0 && rtt > 0) {
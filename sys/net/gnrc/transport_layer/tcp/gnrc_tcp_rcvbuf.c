@@ -16,6 +16,8 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  */
 #include <errno.h>
+#include <string.h>
+#include "internal/common.h"
 #include "internal/rcvbuf.h"
 
 #define ENABLE_DEBUG (0)
@@ -80,13 +82,22 @@ static void _rcvbuf_free(void * const buf)
 int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
 {
     if (tcb->rcv_buf_raw == NULL) {
-        tcb->rcv_buf_raw = _rcvbuf_alloc();
+        size_t size = GNRC_TCP_RCV_BUF_SIZE;
+
+        /* Prefer a buffer supplied by the user over the preallocated ones */
+        if (tcb->rcv_buf_user != NULL) {
+            tcb->rcv_buf_raw = tcb->rcv_buf_user;
+            size = tcb->rcv_buf_user_size;
+        }
+        else {
+            tcb->rcv_buf_raw = _rcvbuf_alloc();
+        }
         if (tcb->rcv_buf_raw == NULL) {
             DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_get_buffer() : Can't allocate rcv_buf_raw\n");
             return -ENOMEM;
         }
         else {
-            ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw, GNRC_TCP_RCV_BUF_SIZE);
+            ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw, size);
         }
     }
     return 0;
@@ -95,7 +106,144 @@ int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
 void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb)
 {
     if (tcb->rcv_buf_raw != NULL) {
-        _rcvbuf_free(tcb->rcv_buf_raw);
+        if (tcb->rcv_buf_raw != tcb->rcv_buf_user) {
+            _rcvbuf_free(tcb->rcv_buf_raw);
+        }
         tcb->rcv_buf_raw = NULL;
     }
 }
+
+/**
+ * @brief Copies data behind the readable part of the receive buffer.
+ *
+ * @param[in,out] rb     Ringbuffer to copy into.
+ * @param[in]     off    Offset to the end of the readable data.
+ * @param[in]     data   Data to copy.
+ * @param[in]     len    Number of bytes to copy. Must fit into the free space.
+ */
+static void _rcvbuf_copy(ringbuffer_t *rb, size_t off, const uint8_t *data, size_t len)
+{
+    size_t pos = (rb->start + rb->avail + off) % rb->size;
+    size_t till_end = rb->size - pos;
+
+    if (len <= till_end) {
+        memcpy(rb->buf + pos, data, len);
+    }
+    else {
+        memcpy(rb->buf + pos, data, till_end);
+        memcpy(rb->buf, data + till_end, len - till_end);
+    }
+}
+
+/**
+ * @brief Records a block of out-of-order data, most recent first.
+ *
+ * Blocks overlapping or adjacent to the new one are merged into it. If the list
+ * is full the oldest block is forgotten, its data is then received again.
+ *
+ * @param[in,out] tcb     TCB holding the block list.
+ * @param[in]     left    First sequence number of the new block.
+ * @param[in]     right   Sequence number following the new block.
+ */
+static void _rcvbuf_sack_add(gnrc_tcp_tcb_t *tcb, uint32_t left, uint32_t right)
+{
+    gnrc_tcp_sack_block_t *sack = tcb->rcv_sack;
+    uint8_t i = 0;
+
+    while (i < tcb->rcv_sack_num) {
+        if (LEQ_32_BIT(sack[i].left, right) && LEQ_32_BIT(left, sack[i].right)) {
+            left = LSS_32_BIT(sack[i].left, left) ? sack[i].left : left;
+            right = GRT_32_BIT(sack[i].right, right) ? sack[i].right : right;
+            memmove(&sack[i], &sack[i + 1], (tcb->rcv_sack_num - i - 1) * sizeof(*sack));
+            tcb->rcv_sack_num--;
+        }
+        else {
+            i++;
+        }
+    }
+    if (tcb->rcv_sack_num == GNRC_TCP_SACK_BLOCKS) {
+        tcb->rcv_sack_num--;
+    }
+    memmove(&sack[1], &sack[0], tcb->rcv_sack_num * sizeof(*sack));
+    sack[0].left = left;
+    sack[0].right = right;
+    tcb->rcv_sack_num++;
+}
+
+size_t _rcvbuf_add_segment(gnrc_tcp_tcb_t *tcb, uint32_t seq, gnrc_pktsnip_t *snp)
+{
+    ringbuffer_t *rb = &tcb->rcv_buf;
+    size_t free = rb->size - rb->avail;
+    uint32_t left = 0;
+    uint32_t right = seq;
+    bool stored = false;
+
+    while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
+        const uint8_t *data = snp->data;
+        size_t len = snp->size;
+        snp = snp->next;
+
+        /* Skip data that was already received */
+        if (LSS_32_BIT(right, tcb->rcv_nxt)) {
+            uint32_t skip = tcb->rcv_nxt - right;
+            if (skip >= len) {
+                right += len;
+                continue;
+            }
+            data += skip;
+            len -= skip;
+            right += skip;
+        }
+
+        /* Store as much as fits into the free part of the receive buffer */
+        size_t off = right - tcb->rcv_nxt;
+        if (off >= free) {
+            break;
+        }
+        if (len > free - off) {
+            len = free - off;
+        }
+        _rcvbuf_copy(rb, off, data, len);
+        if (!stored) {
+            left = right;
+            stored = true;
+        }
+        right += len;
+    }
+
+    if (!stored) {
+        return 0;
+    }
+
+    /* Data following a gap is kept back until the gap has been filled */
+    if (left != tcb->rcv_nxt) {
+        DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_add_segment() : out-of-order [%"PRIu32", %"PRIu32")\n",
+              left, right);
+        _rcvbuf_sack_add(tcb, left, right);
+        return 0;
+    }
+
+    /* Advance over all blocks that became contiguous with the received data */
+    uint32_t rcv_nxt = right;
+    uint8_t i = 0;
+    while (i < tcb->rcv_sack_num) {
+        gnrc_tcp_sack_block_t *sack = tcb->rcv_sack;
+        if (LEQ_32_BIT(sack[i].left, rcv_nxt)) {
+            if (GRT_32_BIT(sack[i].right, rcv_nxt)) {
+                rcv_nxt = sack[i].right;
+            }
+            memmove(&sack[i], &sack[i + 1], (tcb->rcv_sack_num - i - 1) * sizeof(*sack));
+            tcb->rcv_sack_num--;
+            i = 0;
+        }
+        else {
+            i++;
+        }
+    }
+
+    /* Make the data readable */
+    size_t added = rcv_nxt - tcb->rcv_nxt;
+    rb->avail += added;
+    tcb->rcv_nxt = rcv_nxt;
+    return added;
+}
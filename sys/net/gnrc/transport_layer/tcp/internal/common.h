@@ -47,13 +47,16 @@ extern "C" {
 #define STATUS_ALLOW_ANY_ADDR (1 << 1)
 #define STATUS_NOTIFY_USER    (1 << 2)
 #define STATUS_WAIT_FOR_MSG   (1 << 3)
+#define STATUS_WND_SCALE      (1 << 4)
+#define STATUS_SACK_PERMITTED (1 << 5)
+#define STATUS_ACCEPTED       (1 << 6)
 /** @} */
 
 /**
  * @brief Defines for "eventloop" thread settings.
  * @{
  */
-#define TCP_EVENTLOOP_MSG_QUEUE_SIZE (8U)
+#define TCP_EVENTLOOP_MSG_QUEUE_SIZE (GNRC_TCP_EVENTLOOP_MSG_QUEUE_SIZE)
 #define TCP_EVENTLOOP_PRIO           (THREAD_PRIORITY_MAIN - 2U)
 #define TCP_EVENTLOOP_STACK_SIZE     (THREAD_STACKSIZE_DEFAULT)
 /** @} */
@@ -87,8 +90,15 @@ extern "C" {
 #define MSG_TYPE_RETRANSMISSION     (GNRC_NETAPI_MSG_TYPE_ACK + 104)
 #define MSG_TYPE_TIMEWAIT           (GNRC_NETAPI_MSG_TYPE_ACK + 105)
 #define MSG_TYPE_NOTIFY_USER        (GNRC_NETAPI_MSG_TYPE_ACK + 106)
+#define MSG_TYPE_NOTIFY_QUEUE       (GNRC_NETAPI_MSG_TYPE_ACK + 107)
 /** @} */
 
+/**
+ * @brief Number of SYN+ACK retransmissions before a TCB of a listening queue
+ *        gives up on a half-open connection and listens again.
+ */
+#define SYN_RCVD_RETRIES_MAX (5U)
+
 /**
  * @brief Define for marking that time measurement is uninitialized.
  */
@@ -102,7 +112,7 @@ extern "C" {
 #define LSS_32_BIT(x, y) (((int32_t) (x)) - ((int32_t) (y)) <  0)
 #define LEQ_32_BIT(x, y) (((int32_t) (x)) - ((int32_t) (y)) <= 0)
 #define GRT_32_BIT(x, y) (!LEQ_32_BIT(x, y))
-#define GEQ_32_BIT(x, y) (!LSS_32_BOT(x, y))
+#define GEQ_32_BIT(x, y) (!LSS_32_BIT(x, y))
 /** @} */
 
 /**
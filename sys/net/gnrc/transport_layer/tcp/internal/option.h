@@ -42,6 +42,47 @@ static inline uint32_t _option_build_mss(uint16_t mss)
             ((uint32_t) TCP_OPTION_LENGTH_MSS << 16) | mss);
 }
 
+/**
+ * @brief Helper function to build the window scale option, preceded by a NOP.
+ *
+ * @param[in] shift   Shift count that should be set.
+ *
+ * @returns   Window scale option value.
+ */
+static inline uint32_t _option_build_wnd_scale(uint8_t shift)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) |
+            ((uint32_t) TCP_OPTION_KIND_WND_SCALE << 16) |
+            ((uint32_t) TCP_OPTION_LENGTH_WND_SCALE << 8) | shift);
+}
+
+/**
+ * @brief Helper function to build the SACK permitted option, preceded by two NOPs.
+ *
+ * @returns   SACK permitted option value.
+ */
+static inline uint32_t _option_build_sack_perm(void)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) |
+            ((uint32_t) TCP_OPTION_KIND_NOP << 16) |
+            ((uint32_t) TCP_OPTION_KIND_SACK_PERM << 8) | TCP_OPTION_LENGTH_SACK_PERM);
+}
+
+/**
+ * @brief Helper function to build the header of a SACK option, preceded by two NOPs.
+ *
+ * @param[in] nblocks   Number of SACK blocks following the header.
+ *
+ * @returns   SACK option header value.
+ */
+static inline uint32_t _option_build_sack(uint8_t nblocks)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) |
+            ((uint32_t) TCP_OPTION_KIND_NOP << 16) |
+            ((uint32_t) TCP_OPTION_KIND_SACK << 8) |
+            (TCP_OPTION_LENGTH_MIN + nblocks * TCP_OPTION_LENGTH_SACK_BLOCK));
+}
+
 /**
  * @brief Helper function to build the combined option and control flag field.
  *
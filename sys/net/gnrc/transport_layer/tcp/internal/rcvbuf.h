@@ -67,6 +67,22 @@ int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb);
  */
 void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Stores the payload of a received segment in the receive buffer.
+ *
+ * Data that was already received is skipped, data that does not fit into the
+ * buffer is dropped. Data following a gap is stored at its final position but
+ * only becomes readable once the gap has been filled; until then it is tracked
+ * in the SACK blocks of @p tcb.
+ *
+ * @param[in,out] tcb   TCB holding the receive buffer. rcv_nxt is advanced.
+ * @param[in]     seq   Sequence number of the first payload byte.
+ * @param[in]     snp   First payload snip of the segment.
+ *
+ * @returns   Number of bytes that became readable.
+ */
+size_t _rcvbuf_add_segment(gnrc_tcp_tcb_t *tcb, uint32_t seq, gnrc_pktsnip_t *snp);
+
 #ifdef __cplusplus
 }
 #endif
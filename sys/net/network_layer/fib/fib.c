@@ -19,11 +19,13 @@
  * @}
  */
 
+#include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <inttypes.h>
 #include <errno.h>
+#include "kernel_defines.h"
 #include "thread.h"
 #include "mutex.h"
 #include "msg.h"
@@ -65,6 +67,295 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
     *target = xtimer_now_usec64() + (ms * US_PER_MS);
 }
 
+static int fib_remove(fib_table_t *table, fib_entry_t *entry);
+
+#ifdef MODULE_FIB_RADIX
+/**
+ * @brief returns the bit at position pos of the given address, MSB first
+ */
+static inline unsigned fib_radix_bit(const uint8_t *addr, unsigned pos)
+{
+    return (addr[pos >> 3] >> (7 - (pos & 0x7))) & 0x1;
+}
+
+/**
+ * @brief returns the number of leading bits two addresses have in common,
+ *        at most max_bits
+ */
+static unsigned fib_radix_common_bits(const uint8_t *a, const uint8_t *b,
+                                      unsigned max_bits)
+{
+    unsigned i = 0;
+
+    while ((i + 8) <= max_bits && (a[i >> 3] == b[i >> 3])) {
+        i += 8;
+    }
+    while ((i < max_bits) && (fib_radix_bit(a, i) == fib_radix_bit(b, i))) {
+        i++;
+    }
+    return i;
+}
+
+/**
+ * @brief returns the prefix length in bits an entry is indexed with
+ *
+ * An all-zero address is a default route, entries without a prefix length
+ * in their flags only match the exact address.
+ */
+static unsigned fib_radix_prefix_len(fib_entry_t *entry)
+{
+    universal_address_container_t *global = entry->global;
+    unsigned len = global->address_size << 3;
+    bool is_all_zeros_addr = true;
+
+    for (size_t i = 0; i < global->address_size; ++i) {
+        if (global->address[i] != 0) {
+            is_all_zeros_addr = false;
+            break;
+        }
+    }
+
+    if (is_all_zeros_addr) {
+        return 0;
+    }
+    if (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK) {
+        unsigned prefix = (entry->global_flags & FIB_FLAG_NET_PREFIX_MASK)
+                          >> FIB_FLAG_NET_PREFIX_SHIFT;
+        if (prefix < len) {
+            len = prefix;
+        }
+    }
+    return len;
+}
+
+/**
+ * @brief initializes an empty radix tree, all nodes of the entries are unused
+ */
+static void fib_radix_init(fib_table_t *table)
+{
+    table->radix_root = NULL;
+    table->radix_free = NULL;
+
+    if (table->table_type == FIB_TABLE_TYPE_SR) {
+        return;
+    }
+
+    /* unused nodes are linked by their parent pointer */
+    for (size_t i = 0; i < table->size; ++i) {
+        for (unsigned j = 0; j < ARRAY_SIZE(table->data.entries[i].radix_nodes); ++j) {
+            fib_radix_node_t *node = &table->data.entries[i].radix_nodes[j];
+
+            node->parent = table->radix_free;
+            table->radix_free = node;
+        }
+    }
+}
+
+static fib_radix_node_t *fib_radix_node_alloc(fib_table_t *table, const uint8_t *key,
+                                              unsigned len)
+{
+    fib_radix_node_t *node = table->radix_free;
+
+    /* there are less branching nodes than nodes with entries */
+    assert(node != NULL);
+    table->radix_free = node->parent;
+    memset(node, 0, sizeof(*node));
+    node->key = key;
+    node->len = len;
+    return node;
+}
+
+static void fib_radix_node_free(fib_table_t *table, fib_radix_node_t *node)
+{
+    node->parent = table->radix_free;
+    table->radix_free = node;
+}
+
+/**
+ * @brief replaces a node in the tree, new_node may be NULL
+ */
+static void fib_radix_replace(fib_table_t *table, fib_radix_node_t *node,
+                              fib_radix_node_t *new_node)
+{
+    fib_radix_node_t *parent = node->parent;
+
+    if (new_node != NULL) {
+        new_node->parent = parent;
+    }
+    if (parent == NULL) {
+        table->radix_root = new_node;
+    }
+    else {
+        parent->child[parent->child[1] == node] = new_node;
+    }
+}
+
+/**
+ * @brief adds an entry with a valid global address to the radix tree
+ */
+static void fib_radix_insert(fib_table_t *table, fib_entry_t *entry)
+{
+    const uint8_t *key = entry->global->address;
+    unsigned len = fib_radix_prefix_len(entry);
+    fib_radix_node_t *parent = NULL;
+    fib_radix_node_t **link = &table->radix_root;
+
+    entry->radix_next = NULL;
+
+    while (*link != NULL) {
+        fib_radix_node_t *node = *link;
+        unsigned max_bits = (node->len < len) ? node->len : len;
+        unsigned common = fib_radix_common_bits(node->key, key, max_bits);
+
+        if (common < node->len) {
+            /* the new prefix goes above the node */
+            fib_radix_node_t *new_node = fib_radix_node_alloc(table, key, len);
+
+            new_node->entry = entry;
+            if (common < len) {
+                /* both share a branching node */
+                fib_radix_node_t *branch = fib_radix_node_alloc(table, key, common);
+
+                branch->child[fib_radix_bit(key, common)] = new_node;
+                new_node->parent = branch;
+                new_node = branch;
+            }
+            fib_radix_replace(table, node, new_node);
+            new_node->child[fib_radix_bit(node->key, common)] = node;
+            node->parent = new_node;
+            return;
+        }
+        if (node->len == len) {
+            if (node->entry == NULL) {
+                /* a branching node becomes the node of the prefix */
+                node->key = key;
+            }
+            entry->radix_next = node->entry;
+            node->entry = entry;
+            return;
+        }
+        parent = node;
+        link = &node->child[fib_radix_bit(key, node->len)];
+    }
+
+    *link = fib_radix_node_alloc(table, key, len);
+    (*link)->parent = parent;
+    (*link)->entry = entry;
+}
+
+/**
+ * @brief removes an entry from the radix tree, before its global address is
+ *        released
+ */
+static void fib_radix_remove(fib_table_t *table, fib_entry_t *entry)
+{
+    const uint8_t *key = entry->global->address;
+    unsigned len = fib_radix_prefix_len(entry);
+    fib_radix_node_t *node = table->radix_root;
+    fib_entry_t **ptr;
+
+    while ((node != NULL) && (node->len < len)) {
+        node = node->child[fib_radix_bit(key, node->len)];
+    }
+    if ((node == NULL) || (node->len != len)) {
+        return;
+    }
+    for (ptr = &node->entry; (*ptr != NULL) && (*ptr != entry); ptr = &(*ptr)->radix_next) {}
+    if (*ptr == NULL) {
+        return;
+    }
+    *ptr = entry->radix_next;
+    entry->radix_next = NULL;
+
+    if (node->entry == NULL) {
+        /* only nodes with entries or two children may stay in the tree */
+        fib_radix_node_t *parent = node->parent;
+
+        if ((node->child[0] != NULL) && (node->child[1] != NULL)) {
+            node->key = node->child[0]->key;
+        }
+        else {
+            fib_radix_replace(table, node, node->child[node->child[0] == NULL]);
+            if ((node->child[0] == NULL) && (node->child[1] == NULL) &&
+                (parent != NULL) && (parent->entry == NULL)) {
+                /* the parent is left with a single child */
+                fib_radix_node_t *grand = parent->parent;
+
+                fib_radix_replace(table, parent,
+                                  parent->child[parent->child[0] == NULL]);
+                fib_radix_node_free(table, parent);
+                parent = grand;
+            }
+            fib_radix_node_free(table, node);
+            node = parent;
+        }
+    }
+    else {
+        node->key = node->entry->global->address;
+    }
+
+    /* branching nodes may have borrowed the address of the entry */
+    for (; node != NULL; node = node->parent) {
+        if ((node->key == key) && (node->entry == NULL)) {
+            node->key = node->child[0]->key;
+        }
+    }
+}
+
+/**
+ * @brief returns the entry with the longest prefix matching the destination,
+ *        the radix tree counterpart of fib_find_entry()
+ */
+static int fib_radix_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
+                                fib_entry_t **entry_arr, size_t *entry_arr_size)
+{
+    uint64_t now = xtimer_now_usec64();
+    unsigned dst_bits = dst_size << 3;
+    fib_entry_t *match;
+    fib_radix_node_t *node;
+
+restart:
+    match = NULL;
+    node = table->radix_root;
+
+    /* the path is compressed, so the prefix of every node with entries needs
+     * to be checked, below a mismatch there are no matching prefixes */
+    while ((node != NULL) && (node->len <= dst_bits)) {
+        if (node->entry != NULL) {
+            if (fib_radix_common_bits(node->key, dst, node->len) != node->len) {
+                break;
+            }
+            for (fib_entry_t *entry = node->entry; entry != NULL; entry = entry->radix_next) {
+                if ((entry->lifetime != FIB_LIFETIME_NO_EXPIRE) &&
+                    (entry->lifetime < now)) {
+                    /* remove this entry if its lifetime expired */
+                    fib_remove(table, entry);
+                    goto restart;
+                }
+                if (entry->global->address_size == dst_size) {
+                    match = entry;
+                    break;
+                }
+            }
+        }
+        if (node->len == dst_bits) {
+            break;
+        }
+        node = node->child[fib_radix_bit(dst, node->len)];
+    }
+
+    if (match == NULL) {
+        *entry_arr_size = 0;
+        return -EHOSTUNREACH;
+    }
+
+    entry_arr[0] = match;
+    *entry_arr_size = 1;
+    /* the exact address matches all bits */
+    return (memcmp(match->global->address, dst, dst_size) == 0) ? 1 : 0;
+}
+#endif /* MODULE_FIB_RADIX */
+
 /**
  * @brief returns pointer to the entry for the given destination address
  *
@@ -112,20 +403,7 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
             /* check if the lifetime expired */
             if (table->data.entries[i].lifetime < now) {
                 /* remove this entry if its lifetime expired */
-                table->data.entries[i].lifetime = 0;
-                table->data.entries[i].global_flags = 0;
-                table->data.entries[i].next_hop_flags = 0;
-                table->data.entries[i].iface_id = KERNEL_PID_UNDEF;
-
-                if (table->data.entries[i].global != NULL) {
-                    universal_address_rem(table->data.entries[i].global);
-                    table->data.entries[i].global = NULL;
-                }
-
-                if (table->data.entries[i].next_hop != NULL) {
-                    universal_address_rem(table->data.entries[i].next_hop);
-                    table->data.entries[i].next_hop = NULL;
-                }
+                fib_remove(table, &table->data.entries[i]);
             }
         }
 
@@ -189,6 +467,22 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
     return ret;
 }
 
+/**
+ * @brief returns pointer to the entry to forward to the given destination,
+ *        by the radix tree if available
+ *
+ * @see fib_find_entry()
+ */
+static inline int fib_lookup_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
+                                   fib_entry_t **entry_arr, size_t *entry_arr_size)
+{
+#ifdef MODULE_FIB_RADIX
+    return fib_radix_find_entry(table, dst, dst_size, entry_arr, entry_arr_size);
+#else
+    return fib_find_entry(table, dst, dst_size, entry_arr, entry_arr_size);
+#endif
+}
+
 /**
  * @brief updates the next hop the lifetime and the interface id for a given entry
  *
@@ -268,6 +562,9 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
                     table->data.entries[i].lifetime = FIB_LIFETIME_NO_EXPIRE;
                 }
 
+#ifdef MODULE_FIB_RADIX
+                fib_radix_insert(table, &table->data.entries[i]);
+#endif
                 return 0;
             }
         }
@@ -279,13 +576,21 @@ static int fib_create_entry(fib_table_t *table, kernel_pid_t iface_id,
 /**
  * @brief removes the given entry
  *
+ * @param[in] table the FIB table the entry belongs to
  * @param[in] entry the entry to be removed
  *
  * @return 0 on success
  */
-static int fib_remove(fib_entry_t *entry)
+static int fib_remove(fib_table_t *table, fib_entry_t *entry)
 {
+    (void)table;
+
     if (entry->global != NULL) {
+#ifdef MODULE_FIB_RADIX
+        if (entry->lifetime != 0) {
+            fib_radix_remove(table, entry);
+        }
+#endif
         universal_address_rem(entry->global);
     }
 
@@ -457,7 +762,7 @@ void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
-        fib_remove(entry[0]);
+        fib_remove(table, entry[0]);
     }
     else {
         /* we have ambiguous entries, i.e. count > 1
@@ -477,7 +782,7 @@ void fib_flush(fib_table_t *table, kernel_pid_t interface)
     for (size_t i = 0; i < table->size; ++i) {
         if ((interface == KERNEL_PID_UNDEF) ||
             (interface == table->data.entries[i].iface_id)) {
-            fib_remove(&table->data.entries[i]);
+            fib_remove(table, &table->data.entries[i]);
         }
     }
 
@@ -506,14 +811,14 @@ int fib_get_next_hop(fib_table_t *table, kernel_pid_t *iface_id,
         return -EFAULT;
     }
 
-    int ret = fib_find_entry(table, dst, dst_size, &(entry[0]), &count);
+    int ret = fib_lookup_entry(table, dst, dst_size, &(entry[0]), &count);
     if (!(ret == 0 || ret == 1)) {
         /* notify all responsible RPs for unknown  next-hop for the destination address */
         if (fib_signal_rp(table, FIB_MSG_RP_SIGNAL_UNREACHABLE_DESTINATION,
                           dst, dst_size, dst_flags) == 0) {
             count = 1;
             /* now lets see if the RRPs have found a valid next-hop */
-            ret = fib_find_entry(table, dst, dst_size, &(entry[0]), &count);
+            ret = fib_lookup_entry(table, dst, dst_size, &(entry[0]), &count);
         }
     }
 
@@ -597,6 +902,9 @@ void fib_init(fib_table_t *table)
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
     }
+#ifdef MODULE_FIB_RADIX
+    fib_radix_init(table);
+#endif
     universal_address_init();
     mutex_unlock(&(table->mtx_access));
 }
@@ -622,6 +930,9 @@ void fib_deinit(fib_table_t *table)
     else {
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
     }
+#ifdef MODULE_FIB_RADIX
+    fib_radix_init(table);
+#endif
     universal_address_reset();
     mutex_unlock(&(table->mtx_access));
 }
@@ -26,6 +26,11 @@
 #include "schedstatistics.h"
 #endif
 
+#ifdef MODULE_SCHEDSTATISTICS_EXT
+#include <inttypes.h>
+#include "xtimer.h"
+#endif
+
 #ifdef MODULE_TLSF_MALLOC
 #include "tlsf.h"
 #include "tlsf-malloc.h"
@@ -68,6 +73,9 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
            "| runtime  | switches"
+#endif
+#ifdef MODULE_SCHEDSTATISTICS_EXT
+           " | preempted | voluntary | max latency"
 #endif
            "\n",
 #ifdef DEVELHELP
@@ -116,6 +124,12 @@ void ps(void)
             unsigned runtime_major = runtime_ticks / rt_sum;
             unsigned runtime_minor = ((runtime_ticks % rt_sum) * 1000) / rt_sum;
             unsigned switches = sched_pidlist[i].schedules;
+#endif
+#ifdef MODULE_SCHEDSTATISTICS_EXT
+            unsigned preemptions = sched_pidlist[i].preemptions;
+            unsigned voluntary = sched_pidlist[i].voluntary;
+            uint32_t max_latency = xtimer_usec_from_ticks(
+                (xtimer_ticks32_t){ sched_pidlist[i].max_latency_ticks });
 #endif
             printf("\t%3" PRIkernel_pid
 #ifdef DEVELHELP
@@ -127,6 +141,9 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
                    " | %2d.%03d%% |  %8u"
+#endif
+#ifdef MODULE_SCHEDSTATISTICS_EXT
+                   " | %9u | %9u | %8" PRIu32 " us"
 #endif
                    "\n",
                    p->pid,
@@ -139,6 +156,9 @@ void ps(void)
 #endif
 #ifdef MODULE_SCHEDSTATISTICS
                    , runtime_major, runtime_minor, switches
+#endif
+#ifdef MODULE_SCHEDSTATISTICS_EXT
+                   , preemptions, voluntary, max_latency
 #endif
                   );
         }
@@ -155,4 +175,39 @@ void ps(void)
     printf("\tTotal used size: %u\n", sizes.used);
 #   endif
 #endif
+#ifdef MODULE_SCHEDSTATISTICS_EXT
+    printf("\tLongest time in scheduler: %" PRIu32 " us\n",
+           xtimer_usec_from_ticks(
+               (xtimer_ticks32_t){ schedstatistics_sched_run_max() }));
+
+    /* exited threads count as well, so sum up the priorities on their own */
+    uint64_t prio_rt_sum = 0;
+    for (unsigned prio = 0; prio < SCHED_PRIO_LEVELS; prio++) {
+        prio_rt_sum += sched_priolist[prio].runtime_ticks;
+    }
+    if (prio_rt_sum == 0) {
+        prio_rt_sum = 1;
+    }
+    printf("\n\tpri | runtime  | switches | preempted | voluntary "
+           "| max latency | max queue\n");
+    for (unsigned prio = 0; prio < SCHED_PRIO_LEVELS; prio++) {
+        schedstat_prio_t stat;
+
+        schedstatistics_get_prio(prio, &stat);
+        if (stat.schedules == 0) {
+            continue;
+        }
+        /* multiply with 100 for percentage and to avoid floats/doubles */
+        uint64_t runtime_ticks = stat.runtime_ticks * 100;
+        unsigned runtime_major = runtime_ticks / prio_rt_sum;
+        unsigned runtime_minor = ((runtime_ticks % prio_rt_sum) * 1000) /
+                                 prio_rt_sum;
+        uint32_t max_latency = xtimer_usec_from_ticks(
+            (xtimer_ticks32_t){ stat.max_latency_ticks });
+
+        printf("\t%3u | %2d.%03d%% |  %8u | %9u | %9u | %8" PRIu32 " us "
+               "| %9u\n", prio, runtime_major, runtime_minor, stat.schedules,
+               stat.preemptions, stat.voluntary, max_latency, stat.max_depth);
+    }
+#endif
 }
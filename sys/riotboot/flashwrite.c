@@ -34,8 +34,133 @@ static inline size_t min(size_t a, size_t b)
     return a <= b ? a : b;
 }
 
+#if MODULE_RIOTBOOT_FLASHWRITE_MTD
+#define VERIFY_CHUNK    (32U)
+
+static inline uint32_t _mtd_sector_size(const mtd_dev_t *mtd)
+{
+    return mtd->pages_per_sector * mtd->page_size;
+}
+
+/* starts erasing the sector behind the range erased so far */
+static int _mtd_erase_next(riotboot_flashwrite_t *state)
+{
+    uint32_t sector_size = _mtd_sector_size(state->mtd);
+
+    if (state->erased >= state->mtd_size) {
+        LOG_WARNING(LOG_PREFIX "image exceeds the slot!\n");
+        return -1;
+    }
+    if (mtd_erase_async(state->mtd, &state->erase,
+                        state->mtd_addr + state->erased, sector_size,
+                        NULL, NULL) < 0) {
+        LOG_WARNING(LOG_PREFIX "error erasing slot at 0x%lx!\n",
+                    (unsigned long)state->erased);
+        return -1;
+    }
+    state->erased += sector_size;
+    return 0;
+}
+
+/* waits for the erase and makes sure the slot is erased up to end */
+static int _mtd_erase_until(riotboot_flashwrite_t *state, size_t end)
+{
+    /* no other operation must be issued on the device while it erases */
+    if (mtd_async_wait(&state->erase) < 0) {
+        LOG_WARNING(LOG_PREFIX "error erasing slot!\n");
+        return -1;
+    }
+    while (state->erased < end) {
+        if ((_mtd_erase_next(state) < 0) ||
+            (mtd_async_wait(&state->erase) < 0)) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* writes len bytes to the slot at pos page by page and reads them back */
+static int _mtd_write_and_verify(riotboot_flashwrite_t *state,
+                                 const uint8_t *bytes, size_t pos, size_t len)
+{
+    uint32_t page_size = state->mtd->page_size;
+    uint8_t chunk[VERIFY_CHUNK];
+
+    while (len) {
+        uint32_t addr = state->mtd_addr + pos;
+        size_t n = min(page_size - (addr % page_size), len);
+
+        if (mtd_write(state->mtd, bytes, addr, n) != (int)n) {
+            return -1;
+        }
+        for (size_t i = 0; i < n; i += sizeof(chunk)) {
+            size_t m = min(sizeof(chunk), n - i);
+
+            if ((mtd_read(state->mtd, chunk, addr + i, m) < 0) ||
+                (memcmp(chunk, bytes + i, m) != 0)) {
+                return -1;
+            }
+        }
+        bytes += n;
+        pos += n;
+        len -= n;
+    }
+    return 0;
+}
+
+/* writes the flash writing buffer, which starts at pos in the slot, up to
+ * end */
+static int _mtd_write_buf(riotboot_flashwrite_t *state, size_t pos,
+                          size_t end, bool more)
+{
+    if ((_mtd_erase_until(state, end) < 0) ||
+        (_mtd_write_and_verify(state, state->flashpage_buf, pos,
+                               end - pos) < 0)) {
+        return -1;
+    }
+    /* erase the next sector while the next chunk of the image is received,
+     * as soon as the next buffer would not fit the erased range anymore */
+    if (more && ((state->erased - end) < FLASHPAGE_SIZE) &&
+        (state->erased < state->mtd_size)) {
+        return _mtd_erase_next(state);
+    }
+    return 0;
+}
+
+int riotboot_flashwrite_init_mtd(riotboot_flashwrite_t *state, mtd_dev_t *mtd,
+                                 uint32_t addr, uint32_t size, size_t offset)
+{
+    assert(offset <= FLASHPAGE_SIZE);
+    assert((addr % _mtd_sector_size(mtd)) == 0);
+    assert((size % _mtd_sector_size(mtd)) == 0);
+    assert((FLASHPAGE_SIZE % mtd->page_size) == 0);
+
+    LOG_INFO(LOG_PREFIX "initializing update to MTD slot at 0x%lx\n",
+             (unsigned long)addr);
+
+    memset(state, 0, sizeof(riotboot_flashwrite_t));
+
+    state->offset = offset;
+    state->target_slot = -1;
+    state->mtd = mtd;
+    state->mtd_addr = addr;
+    state->mtd_size = size;
+    /* the skipped bytes are written as erased, so that they can still be
+     * written on finish */
+    memset(state->flashpage_buf, 0xff, offset);
+
+    /* erase the first sector while the first chunk is received */
+    return _mtd_erase_next(state);
+}
+#endif /* MODULE_RIOTBOOT_FLASHWRITE_MTD */
+
 size_t riotboot_flashwrite_slotsize(const riotboot_flashwrite_t *state)
 {
+#if MODULE_RIOTBOOT_FLASHWRITE_MTD
+    if (state->mtd) {
+        return state->mtd_size;
+    }
+#endif
     switch (state->target_slot) {
         case 0: return SLOT0_LEN;
 #if NUM_SLOTS==2
@@ -67,6 +192,13 @@ int riotboot_flashwrite_putbytes(riotboot_flashwrite_t *state,
 {
     LOG_DEBUG(LOG_PREFIX "processing bytes %u-%u\n", state->offset, state->offset + len - 1);
 
+#if MODULE_RIOTBOOT_FLASHWRITE_MTD
+    if (state->mtd) {
+        /* advance the erase started ahead without waiting for it */
+        mtd_async_poll(&state->erase);
+    }
+#endif
+
     while (len) {
         size_t flashpage_pos = state->offset % FLASHPAGE_SIZE;
         size_t flashpage_avail = FLASHPAGE_SIZE - flashpage_pos;
@@ -80,6 +212,19 @@ int riotboot_flashwrite_putbytes(riotboot_flashwrite_t *state,
         bytes += to_copy;
         len -= to_copy;
         if ((!flashpage_avail) || (!more)) {
+#if MODULE_RIOTBOOT_FLASHWRITE_MTD
+            if (state->mtd) {
+                size_t end = state->offset;
+
+                if (_mtd_write_buf(state, end - (flashpage_pos + to_copy), end,
+                                   more || len) < 0) {
+                    LOG_WARNING(LOG_PREFIX "error writing slot at 0x%lx!\n",
+                                (unsigned long)(end - (flashpage_pos + to_copy)));
+                    return -1;
+                }
+                continue;
+            }
+#endif
             if (flashpage_write_and_verify(state->flashpage, state->flashpage_buf) != FLASHPAGE_OK) {
                 LOG_WARNING(LOG_PREFIX "error writing flashpage %u!\n", state->flashpage);
                 return -1;
@@ -98,6 +243,19 @@ int riotboot_flashwrite_finish_raw(riotboot_flashwrite_t *state,
 
     int res = -1;
 
+#if MODULE_RIOTBOOT_FLASHWRITE_MTD
+    if (state->mtd) {
+        /* the first bytes were skipped and are still erased */
+        if ((_mtd_erase_until(state, len) < 0) ||
+            (_mtd_write_and_verify(state, bytes, 0, len) < 0)) {
+            LOG_WARNING(LOG_PREFIX "re-flashing first block failed!\n");
+            return -1;
+        }
+        LOG_INFO(LOG_PREFIX "riotboot flashing completed successfully\n");
+        return 0;
+    }
+#endif
+
     uint8_t *slot_start = (uint8_t *)riotboot_slot_get_hdr(state->target_slot);
 
     uint8_t *firstpage;
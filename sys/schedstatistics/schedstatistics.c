@@ -21,12 +21,28 @@
  * @}
  */
 
+#include <assert.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "clist.h"
+#include "irq.h"
 #include "sched.h"
+#include "thread.h"
 #include "xtimer.h"
 #include "schedstatistics.h"
 
 schedstat_t sched_pidlist[KERNEL_PID_LAST + 1];
 
+#ifdef MODULE_SCHEDSTATISTICS_EXT
+schedstat_prio_t sched_priolist[SCHED_PRIO_LEVELS];
+
+/* the hooks are called by the scheduler right from the start, but xtimer
+ * can only be read once it is initialized */
+static bool _enabled;
+static uint32_t _sched_run_max;
+#endif
+
 void sched_statistics_cb(kernel_pid_t active_thread, kernel_pid_t next_thread)
 {
     uint32_t now = xtimer_now().ticks32;
@@ -34,12 +50,116 @@ void sched_statistics_cb(kernel_pid_t active_thread, kernel_pid_t next_thread)
     /* Update active thread runtime, there is always an active thread since
        first sched_run happens when main_trampoline gets scheduled */
     schedstat_t *active_stat = &sched_pidlist[active_thread];
-    active_stat->runtime_ticks += now - active_stat->laststart;
+    uint32_t runtime = now - active_stat->laststart;
+    active_stat->runtime_ticks += runtime;
 
     /* Update next_thread stats */
     schedstat_t *next_stat = &sched_pidlist[next_thread];
     next_stat->laststart = now;
     next_stat->schedules++;
+
+#ifdef MODULE_SCHEDSTATISTICS_EXT
+    thread_t *active = (thread_t *)sched_threads[active_thread];
+    thread_t *next = (thread_t *)sched_threads[next_thread];
+    schedstat_prio_t *next_prio = &sched_priolist[next->priority];
+    uint32_t latency = now - next_stat->readystart;
+
+    /* active is NULL if the thread just exited */
+    if (active != NULL) {
+        schedstat_prio_t *active_prio = &sched_priolist[active->priority];
+
+        active_prio->runtime_ticks += runtime;
+        /* there is no time slicing, so a thread still on its run queue is
+         * only switched out for one of the same priority if it yielded */
+        if ((active->status >= STATUS_ON_RUNQUEUE) &&
+            (next->priority < active->priority)) {
+            active_stat->preemptions++;
+            active_prio->preemptions++;
+        }
+        else {
+            active_stat->voluntary++;
+            active_prio->voluntary++;
+        }
+        if (active->status >= STATUS_ON_RUNQUEUE) {
+            active_stat->readystart = now;
+        }
+    }
+    next_prio->schedules++;
+    if (latency > next_stat->max_latency_ticks) {
+        next_stat->max_latency_ticks = latency;
+    }
+    if (latency > next_prio->max_latency_ticks) {
+        next_prio->max_latency_ticks = latency;
+    }
+#endif
+}
+
+#ifdef MODULE_SCHEDSTATISTICS_EXT
+void sched_statistics_ready(kernel_pid_t pid)
+{
+    if (_enabled) {
+        uint8_t prio = sched_threads[pid]->priority;
+        unsigned depth = clist_count(&sched_runqueues[prio]);
+
+        sched_pidlist[pid].readystart = xtimer_now().ticks32;
+        if (depth > sched_priolist[prio].max_depth) {
+            sched_priolist[prio].max_depth = depth;
+        }
+    }
+}
+
+uint32_t sched_statistics_run_start(void)
+{
+    return (_enabled) ? xtimer_now().ticks32 : 0;
+}
+
+void sched_statistics_run_end(uint32_t start)
+{
+    if (_enabled) {
+        uint32_t duration = xtimer_now().ticks32 - start;
+
+        if (duration > _sched_run_max) {
+            _sched_run_max = duration;
+        }
+    }
+}
+
+uint32_t schedstatistics_sched_run_max(void)
+{
+    return _sched_run_max;
+}
+
+void schedstatistics_reset_max(void)
+{
+    unsigned state = irq_disable();
+
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        sched_pidlist[i].max_latency_ticks = 0;
+    }
+    for (unsigned i = 0; i < SCHED_PRIO_LEVELS; i++) {
+        sched_priolist[i].max_latency_ticks = 0;
+        sched_priolist[i].max_depth = 0;
+    }
+    _sched_run_max = 0;
+    irq_restore(state);
+}
+
+void schedstatistics_get_prio(uint8_t prio, schedstat_prio_t *stat)
+{
+    assert(prio < SCHED_PRIO_LEVELS);
+    unsigned state = irq_disable();
+
+    memcpy(stat, &sched_priolist[prio], sizeof(schedstat_prio_t));
+    irq_restore(state);
+}
+#endif
+
+void schedstatistics_get(kernel_pid_t pid, schedstat_t *stat)
+{
+    unsigned state = irq_disable();
+
+    memcpy(stat, &sched_pidlist[pid], sizeof(schedstat_t));
+    irq_restore(state);
 }
 
 void init_schedstatistics(void)
@@ -49,5 +169,17 @@ void init_schedstatistics(void)
     schedstat_t *active_stat = &sched_pidlist[sched_active_pid];
     active_stat->laststart = xtimer_now().ticks32;
     active_stat->schedules = 1;
+#ifdef MODULE_SCHEDSTATISTICS_EXT
+    unsigned state = irq_disable();
+    uint32_t now = xtimer_now().ticks32;
+
+    /* threads already waiting to run became ready just now, as far as we know */
+    for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; i++) {
+        sched_pidlist[i].readystart = now;
+    }
+    sched_priolist[sched_active_thread->priority].schedules = 1;
+    _enabled = true;
+    irq_restore(state);
+#endif
     sched_register_cb(sched_statistics_cb);
 }
@@ -15,6 +15,7 @@
 
 #include <stdio.h>
 
+#include "net/gnrc/netif.h"
 #include "net/gnrc/sixlowpan/frag/stats.h"
 
 int _gnrc_6lo_frag_stats(int argc, char **argv)
@@ -30,6 +31,19 @@ int _gnrc_6lo_frag_stats(int argc, char **argv)
 #endif
     printf("frags complete: %u\n", stats->fragments);
     printf("dgs complete: %u\n", stats->datagrams);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    gnrc_netif_t *netif = NULL;
+
+    while ((netif = gnrc_netif_iter(netif))) {
+        const gnrc_sixlowpan_frag_vrb_stats_t *vrb_stats =
+            &netif->sixlo.vrb_stats;
+
+        printf("Iface %u:\n", (unsigned)netif->pid);
+        printf("  frags forwarded: %u\n", vrb_stats->fwd);
+        printf("  frags fwd dropped: %u\n", vrb_stats->drops);
+        printf("  dgs reassembled: %u\n", vrb_stats->reasm);
+    }
+#endif
     return 0;
 }
 
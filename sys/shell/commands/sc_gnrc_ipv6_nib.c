@@ -13,6 +13,7 @@
  * @author  Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 
 #include "net/gnrc/ipv6/nib.h"
@@ -23,6 +24,7 @@ static void _usage(char **argv);
 static int _nib_neigh(int argc, char **argv);
 static int _nib_prefix(int argc, char **argv);
 static int _nib_route(int argc, char **argv);
+static int _nib_cache(int argc, char **argv);
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C
 static int _nib_abr(int argc, char **argv);
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
@@ -44,6 +46,9 @@ int _gnrc_ipv6_nib(int argc, char **argv)
     else if (strcmp(argv[1], "route") == 0) {
         res = _nib_route(argc, argv);
     }
+    else if (strcmp(argv[1], "cache") == 0) {
+        res = _nib_cache(argc, argv);
+    }
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C
     else if (strcmp(argv[1], "abr") == 0) {
         res = _nib_abr(argc, argv);
@@ -58,9 +63,9 @@ int _gnrc_ipv6_nib(int argc, char **argv)
 static void _usage(char **argv)
 {
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C
-    printf("usage: %s {neigh|prefix|route|abr|help} ...\n", argv[0]);
+    printf("usage: %s {neigh|prefix|route|cache|abr|help} ...\n", argv[0]);
 #else   /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
-    printf("usage: %s {neigh|prefix|route|help} ...\n", argv[0]);
+    printf("usage: %s {neigh|prefix|route|cache|help} ...\n", argv[0]);
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
 }
 
@@ -294,6 +299,39 @@ static int _nib_route(int argc, char **argv)
     return 0;
 }
 
+static void _usage_nib_cache(char **argv)
+{
+    printf("usage: %s %s [show|flush|help]\n", argv[0], argv[1]);
+}
+
+static int _nib_cache(int argc, char **argv)
+{
+    if ((argc == 2) || (strcmp(argv[2], "show") == 0)) {
+        gnrc_ipv6_nib_rc_stats_t stats;
+
+        if (CONFIG_GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF == 0) {
+            puts("route cache disabled");
+            return 0;
+        }
+        gnrc_ipv6_nib_rc_get_stats(&stats);
+        printf("route cache: %u entries, %" PRIu32 " hits, %" PRIu32
+               " misses, %" PRIu32 " flushes\n",
+               (unsigned)CONFIG_GNRC_IPV6_NIB_ROUTE_CACHE_NUMOF, stats.hits,
+               stats.misses, stats.flushes);
+    }
+    else if (strcmp(argv[2], "flush") == 0) {
+        gnrc_ipv6_nib_rc_flush();
+    }
+    else if (strcmp(argv[2], "help") == 0) {
+        _usage_nib_cache(argv);
+    }
+    else {
+        _usage_nib_cache(argv);
+        return 1;
+    }
+    return 0;
+}
+
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C
 static void _usage_nib_abr(char **argv)
 {
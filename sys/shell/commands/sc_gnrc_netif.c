@@ -133,6 +133,20 @@ static int _netif_stats(netif_t *iface, unsigned module, bool reset)
 }
 #endif /* MODULE_NETSTATS */
 
+#ifdef MODULE_GNRC_NETIF_RX_BATCH
+static void _netif_rx_batch_stats(gnrc_netif_t *netif)
+{
+    const gnrc_netif_rx_batch_stats_t *stats = &netif->rx_batch.stats;
+    /* average batch size in tenths */
+    unsigned avg = (stats->batches) ?
+                   (unsigned)(((uint64_t)stats->pkts * 10) / stats->batches) : 0;
+
+    printf("          RX batches %u  packets %u  avg. size %u.%u\n",
+           (unsigned)stats->batches, (unsigned)stats->pkts,
+           avg / 10, avg % 10);
+}
+#endif
+
 static void _link_usage(char *cmd_name)
 {
     printf("usage: %s <if_id> [up|down]\n", cmd_name);
@@ -664,6 +678,9 @@ static void _netif_list(netif_t *iface)
 #endif
 #ifdef MODULE_NETSTATS_IPV6
     _netif_stats(iface, NETSTATS_IPV6, false);
+#endif
+#ifdef MODULE_GNRC_NETIF_RX_BATCH
+    _netif_rx_batch_stats((gnrc_netif_t *)iface);
 #endif
     puts("");
 }
@@ -12,27 +12,76 @@
  * @file
  * @brief       thread-safe ringbuffer implementation
  *
+ * The producer only ever modifies tsrb_t::writes and the consumer only ever
+ * modifies tsrb_t::reads. The fences order the buffer accesses with respect to
+ * the counter updates, so one producer and one consumer (e.g. an ISR and a
+ * thread) can operate on the ringbuffer concurrently without any locking.
+ *
  * @author      Kaspar Schleiser <kaspar@schleiser.de>
  *
  * @}
  */
 
+#include <stdatomic.h>
+#include <string.h>
+
 #include "tsrb.h"
 
-static void _push(tsrb_t *rb, uint8_t c)
+static inline unsigned _region(const tsrb_t *rb, unsigned pos, unsigned len)
+{
+    /* regions end at the end of the buffer */
+    return (len < (rb->size - pos)) ? len : (rb->size - pos);
+}
+
+unsigned tsrb_peek_read(const tsrb_t *rb, const uint8_t **data)
 {
-    rb->buf[rb->writes++ & (rb->size - 1)] = c;
+    unsigned reads = rb->reads;
+    unsigned avail = rb->writes - reads;
+    unsigned pos = reads & (rb->size - 1);
+
+    /* make bytes written before tsrb_t::writes was updated visible */
+    atomic_thread_fence(memory_order_acquire);
+    *data = &rb->buf[pos];
+    return _region(rb, pos, avail);
 }
 
-static uint8_t _pop(tsrb_t *rb)
+void tsrb_commit_read(tsrb_t *rb, unsigned n)
 {
-    return rb->buf[rb->reads++ & (rb->size - 1)];
+    assert(n <= tsrb_avail(rb));
+    /* finish reading before handing the space back to the producer */
+    atomic_thread_fence(memory_order_release);
+    rb->reads += n;
+}
+
+unsigned tsrb_peek_write(tsrb_t *rb, uint8_t **data)
+{
+    unsigned writes = rb->writes;
+    unsigned space = rb->size - (writes - rb->reads);
+    unsigned pos = writes & (rb->size - 1);
+
+    /* don't overwrite bytes before the consumer is done reading them */
+    atomic_thread_fence(memory_order_acquire);
+    *data = &rb->buf[pos];
+    return _region(rb, pos, space);
+}
+
+void tsrb_commit_write(tsrb_t *rb, unsigned n)
+{
+    assert(n <= tsrb_free(rb));
+    /* finish writing before handing the bytes to the consumer */
+    atomic_thread_fence(memory_order_release);
+    rb->writes += n;
 }
 
 int tsrb_get_one(tsrb_t *rb)
 {
-    if (!tsrb_empty(rb)) {
-        return _pop(rb);
+    const uint8_t *data;
+
+    if (tsrb_peek_read(rb, &data) > 0) {
+        int c = *data;
+
+        tsrb_commit_read(rb, 1);
+        return c;
     }
     else {
         return -1;
@@ -41,28 +90,46 @@ int tsrb_get_one(tsrb_t *rb)
 
 int tsrb_get(tsrb_t *rb, uint8_t *dst, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_empty(rb)) {
-        *dst++ = _pop(rb);
-        tmp--;
+    const uint8_t *data;
+    size_t done = 0;
+    unsigned len;
+
+    /* takes at most two iterations, unless the producer adds bytes
+     * concurrently */
+    while ((done < n) && ((len = tsrb_peek_read(rb, &data)) > 0)) {
+        if (len > (n - done)) {
+            len = n - done;
+        }
+        memcpy(&dst[done], data, len);
+        tsrb_commit_read(rb, len);
+        done += len;
     }
-    return (n - tmp);
+    return done;
 }
 
 int tsrb_drop(tsrb_t *rb, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_empty(rb)) {
-        _pop(rb);
-        tmp--;
+    const uint8_t *data;
+    size_t done = 0;
+    unsigned len;
+
+    while ((done < n) && ((len = tsrb_peek_read(rb, &data)) > 0)) {
+        if (len > (n - done)) {
+            len = n - done;
+        }
+        tsrb_commit_read(rb, len);
+        done += len;
     }
-    return (n - tmp);
+    return done;
 }
 
 int tsrb_add_one(tsrb_t *rb, uint8_t c)
 {
-    if (!tsrb_full(rb)) {
-        _push(rb, c);
+    uint8_t *data;
+
+    if (tsrb_peek_write(rb, &data) > 0) {
+        *data = c;
+        tsrb_commit_write(rb, 1);
         return 0;
     }
     else {
@@ -72,10 +139,19 @@ int tsrb_add_one(tsrb_t *rb, uint8_t c)
 
 int tsrb_add(tsrb_t *rb, const uint8_t *src, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_full(rb)) {
-        _push(rb, *src++);
-        tmp--;
+    uint8_t *data;
+    size_t done = 0;
+    unsigned len;
+
+    /* takes at most two iterations, unless the consumer removes bytes
+     * concurrently */
+    while ((done < n) && ((len = tsrb_peek_write(rb, &data)) > 0)) {
+        if (len > (n - done)) {
+            len = n - done;
+        }
+        memcpy(data, &src[done], len);
+        tsrb_commit_write(rb, len);
+        done += len;
     }
-    return (n - tmp);
+    return done;
 }
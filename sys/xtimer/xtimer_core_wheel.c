@@ -0,0 +1,388 @@
+/**
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup sys_xtimer
+ *
+ * @{
+ * @file
+ * @brief xtimer core functionality based on a hierarchical timer wheel
+ *
+ * Timers are sorted into @ref XTIMER_WHEEL_LEVELS levels of 32 slots each by
+ * their absolute target time. A slot of level 0 spans
+ * 2^@ref XTIMER_WHEEL_SLOT_SHIFT ticks, a slot of level `l` spans 32 slots of
+ * level `l - 1`. When the wheel time reaches the start of a slot, its timers
+ * are cascaded into the next lower level or, on level 0, into a short sorted
+ * list of timers expiring within the current level 0 slot. Timers beyond the
+ * range of the highest level are kept in a separate list that is re-examined
+ * whenever a slot of the highest level starts.
+ *
+ * The low-level timer is only programmed for the start of the next occupied
+ * slot (found via per-level occupancy bitmaps) or the first timer in the
+ * short list, so neither setting a timer nor the ISR needs to walk all active
+ * timers.
+ * @}
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include "board.h"
+#include "periph/timer.h"
+#include "periph_conf.h"
+
+#include "xtimer.h"
+#include "irq.h"
+
+/* WARNING! enabling this will have side effects and can lead to timer underflows. */
+#define ENABLE_DEBUG 0
+#include "debug.h"
+
+#define _SLOT_BITS          (5U)
+#define _SLOTS              (1U << _SLOT_BITS)
+#define _SLOT_MASK          (_SLOTS - 1)
+#define _SHIFT(level)       (XTIMER_WHEEL_SLOT_SHIFT + ((level) * _SLOT_BITS))
+#define _SPAN(level)        ((uint64_t)1 << _SHIFT(level))
+
+/* bucket indexes of the short list of timers firing within the current
+ * level 0 slot and of the list of timers beyond the range of the wheel */
+#define _LOC_NEAR           (XTIMER_WHEEL_LEVELS * _SLOTS)
+#define _LOC_FAR            (_LOC_NEAR + 1)
+#define _LOC_NUMOF          (_LOC_FAR + 1)
+#define _LOC_NONE           (_LOC_NUMOF)
+
+static volatile int _in_handler = 0;
+
+volatile uint64_t _xtimer_current_time = 0;
+
+/* start of the current level 0 slot, all slots before were processed */
+static uint64_t _wheel_time;
+/* time the low-level timer is currently set to */
+static uint64_t _next_target = UINT64_MAX;
+static xtimer_t *_buckets[_LOC_NUMOF];
+static uint32_t _occupied[XTIMER_WHEEL_LEVELS];
+
+static void _add_timer(xtimer_t *timer);
+static void _shoot(xtimer_t *timer);
+static void _schedule_earliest_lltimer(uint64_t now);
+
+static void _timer_callback(void);
+static void _periph_timer_callback(void *arg, int chan);
+
+static inline uint64_t _target(const xtimer_t *timer)
+{
+    return ((((uint64_t)timer->long_start_time) << 32) | timer->start_time) +
+           ((((uint64_t)timer->long_offset) << 32) | timer->offset);
+}
+
+void xtimer_init(void)
+{
+    /* initialize low-level timer */
+    timer_init(XTIMER_DEV, XTIMER_HZ, _periph_timer_callback, NULL);
+
+    uint64_t now = _xtimer_now64();
+
+    _wheel_time = now & ~(_SPAN(0) - 1);
+    for (unsigned i = 0; i < _LOC_NUMOF; i++) {
+        _buckets[i] = NULL;
+    }
+    /* register initial overflow tick */
+    _schedule_earliest_lltimer(now);
+}
+
+uint32_t _xtimer_now(void)
+{
+    return (uint32_t) _xtimer_now64();
+}
+
+/**
+ * @brief   returns the time the next wheel slot with timers starts
+ */
+static uint64_t _next_slot(void)
+{
+    uint64_t next = UINT64_MAX;
+
+    for (unsigned l = 0; l < XTIMER_WHEEL_LEVELS; l++) {
+        if (_occupied[l]) {
+            uint64_t period = _wheel_time >> _SHIFT(l);
+            unsigned cur = (period + 1) & _SLOT_MASK;
+            /* rotate bitmap, so bit 0 represents the slot after the current */
+            uint32_t rot = (_occupied[l] >> cur);
+
+            if (cur) {
+                rot |= (_occupied[l] << (_SLOTS - cur));
+            }
+            uint64_t start = (period + 1 + __builtin_ctzl(rot)) << _SHIFT(l);
+            if (start < next) {
+                next = start;
+            }
+        }
+    }
+    if (_buckets[_LOC_FAR]) {
+        unsigned top = _SHIFT(XTIMER_WHEEL_LEVELS - 1);
+        uint64_t start = ((_wheel_time >> top) + 1) << top;
+
+        if (start < next) {
+            next = start;
+        }
+    }
+    return next;
+}
+
+/**
+ * @brief   returns the time the low-level timer needs to fire next
+ */
+static uint64_t _next_event(void)
+{
+    uint64_t next = _next_slot();
+
+    if (_buckets[_LOC_NEAR] && (_target(_buckets[_LOC_NEAR]) < next)) {
+        next = _target(_buckets[_LOC_NEAR]);
+    }
+    return next;
+}
+
+static void _cascade(unsigned loc)
+{
+    xtimer_t *timer = _buckets[loc];
+
+    _buckets[loc] = NULL;
+    if (loc < _LOC_NEAR) {
+        _occupied[loc / _SLOTS] &= ~(1UL << (loc % _SLOTS));
+    }
+    while (timer) {
+        xtimer_t *next = timer->next;
+
+        _add_timer(timer);
+        timer = next;
+    }
+}
+
+/**
+ * @brief   advance the wheel up to @p now, cascading all slots that started
+ */
+static void _advance(uint64_t now)
+{
+    uint64_t next;
+
+    while ((next = _next_slot()) <= now) {
+        _wheel_time = next;
+        if ((next & (_SPAN(XTIMER_WHEEL_LEVELS - 1) - 1)) == 0) {
+            _cascade(_LOC_FAR);
+        }
+        /* cascade higher levels first, their timers may end up in the current
+         * slot of a lower level */
+        for (unsigned l = XTIMER_WHEEL_LEVELS; l-- > 0;) {
+            if ((next & (_SPAN(l) - 1)) == 0) {
+                _cascade((l * _SLOTS) + ((next >> _SHIFT(l)) & _SLOT_MASK));
+            }
+        }
+    }
+    /* no slots were skipped, so the wheel can just move on */
+    next = now & ~(_SPAN(0) - 1);
+    if (next > _wheel_time) {
+        _wheel_time = next;
+    }
+}
+
+void _xtimer_set64(xtimer_t *timer, uint32_t offset, uint32_t long_offset)
+{
+    DEBUG(" _xtimer_set64() offset=%" PRIu32 " long_offset=%" PRIu32 "\n", offset, long_offset);
+
+    if (!timer->callback) {
+        DEBUG("_xtimer_set64(): timer has no callback.\n");
+        return;
+    }
+
+    xtimer_remove(timer);
+
+    if (!long_offset && offset < XTIMER_BACKOFF) {
+        /* timer fits into the short timer */
+        _xtimer_spin(offset);
+        _shoot(timer);
+        return;
+    }
+
+    /* time sensitive */
+    unsigned int state = irq_disable();
+    uint64_t now = _xtimer_now64();
+    timer->offset = offset;
+    timer->long_offset = long_offset;
+    timer->start_time = (uint32_t)now;
+    timer->long_start_time = (uint32_t)(now >> 32);
+
+    _advance(now);
+    _add_timer(timer);
+    _schedule_earliest_lltimer(now);
+    irq_restore(state);
+}
+
+static void _periph_timer_callback(void *arg, int chan)
+{
+    (void)arg;
+    (void)chan;
+    _timer_callback();
+}
+
+static void _shoot(xtimer_t *timer)
+{
+    timer->callback(timer->arg);
+}
+
+static void _schedule_earliest_lltimer(uint64_t now)
+{
+    uint64_t target = _next_event();
+    uint64_t max = now + (_xtimer_lltimer_mask(0xFFFFFFFF) >> 1);
+
+    if (_in_handler) {
+        return;
+    }
+    if (target > max) {
+        /* schedule lltimer after max_low_level_time/2 to detect a cycle */
+        target = max;
+    }
+    if (target >= _next_target) {
+        /* lltimer is already running and fires early enough */
+        return;
+    }
+    if (target < (now + XTIMER_ISR_BACKOFF)) {
+        target = now + XTIMER_ISR_BACKOFF;
+    }
+
+    DEBUG("_schedule_earliest_lltimer(): setting %" PRIu32 "\n",
+          _xtimer_lltimer_mask((uint32_t)target));
+    timer_set_absolute(XTIMER_DEV, XTIMER_CHAN,
+                       _xtimer_lltimer_mask((uint32_t)target));
+    _next_target = target;
+}
+
+/**
+ * @brief add a timer to the bucket its target time belongs to
+ */
+static void _add_timer(xtimer_t *timer)
+{
+    uint64_t target = _target(timer);
+    unsigned loc = _LOC_FAR;
+
+    if (target < (_wheel_time + _SPAN(0))) {
+        xtimer_t **list_head = &_buckets[_LOC_NEAR];
+
+        /* keep list sorted, timers with equal target fire in order of setting */
+        while (*list_head && (_target(*list_head) <= target)) {
+            list_head = &((*list_head)->next);
+        }
+        timer->next = *list_head;
+        timer->wheel_loc = _LOC_NEAR;
+        *list_head = timer;
+        return;
+    }
+    for (unsigned l = 0; l < XTIMER_WHEEL_LEVELS; l++) {
+        if ((target - _wheel_time) < _SPAN(l + 1)) {
+            unsigned slot = (target >> _SHIFT(l)) & _SLOT_MASK;
+
+            _occupied[l] |= (1UL << slot);
+            loc = (l * _SLOTS) + slot;
+            break;
+        }
+    }
+    timer->next = _buckets[loc];
+    timer->wheel_loc = loc;
+    _buckets[loc] = timer;
+}
+
+/**
+ * @brief remove a timer from the bucket it is stored in
+ */
+static void _remove_timer(xtimer_t *timer)
+{
+    /* an unset timer might contain garbage, so only trust wheel_loc to name
+     * the bucket to search */
+    unsigned loc = timer->wheel_loc;
+    xtimer_t **list_head;
+
+    if (loc >= _LOC_NUMOF) {
+        return;
+    }
+    list_head = &_buckets[loc];
+    while (*list_head) {
+        if (*list_head == timer) {
+            *list_head = timer->next;
+            timer->next = NULL;
+            timer->wheel_loc = _LOC_NONE;
+            if ((loc < _LOC_NEAR) && (_buckets[loc] == NULL)) {
+                _occupied[loc / _SLOTS] &= ~(1UL << (loc % _SLOTS));
+            }
+            return;
+        }
+        list_head = &((*list_head)->next);
+    }
+}
+
+void xtimer_remove(xtimer_t *timer)
+{
+    /* time sensitive since the target timer can be fired */
+    unsigned int state = irq_disable();
+    _remove_timer(timer);
+    timer->offset = 0;
+    timer->long_offset = 0;
+    timer->start_time = 0;
+    timer->long_start_time = 0;
+    irq_restore(state);
+}
+
+/**
+ * @brief fire timers that are close to expiry
+ */
+static void _fire_near_timers(uint64_t *now)
+{
+    xtimer_t *timer;
+
+    while ((timer = _buckets[_LOC_NEAR]) &&
+           (_target(timer) <= (*now + XTIMER_ISR_BACKOFF))) {
+        uint64_t target = _target(timer);
+
+        /* make sure we don't fire too early */
+        while (_xtimer_now64() < target) {}
+        /* advance list */
+        _buckets[_LOC_NEAR] = timer->next;
+        /* make sure timer is recognized as being already fired */
+        timer->offset = 0;
+        timer->long_offset = 0;
+        timer->start_time = 0;
+        timer->long_start_time = 0;
+        timer->next = NULL;
+        timer->wheel_loc = _LOC_NONE;
+        /* fire timer */
+        _shoot(timer);
+        /* update current_time */
+        *now = _xtimer_now64();
+    }
+}
+
+/**
+ * @brief main xtimer callback function (called in an interrupt context)
+ */
+static void _timer_callback(void)
+{
+    uint64_t now;
+
+    _in_handler = 1;
+    _next_target = UINT64_MAX;
+    now = _xtimer_now64();
+
+    do {
+        _advance(now);
+        _fire_near_timers(&now);
+        /* update current time */
+        now = _xtimer_now64();
+        /* make sure we're not setting a time in the past */
+    } while (_next_event() < (now + XTIMER_ISR_BACKOFF));
+    _in_handler = 0;
+
+    /* set low level timer */
+    _schedule_earliest_lltimer(now);
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure dispatching CoAP requests to resources
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "net/nanocoap.h"
+#include "xtimer.h"
+
+#ifndef TEST_RUNS
+#define TEST_RUNS           (1000U)
+#endif
+
+#define _BUF_SIZE           (64U)
+
+static ssize_t _handler(coap_pkt_t *pkt, uint8_t *buf, size_t len, void *ctx)
+{
+    /* reply with the index of the resource, so the variants can be compared */
+    return coap_reply_simple(pkt, COAP_CODE_CONTENT, buf, len, COAP_FORMAT_TEXT,
+                             (uint8_t *)&ctx, sizeof(ctx));
+}
+
+#define _RES(x, y)      { "/sensor/" #x #y, COAP_GET, _handler, \
+                          (void *)(uintptr_t)0x ## x ## y },
+#define _RES16(x)       _RES(x, 0) _RES(x, 1) _RES(x, 2) _RES(x, 3) \
+                        _RES(x, 4) _RES(x, 5) _RES(x, 6) _RES(x, 7) \
+                        _RES(x, 8) _RES(x, 9) _RES(x, a) _RES(x, b) \
+                        _RES(x, c) _RES(x, d) _RES(x, e) _RES(x, f)
+
+const coap_resource_t coap_resources[] = {
+    _RES16(0) _RES16(1) _RES16(2) _RES16(3)
+    _RES16(4) _RES16(5) _RES16(6) _RES16(7)
+    _RES16(8) _RES16(9) _RES16(a) _RES16(b)
+    _RES16(c) _RES16(d) _RES16(e) _RES16(f)
+};
+
+const unsigned coap_resources_numof = ARRAY_SIZE(coap_resources);
+
+static uint8_t _req_buf[_BUF_SIZE];
+static uint8_t _resp_buf[_BUF_SIZE];
+
+/* resource lookup coap_handle_req() did before it binary searched resources */
+static ssize_t _linear(coap_pkt_t *pkt, uint8_t *resp_buf, unsigned resp_buf_len)
+{
+    coap_method_flags_t method_flag = coap_method2flag(coap_get_code_detail(pkt));
+
+    uint8_t uri[NANOCOAP_URI_MAX];
+    if (coap_get_uri_path(pkt, uri) <= 0) {
+        return -EBADMSG;
+    }
+
+    for (unsigned i = 0; i < coap_resources_numof; i++) {
+        const coap_resource_t *resource = &coap_resources[i];
+        if (!(resource->methods & method_flag)) {
+            continue;
+        }
+
+        int res = coap_match_path(resource, uri);
+        if (res > 0) {
+            continue;
+        }
+        else if (res < 0) {
+            break;
+        }
+        else {
+            return resource->handler(pkt, resp_buf, resp_buf_len, resource->context);
+        }
+    }
+
+    return coap_build_reply(pkt, COAP_CODE_404, resp_buf, resp_buf_len, 0);
+}
+
+static void _run(const char *name, const char *path,
+                 ssize_t (*handle)(coap_pkt_t *, uint8_t *, unsigned))
+{
+    coap_pkt_t pkt;
+    ssize_t res = 0;
+    uint32_t start, time;
+    uint8_t *pos = _req_buf;
+
+    pos += coap_build_hdr((coap_hdr_t *)pos, COAP_TYPE_NON, NULL, 0,
+                          COAP_METHOD_GET, 1);
+    pos += coap_opt_put_uri_path(pos, 0, path);
+    coap_parse(&pkt, _req_buf, pos - _req_buf);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        res = handle(&pkt, _resp_buf, sizeof(_resp_buf));
+    }
+    time = xtimer_now_usec() - start;
+    printf("{ \"variant\" : \"%s\", \"path\" : \"%s\", "
+           "\"time_us\" : %" PRIu32 ", \"res\" : %d }\n",
+           name, path, time, (int)res);
+}
+
+int main(void)
+{
+    static const char *paths[] = {
+        "/sensor/00", "/sensor/7f", "/sensor/ff", "/sensor/zz",
+    };
+
+    puts("main starting");
+
+    for (unsigned i = 0; i < ARRAY_SIZE(paths); i++) {
+        _run("linear", paths[i], _linear);
+        _run("coap_handle_req", paths[i], coap_handle_req);
+    }
+    puts("done");
+
+    return 0;
+}
@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for path in ("/sensor/00", "/sensor/7f", "/sensor/ff", "/sensor/zz"):
+        results = set()
+        for variant in ("linear", "coap_handle_req"):
+            child.expect(r"{ \"variant\" : \"%s\", \"path\" : \"%s\", "
+                         r"\"time_us\" : \d+, \"res\" : (-?\d+) }"
+                         % (variant, path))
+            results.add(child.match.group(1))
+        # both variants must dispatch to the same resource
+        assert len(results) == 1
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure next hop lookups in FIB tables of different sizes
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "net/fib.h"
+#include "xtimer.h"
+
+#define ENTRIES_MAX         (2048U)
+#define NEXT_HOPS           (16U)
+#define LOOKUPS             (10000U)
+#define ADDR_SIZE           (16U)
+#define PREFIX_LEN          (64U)
+
+static const unsigned _entries[] = { 16, 256, ENTRIES_MAX };
+
+static fib_entry_t _fib_entries[ENTRIES_MAX];
+static fib_table_t _fib_table = { .data.entries = _fib_entries,
+                                  .table_type = FIB_TABLE_TYPE_SH };
+
+static uint32_t _scramble(uint32_t i)
+{
+    return i * 2654435761U;
+}
+
+/* 2001:db8:XXXX:XXXX::/64, the prefixes are spread over the address space */
+static void _prefix(uint8_t *addr, unsigned idx)
+{
+    uint32_t bits = _scramble(idx);
+
+    memset(addr, 0, ADDR_SIZE);
+    addr[0] = 0x20;
+    addr[1] = 0x01;
+    addr[2] = 0x0d;
+    addr[3] = 0xb8;
+    memcpy(&addr[4], &bits, sizeof(bits));
+}
+
+/* fe80::X */
+static void _next_hop(uint8_t *addr, unsigned idx)
+{
+    memset(addr, 0, ADDR_SIZE);
+    addr[0] = 0xfe;
+    addr[1] = 0x80;
+    addr[ADDR_SIZE - 1] = 1 + (idx % NEXT_HOPS);
+}
+
+static unsigned _fill(unsigned entries)
+{
+    uint8_t dst[ADDR_SIZE];
+    uint8_t next_hop[ADDR_SIZE];
+    unsigned errors = 0;
+
+    _fib_table.size = entries;
+    fib_init(&_fib_table);
+    for (unsigned i = 0; i < entries; i++) {
+        _prefix(dst, i);
+        _next_hop(next_hop, i);
+        if (fib_add_entry(&_fib_table, 1, dst, sizeof(dst),
+                          (PREFIX_LEN << FIB_FLAG_NET_PREFIX_SHIFT), next_hop,
+                          sizeof(next_hop), 0,
+                          (uint32_t)FIB_LIFETIME_NO_EXPIRE) != 0) {
+            errors++;
+        }
+    }
+    return errors;
+}
+
+int main(void)
+{
+    for (unsigned i = 0; i < ARRAY_SIZE(_entries); i++) {
+        unsigned entries = _entries[i];
+        unsigned errors = _fill(entries);
+        uint8_t dst[ADDR_SIZE];
+        uint8_t expected[ADDR_SIZE];
+        uint8_t next_hop[ADDR_SIZE];
+
+        uint32_t start = xtimer_now_usec();
+        for (unsigned n = 0; n < LOOKUPS; n++) {
+            unsigned idx = n % entries;
+            size_t next_hop_size = sizeof(next_hop);
+            uint32_t next_hop_flags;
+            uint32_t iid = _scramble(n);
+            kernel_pid_t iface;
+
+            _prefix(dst, idx);
+            memcpy(&dst[ADDR_SIZE - sizeof(iid)], &iid, sizeof(iid));
+            if (fib_get_next_hop(&_fib_table, &iface, next_hop, &next_hop_size,
+                                 &next_hop_flags, dst, sizeof(dst), 0) != 0) {
+                errors++;
+                continue;
+            }
+            _next_hop(expected, idx);
+            errors += (memcmp(next_hop, expected, sizeof(expected)) != 0);
+        }
+        uint32_t time_us = xtimer_now_usec() - start;
+
+        printf("{ \"entries\" : %u, \"lookups\" : %u, \"time_us\" : %" PRIu32 ", "
+               "\"errors\" : %u }\n", entries, LOOKUPS, time_us, errors);
+        fib_deinit(&_fib_table);
+    }
+    puts("done");
+
+    return 0;
+}
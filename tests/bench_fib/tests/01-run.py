@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+LOOKUPS = 10000
+
+
+def testfunc(child):
+    for entries in (16, 256, 2048):
+        child.expect(r"{ \"entries\" : %d, \"lookups\" : (\d+), "
+                     r"\"time_us\" : \d+, \"errors\" : (\d+) }" % entries,
+                     timeout=120)
+        assert int(child.match.group(1)) == LOOKUPS
+        assert int(child.match.group(2)) == 0
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure block-wise transfers with gcoap
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/gcoap.h"
+#include "net/gcoap_block.h"
+#include "net/ipv6/addr.h"
+#include "xtimer.h"
+
+#define BODY_LEN            (256U * 1024U)
+
+/* block size exponent for 1 KiB blocks */
+#define SZX                 (6U)
+
+static const unsigned _windows[] = { 1, 2, 4 };
+
+/* corrupted bytes seen by sink or server, and bytes the server received */
+static unsigned _errors;
+static size_t _received;
+
+static uint8_t _body_byte(size_t offset)
+{
+    return (uint8_t)(offset ^ (offset >> 8));
+}
+
+static unsigned _check(size_t offset, const uint8_t *buf, size_t len)
+{
+    unsigned errors = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        errors += (buf[i] != _body_byte(offset + i));
+    }
+    return errors;
+}
+
+static ssize_t _get_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                            void *ctx)
+{
+    (void)ctx;
+    coap_block_slicer_t slicer;
+
+    coap_block2_init(pdu, &slicer);
+    if (slicer.start >= BODY_LEN) {
+        return gcoap_response(pdu, buf, len, COAP_CODE_BAD_OPTION);
+    }
+    gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+    coap_opt_add_block2(pdu, &slicer, 1);
+    ssize_t plen = coap_opt_finish(pdu, COAP_OPT_FINISH_PAYLOAD);
+
+    size_t end = (slicer.end < BODY_LEN) ? slicer.end : BODY_LEN;
+    for (size_t i = slicer.start; i < end; i++) {
+        pdu->payload[i - slicer.start] = _body_byte(i);
+    }
+    /* the slicer sets the more flag if the body continues after the block */
+    slicer.cur = BODY_LEN;
+    coap_block2_finish(&slicer);
+
+    return plen + (end - slicer.start);
+}
+
+static ssize_t _put_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                            void *ctx)
+{
+    (void)ctx;
+    coap_block1_t block1;
+    unsigned code = COAP_CODE_CHANGED;
+
+    if (coap_get_block1(pdu, &block1)) {
+        _errors += _check(block1.offset, pdu->payload, pdu->payload_len);
+        _received += pdu->payload_len;
+        if (block1.more == 1) {
+            code = COAP_CODE_CONTINUE;
+        }
+    }
+    if ((code == COAP_CODE_CHANGED) && (_received != BODY_LEN)) {
+        code = COAP_CODE_BAD_REQUEST;
+    }
+    gcoap_resp_init(pdu, buf, len, code);
+    coap_opt_add_block1_control(pdu, &block1);
+    return coap_opt_finish(pdu, COAP_OPT_FINISH_NONE);
+}
+
+static ssize_t _body_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             void *ctx)
+{
+    if (coap_method2flag(coap_get_code_detail(pdu)) == COAP_PUT) {
+        return _put_handler(pdu, buf, len, ctx);
+    }
+    return _get_handler(pdu, buf, len, ctx);
+}
+
+static const coap_resource_t _resources[] = {
+    { "/body", COAP_GET | COAP_PUT, _body_handler, NULL },
+};
+
+static gcoap_listener_t _listener = {
+    .resources     = &_resources[0],
+    .resources_len = ARRAY_SIZE(_resources),
+    .link_encoder  = NULL,
+    .next          = NULL,
+};
+
+static int _sink(void *arg, size_t offset, const uint8_t *buf, size_t len,
+                 bool more)
+{
+    (void)arg;
+    (void)more;
+    _errors += _check(offset, buf, len);
+    return 0;
+}
+
+static ssize_t _source(void *arg, size_t offset, uint8_t *buf, size_t len)
+{
+    (void)arg;
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = _body_byte(offset + i);
+    }
+    return len;
+}
+
+int main(void)
+{
+    sock_udp_ep_t remote = {
+        .family = AF_INET6,
+        .netif = SOCK_ADDR_ANY_NETIF,
+        .port = CONFIG_GCOAP_PORT,
+    };
+
+    memcpy(remote.addr.ipv6, &ipv6_addr_loopback, sizeof(ipv6_addr_t));
+    gcoap_register_listener(&_listener);
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_windows); i++) {
+        _errors = 0;
+        uint32_t start = xtimer_now_usec();
+        ssize_t res = gcoap_block2_get(&remote, "/body", SZX, _windows[i],
+                                       _sink, NULL);
+        uint32_t time = xtimer_now_usec() - start;
+
+        printf("{ \"dir\" : \"get\", \"window\" : %u, \"res\" : %d, "
+               "\"time_us\" : %" PRIu32 ", \"errors\" : %u }\n",
+               _windows[i], (int)res, time, _errors);
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(_windows); i++) {
+        _errors = 0;
+        _received = 0;
+        uint32_t start = xtimer_now_usec();
+        int res = gcoap_block1_send(&remote, "/body", COAP_METHOD_PUT,
+                                    BODY_LEN, SZX, _windows[i], _source, NULL);
+        uint32_t time = xtimer_now_usec() - start;
+
+        printf("{ \"dir\" : \"put\", \"window\" : %u, \"res\" : %d, "
+               "\"time_us\" : %" PRIu32 ", \"errors\" : %u }\n",
+               _windows[i], res, time, _errors);
+    }
+    puts("done");
+
+    return 0;
+}
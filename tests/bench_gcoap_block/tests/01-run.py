@@ -0,0 +1,30 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+BODY_LEN = 256 * 1024
+# raw CoAP code 2.04 Changed
+CODE_CHANGED = (2 << 5) | 4
+
+
+def testfunc(child):
+    for direction, res in (("get", BODY_LEN), ("put", CODE_CHANGED)):
+        for window in (1, 2, 4):
+            child.expect(r"{ \"dir\" : \"%s\", \"window\" : %d, "
+                         r"\"res\" : (-?\d+), \"time_us\" : \d+, "
+                         r"\"errors\" : (\d+) }" % (direction, window),
+                         timeout=60)
+            assert int(child.match.group(1)) == res
+            assert int(child.match.group(2)) == 0
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure neighbor cache and forwarding table lookups in the NIB
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/ethernet.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/netif/ethernet.h"
+#include "net/netdev_test.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define LOOKUPS             (1000U)
+#define PREFIX_LEN          (64U)
+
+/* leave room for the entries the interface initialization creates */
+#define NC_ENTRIES          (GNRC_IPV6_NIB_NUMOF / 2)
+#define FT_ENTRIES          (GNRC_IPV6_NIB_OFFL_NUMOF / 2)
+
+static const uint8_t _l2addr[] = { 0xce, 0xab, 0xfe, 0xad, 0xf7, 0x26 };
+static const uint8_t _rem_l2[] = { 0xce, 0xab, 0xfe, 0xad, 0xf7, 0x27 };
+/* fe80::ccab:feff:fead:f727 */
+static const ipv6_addr_t _rem_ll = { {
+        0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0xcc, 0xab, 0xfe, 0xff, 0xfe, 0xad, 0xf7, 0x27
+    } };
+/* 2001:18c9:f800::ccab:feff:fead:f727 */
+static const ipv6_addr_t _rem_gb = { {
+        0x20, 0x01, 0x18, 0xc9, 0xf8, 0x00, 0x00, 0x00,
+        0xcc, 0xab, 0xfe, 0xff, 0xfe, 0xad, 0xf7, 0x27
+    } };
+
+static netdev_test_t _netdev;
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+
+static int _get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = NETDEV_TYPE_ETHERNET;
+    return sizeof(uint16_t);
+}
+
+static int _get_max_packet_size(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = ETHERNET_DATA_LEN;
+    return sizeof(uint16_t);
+}
+
+static int _get_address(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    assert(max_len >= sizeof(_l2addr));
+    memcpy(value, _l2addr, sizeof(_l2addr));
+    return sizeof(_l2addr);
+}
+
+/* the neighbor fe80::ccab:feff:fead:XXXX */
+static void _nc_addr(ipv6_addr_t *addr, unsigned idx)
+{
+    memcpy(addr, &_rem_ll, sizeof(*addr));
+    addr->u8[14] = idx >> 8;
+    addr->u8[15] = idx & 0xff;
+}
+
+/* the prefix 2001:18c9:f800:XXXX::/64 */
+static void _ft_addr(ipv6_addr_t *addr, unsigned idx)
+{
+    memcpy(addr, &_rem_gb, sizeof(*addr));
+    addr->u8[6] = idx >> 8;
+    addr->u8[7] = idx & 0xff;
+}
+
+int main(void)
+{
+    gnrc_netif_t *netif;
+    gnrc_ipv6_nib_nc_t nce;
+    gnrc_ipv6_nib_ft_t fte;
+    ipv6_addr_t addr;
+    unsigned errors = 0;
+
+    netdev_test_setup(&_netdev, 0);
+    netdev_test_set_get_cb(&_netdev, NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_get_cb(&_netdev, NETOPT_MAX_PDU_SIZE,
+                           _get_max_packet_size);
+    netdev_test_set_get_cb(&_netdev, NETOPT_ADDRESS, _get_address);
+    netif = gnrc_netif_ethernet_create(_netif_stack, sizeof(_netif_stack),
+                                       GNRC_NETIF_PRIO, "mockup_eth",
+                                       &_netdev.netdev);
+    assert(netif != NULL);
+
+    for (unsigned i = 0; i < FT_ENTRIES; i++) {
+        _ft_addr(&addr, i);
+        if (gnrc_ipv6_nib_ft_add(&addr, PREFIX_LEN, &_rem_ll, netif->pid,
+                                 0) != 0) {
+            errors++;
+        }
+    }
+    for (unsigned i = 0; i < NC_ENTRIES; i++) {
+        _nc_addr(&addr, i);
+        if (gnrc_ipv6_nib_nc_set(&addr, netif->pid, _rem_l2,
+                                 sizeof(_rem_l2)) != 0) {
+            errors++;
+        }
+    }
+
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < LOOKUPS; i++) {
+        _nc_addr(&addr, i % NC_ENTRIES);
+        if (gnrc_ipv6_nib_get_next_hop_l2addr(&addr, netif, NULL, &nce) != 0) {
+            errors++;
+        }
+    }
+    uint32_t nc_us = xtimer_now_usec() - start;
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < LOOKUPS; i++) {
+        _ft_addr(&addr, i % FT_ENTRIES);
+        if ((gnrc_ipv6_nib_ft_get(&addr, NULL, &fte) != 0) ||
+            (fte.dst_len != PREFIX_LEN)) {
+            errors++;
+        }
+    }
+    uint32_t ft_us = xtimer_now_usec() - start;
+
+    printf("{ \"nc_entries\" : %u, \"ft_entries\" : %u, \"lookups\" : %u, "
+           "\"nc_us\" : %" PRIu32 ", \"ft_us\" : %" PRIu32 " }\n",
+           (unsigned)NC_ENTRIES, (unsigned)FT_ENTRIES, LOOKUPS, nc_us, ft_us);
+    if (errors) {
+        printf("%u errors\n", errors);
+        return 1;
+    }
+    puts("done");
+
+    return 0;
+}
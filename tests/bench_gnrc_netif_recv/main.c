@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the receive path of the GNRC Ethernet interface
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "iolist.h"
+#include "net/ethernet.h"
+#include "net/ethertype.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/ethernet.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/netdev/eth.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_FRAMES
+#define TEST_FRAMES         (10000U)
+#endif
+
+#ifndef TEST_PAYLOAD_LEN
+#define TEST_PAYLOAD_LEN    (1280U)
+#endif
+
+#define TEST_FRAME_LEN      (sizeof(ethernet_hdr_t) + TEST_PAYLOAD_LEN)
+
+static const uint8_t _addr[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+static const uint8_t _remote[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x02 };
+
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+/* stands in for the frame buffer of a network device */
+static uint8_t _frame[TEST_FRAME_LEN];
+static netdev_t _dev;
+
+static int _init(netdev_t *dev)
+{
+    (void)dev;
+    return 0;
+}
+
+static void _isr(netdev_t *dev)
+{
+    (void)dev;
+}
+
+static int _send(netdev_t *dev, const iolist_t *iolist)
+{
+    (void)dev;
+    return iolist_size(iolist);
+}
+
+static int _recv(netdev_t *dev, void *buf, size_t len, void *info)
+{
+    (void)dev;
+    (void)info;
+    if (buf == NULL) {
+        return sizeof(_frame);
+    }
+    if (len < sizeof(_frame)) {
+        return -ENOBUFS;
+    }
+    memcpy(buf, _frame, sizeof(_frame));
+    return sizeof(_frame);
+}
+
+static int _recv_iol(netdev_t *dev, const iolist_t *iolist, void *info)
+{
+    size_t offset = 0;
+
+    (void)dev;
+    (void)info;
+    for (; (iolist != NULL) && (offset < sizeof(_frame));
+         iolist = iolist->iol_next) {
+        size_t len = sizeof(_frame) - offset;
+
+        if (len > iolist->iol_len) {
+            len = iolist->iol_len;
+        }
+        memcpy(iolist->iol_base, &_frame[offset], len);
+        offset += len;
+    }
+    return (offset < sizeof(_frame)) ? -ENOBUFS : (int)offset;
+}
+
+static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
+{
+    if (opt == NETOPT_ADDRESS) {
+        if (max_len < sizeof(_addr)) {
+            return -EINVAL;
+        }
+        memcpy(value, _addr, sizeof(_addr));
+        return sizeof(_addr);
+    }
+    return netdev_eth_get(dev, opt, value, max_len);
+}
+
+static int _set(netdev_t *dev, netopt_t opt, const void *value, size_t len)
+{
+    return netdev_eth_set(dev, opt, value, len);
+}
+
+/* a driver that only provides recv() has to copy the whole frame into one
+ * buffer that is split up afterwards */
+static const netdev_driver_t _frame_driver = {
+    .send = _send,
+    .recv = _recv,
+    .init = _init,
+    .isr = _isr,
+    .get = _get,
+    .set = _set,
+};
+
+static const netdev_driver_t _scattered_driver = {
+    .send = _send,
+    .recv = _recv,
+    .recv_iol = _recv_iol,
+    .init = _init,
+    .isr = _isr,
+    .get = _get,
+    .set = _set,
+};
+
+static void _run(gnrc_netif_t *netif, const char *name,
+                 const netdev_driver_t *driver)
+{
+    unsigned fails = 0;
+    uint32_t start, time;
+
+    _dev.driver = driver;
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_FRAMES; i++) {
+        gnrc_pktsnip_t *pkt = netif->ops->recv(netif);
+
+        if ((pkt == NULL) || (pkt->size != TEST_PAYLOAD_LEN) ||
+            (pkt->next == NULL) || (pkt->next->type != GNRC_NETTYPE_NETIF)) {
+            fails++;
+        }
+        if (pkt != NULL) {
+            gnrc_pktbuf_release(pkt);
+        }
+    }
+    time = xtimer_now_usec() - start;
+    printf("{ \"variant\" : \"%s\", \"frames\" : %u, \"time_us\" : %" PRIu32
+           ", \"fails\" : %u }\n", name, TEST_FRAMES, time, fails);
+}
+
+int main(void)
+{
+    ethernet_hdr_t *hdr = (ethernet_hdr_t *)_frame;
+    gnrc_netif_t *netif;
+
+    puts("main starting");
+
+    memcpy(hdr->dst, _addr, sizeof(_addr));
+    memcpy(hdr->src, _remote, sizeof(_remote));
+    hdr->type = byteorder_htons(ETHERTYPE_IPV6);
+    for (unsigned i = sizeof(ethernet_hdr_t); i < sizeof(_frame); i++) {
+        _frame[i] = (uint8_t)i;
+    }
+
+    _dev.driver = &_frame_driver;
+    netif = gnrc_netif_ethernet_create(_netif_stack, sizeof(_netif_stack),
+                                       GNRC_NETIF_PRIO, "bench", &_dev);
+    _run(netif, "frame", &_frame_driver);
+    _run(netif, "scattered", &_scattered_driver);
+    puts("done");
+
+    return 0;
+}
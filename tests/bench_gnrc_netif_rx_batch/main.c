@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the rate of received packets GNRC can take in
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "iolist.h"
+#include "msg.h"
+#include "net/ethernet.h"
+#include "net/ethertype.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/ethernet.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev.h"
+#include "net/netdev/eth.h"
+#include "net/protnum.h"
+#include "net/udp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_BURSTS
+#define TEST_BURSTS         (1000U)
+#endif
+
+/* must fit into the message queue of the interface thread */
+#ifndef TEST_BURST_LEN
+#define TEST_BURST_LEN      (8U)
+#endif
+
+#ifndef TEST_PAYLOAD_LEN
+#define TEST_PAYLOAD_LEN    (64U)
+#endif
+
+#define TEST_FRAME_LEN      (sizeof(ethernet_hdr_t) + sizeof(ipv6_hdr_t) + \
+                             sizeof(udp_hdr_t) + TEST_PAYLOAD_LEN)
+
+static const uint8_t _addr[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+static const uint8_t _remote[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x02 };
+
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static char _isr_stack[THREAD_STACKSIZE_DEFAULT];
+static uint8_t _frame[TEST_FRAME_LEN];
+static netdev_t _dev;
+
+static int _init(netdev_t *dev)
+{
+    (void)dev;
+    return 0;
+}
+
+static void _isr(netdev_t *dev)
+{
+    dev->event_callback(dev, NETDEV_EVENT_RX_COMPLETE);
+}
+
+static int _send(netdev_t *dev, const iolist_t *iolist)
+{
+    (void)dev;
+    return iolist_size(iolist);
+}
+
+static int _recv(netdev_t *dev, void *buf, size_t len, void *info)
+{
+    (void)dev;
+    (void)info;
+    if (buf == NULL) {
+        return sizeof(_frame);
+    }
+    if (len < sizeof(_frame)) {
+        return -ENOBUFS;
+    }
+    memcpy(buf, _frame, sizeof(_frame));
+    return sizeof(_frame);
+}
+
+static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
+{
+    if (opt == NETOPT_ADDRESS) {
+        if (max_len < sizeof(_addr)) {
+            return -EINVAL;
+        }
+        memcpy(value, _addr, sizeof(_addr));
+        return sizeof(_addr);
+    }
+    return netdev_eth_get(dev, opt, value, max_len);
+}
+
+static int _set(netdev_t *dev, netopt_t opt, const void *value, size_t len)
+{
+    return netdev_eth_set(dev, opt, value, len);
+}
+
+static const netdev_driver_t _driver = {
+    .send = _send,
+    .recv = _recv,
+    .init = _init,
+    .isr = _isr,
+    .get = _get,
+    .set = _set,
+};
+
+/* runs above the interface thread, so a whole burst of frames is pending
+ * before the interface gets to handle the first, like when an interrupt
+ * fires for every frame of a burst */
+static void *_isr_thread(void *arg)
+{
+    (void)arg;
+    while (1) {
+        thread_sleep();
+        for (unsigned i = 0; i < TEST_BURST_LEN; i++) {
+            _dev.event_callback(&_dev, NETDEV_EVENT_ISR);
+        }
+    }
+    return NULL;
+}
+
+static void _init_frame(void)
+{
+    ethernet_hdr_t *eth = (ethernet_hdr_t *)_frame;
+    ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)(eth + 1);
+    udp_hdr_t *udp = (udp_hdr_t *)(ipv6 + 1);
+
+    /* all-nodes multicast, so no address configuration is needed */
+    memcpy(eth->dst, ((uint8_t []){ 0x33, 0x33, 0x00, 0x00, 0x00, 0x01 }),
+           ETHERNET_ADDR_LEN);
+    memcpy(eth->src, _remote, sizeof(_remote));
+    eth->type = byteorder_htons(ETHERTYPE_IPV6);
+    ipv6_hdr_set_version(ipv6);
+    ipv6->len = byteorder_htons(sizeof(udp_hdr_t) + TEST_PAYLOAD_LEN);
+    ipv6->nh = PROTNUM_UDP;
+    ipv6->hl = 64;
+    ipv6->src.u8[0] = 0xfe;
+    ipv6->src.u8[1] = 0x80;
+    ipv6->src.u8[15] = 0x02;
+    ipv6_addr_set_all_nodes_multicast(&ipv6->dst, IPV6_ADDR_MCAST_SCP_LINK_LOCAL);
+    udp->src_port = byteorder_htons(61616);
+    udp->dst_port = byteorder_htons(61617);
+    udp->length = ipv6->len;
+}
+
+int main(void)
+{
+    kernel_pid_t isr_pid;
+    uint32_t start, time;
+
+    puts("main starting");
+
+    _init_frame();
+    _dev.driver = &_driver;
+    gnrc_netif_ethernet_create(_netif_stack, sizeof(_netif_stack),
+                               GNRC_NETIF_PRIO, "bench", &_dev);
+    isr_pid = thread_create(_isr_stack, sizeof(_isr_stack),
+                            GNRC_NETIF_PRIO - 1, THREAD_CREATE_STACKTEST,
+                            _isr_thread, NULL, "isr");
+    /* let the interface settle after start-up */
+    xtimer_sleep(1);
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_BURSTS; i++) {
+        /* main has the lowest priority, so when thread_wakeup() returns,
+         * the burst was handled by all layers */
+        thread_wakeup(isr_pid);
+    }
+    time = xtimer_now_usec() - start;
+    printf("{ \"batching\" : %s, \"pkts\" : %u, \"time_us\" : %" PRIu32
+           ", \"pps\" : %" PRIu32 " }\n",
+           IS_USED(MODULE_GNRC_NETIF_RX_BATCH) ? "true" : "false",
+           TEST_BURSTS * TEST_BURST_LEN, time,
+           (uint32_t)(((uint64_t)TEST_BURSTS * TEST_BURST_LEN * US_PER_SEC) /
+                      (time ? time : 1)));
+    puts("done");
+
+    return 0;
+}
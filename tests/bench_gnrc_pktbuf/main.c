@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure packet buffer allocation cost under bursty load
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "kernel_defines.h"
+#include "net/gnrc/pktbuf.h"
+#include "xtimer.h"
+
+#ifndef TEST_ROUNDS
+#define TEST_ROUNDS         (100000U)
+#endif
+
+#ifndef TEST_WINDOW
+#define TEST_WINDOW         (8U)
+#endif
+
+#ifndef PKTBUF_BACKEND
+#define PKTBUF_BACKEND      "unknown"
+#endif
+
+/* typical payload sizes: ACKs, 802.15.4 frames, mid-sized, full IPv6 MTU */
+static const uint16_t _sizes[] = { 40, 80, 127, 300, 1280 };
+
+static gnrc_pktsnip_t *_window[TEST_WINDOW];
+static uint32_t _state = 0x2f6b1d3bU;
+
+/* xorshift32, deterministic so all backends see the same sequence */
+static uint32_t _rand(void)
+{
+    _state ^= _state << 13;
+    _state ^= _state >> 17;
+    _state ^= _state << 5;
+    return _state;
+}
+
+static gnrc_pktsnip_t *_alloc_pkt(uint32_t rnd)
+{
+    size_t size = _sizes[rnd % ARRAY_SIZE(_sizes)];
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, size,
+                                          GNRC_NETTYPE_UNDEF);
+
+    if (pkt == NULL) {
+        return NULL;
+    }
+    /* split off one or two headers like the receive path would */
+    for (unsigned i = 0; i <= ((rnd >> 8) & 1); i++) {
+        size_t hdr_len = 4 + ((rnd >> (9 + (i * 4))) & 0xf) * 2;
+
+        if ((hdr_len >= pkt->size) ||
+            (gnrc_pktbuf_mark(pkt, hdr_len, GNRC_NETTYPE_UNDEF) == NULL)) {
+            break;
+        }
+    }
+    return pkt;
+}
+
+int main(void)
+{
+    uint32_t fails = 0;
+    uint32_t start, time;
+
+    printf("main starting (backend: %s)\n", PKTBUF_BACKEND);
+
+    start = xtimer_now_usec();
+    for (unsigned n = 0; n < TEST_ROUNDS; n++) {
+        uint32_t rnd = _rand();
+        unsigned idx = rnd % TEST_WINDOW;
+
+        /* bursts: release less often than allocating, so buffer fills up */
+        if ((_window[idx] != NULL) && ((rnd >> 16) & 0x3)) {
+            gnrc_pktbuf_release(_window[idx]);
+            _window[idx] = NULL;
+        }
+        if (_window[idx] == NULL) {
+            if ((_window[idx] = _alloc_pkt(rnd)) == NULL) {
+                fails++;
+            }
+        }
+    }
+    for (unsigned i = 0; i < TEST_WINDOW; i++) {
+        gnrc_pktbuf_release(_window[i]);
+    }
+    time = xtimer_now_usec() - start;
+
+#ifdef DEVELHELP
+    gnrc_pktbuf_stats();
+#endif
+    printf("{ \"backend\" : \"%s\", \"time_us\" : %" PRIu32 ", "
+           "\"ops\" : %u, \"fails\" : %" PRIu32 " }\n",
+           PKTBUF_BACKEND, time, TEST_ROUNDS, fails);
+
+    return 0;
+}
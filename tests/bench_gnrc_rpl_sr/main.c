@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure source routing headers of a non-storing mode root in
+ *              a simulated DODAG of 500 nodes
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "net/gnrc/rpl/sr.h"
+#include "xtimer.h"
+
+#define NODES               (500U)
+#define DEPTH_MAX           (12U)
+#define LOOKUPS             (10000U)
+#define HOT_NODES           (GNRC_RPL_SR_CACHE_NUMOF)
+#define CHUNK               (16U)
+#define LIFETIME            (3600U)
+
+/* node 0 is the root */
+static ipv6_addr_t _addrs[NODES];
+static uint16_t _parents[NODES];
+static uint8_t _depths[NODES];
+
+/* results of a chunk of operations, checked after the time was taken */
+static struct {
+    unsigned node;
+    int res;
+    ipv6_addr_t first_hop;
+    uint8_t srh[sizeof(gnrc_rpl_srh_t) + (GNRC_RPL_SR_HOPS_MAX * sizeof(ipv6_addr_t))];
+} _results[CHUNK];
+
+static uint32_t _rand_state = 0x20200101U;
+
+static uint32_t _rand(void)
+{
+    /* xorshift32, the same topology on every run */
+    _rand_state ^= _rand_state << 13;
+    _rand_state ^= _rand_state >> 17;
+    _rand_state ^= _rand_state << 5;
+    return _rand_state;
+}
+
+/* 2001:db8::/64 with random interface identifiers */
+static void _topology(void)
+{
+    for (unsigned i = 0; i < NODES; i++) {
+        uint32_t iid[2] = { _rand(), _rand() };
+
+        memset(&_addrs[i], 0, sizeof(_addrs[i]));
+        _addrs[i].u8[0] = 0x20;
+        _addrs[i].u8[1] = 0x01;
+        _addrs[i].u8[2] = 0x0d;
+        _addrs[i].u8[3] = 0xb8;
+        memcpy(&_addrs[i].u8[8], iid, sizeof(iid));
+        if (i == 0) {
+            continue;
+        }
+        do {
+            _parents[i] = _rand() % i;
+        } while (_depths[_parents[i]] >= DEPTH_MAX);
+        _depths[i] = _depths[_parents[i]] + 1;
+    }
+}
+
+/* checks the path in the header against the topology */
+static unsigned _check(unsigned node, int res, const ipv6_addr_t *first_hop,
+                       const uint8_t *buf)
+{
+    const gnrc_rpl_srh_t *srh = (const gnrc_rpl_srh_t *)buf;
+    unsigned hops = _depths[node];
+    unsigned compr, addr_len;
+    ipv6_addr_t addr;
+
+    if (res < 0) {
+        return 1;
+    }
+    if (hops == 1) {
+        return (res != 0) || !ipv6_addr_equal(first_hop, &_addrs[node]);
+    }
+    compr = srh->compr & 0x0f;
+    addr_len = sizeof(ipv6_addr_t) - compr;
+    if ((res != (8 * (srh->len + 1))) || (srh->seg_left != (hops - 1)) ||
+        ((srh->compr >> 4) != compr)) {
+        return 1;
+    }
+    /* walks the path from the destination back to the first hop */
+    memcpy(&addr, first_hop, compr);
+    for (unsigned i = hops - 1; i > 0; i--) {
+        memcpy(&addr.u8[compr], &buf[sizeof(gnrc_rpl_srh_t) + ((i - 1) * addr_len)],
+               addr_len);
+        if (!ipv6_addr_equal(&addr, &_addrs[node])) {
+            return 1;
+        }
+        node = _parents[node];
+    }
+    return !ipv6_addr_equal(first_hop, &_addrs[node]);
+}
+
+/* builds the headers for `ops` destinations, returns the number of errors */
+static unsigned _build(unsigned ops, unsigned (*next)(unsigned), uint32_t *time_us)
+{
+    unsigned errors = 0;
+
+    *time_us = 0;
+    for (unsigned done = 0; done < ops; done += CHUNK) {
+        unsigned len = ((ops - done) < CHUNK) ? (ops - done) : CHUNK;
+
+        for (unsigned i = 0; i < len; i++) {
+            _results[i].node = next(done + i);
+        }
+        uint32_t start = xtimer_now_usec();
+        for (unsigned i = 0; i < len; i++) {
+            _results[i].res = gnrc_rpl_sr_build_srh(&_addrs[0],
+                                                    &_addrs[_results[i].node],
+                                                    &_results[i].first_hop,
+                                                    (gnrc_rpl_srh_t *)_results[i].srh,
+                                                    sizeof(_results[i].srh));
+        }
+        *time_us += xtimer_now_usec() - start;
+        for (unsigned i = 0; i < len; i++) {
+            errors += _check(_results[i].node, _results[i].res,
+                             &_results[i].first_hop, _results[i].srh);
+        }
+    }
+    return errors;
+}
+
+static unsigned _all_nodes(unsigned n)
+{
+    return 1 + (n % (NODES - 1));
+}
+
+static unsigned _hot_nodes(unsigned n)
+{
+    return 1 + (n % HOT_NODES);
+}
+
+static unsigned _random_nodes(unsigned n)
+{
+    (void)n;
+    return 1 + (_rand() % (NODES - 1));
+}
+
+static void _print(const char *mode, unsigned ops, uint32_t time_us, unsigned errors)
+{
+    printf("{ \"mode\" : \"%s\", \"ops\" : %u, \"time_us\" : %" PRIu32 ", "
+           "\"errors\" : %u }\n", mode, ops, time_us, errors);
+}
+
+int main(void)
+{
+    unsigned errors = 0;
+    uint32_t time_us;
+
+    _topology();
+    printf("{ \"nodes\" : %u, \"table_bytes\" : %u, \"cache_bytes\" : %u }\n",
+           NODES,
+           (unsigned)((GNRC_RPL_SR_NODES_NUMOF * sizeof(gnrc_rpl_sr_node_t)) +
+                      (GNRC_RPL_SR_BUCKETS_NUMOF * sizeof(uint16_t))),
+           (unsigned)(GNRC_RPL_SR_CACHE_NUMOF * sizeof(gnrc_rpl_sr_cache_t)));
+
+    /* the DAOs arrive in random order, parents may not be known yet */
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < (NODES - 1); i++) {
+        unsigned node = _random_nodes(i);
+
+        errors += (gnrc_rpl_sr_add(&_addrs[node], &_addrs[_parents[node]],
+                                   LIFETIME) != 0);
+    }
+    for (unsigned node = 1; node < NODES; node++) {
+        errors += (gnrc_rpl_sr_add(&_addrs[node], &_addrs[_parents[node]],
+                                   LIFETIME) != 0);
+    }
+    _print("add", 2 * (NODES - 1), xtimer_now_usec() - start, errors);
+
+    /* every destination once, as after a change of the topology */
+    errors = _build(NODES - 1, _all_nodes, &time_us);
+    _print("build", NODES - 1, time_us, errors);
+
+    /* as many destinations as fit into the cache */
+    errors = _build(LOOKUPS, _hot_nodes, &time_us);
+    _print("cached", LOOKUPS, time_us, errors);
+
+    /* destinations all over the DODAG, mostly missing the cache */
+    errors = _build(LOOKUPS, _random_nodes, &time_us);
+    _print("random", LOOKUPS, time_us, errors);
+
+    puts("done");
+
+    return 0;
+}
@@ -0,0 +1,30 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+NODES = 500
+LOOKUPS = 10000
+
+
+def testfunc(child):
+    child.expect(r"{ \"nodes\" : %d, \"table_bytes\" : \d+, "
+                 r"\"cache_bytes\" : \d+ }" % NODES)
+    for mode, ops in (("add", 2 * (NODES - 1)), ("build", NODES - 1),
+                      ("cached", LOOKUPS), ("random", LOOKUPS)):
+        child.expect(r"{ \"mode\" : \"%s\", \"ops\" : (\d+), "
+                     r"\"time_us\" : \d+, \"errors\" : (\d+) }" % mode,
+                     timeout=60)
+        assert int(child.match.group(1)) == ops
+        assert int(child.match.group(2)) == 0
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,263 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure a single threaded TCP server with concurrent clients
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "event.h"
+#include "kernel_defines.h"
+#include "msg.h"
+#include "net/af.h"
+#include "net/gnrc/tcp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define SERVER_PORT         (2020U)
+#define SERVER_TCBS         (8U)
+#define SERVER_RCV_BUF_SIZE (2 * GNRC_TCP_MSS)
+#define CLIENTS_MAX         (8U)
+#define CLIENT_RCV_BUF_SIZE (256U)
+#define BYTES_PER_CLIENT    (16U * 1024U)
+
+#define MSG_TYPE_START      (0x2000)
+#define MSG_TYPE_CLIENT     (0x2001)
+#define MSG_TYPE_SERVER     (0x2002)
+
+typedef struct {
+    event_t super;
+    gnrc_tcp_tcb_t *tcb;
+    size_t received;
+} _conn_t;
+
+static const unsigned _clients[] = { 1, 2, 4, 8 };
+
+static kernel_pid_t _main_pid;
+static msg_t _main_queue[16];
+
+static event_queue_t _server_evq;
+static gnrc_tcp_tcb_queue_t _server_queue;
+static gnrc_tcp_tcb_t _server_tcbs[SERVER_TCBS];
+static uint8_t _server_rcv_bufs[SERVER_TCBS][SERVER_RCV_BUF_SIZE];
+static _conn_t _server_conns[SERVER_TCBS];
+static char _server_stack[THREAD_STACKSIZE_DEFAULT];
+static uint8_t _server_buf[GNRC_TCP_MSS];
+
+/* statistics of the current round, only touched by the server thread */
+static size_t _bytes;
+static unsigned _errors;
+static unsigned _finished;
+static unsigned _expected;
+
+static gnrc_tcp_tcb_t _client_tcbs[CLIENTS_MAX];
+static uint8_t _client_rcv_bufs[CLIENTS_MAX][CLIENT_RCV_BUF_SIZE];
+static char _client_stacks[CLIENTS_MAX][THREAD_STACKSIZE_DEFAULT];
+static kernel_pid_t _client_pids[CLIENTS_MAX];
+
+static uint8_t _body_byte(size_t offset)
+{
+    return (uint8_t)(offset ^ (offset >> 8));
+}
+
+static void _conn_finish(_conn_t *conn)
+{
+    if (conn->received != BYTES_PER_CLIENT) {
+        _errors++;
+    }
+    /* puts the TCB back into listening state */
+    gnrc_tcp_close(conn->tcb);
+    conn->tcb = NULL;
+
+    if (++_finished == _expected) {
+        msg_t m = { .type = MSG_TYPE_SERVER };
+        msg_send(&m, _main_pid);
+    }
+}
+
+static void _conn_handler(event_t *event)
+{
+    _conn_t *conn = container_of(event, _conn_t, super);
+    ssize_t res;
+
+    /* event was posted before the connection got closed */
+    if (conn->tcb == NULL) {
+        return;
+    }
+    while ((res = gnrc_tcp_recv(conn->tcb, _server_buf, sizeof(_server_buf), 0)) > 0) {
+        for (ssize_t i = 0; i < res; i++) {
+            _errors += (_server_buf[i] != _body_byte(conn->received + i));
+        }
+        conn->received += res;
+        _bytes += res;
+    }
+    /* zero on the peers FIN, anything but -EAGAIN on a reset */
+    if (res != -EAGAIN) {
+        _conn_finish(conn);
+    }
+}
+
+static void _conn_cb(gnrc_tcp_tcb_t *tcb, gnrc_tcp_event_t events, void *arg)
+{
+    (void)tcb;
+    (void)events;
+    event_post(&_server_evq, arg);
+}
+
+static void _accept_handler(event_t *event)
+{
+    (void)event;
+    gnrc_tcp_tcb_t *tcb;
+
+    while (gnrc_tcp_accept(&_server_queue, &tcb, 0) == 0) {
+        _conn_t *conn = &_server_conns[tcb - _server_tcbs];
+
+        conn->tcb = tcb;
+        conn->received = 0;
+        gnrc_tcp_tcb_set_cb(tcb, _conn_cb, conn);
+        /* pick up what arrived before the callback was registered */
+        _conn_handler(&conn->super);
+    }
+}
+
+static event_t _accept_event = { .handler = _accept_handler };
+
+static void _queue_cb(gnrc_tcp_tcb_queue_t *queue, gnrc_tcp_event_t events, void *arg)
+{
+    (void)queue;
+    (void)events;
+    (void)arg;
+    event_post(&_server_evq, &_accept_event);
+}
+
+static void *_server(void *arg)
+{
+    (void)arg;
+
+    event_queue_claim(&_server_evq);
+    event_loop(&_server_evq);
+    return NULL;
+}
+
+static unsigned _client_run(gnrc_tcp_tcb_t *tcb, uint8_t *rcv_buf)
+{
+    /* gnrc_tcp_open_active() modifies the address string */
+    char addr[] = "::1";
+    uint8_t buf[GNRC_TCP_MSS];
+    size_t sent = 0;
+
+    gnrc_tcp_tcb_init(tcb);
+    gnrc_tcp_tcb_set_rcv_buf(tcb, rcv_buf, CLIENT_RCV_BUF_SIZE);
+    if (gnrc_tcp_open_active(tcb, AF_INET6, addr, SERVER_PORT, 0) < 0) {
+        return 1;
+    }
+    while (sent < BYTES_PER_CLIENT) {
+        size_t len = BYTES_PER_CLIENT - sent;
+
+        if (len > sizeof(buf)) {
+            len = sizeof(buf);
+        }
+        for (size_t i = 0; i < len; i++) {
+            buf[i] = _body_byte(sent + i);
+        }
+        ssize_t res = gnrc_tcp_send(tcb, buf, len, 0);
+        if (res <= 0) {
+            gnrc_tcp_abort(tcb);
+            return 1;
+        }
+        sent += res;
+    }
+    gnrc_tcp_close(tcb);
+    return 0;
+}
+
+static void *_client(void *arg)
+{
+    unsigned idx = (uintptr_t)arg;
+    msg_t m;
+
+    while (1) {
+        msg_receive(&m);
+        m.type = MSG_TYPE_CLIENT;
+        m.content.value = _client_run(&_client_tcbs[idx], _client_rcv_bufs[idx]);
+        msg_send(&m, _main_pid);
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    _main_pid = thread_getpid();
+    msg_init_queue(_main_queue, ARRAY_SIZE(_main_queue));
+
+    event_queue_init_detached(&_server_evq);
+    thread_create(_server_stack, sizeof(_server_stack), THREAD_PRIORITY_MAIN - 2,
+                  THREAD_CREATE_STACKTEST, _server, NULL, "server");
+    for (unsigned i = 0; i < CLIENTS_MAX; i++) {
+        _client_pids[i] = thread_create(_client_stacks[i], sizeof(_client_stacks[i]),
+                                        THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                                        _client, (void *)(uintptr_t)i, "client");
+    }
+
+    for (unsigned i = 0; i < SERVER_TCBS; i++) {
+        gnrc_tcp_tcb_init(&_server_tcbs[i]);
+        gnrc_tcp_tcb_set_rcv_buf(&_server_tcbs[i], _server_rcv_bufs[i], SERVER_RCV_BUF_SIZE);
+        _server_conns[i].super.handler = _conn_handler;
+    }
+    int res = gnrc_tcp_listen(&_server_queue, _server_tcbs, SERVER_TCBS,
+                              AF_INET6, NULL, SERVER_PORT);
+    if (res < 0) {
+        printf("gnrc_tcp_listen() failed: %d\n", res);
+        return 1;
+    }
+    gnrc_tcp_tcb_queue_set_cb(&_server_queue, _queue_cb, NULL);
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_clients); i++) {
+        unsigned clients = _clients[i];
+        unsigned client_errors = 0;
+        uint32_t time_us = 0;
+        msg_t m = { .type = MSG_TYPE_START };
+
+        /* the server is idle between rounds */
+        _bytes = 0;
+        _errors = 0;
+        _finished = 0;
+        _expected = clients;
+
+        uint32_t start = xtimer_now_usec();
+        for (unsigned c = 0; c < clients; c++) {
+            msg_send(&m, _client_pids[c]);
+        }
+        /* wait for the server to close all connections and for the clients to return */
+        for (unsigned pending = clients + 1; pending > 0; pending--) {
+            msg_receive(&m);
+            if (m.type == MSG_TYPE_SERVER) {
+                time_us = xtimer_now_usec() - start;
+            }
+            else {
+                client_errors += m.content.value;
+            }
+        }
+        printf("{ \"clients\" : %u, \"bytes\" : %u, \"time_us\" : %" PRIu32 ", "
+               "\"errors\" : %u }\n", clients, (unsigned)_bytes, time_us,
+               _errors + client_errors);
+    }
+    puts("done");
+
+    return 0;
+}
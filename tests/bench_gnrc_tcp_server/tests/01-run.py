@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+BYTES_PER_CLIENT = 16 * 1024
+
+
+def testfunc(child):
+    for clients in (1, 2, 4, 8):
+        child.expect(r"{ \"clients\" : %d, \"bytes\" : (\d+), "
+                     r"\"time_us\" : \d+, \"errors\" : (\d+) }" % clients,
+                     timeout=60)
+        assert int(child.match.group(1)) == clients * BYTES_PER_CLIENT
+        assert int(child.match.group(2)) == 0
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
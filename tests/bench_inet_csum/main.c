@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure throughput of the Internet Checksum calculation
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "net/inet_csum.h"
+#include "xtimer.h"
+
+#ifndef TEST_LEN
+#define TEST_LEN            (1280U)
+#endif
+
+#ifndef TEST_RUNS
+#define TEST_RUNS           (1000U)
+#endif
+
+/* one more byte, so the buffer can also start on an odd address */
+static uint32_t _buf[(TEST_LEN / sizeof(uint32_t)) + 1];
+
+/* byte pair-wise summation inet_csum_slice() used before it summed up words */
+static uint16_t _bytewise(uint16_t sum, const uint8_t *buf, uint16_t len,
+                          size_t accum_len)
+{
+    uint32_t csum = sum;
+
+    if (len == 0) {
+        return csum;
+    }
+    if (accum_len & 1) {
+        csum += *buf;
+        buf++;
+        len--;
+        accum_len++;
+    }
+    for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
+        csum += (uint16_t)(*buf << 8) + *(buf + 1);
+    }
+    if ((accum_len + len) & 1) {
+        csum += (uint16_t)(*buf << 8);
+    }
+    while (csum >> 16) {
+        uint16_t carry = csum >> 16;
+        csum = (csum & 0xffff) + carry;
+    }
+    return csum;
+}
+
+static void _run(const char *name, unsigned offset,
+                 uint16_t (*csum)(uint16_t, const uint8_t *, uint16_t, size_t))
+{
+    const uint8_t *buf = ((uint8_t *)_buf) + offset;
+    uint16_t sum = 0;
+    uint32_t start, time;
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_RUNS; i++) {
+        /* chain the results, so no run can be optimized away */
+        sum = csum(sum, buf, TEST_LEN, 0);
+    }
+    time = xtimer_now_usec() - start;
+    printf("{ \"variant\" : \"%s\", \"offset\" : %u, \"len\" : %u, "
+           "\"time_us\" : %" PRIu32 ", \"csum\" : %u }\n",
+           name, offset, TEST_LEN, time, sum);
+}
+
+int main(void)
+{
+    puts("main starting");
+
+    uint8_t *bytes = (uint8_t *)_buf;
+
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        bytes[i] = (uint8_t)((i * 7) ^ (i >> 3));
+    }
+    for (unsigned offset = 0; offset < 2; offset++) {
+        _run("bytewise", offset, _bytewise);
+        _run("inet_csum", offset, inet_csum_slice);
+    }
+    puts("done");
+
+    return 0;
+}
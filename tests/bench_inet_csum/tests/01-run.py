@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for offset in (0, 1):
+        csums = set()
+        for variant in ("bytewise", "inet_csum"):
+            child.expect(r"{ \"variant\" : \"%s\", \"offset\" : %u, "
+                         r"\"len\" : \d+, \"time_us\" : \d+, "
+                         r"\"csum\" : (\d+) }" % (variant, offset))
+            csums.add(child.match.group(1))
+        # both variants must calculate the same checksum
+        assert len(csums) == 1
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure messages received per second from multiple producers
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include "thread.h"
+
+#include "msg.h"
+#include "xtimer.h"
+
+#ifndef TEST_DURATION
+#define TEST_DURATION       (1000000U)
+#endif
+
+#ifndef TEST_PRODUCERS
+#define TEST_PRODUCERS      (3U)
+#endif
+
+#ifndef TEST_QUEUE_SIZE
+#define TEST_QUEUE_SIZE     (8U)
+#endif
+
+#ifndef TEST_ISR_INTERVAL
+#define TEST_ISR_INTERVAL   (100U)
+#endif
+
+#define MSG_TYPE_THREAD     (0x1000)
+#define MSG_TYPE_ISR        (0x1001)
+
+volatile unsigned _flag = 0;
+static uint32_t _isr_dropped = 0;
+static kernel_pid_t _consumer;
+static xtimer_t _isr_timer;
+static msg_t _queue[TEST_QUEUE_SIZE];
+static char _stacks[TEST_PRODUCERS][THREAD_STACKSIZE_DEFAULT];
+
+static void _timer_callback(void *arg)
+{
+    (void)arg;
+
+    _flag = 1;
+}
+
+static void _isr_callback(void *arg)
+{
+    (void)arg;
+    msg_t m = { .type = MSG_TYPE_ISR };
+
+    if (_flag) {
+        return;
+    }
+    if (msg_send_int(&m, _consumer) != 1) {
+        _isr_dropped++;
+    }
+    xtimer_set(&_isr_timer, TEST_ISR_INTERVAL);
+}
+
+static void *_producer(void *arg)
+{
+    (void)arg;
+    msg_t m = { .type = MSG_TYPE_THREAD };
+
+    while (1) {
+        msg_send(&m, _consumer);
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    printf("main starting\n");
+
+    _consumer = thread_getpid();
+    msg_init_queue(_queue, TEST_QUEUE_SIZE);
+
+    for (unsigned i = 0; i < TEST_PRODUCERS; i++) {
+        thread_create(_stacks[i], sizeof(_stacks[i]),
+                      (THREAD_PRIORITY_MAIN - 1), THREAD_CREATE_STACKTEST,
+                      _producer, NULL, "producer");
+    }
+
+    xtimer_t timer;
+    timer.callback = _timer_callback;
+    _isr_timer.callback = _isr_callback;
+
+    msg_t m;
+
+    uint32_t n = 0;
+    uint32_t n_isr = 0;
+
+    xtimer_set(&timer, TEST_DURATION);
+    xtimer_set(&_isr_timer, TEST_ISR_INTERVAL);
+    while (!_flag) {
+        msg_receive(&m);
+        if (m.type == MSG_TYPE_ISR) {
+            n_isr++;
+        }
+        n++;
+    }
+    xtimer_remove(&_isr_timer);
+
+    printf("{ \"result\" : %"PRIu32", \"isr\" : %"PRIu32", "
+           "\"isr_dropped\" : %"PRIu32" }\n", n, n_isr, _isr_dropped);
+
+    return 0;
+}
@@ -0,0 +1,20 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect(r"{ \"result\" : (\d+), \"isr\" : (\d+), "
+                 r"\"isr_dropped\" : \d+ }")
+    assert int(child.match.group(1)) >= int(child.match.group(2))
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
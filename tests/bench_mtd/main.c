@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the erase, write and read throughput of MTD_0
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "board.h"
+#include "mtd.h"
+#include "xtimer.h"
+
+#define REGION_SIZE     (64U * 1024U)
+#define BUF_SIZE        (1024U)
+
+static uint8_t _buf[BUF_SIZE];
+
+static uint8_t _byte(uint32_t addr)
+{
+    return (uint8_t)(addr ^ (addr >> 8));
+}
+
+static unsigned _erase(mtd_dev_t *dev, uint32_t region)
+{
+    return (mtd_erase(dev, 0, region) != 0);
+}
+
+static unsigned _write(mtd_dev_t *dev, uint32_t region)
+{
+    /* writes must not cross a page boundary */
+    uint32_t chunk = (dev->page_size < BUF_SIZE) ? dev->page_size : BUF_SIZE;
+    unsigned errors = 0;
+
+    for (uint32_t addr = 0; addr < region; addr += chunk) {
+        for (unsigned i = 0; i < chunk; i++) {
+            _buf[i] = _byte(addr + i);
+        }
+        errors += (mtd_write(dev, _buf, addr, chunk) != (int)chunk);
+    }
+    return errors;
+}
+
+static unsigned _read(mtd_dev_t *dev, uint32_t region)
+{
+    unsigned errors = 0;
+
+    for (uint32_t addr = 0; addr < region;) {
+        int res = mtd_read(dev, _buf, addr, BUF_SIZE);
+
+        if (res <= 0) {
+            return errors + 1;
+        }
+        for (int i = 0; i < res; i++) {
+            errors += (_buf[i] != _byte(addr + i));
+        }
+        addr += res;
+    }
+    return errors;
+}
+
+static void _run(const char *op, unsigned (*func)(mtd_dev_t *, uint32_t),
+                 mtd_dev_t *dev, uint32_t region)
+{
+    uint32_t start = xtimer_now_usec();
+    unsigned errors = func(dev, region);
+    uint32_t time_us = xtimer_now_usec() - start;
+    /* bytes per microsecond are megabytes per second */
+    uint64_t milli_mbs = time_us ? ((uint64_t)region * 1000) / time_us : 0;
+
+    printf("{ \"op\" : \"%s\", \"bytes\" : %" PRIu32 ", \"time_us\" : %" PRIu32
+           ", \"mb_s\" : %" PRIu32 ".%03" PRIu32 ", \"errors\" : %u }\n",
+           op, region, time_us, (uint32_t)(milli_mbs / 1000),
+           (uint32_t)(milli_mbs % 1000), errors);
+}
+
+int main(void)
+{
+    mtd_dev_t *dev = MTD_0;
+    uint32_t sector_size, region;
+
+    if (mtd_init(dev) != 0) {
+        puts("mtd_init() failed");
+        return 1;
+    }
+    /* the region is erased as a whole, so it spans whole sectors */
+    sector_size = dev->pages_per_sector * dev->page_size;
+    region = ((REGION_SIZE + sector_size - 1) / sector_size) * sector_size;
+    if (region > (sector_size * dev->sector_count)) {
+        region = sector_size * dev->sector_count;
+    }
+
+    _run("erase", _erase, dev, region);
+    _run("write", _write, dev, region);
+    _run("read", _read, dev, region);
+    puts("done");
+
+    return 0;
+}
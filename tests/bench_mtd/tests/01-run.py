@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for op in ("erase", "write", "read"):
+        child.expect(r"{ \"op\" : \"%s\", \"bytes\" : \d+, "
+                     r"\"time_us\" : \d+, \"mb_s\" : \d+\.\d{3}, "
+                     r"\"errors\" : (\d+) }" % op, timeout=120)
+        assert int(child.match.group(1)) == 0
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
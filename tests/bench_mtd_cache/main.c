@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Count the operations on a MTD device with and without the
+ *              page cache
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "board.h"
+#include "kernel_defines.h"
+#include "mtd.h"
+#include "mtd_cache.h"
+#include "xtimer.h"
+
+#define REGION_SIZE         (64U * 1024U)
+#define HOT_SIZE            (4U * 1024U)
+#define CHUNK_SIZE          (16U)
+#define RANDOM_READS        (4096U)
+#define SLOTS               (16U)
+
+enum {
+    WORKLOAD_WRITE,
+    WORKLOAD_SEQ_READ,
+    WORKLOAD_RANDOM_READ,
+};
+
+static const char *_workloads[] = { "write", "seq_read", "random_read" };
+
+static uint8_t _cache_buf[SLOTS * MTD_PAGE_SIZE];
+static mtd_cache_slot_t _cache_slots[SLOTS];
+static uint32_t _erase_counts[MTD_SECTOR_NUM];
+static mtd_cache_t _cache = {
+    .base.driver = &mtd_cache_driver,
+    .buf = _cache_buf,
+    .slots = _cache_slots,
+    .slots_numof = SLOTS,
+    .erase_counts = _erase_counts,
+};
+
+static uint32_t _rand_state = 0x20200101U;
+
+static uint32_t _rand(void)
+{
+    /* xorshift32, the same accesses on every run */
+    _rand_state ^= _rand_state << 13;
+    _rand_state ^= _rand_state >> 17;
+    _rand_state ^= _rand_state << 5;
+    return _rand_state;
+}
+
+static uint8_t _byte(uint32_t addr)
+{
+    return (uint8_t)(addr ^ (addr >> 8));
+}
+
+static unsigned _check(const uint8_t *buf, uint32_t addr, int res)
+{
+    if (res != CHUNK_SIZE) {
+        return 1;
+    }
+    for (unsigned i = 0; i < CHUNK_SIZE; i++) {
+        if (buf[i] != _byte(addr + i)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* runs a workload, returns the number of operations on `dev` */
+static unsigned _run(mtd_dev_t *dev, unsigned workload, unsigned *errors)
+{
+    uint8_t buf[CHUNK_SIZE];
+    unsigned ops = 0;
+
+    switch (workload) {
+    case WORKLOAD_WRITE:
+        ops++;
+        *errors += (mtd_erase(dev, 0, REGION_SIZE) != 0);
+        for (uint32_t addr = 0; addr < REGION_SIZE; addr += CHUNK_SIZE) {
+            for (unsigned i = 0; i < CHUNK_SIZE; i++) {
+                buf[i] = _byte(addr + i);
+            }
+            ops++;
+            *errors += (mtd_write(dev, buf, addr, CHUNK_SIZE) != CHUNK_SIZE);
+        }
+        break;
+    case WORKLOAD_SEQ_READ:
+        for (uint32_t addr = 0; addr < REGION_SIZE; addr += CHUNK_SIZE) {
+            ops++;
+            *errors += _check(buf, addr, mtd_read(dev, buf, addr, CHUNK_SIZE));
+        }
+        break;
+    case WORKLOAD_RANDOM_READ:
+        for (unsigned n = 0; n < RANDOM_READS; n++) {
+            uint32_t addr = (_rand() % (HOT_SIZE / CHUNK_SIZE)) * CHUNK_SIZE;
+
+            ops++;
+            *errors += _check(buf, addr, mtd_read(dev, buf, addr, CHUNK_SIZE));
+        }
+        break;
+    }
+    return ops;
+}
+
+static void _print(const char *dev, unsigned workload, unsigned ops,
+                   uint32_t time_us, unsigned errors)
+{
+    printf("{ \"dev\" : \"%s\", \"workload\" : \"%s\", \"ops\" : %u, "
+           "\"time_us\" : %" PRIu32 ", \"errors\" : %u }\n", dev,
+           _workloads[workload], ops, time_us, errors);
+}
+
+int main(void)
+{
+    _cache.mtd = MTD_0;
+    if ((mtd_init(MTD_0) != 0) || (mtd_init(&_cache.base) != 0)) {
+        puts("mtd_init() failed");
+        return 1;
+    }
+
+    for (unsigned workload = 0; workload < ARRAY_SIZE(_workloads); workload++) {
+        unsigned errors = 0;
+        unsigned ops;
+
+        uint32_t start = xtimer_now_usec();
+        ops = _run(MTD_0, workload, &errors);
+        _print("direct", workload, ops, xtimer_now_usec() - start, errors);
+
+        /* every round starts with a cold cache */
+        errors = 0;
+        mtd_init(&_cache.base);
+        start = xtimer_now_usec();
+        _run(&_cache.base, workload, &errors);
+        errors += (mtd_cache_flush(&_cache) != 0);
+        ops = _cache.stats.reads + _cache.stats.writes + _cache.stats.erases;
+        _print("cached", workload, ops, xtimer_now_usec() - start, errors);
+    }
+    printf("{ \"erase_count\" : %" PRIu32 " }\n", mtd_cache_erase_count(&_cache, 0));
+    puts("done");
+
+    return 0;
+}
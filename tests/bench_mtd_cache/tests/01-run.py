@@ -0,0 +1,29 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    for workload in ("write", "seq_read", "random_read"):
+        ops = {}
+        for dev in ("direct", "cached"):
+            child.expect(r"{ \"dev\" : \"%s\", \"workload\" : \"%s\", "
+                         r"\"ops\" : (\d+), \"time_us\" : \d+, "
+                         r"\"errors\" : (\d+) }" % (dev, workload),
+                         timeout=300)
+            ops[dev] = int(child.match.group(1))
+            assert int(child.match.group(2)) == 0
+        assert ops["cached"] < ops["direct"]
+    child.expect(r"{ \"erase_count\" : 1 }")
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure forwarding of 6LoWPAN fragments with and without a
+ *              virtual reassembly buffer entry
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "iolist.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/netif/ieee802154.h"
+#include "net/gnrc/sixlowpan/frag/stats.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev_test.h"
+#include "net/sixlowpan.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_DATAGRAMS
+#define TEST_DATAGRAMS      (100U)
+#endif
+
+/* subsequent fragments per datagram */
+#ifndef TEST_FRAGS_N
+#define TEST_FRAGS_N        (4U)
+#endif
+
+/* payload after the IPv6 header in the first fragment, so that the offset of
+ * the second fragment is a multiple of 8 */
+#define FRAG_1_PAYLOAD      (56U)
+#define FRAG_N_PAYLOAD      (80U)
+#define DATAGRAM_SIZE       (sizeof(ipv6_hdr_t) + FRAG_1_PAYLOAD + \
+                             (TEST_FRAGS_N * FRAG_N_PAYLOAD))
+
+#define MAX_PDU_SIZE        (102U)
+
+#define TEST_SRC            { 0x2a, 0xab, 0xdc, 0x15, 0x54, 0x01, 0x64, 0x79 }
+#define TEST_DST            { 0x5a, 0x9d, 0x93, 0x86, 0x22, 0x08, 0x65, 0x79 }
+#define TEST_TGT_IPV6       { 0xfe, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, \
+                              0x48, 0x3d, 0x1d, 0x0c, 0x98, 0x31, 0x58, 0xae }
+
+static const uint8_t _src[] = TEST_SRC;
+static const uint8_t _dst[] = TEST_DST;
+static const ipv6_addr_t _tgt_ipv6 = { .u8 = TEST_TGT_IPV6 };
+/* IPHC with inline next header (ICMPv6), hop limit 64, and inline source
+ * (2001:db8::1) and destination (2001:db8::2) addresses */
+static const uint8_t _iphc_hdr[] = {
+    0x7a, 0x00, 0x3a,
+    0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+    0x20, 0x01, 0x0d, 0xb8, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02,
+};
+
+static char _mock_netif_stack[THREAD_STACKSIZE_DEFAULT];
+static netdev_test_t _mock_dev;
+static gnrc_netif_t *_mock_netif;
+static unsigned _sent;
+
+static gnrc_pktsnip_t *_frag(uint16_t tag, unsigned idx)
+{
+    gnrc_pktsnip_t *netif, *pkt;
+    size_t size;
+
+    netif = gnrc_netif_hdr_build(_src, sizeof(_src), _dst, sizeof(_dst));
+    if (netif == NULL) {
+        return NULL;
+    }
+    gnrc_netif_hdr_set_netif(netif->data, _mock_netif);
+    size = (idx == 0)
+         ? sizeof(sixlowpan_frag_t) + sizeof(_iphc_hdr) + FRAG_1_PAYLOAD
+         : sizeof(sixlowpan_frag_n_t) + FRAG_N_PAYLOAD;
+    pkt = gnrc_pktbuf_add(netif, NULL, size, GNRC_NETTYPE_SIXLOWPAN);
+    if (pkt == NULL) {
+        gnrc_pktbuf_release(netif);
+        return NULL;
+    }
+    sixlowpan_frag_t *hdr = pkt->data;
+
+    memset(pkt->data, (uint8_t)idx, size);
+    hdr->disp_size = byteorder_htons(DATAGRAM_SIZE);
+    hdr->tag = byteorder_htons(tag);
+    if (idx == 0) {
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+        memcpy(hdr + 1, _iphc_hdr, sizeof(_iphc_hdr));
+    }
+    else {
+        sixlowpan_frag_n_t *hdr_n = pkt->data;
+
+        hdr_n->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+        hdr_n->offset = (sizeof(ipv6_hdr_t) + FRAG_1_PAYLOAD +
+                         ((idx - 1) * FRAG_N_PAYLOAD)) / 8;
+    }
+    return pkt;
+}
+
+static void _run(const char *mode)
+{
+    gnrc_sixlowpan_frag_vrb_stats_t before = _mock_netif->sixlo.vrb_stats;
+    gnrc_sixlowpan_frag_vrb_stats_t *after;
+    static uint16_t tag;
+    unsigned fragments = 0;
+
+    _sent = 0;
+    uint32_t start = xtimer_now_usec();
+    for (unsigned i = 0; i < TEST_DATAGRAMS; i++) {
+        tag++;
+        for (unsigned j = 0; j <= TEST_FRAGS_N; j++) {
+            gnrc_pktsnip_t *pkt = _frag(tag, j);
+
+            if (pkt == NULL) {
+                puts("unable to allocate fragment");
+                return;
+            }
+            /* the 6LoWPAN thread and the interface run at a higher priority,
+             * so the fragment is handled when this returns */
+            gnrc_netapi_dispatch_receive(GNRC_NETTYPE_SIXLOWPAN,
+                                         GNRC_NETREG_DEMUX_CTX_ALL, pkt);
+            fragments++;
+        }
+    }
+    uint32_t time = xtimer_now_usec() - start;
+
+    after = &_mock_netif->sixlo.vrb_stats;
+    printf("{ \"mode\" : \"%s\", \"datagrams\" : %u, \"fragments\" : %u, "
+           "\"sent\" : %u, \"time_us\" : %" PRIu32 ", \"fwd\" : %u, "
+           "\"reasm\" : %u, \"drops\" : %u }\n",
+           mode, TEST_DATAGRAMS, fragments, _sent, time,
+           after->fwd - before.fwd,
+           after->reasm - before.reasm,
+           after->drops - before.drops);
+}
+
+static int _send(netdev_t *dev, const iolist_t *iolist)
+{
+    (void)dev;
+    _sent++;
+    return iolist_size(iolist);
+}
+
+static int _get_netdev_device_type(netdev_t *netdev, void *value, size_t max_len)
+{
+    assert(max_len == sizeof(uint16_t));
+    (void)netdev;
+
+    *((uint16_t *)value) = NETDEV_TYPE_IEEE802154;
+    return sizeof(uint16_t);
+}
+
+static int _get_netdev_proto(netdev_t *netdev, void *value, size_t max_len)
+{
+    assert(max_len == sizeof(gnrc_nettype_t));
+    (void)netdev;
+
+    *((gnrc_nettype_t *)value) = GNRC_NETTYPE_SIXLOWPAN;
+    return sizeof(gnrc_nettype_t);
+}
+
+static int _get_netdev_max_pdu_size(netdev_t *netdev, void *value,
+                                    size_t max_len)
+{
+    assert(max_len == sizeof(uint16_t));
+    (void)netdev;
+
+    *((uint16_t *)value) = MAX_PDU_SIZE;
+    return sizeof(uint16_t);
+}
+
+static int _get_netdev_src_len(netdev_t *netdev, void *value, size_t max_len)
+{
+    (void)netdev;
+    assert(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = sizeof(_dst);
+    return sizeof(uint16_t);
+}
+
+static int _get_netdev_addr_long(netdev_t *netdev, void *value, size_t max_len)
+{
+    (void)netdev;
+    assert(max_len >= sizeof(_dst));
+    memcpy(value, _dst, sizeof(_dst));
+    return sizeof(_dst);
+}
+
+static void _init_mock_netif(void)
+{
+    netdev_test_setup(&_mock_dev, NULL);
+    netdev_test_set_send_cb(&_mock_dev, _send);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_DEVICE_TYPE,
+                           _get_netdev_device_type);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_PROTO,
+                           _get_netdev_proto);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_MAX_PDU_SIZE,
+                           _get_netdev_max_pdu_size);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_SRC_LEN,
+                           _get_netdev_src_len);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_ADDRESS_LONG,
+                           _get_netdev_addr_long);
+    _mock_netif = gnrc_netif_ieee802154_create(
+            _mock_netif_stack, THREAD_STACKSIZE_DEFAULT, GNRC_NETIF_PRIO,
+            "mock_netif", (netdev_t *)&_mock_dev);
+    thread_yield_higher();
+}
+
+int main(void)
+{
+    _init_mock_netif();
+
+    /* default route, so the first fragment creates a VRB entry */
+    gnrc_ipv6_nib_ft_add(NULL, 0, &_tgt_ipv6, _mock_netif->pid, 0);
+    _run("cut-through");
+    gnrc_ipv6_nib_ft_del(NULL, 0);
+    _run("reassembly");
+    puts("done");
+
+    return 0;
+}
@@ -0,0 +1,37 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def _expect_mode(child, mode):
+    child.expect(r"{ \"mode\" : \"%s\", \"datagrams\" : (\d+), "
+                 r"\"fragments\" : (\d+), \"sent\" : (\d+), "
+                 r"\"time_us\" : \d+, \"fwd\" : (\d+), \"reasm\" : (\d+), "
+                 r"\"drops\" : (\d+) }" % mode)
+    return [int(g) for g in child.match.groups()]
+
+
+def testfunc(child):
+    datagrams, fragments, sent, fwd, reasm, drops = \
+        _expect_mode(child, "cut-through")
+    assert sent == fragments
+    assert fwd == fragments
+    assert reasm == 0
+    assert drops == 0
+    datagrams, fragments, sent, fwd, reasm, drops = \
+        _expect_mode(child, "reassembly")
+    assert fwd == 0
+    assert reasm == datagrams
+    assert drops == 0
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
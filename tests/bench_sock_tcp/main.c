@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure a TCP server with concurrent clients using sock_tcp
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "msg.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/tcp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifdef MODULE_SOCK_ASYNC_EVENT
+#include "event.h"
+#include "net/sock/async/event.h"
+#endif
+
+#define SERVER_PORT         (2020U)
+#define SERVER_SOCKS        (8U)
+#define CLIENTS_MAX         (8U)
+#define BYTES_PER_CLIENT    (16U * 1024U)
+#define CHUNK_SIZE          (512U)
+
+#define MSG_TYPE_START      (0x2000)
+#define MSG_TYPE_CLIENT     (0x2001)
+#define MSG_TYPE_SERVER     (0x2002)
+
+static const unsigned _clients[] = { 1, 2, 4, 8 };
+
+static kernel_pid_t _main_pid;
+static msg_t _main_queue[16];
+
+static sock_tcp_queue_t _server_queue;
+static sock_tcp_t _server_socks[SERVER_SOCKS];
+static size_t _server_received[SERVER_SOCKS];
+static char _server_stack[THREAD_STACKSIZE_DEFAULT];
+static uint8_t _server_buf[CHUNK_SIZE];
+
+/* statistics of the current round, only touched by the server thread */
+static size_t _bytes;
+static unsigned _errors;
+static unsigned _finished;
+static unsigned _expected;
+
+static sock_tcp_t _client_socks[CLIENTS_MAX];
+static char _client_stacks[CLIENTS_MAX][THREAD_STACKSIZE_DEFAULT];
+static kernel_pid_t _client_pids[CLIENTS_MAX];
+
+static uint8_t _body_byte(size_t offset)
+{
+    return (uint8_t)(offset ^ (offset >> 8));
+}
+
+static void _conn_finish(sock_tcp_t *sock)
+{
+    if (_server_received[sock - _server_socks] != BYTES_PER_CLIENT) {
+        _errors++;
+    }
+    sock_tcp_disconnect(sock);
+
+    if (++_finished == _expected) {
+        msg_t m = { .type = MSG_TYPE_SERVER };
+        msg_send(&m, _main_pid);
+    }
+}
+
+/* reads what is available, returns true once the peer is gone */
+static bool _conn_read(sock_tcp_t *sock, uint32_t timeout)
+{
+    size_t *received = &_server_received[sock - _server_socks];
+    ssize_t res;
+
+    while ((res = sock_tcp_read(sock, _server_buf, sizeof(_server_buf), timeout)) > 0) {
+        for (ssize_t i = 0; i < res; i++) {
+            _errors += (_server_buf[i] != _body_byte(*received + i));
+        }
+        *received += res;
+        _bytes += res;
+    }
+    /* GNRC reports the end of the stream with 0, lwIP with -ECONNRESET */
+    return (res != -EAGAIN);
+}
+
+#ifdef MODULE_SOCK_ASYNC_EVENT
+static event_queue_t _server_evq;
+
+static void _conn_handler(sock_tcp_t *sock, sock_async_flags_t flags)
+{
+    (void)flags;
+
+    if (_conn_read(sock, 0)) {
+        _conn_finish(sock);
+        /* no events of this connection must remain when the sock is reused */
+        event_cancel(&_server_evq, &sock_tcp_get_async_ctx(sock)->event.super);
+    }
+}
+
+static void _accept_handler(sock_tcp_queue_t *queue, sock_async_flags_t flags)
+{
+    sock_tcp_t *sock;
+
+    (void)flags;
+    while (sock_tcp_accept(queue, &sock, 0) == 0) {
+        _server_received[sock - _server_socks] = 0;
+        sock_tcp_event_init(sock, &_server_evq, _conn_handler);
+        /* pick up what arrived before the callback was registered */
+        _conn_handler(sock, 0);
+    }
+}
+
+static void *_server(void *arg)
+{
+    (void)arg;
+
+    event_queue_init(&_server_evq);
+    sock_tcp_queue_event_init(&_server_queue, &_server_evq, _accept_handler);
+    event_loop(&_server_evq);
+    return NULL;
+}
+#else
+static void *_server(void *arg)
+{
+    (void)arg;
+    sock_tcp_t *sock;
+
+    /* serves one connection after the other, the others wait in the queue */
+    while (1) {
+        if (sock_tcp_accept(&_server_queue, &sock, SOCK_NO_TIMEOUT) < 0) {
+            continue;
+        }
+        _server_received[sock - _server_socks] = 0;
+        _conn_read(sock, SOCK_NO_TIMEOUT);
+        _conn_finish(sock);
+    }
+    return NULL;
+}
+#endif
+
+static unsigned _client_run(sock_tcp_t *sock)
+{
+    sock_tcp_ep_t remote = { .family = AF_INET6, .port = SERVER_PORT };
+    uint8_t buf[CHUNK_SIZE];
+    size_t sent = 0;
+
+    memcpy(remote.addr.ipv6, &ipv6_addr_loopback, sizeof(remote.addr.ipv6));
+    if (sock_tcp_connect(sock, &remote, 0, 0) < 0) {
+        return 1;
+    }
+    while (sent < BYTES_PER_CLIENT) {
+        for (size_t i = 0; i < sizeof(buf); i++) {
+            buf[i] = _body_byte(sent + i);
+        }
+        ssize_t res = sock_tcp_write(sock, buf, sizeof(buf));
+        if (res <= 0) {
+            sock_tcp_disconnect(sock);
+            return 1;
+        }
+        sent += res;
+    }
+    sock_tcp_disconnect(sock);
+    return 0;
+}
+
+static void *_client(void *arg)
+{
+    sock_tcp_t *sock = arg;
+    msg_t m;
+
+    while (1) {
+        msg_receive(&m);
+        m.type = MSG_TYPE_CLIENT;
+        m.content.value = _client_run(sock);
+        msg_send(&m, _main_pid);
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    sock_tcp_ep_t local = SOCK_IPV6_EP_ANY;
+
+    _main_pid = thread_getpid();
+    msg_init_queue(_main_queue, ARRAY_SIZE(_main_queue));
+
+    local.port = SERVER_PORT;
+    int res = sock_tcp_listen(&_server_queue, &local, _server_socks, SERVER_SOCKS, 0);
+    if (res < 0) {
+        printf("sock_tcp_listen() failed: %d\n", res);
+        return 1;
+    }
+    thread_create(_server_stack, sizeof(_server_stack), THREAD_PRIORITY_MAIN - 2,
+                  THREAD_CREATE_STACKTEST, _server, NULL, "server");
+    for (unsigned i = 0; i < CLIENTS_MAX; i++) {
+        _client_pids[i] = thread_create(_client_stacks[i], sizeof(_client_stacks[i]),
+                                        THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                                        _client, &_client_socks[i], "client");
+    }
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_clients); i++) {
+        unsigned clients = _clients[i];
+        unsigned client_errors = 0;
+        uint32_t time_us = 0;
+        msg_t m = { .type = MSG_TYPE_START };
+
+        /* the server is idle between rounds */
+        _bytes = 0;
+        _errors = 0;
+        _finished = 0;
+        _expected = clients;
+
+        uint32_t start = xtimer_now_usec();
+        for (unsigned c = 0; c < clients; c++) {
+            msg_send(&m, _client_pids[c]);
+        }
+        /* wait for the server to close all connections and for the clients to return */
+        for (unsigned pending = clients + 1; pending > 0; pending--) {
+            msg_receive(&m);
+            if (m.type == MSG_TYPE_SERVER) {
+                time_us = xtimer_now_usec() - start;
+            }
+            else {
+                client_errors += m.content.value;
+            }
+        }
+        printf("{ \"clients\" : %u, \"bytes\" : %u, \"time_us\" : %" PRIu32 ", "
+               "\"errors\" : %u }\n", clients, (unsigned)_bytes, time_us,
+               _errors + client_errors);
+    }
+    puts("done");
+
+    return 0;
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the datagrams per second received with sock_udp
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "msg.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/udp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define SERVER_PORT         (2020U)
+#define CLIENT_PORT         (2021U)
+#define PKTS                (4096U)
+#define BURST               (8U)
+#define PAYLOAD_SIZE        (64U)
+#define RECV_TIMEOUT        (100U * US_PER_MS)
+
+enum {
+    MODE_RECV,
+    MODE_RECV_BATCH,
+    MODE_RECV_BUF,
+};
+
+static const char *_modes[] = { "recv", "recv_batch", "recv_buf" };
+
+static sock_udp_t _server_sock;
+static uint8_t _server_bufs[BURST][PAYLOAD_SIZE];
+static unsigned _errors;
+
+static sock_udp_t _client_sock;
+static uint8_t _client_bufs[BURST][PAYLOAD_SIZE];
+static sock_udp_msg_t _client_msgs[BURST];
+static char _client_stack[THREAD_STACKSIZE_DEFAULT];
+static kernel_pid_t _client_pid;
+
+static void _check_payload(const uint8_t *data, ssize_t len, unsigned idx)
+{
+    if ((len != PAYLOAD_SIZE) || (memcmp(data, _client_bufs[idx], PAYLOAD_SIZE) != 0)) {
+        _errors++;
+    }
+}
+
+/* returns the number of datagrams received of a burst */
+static unsigned _recv_burst(unsigned mode)
+{
+    unsigned received = 0;
+
+    while (received < BURST) {
+        int res = -ENOTSUP;
+
+        switch (mode) {
+        case MODE_RECV:
+            res = sock_udp_recv(&_server_sock, _server_bufs[0], PAYLOAD_SIZE,
+                                RECV_TIMEOUT, NULL);
+            if (res >= 0) {
+                _check_payload(_server_bufs[0], res, received);
+                res = 1;
+            }
+            break;
+        case MODE_RECV_BATCH: {
+            sock_udp_msg_t msgs[BURST];
+            unsigned len = BURST - received;
+
+            for (unsigned i = 0; i < len; i++) {
+                msgs[i].data = _server_bufs[i];
+                msgs[i].len = PAYLOAD_SIZE;
+                msgs[i].remote = NULL;
+            }
+            res = sock_udp_recv_batch(&_server_sock, msgs, len, RECV_TIMEOUT);
+            for (int i = 0; i < res; i++) {
+                _check_payload(msgs[i].data, msgs[i].len, received + i);
+            }
+            break;
+        }
+        case MODE_RECV_BUF: {
+            void *data = NULL, *ctx = NULL;
+
+            res = sock_udp_recv_buf(&_server_sock, &data, &ctx, RECV_TIMEOUT, NULL);
+            if (res >= 0) {
+                _check_payload(data, res, received);
+                /* hands the packet back to the network stack */
+                sock_udp_recv_buf(&_server_sock, &data, &ctx, RECV_TIMEOUT, NULL);
+                res = 1;
+            }
+            break;
+        }
+        }
+        if (res < 0) {
+            /* the rest of the burst got lost */
+            break;
+        }
+        received += res;
+    }
+    return received;
+}
+
+static void *_client(void *arg)
+{
+    (void)arg;
+    msg_t m;
+
+    while (1) {
+        msg_receive(&m);
+        /* the receiver times out for datagrams that were not sent */
+        sock_udp_send_batch(&_client_sock, _client_msgs, BURST);
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    sock_udp_ep_t remote = { .family = AF_INET6, .port = SERVER_PORT };
+    int res;
+
+    memcpy(remote.addr.ipv6, &ipv6_addr_loopback, sizeof(remote.addr.ipv6));
+    local.port = SERVER_PORT;
+    if ((res = sock_udp_create(&_server_sock, &local, NULL, 0)) < 0) {
+        printf("sock_udp_create() failed: %d\n", res);
+        return 1;
+    }
+    local.port = CLIENT_PORT;
+    if ((res = sock_udp_create(&_client_sock, &local, &remote, 0)) < 0) {
+        printf("sock_udp_create() failed: %d\n", res);
+        return 1;
+    }
+    for (unsigned i = 0; i < BURST; i++) {
+        memset(_client_bufs[i], i, PAYLOAD_SIZE);
+        _client_msgs[i].data = _client_bufs[i];
+        _client_msgs[i].len = PAYLOAD_SIZE;
+        _client_msgs[i].remote = NULL;
+    }
+    /* sends a whole burst before the receiver gets to run */
+    _client_pid = thread_create(_client_stack, sizeof(_client_stack),
+                                THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                                _client, NULL, "client");
+
+    for (unsigned mode = 0; mode < ARRAY_SIZE(_modes); mode++) {
+        unsigned pkts = 0;
+        msg_t m = { .type = 0 };
+
+        _errors = 0;
+        uint32_t start = xtimer_now_usec();
+        for (unsigned sent = 0; sent < PKTS; sent += BURST) {
+            msg_send(&m, _client_pid);
+            pkts += _recv_burst(mode);
+        }
+        uint32_t time_us = xtimer_now_usec() - start;
+
+        printf("{ \"mode\" : \"%s\", \"pkts\" : %u, \"time_us\" : %" PRIu32 ", "
+               "\"errors\" : %u }\n", _modes[mode], pkts, time_us,
+               _errors + (PKTS - pkts));
+    }
+    puts("done");
+
+    return 0;
+}
@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+PKTS = 4096
+
+
+def testfunc(child):
+    for mode in ("recv", "recv_batch", "recv_buf"):
+        child.expect(r"{ \"mode\" : \"%s\", \"pkts\" : (\d+), "
+                     r"\"time_us\" : \d+, \"errors\" : (\d+) }" % mode,
+                     timeout=60)
+        assert int(child.match.group(1)) == PKTS
+        assert int(child.match.group(2)) == 0
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure throughput of the thread-safe ringbuffer
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "tsrb.h"
+#include "xtimer.h"
+
+#ifndef TEST_BYTES
+#define TEST_BYTES          (1024U * 1024U)
+#endif
+
+#ifndef TEST_BUF_SIZE
+#define TEST_BUF_SIZE       (256U)
+#endif
+
+/* sizes of the chunks added and removed, so the ringbuffer wraps around at
+ * varying positions like it would with a UART ISR and a reading thread */
+#ifndef TEST_ADD_CHUNK
+#define TEST_ADD_CHUNK      (48U)
+#endif
+
+#ifndef TEST_GET_CHUNK
+#define TEST_GET_CHUNK      (64U)
+#endif
+
+static uint8_t _rb_buf[TEST_BUF_SIZE];
+static tsrb_t _rb = TSRB_INIT(_rb_buf);
+/* byte n of the stream is n & 0xff, whatever the producer chunk sizes are */
+static uint8_t _src[256U + TEST_ADD_CHUNK];
+static uint8_t _dst[TEST_GET_CHUNK];
+static uint32_t _sum;
+
+static void _consume(const uint8_t *data, unsigned len)
+{
+    for (unsigned i = 0; i < len; i++) {
+        _sum += data[i];
+    }
+}
+
+/* byte-wise copy loops the ringbuffer used before it handed out regions */
+static int _bytewise_add(tsrb_t *rb, const uint8_t *src, size_t n)
+{
+    size_t tmp = n;
+
+    while (tmp && !tsrb_full(rb)) {
+        rb->buf[rb->writes++ & (rb->size - 1)] = *src++;
+        tmp--;
+    }
+    return (n - tmp);
+}
+
+static int _bytewise_get(tsrb_t *rb, size_t n)
+{
+    size_t tmp = n;
+    uint8_t *dst = _dst;
+
+    while (tmp && !tsrb_empty(rb)) {
+        *dst++ = rb->buf[rb->reads++ & (rb->size - 1)];
+        tmp--;
+    }
+    _consume(_dst, n - tmp);
+    return (n - tmp);
+}
+
+static int _bulk_get(tsrb_t *rb, size_t n)
+{
+    int res = tsrb_get(rb, _dst, n);
+
+    _consume(_dst, res);
+    return res;
+}
+
+static int _region_add(tsrb_t *rb, const uint8_t *src, size_t n)
+{
+    uint8_t *data;
+    unsigned len = tsrb_peek_write(rb, &data);
+
+    /* only fill the first region, like a DMA transfer would */
+    if (len > n) {
+        len = n;
+    }
+    memcpy(data, src, len);
+    tsrb_commit_write(rb, len);
+    return len;
+}
+
+static int _region_get(tsrb_t *rb, size_t n)
+{
+    const uint8_t *data;
+    unsigned len = tsrb_peek_read(rb, &data);
+
+    if (len > n) {
+        len = n;
+    }
+    /* process bytes in place instead of copying them out */
+    _consume(data, len);
+    tsrb_commit_read(rb, len);
+    return len;
+}
+
+static size_t _min(size_t a, size_t b)
+{
+    return (a < b) ? a : b;
+}
+
+static void _run(const char *name,
+                 int (*add)(tsrb_t *, const uint8_t *, size_t),
+                 int (*get)(tsrb_t *, size_t))
+{
+    uint32_t added = 0, got = 0;
+    uint32_t start, time;
+
+    tsrb_init(&_rb, _rb_buf, sizeof(_rb_buf));
+    _sum = 0;
+    start = xtimer_now_usec();
+    while (got < TEST_BYTES) {
+        if (added < TEST_BYTES) {
+            added += add(&_rb, &_src[added & 0xff],
+                         _min(TEST_ADD_CHUNK, TEST_BYTES - added));
+        }
+        got += get(&_rb, _min(TEST_GET_CHUNK, TEST_BYTES - got));
+    }
+    time = xtimer_now_usec() - start;
+    printf("{ \"variant\" : \"%s\", \"bytes\" : %" PRIu32 ", "
+           "\"time_us\" : %" PRIu32 ", \"sum\" : %" PRIu32 " }\n",
+           name, got, time, _sum);
+}
+
+int main(void)
+{
+    puts("main starting");
+
+    for (unsigned i = 0; i < sizeof(_src); i++) {
+        _src[i] = (uint8_t)i;
+    }
+    _run("bytewise", _bytewise_add, _bytewise_get);
+    _run("bulk", tsrb_add, _bulk_get);
+    _run("region", _region_add, _region_get);
+    puts("done");
+
+    return 0;
+}
@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    sums = set()
+    for variant in ("bytewise", "bulk", "region"):
+        child.expect(r"{ \"variant\" : \"%s\", \"bytes\" : \d+, "
+                     r"\"time_us\" : \d+, \"sum\" : (\d+) }" % variant)
+        sums.add(child.match.group(1))
+    # all variants must have transferred the same data
+    assert len(sums) == 1
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -54,6 +54,15 @@
 #define TEST_MSG_QUEUE_SIZE (4U)
 #define TEST_TIME           (10U)
 
+/* Number of timers armed at once in the scaling phase, the phase is run for
+ * 10, 100, ... timers up to TEST_TIMERS_MAX */
+#ifndef TEST_TIMERS_MAX
+#define TEST_TIMERS_MAX     (100U)
+#endif
+/* The probe timer used to measure ISR latency fires after TEST_PROBE_US, all
+ * other timers of the scaling phase are set further in the future */
+#define TEST_PROBE_US       (10000LU)
+
 static char slacker_stack1[THREAD_STACKSIZE_DEFAULT];
 static char slacker_stack2[THREAD_STACKSIZE_DEFAULT];
 static char worker_stack[THREAD_STACKSIZE_MAIN];
@@ -97,6 +106,56 @@ static void *slacker_thread(void *arg)
     return NULL;
 }
 
+static xtimer_t _timers[TEST_TIMERS_MAX];
+static volatile uint32_t _probe_fired;
+
+static void _nop_callback(void *arg)
+{
+    (void)arg;
+}
+
+static void _probe_callback(void *arg)
+{
+    (void)arg;
+    _probe_fired = xtimer_now_usec();
+}
+
+/* Measures average cost of xtimer_set() and xtimer_remove() and the latency
+ * of a timer interrupt with @p numof other timers armed */
+static void _scaling(unsigned numof)
+{
+    xtimer_t probe = { .callback = _probe_callback };
+    uint32_t start, insert, remove, target;
+
+    for (unsigned i = 0; i < numof; i++) {
+        _timers[i].callback = _nop_callback;
+    }
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < numof; i++) {
+        /* spread timers over ~1 minute, all after the probe timer */
+        xtimer_set(&_timers[i], (2 * TEST_PROBE_US) + ((i * 7919LU) % 60000LU) * 1000LU);
+    }
+    insert = xtimer_now_usec() - start;
+
+    _probe_fired = 0;
+    target = xtimer_now_usec() + TEST_PROBE_US;
+    xtimer_set(&probe, TEST_PROBE_US);
+    while (!_probe_fired) {}
+
+    start = xtimer_now_usec();
+    for (unsigned i = 0; i < numof; i++) {
+        xtimer_remove(&_timers[i]);
+    }
+    remove = xtimer_now_usec() - start;
+
+    printf("timers=%u insert=%" PRIu32 "ns remove=%" PRIu32 "ns "
+           "isr latency=%" PRIi32 "us\n", numof,
+           (uint32_t)(((uint64_t)insert * 1000) / numof),
+           (uint32_t)(((uint64_t)remove * 1000) / numof),
+           (int32_t)(_probe_fired - target));
+}
+
 static volatile int32_t _min_drift, _max_drift, _min_jitter, _max_jitter;
 static volatile int32_t _final_drift;
 static volatile uint32_t _total_jitter, _samples;
@@ -159,6 +218,11 @@ int main(void)
 {
     LOG_DEBUG("[INIT]\n");
     msg_t m;
+
+    puts("[SCALING]");
+    for (unsigned numof = 10; numof <= TEST_TIMERS_MAX; numof *= 10) {
+        _scaling(numof);
+    }
     /* create and trigger first background thread */
     kernel_pid_t pid1 = thread_create(slacker_stack1, sizeof(slacker_stack1),
                                       THREAD_PRIORITY_MAIN - 1,
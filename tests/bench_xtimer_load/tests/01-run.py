@@ -14,6 +14,8 @@ from testrunner import run
 
 
 def testfunc(child):
+    child.expect_exact("[SCALING]\r\n")
+    child.expect(r"timers=10 insert=\d+ns remove=\d+ns isr latency=-?\d+us\r\n")
     child.expect(r"TEST_HZ=\d+\r\n")
     child.expect_exact("[START]\r\n")
     for _ in range(10):
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Load the gcoap client with many open requests
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/gcoap.h"
+#include "net/ipv6/addr.h"
+#include "xtimer.h"
+
+#ifndef TEST_REQUESTS
+#define TEST_REQUESTS       (1000U)
+#endif
+
+#define _PENDING            (CONFIG_GCOAP_REQ_WAITING_MAX - 1)
+
+static unsigned _responses;
+static unsigned _timeouts;
+static mutex_t _resp_lock = MUTEX_INIT_LOCKED;
+
+static ssize_t _load_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             void *ctx)
+{
+    (void)ctx;
+    return gcoap_response(pdu, buf, len, COAP_CODE_CONTENT);
+}
+
+static const coap_resource_t _resources[] = {
+    { "/load", COAP_GET, _load_handler, NULL },
+};
+
+static gcoap_listener_t _listener = {
+    .resources     = &_resources[0],
+    .resources_len = ARRAY_SIZE(_resources),
+    .link_encoder  = NULL,
+    .next          = NULL,
+};
+
+static void _resp_handler(const gcoap_request_memo_t *memo, coap_pkt_t *pdu,
+                          const sock_udp_ep_t *remote)
+{
+    (void)pdu;
+    (void)remote;
+
+    if (memo->state == GCOAP_MEMO_TIMEOUT) {
+        _timeouts++;
+    }
+    else {
+        _responses++;
+        mutex_unlock(&_resp_lock);
+    }
+}
+
+static size_t _send(const sock_udp_ep_t *remote)
+{
+    uint8_t buf[CONFIG_GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    ssize_t len;
+
+    gcoap_req_init(&pdu, buf, sizeof(buf), COAP_METHOD_GET, "/load");
+    coap_hdr_set_type(pdu.hdr, COAP_TYPE_NON);
+    len = coap_opt_finish(&pdu, COAP_OPT_FINISH_NONE);
+    return gcoap_req_send(buf, len, remote, _resp_handler, NULL);
+}
+
+int main(void)
+{
+    sock_udp_ep_t server = {
+        .family = AF_INET6,
+        .netif = SOCK_ADDR_ANY_NETIF,
+        .port = CONFIG_GCOAP_PORT,
+    };
+    /* nobody listens on this port, so requests to it stay open */
+    sock_udp_ep_t silent = {
+        .family = AF_INET6,
+        .netif = SOCK_ADDR_ANY_NETIF,
+        .port = CONFIG_GCOAP_PORT + 1,
+    };
+    unsigned requests = 0;
+
+    memcpy(server.addr.ipv6, &ipv6_addr_loopback, sizeof(ipv6_addr_t));
+    memcpy(silent.addr.ipv6, &ipv6_addr_loopback, sizeof(ipv6_addr_t));
+    gcoap_register_listener(&_listener);
+
+    for (unsigned i = 0; i < _PENDING; i++) {
+        if (_send(&silent) == 0) {
+            puts("failed to send background request");
+            return 1;
+        }
+    }
+    printf("{ \"pending\" : %u }\n", (unsigned)_PENDING);
+
+    uint32_t start = xtimer_now_usec();
+    for (; requests < TEST_REQUESTS; requests++) {
+        if (_send(&server) == 0) {
+            puts("failed to send request");
+            break;
+        }
+        /* wait for the response */
+        mutex_lock(&_resp_lock);
+    }
+    uint32_t time = xtimer_now_usec() - start;
+
+    /* wait for the background requests to time out */
+    while (_timeouts < _PENDING) {
+        xtimer_usleep(CONFIG_GCOAP_NON_TIMEOUT);
+    }
+    printf("{ \"requests\" : %u, \"responses\" : %u, \"timeouts\" : %u, "
+           "\"time_us\" : %" PRIu32 " }\n",
+           requests, _responses, _timeouts, time);
+    puts("done");
+
+    return 0;
+}
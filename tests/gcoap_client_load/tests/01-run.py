@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect(r"{ \"pending\" : (\d+) }")
+    pending = int(child.match.group(1))
+    child.expect(r"{ \"requests\" : (\d+), \"responses\" : (\d+), "
+                 r"\"timeouts\" : (\d+), \"time_us\" : \d+ }")
+    # every exchange is answered, every background request times out
+    assert int(child.match.group(1)) == int(child.match.group(2))
+    assert int(child.match.group(3)) == pending
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test CoCoA retransmission timeouts and the gcoap resend pool
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/gcoap.h"
+#include "net/ipv6/addr.h"
+#include "xtimer.h"
+
+#define _POOL_WORDS         ((CONFIG_GCOAP_RESEND_POOL_SIZE + 1) / 2)
+
+/* transmissions of a request seen by the /cocoa resource */
+static uint32_t _arrivals[COAP_MAX_RETRANSMIT + 1];
+static unsigned _arrivals_numof;
+/* transmissions left to ignore */
+static unsigned _drop;
+
+static unsigned _timeouts;
+static mutex_t _resp_lock = MUTEX_INIT_LOCKED;
+
+static ssize_t _cocoa_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                              void *ctx)
+{
+    (void)ctx;
+
+    if (_arrivals_numof < ARRAY_SIZE(_arrivals)) {
+        _arrivals[_arrivals_numof++] = xtimer_now_usec();
+    }
+    if (_drop > 0) {
+        /* no response, so the client resends */
+        _drop--;
+        return 0;
+    }
+    return gcoap_response(pdu, buf, len, COAP_CODE_CONTENT);
+}
+
+static const coap_resource_t _resources[] = {
+    { "/cocoa", COAP_GET, _cocoa_handler, NULL },
+};
+
+static gcoap_listener_t _listener = {
+    .resources     = &_resources[0],
+    .resources_len = ARRAY_SIZE(_resources),
+    .link_encoder  = NULL,
+    .next          = NULL,
+};
+
+static void _resp_handler(const gcoap_request_memo_t *memo, coap_pkt_t *pdu,
+                          const sock_udp_ep_t *remote)
+{
+    (void)memo;
+    (void)pdu;
+    (void)remote;
+    mutex_unlock(&_resp_lock);
+}
+
+static void _silent_handler(const gcoap_request_memo_t *memo, coap_pkt_t *pdu,
+                            const sock_udp_ep_t *remote)
+{
+    (void)pdu;
+    (void)remote;
+
+    if (memo->state == GCOAP_MEMO_TIMEOUT) {
+        _timeouts++;
+    }
+}
+
+/* Sends a confirmable request with the given payload length */
+static size_t _send(const sock_udp_ep_t *remote, size_t payload_len,
+                    gcoap_resp_handler_t resp_handler)
+{
+    uint8_t buf[CONFIG_GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    ssize_t len;
+
+    gcoap_req_init(&pdu, buf, sizeof(buf), COAP_METHOD_GET, "/cocoa");
+    coap_hdr_set_type(pdu.hdr, COAP_TYPE_CON);
+    if (payload_len == 0) {
+        len = coap_opt_finish(&pdu, COAP_OPT_FINISH_NONE);
+    }
+    else {
+        len = coap_opt_finish(&pdu, COAP_OPT_FINISH_PAYLOAD);
+        memset(pdu.payload, 0x55, payload_len);
+        len += payload_len;
+    }
+    return gcoap_req_send(buf, len, remote, resp_handler, NULL);
+}
+
+/* Runs an exchange with /cocoa that drops the first transmissions */
+static int _exchange(const sock_udp_ep_t *server, unsigned drop)
+{
+    _drop = drop;
+    _arrivals_numof = 0;
+    if (_send(server, 0, _resp_handler) == 0) {
+        puts("failed to send request");
+        return -1;
+    }
+    mutex_lock(&_resp_lock);
+    if (_arrivals_numof != drop + 1) {
+        printf("unexpected transmissions: %u\n", _arrivals_numof);
+        return -1;
+    }
+    return 0;
+}
+
+/* Sends requests of header length only until gcoap refuses one */
+static unsigned _fill(const sock_udp_ep_t *remote)
+{
+    unsigned count = 0;
+
+    while ((count < CONFIG_GCOAP_REQ_WAITING_MAX)
+            && (_send(remote, 0, _silent_handler) > 0)) {
+        count++;
+    }
+    return count;
+}
+
+int main(void)
+{
+    sock_udp_ep_t server = {
+        .family = AF_INET6,
+        .netif = SOCK_ADDR_ANY_NETIF,
+        .port = CONFIG_GCOAP_PORT,
+    };
+    /* nobody listens on these ports, so requests to them stay open */
+    sock_udp_ep_t silent_a = {
+        .family = AF_INET6,
+        .netif = SOCK_ADDR_ANY_NETIF,
+        .port = CONFIG_GCOAP_PORT + 1,
+    };
+    sock_udp_ep_t silent_b = {
+        .family = AF_INET6,
+        .netif = SOCK_ADDR_ANY_NETIF,
+        .port = CONFIG_GCOAP_PORT + 2,
+    };
+
+    memcpy(server.addr.ipv6, &ipv6_addr_loopback, sizeof(ipv6_addr_t));
+    memcpy(silent_a.addr.ipv6, &ipv6_addr_loopback, sizeof(ipv6_addr_t));
+    memcpy(silent_b.addr.ipv6, &ipv6_addr_loopback, sizeof(ipv6_addr_t));
+    gcoap_register_listener(&_listener);
+
+    /* a new destination starts from COAP_ACK_TIMEOUT; the response to the
+     * resend is a weak sample */
+    if (_exchange(&server, 1) < 0) {
+        return 1;
+    }
+    printf("{ \"ack_timeout_us\" : %" PRIu32 ", \"initial_us\" : %" PRIu32
+           " }\n", (uint32_t)COAP_ACK_TIMEOUT * US_PER_SEC,
+           _arrivals[1] - _arrivals[0]);
+
+    /* strong samples over loopback lower the RTO; a short one backs off by
+     * a factor of 3 */
+    for (unsigned i = 0; i < 10; i++) {
+        if (_exchange(&server, 0) < 0) {
+            return 1;
+        }
+    }
+    if (_exchange(&server, 2) < 0) {
+        return 1;
+    }
+    uint32_t strong = _arrivals[1] - _arrivals[0];
+    printf("{ \"strong_us\" : %" PRIu32 ", \"backoff_us\" : %" PRIu32 " }\n",
+           strong, _arrivals[2] - _arrivals[1]);
+
+    /* the weak sample of the exchange above, taken from the first
+     * transmission, raises the RTO again */
+    if (_exchange(&server, 1) < 0) {
+        return 1;
+    }
+    printf("{ \"weak_us\" : %" PRIu32 " }\n", _arrivals[1] - _arrivals[0]);
+
+    /* NSTART limits the requests to silent_a, the resend pool those to
+     * silent_b */
+    unsigned open_a = _fill(&silent_a);
+    unsigned open_b = _fill(&silent_b);
+    uint8_t buf[CONFIG_GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    size_t hdr_len;
+
+    gcoap_req_init(&pdu, buf, sizeof(buf), COAP_METHOD_GET, "/cocoa");
+    hdr_len = coap_opt_finish(&pdu, COAP_OPT_FINISH_NONE);
+    printf("{ \"nstart\" : %u, \"open_a\" : %u, \"open_b\" : %u, "
+           "\"pool_fits\" : %u }\n", (unsigned)CONFIG_GCOAP_NSTART,
+           open_a, open_b,
+           (unsigned)(_POOL_WORDS / (1 + ((hdr_len + 1) / 2))));
+
+    /* once all expired, the freed blocks merge to hold a request filling
+     * the whole pool; the payload marker takes one more byte */
+    while (_timeouts < (open_a + open_b)) {
+        xtimer_usleep(US_PER_SEC);
+    }
+    size_t payload_len = ((_POOL_WORDS - 1) * 2) - hdr_len - 1;
+    printf("{ \"timeouts\" : %u, \"reused\" : %u }\n", _timeouts,
+           (unsigned)(_send(&silent_a, payload_len, _silent_handler) > 0));
+    puts("done");
+
+    return 0;
+}
@@ -0,0 +1,50 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+# allowed deviation of a timeout [in usec]
+TOLERANCE_US = 100000
+
+
+def testfunc(child):
+    child.expect(r"{ \"ack_timeout_us\" : (\d+), \"initial_us\" : (\d+) }")
+    ack_timeout = int(child.match.group(1))
+    initial = int(child.match.group(2))
+    assert abs(initial - ack_timeout) < TOLERANCE_US
+
+    child.expect(r"{ \"strong_us\" : (\d+), \"backoff_us\" : (\d+) }")
+    strong = int(child.match.group(1))
+    backoff = int(child.match.group(2))
+    # loopback round trips pull the RTO far below the initial one
+    assert strong < initial / 4
+    # short RTOs back off by a factor of 3
+    assert backoff > 2 * strong
+
+    child.expect(r"{ \"weak_us\" : (\d+) }")
+    assert int(child.match.group(1)) > 2 * strong
+
+    child.expect(r"{ \"nstart\" : (\d+), \"open_a\" : (\d+), "
+                 r"\"open_b\" : (\d+), \"pool_fits\" : (\d+) }")
+    nstart = int(child.match.group(1))
+    open_a = int(child.match.group(2))
+    open_b = int(child.match.group(3))
+    pool_fits = int(child.match.group(4))
+    assert open_a == nstart
+    assert open_a + open_b == pool_fits
+
+    # the silent requests take 7 s to expire
+    child.expect(r"{ \"timeouts\" : (\d+), \"reused\" : (\d+) }", timeout=20)
+    assert int(child.match.group(1)) == open_a + open_b
+    assert int(child.match.group(2)) == 1
+    child.expect_exact("done")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -23,6 +23,7 @@
 #include "net/gnrc/netreg.h"
 #include "net/gnrc/sixlowpan/frag.h"
 #include "net/gnrc/sixlowpan/frag/rb.h"
+#include "random.h"
 #include "xtimer.h"
 
 #define TEST_NETIF_HDR_SRC      { 0xb3, 0x47, 0x60, 0x49, \
@@ -34,6 +35,8 @@
 #define TEST_PAGE               (0)
 #define TEST_RECEIVE_TIMEOUT    (100U)
 #define TEST_GC_TIMEOUT         (CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_TIMEOUT_US + TEST_RECEIVE_TIMEOUT)
+#define TEST_SHUFFLE_SEED       (0x8e5cd83fU)
+#define TEST_SHUFFLE_RUNS       (128U)
 
 /* test date taken from an experimental run (uncompressed ICMPv6 echo reply with
  * 300 byte payload)*/
@@ -235,10 +238,13 @@ static void _test_entry(const gnrc_sixlowpan_frag_rb_t *entry,
                         "entry->super.dst != TEST_NETIF_HDR_DST");
     TEST_ASSERT_EQUAL_INT(TEST_TAG, entry->super.tag);
     TEST_ASSERT_EQUAL_INT(exp_current_size, entry->super.current_size);
-    TEST_ASSERT_NOT_NULL(entry->super.ints);
-    TEST_ASSERT_NULL(entry->super.ints->next);
-    TEST_ASSERT_EQUAL_INT(exp_int_start, entry->super.ints->start);
-    TEST_ASSERT_EQUAL_INT(exp_int_end, entry->super.ints->end);
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_RB_UNITS; i++) {
+        /* intentionally discarding const qualifier since bf_isset() only
+         * reads */
+        TEST_ASSERT_EQUAL_INT((i >= (exp_int_start / 8U)) &&
+                              (i <= (exp_int_end / 8U)),
+                              bf_isset((uint8_t *)entry->super.received, i));
+    }
 }
 
 static void _check_pktbuf(const gnrc_sixlowpan_frag_rb_t *entry)
@@ -383,6 +389,81 @@ static void test_rbuf_add__success_complete(void)
     _check_pktbuf(NULL);
 }
 
+static void test_rbuf_add__shuffled_duplicates(void)
+{
+    struct {
+        const uint8_t *data;
+        size_t size;
+        size_t offset;
+    } frags[] = {
+        { _fragment1, sizeof(_fragment1), TEST_FRAGMENT1_OFFSET },
+        { _fragment2, sizeof(_fragment2), TEST_FRAGMENT2_OFFSET },
+        { _fragment3, sizeof(_fragment3), TEST_FRAGMENT3_OFFSET },
+        { _fragment4, sizeof(_fragment4), TEST_FRAGMENT4_OFFSET },
+    };
+    /* each fragment is received twice */
+    unsigned order[2 * ARRAY_SIZE(frags)];
+    gnrc_netreg_entry_t reg = GNRC_NETREG_ENTRY_INIT_PID(
+            GNRC_NETREG_DEMUX_CTX_ALL,
+            sched_active_pid
+        );
+
+    random_init(TEST_SHUFFLE_SEED);
+    gnrc_netreg_register(TEST_DATAGRAM_NETTYPE, &reg);
+    for (unsigned run = 0; run < TEST_SHUFFLE_RUNS; run++) {
+        gnrc_pktsnip_t *datagram;
+        msg_t msg = { .type = 0U };
+        int complete = 0;
+
+        for (unsigned i = 0; i < ARRAY_SIZE(order); i++) {
+            order[i] = i % ARRAY_SIZE(frags);
+        }
+        /* Fisher-Yates shuffle */
+        for (unsigned i = ARRAY_SIZE(order) - 1; i > 0; i--) {
+            unsigned j = random_uint32_range(0, i + 1);
+            unsigned tmp = order[i];
+
+            order[i] = order[j];
+            order[j] = tmp;
+        }
+        /* fragments after the completing one would hit the entry scheduled
+         * for deletion, so stop there */
+        for (unsigned i = 0; (i < ARRAY_SIZE(order)) && !complete; i++) {
+            gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, frags[order[i]].data,
+                                                  frags[order[i]].size,
+                                                  GNRC_NETTYPE_SIXLOWPAN);
+            gnrc_sixlowpan_frag_rb_t *entry;
+
+            TEST_ASSERT_NOT_NULL(pkt);
+            TEST_ASSERT_NOT_NULL((entry = gnrc_sixlowpan_frag_rb_add(
+                    &_test_netif_hdr.hdr, pkt, frags[order[i]].offset,
+                    TEST_PAGE
+                )));
+            complete = gnrc_sixlowpan_frag_rb_dispatch_when_complete(
+                    entry, &_test_netif_hdr.hdr
+                );
+            TEST_ASSERT(complete >= 0);
+        }
+        TEST_ASSERT(complete > 0);
+        TEST_ASSERT_MESSAGE(
+                xtimer_msg_receive_timeout(&msg, TEST_RECEIVE_TIMEOUT) >= 0,
+                "Receiving reassembled datagram timed out"
+            );
+        TEST_ASSERT_EQUAL_INT(GNRC_NETAPI_MSG_TYPE_RCV, msg.type);
+        TEST_ASSERT_NOT_NULL(msg.content.ptr);
+        datagram = msg.content.ptr;
+        TEST_ASSERT_EQUAL_INT(TEST_DATAGRAM_SIZE, datagram->size);
+        TEST_ASSERT_MESSAGE(memcmp(_datagram, datagram->data,
+                            TEST_DATAGRAM_SIZE) == 0,
+                            "Reassembled datagram does not contain expected data");
+        gnrc_pktbuf_release(datagram);
+        _check_pktbuf(NULL);
+        /* remove entry scheduled for deletion for next run */
+        gnrc_sixlowpan_frag_rb_reset();
+    }
+    gnrc_netreg_unregister(TEST_DATAGRAM_NETTYPE, &reg);
+}
+
 static void test_rbuf_add__full_rbuf(void)
 {
     gnrc_pktsnip_t *pkt;
@@ -444,6 +525,44 @@ static void test_rbuf_add__too_big_fragment(void)
     _check_pktbuf(NULL);
 }
 
+static void _rbuf_add_empty_fragment(const void *data, size_t size,
+                                     size_t offset)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, data, size,
+                                          GNRC_NETTYPE_SIXLOWPAN);
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_rb_add(
+            &_test_netif_hdr.hdr, pkt, offset, TEST_PAGE
+        ));
+}
+
+static void test_rbuf_add__empty_fragments(void)
+{
+    uint8_t uncomp_frag1[sizeof(sixlowpan_frag_t) + 1];
+    const gnrc_sixlowpan_frag_rb_t *entry;
+
+    memcpy(uncomp_frag1, _fragment1, sizeof(sixlowpan_frag_t));
+    uncomp_frag1[sizeof(sixlowpan_frag_t)] = SIXLOWPAN_UNCOMP;
+    /* fragments that carry no payload of the datagram are dropped */
+    _rbuf_add_empty_fragment(_fragment1, sizeof(sixlowpan_frag_t),
+                             TEST_FRAGMENT1_OFFSET);
+    _rbuf_add_empty_fragment(uncomp_frag1, sizeof(uncomp_frag1),
+                             TEST_FRAGMENT1_OFFSET);
+    _rbuf_add_empty_fragment(_fragment2, sizeof(sixlowpan_frag_n_t),
+                             TEST_FRAGMENT2_OFFSET);
+    TEST_ASSERT_NULL(_first_non_empty_rbuf());
+    _check_pktbuf(NULL);
+    /* ... and leave an existing entry untouched */
+    _rbuf_create_first_fragment();
+    _rbuf_add_empty_fragment(_fragment2, sizeof(sixlowpan_frag_n_t),
+                             TEST_FRAGMENT2_OFFSET);
+    TEST_ASSERT_NOT_NULL((entry = _first_non_empty_rbuf()));
+    _test_entry(entry, TEST_FRAGMENT2_OFFSET,
+                TEST_FRAGMENT1_OFFSET, TEST_FRAGMENT2_OFFSET - 1);
+    _check_pktbuf(entry);
+}
+
 static void test_rbuf_add__overlap_lhs(void)
 {
     static const size_t pkt2_offset = TEST_FRAGMENT2_OFFSET - 8U;
@@ -627,8 +746,10 @@ static void run_unittests(void)
         new_TestFixture(test_rbuf_add__success_subsequent_fragment),
         new_TestFixture(test_rbuf_add__success_duplicate_fragments),
         new_TestFixture(test_rbuf_add__success_complete),
+        new_TestFixture(test_rbuf_add__shuffled_duplicates),
         new_TestFixture(test_rbuf_add__full_rbuf),
         new_TestFixture(test_rbuf_add__too_big_fragment),
+        new_TestFixture(test_rbuf_add__empty_fragments),
         new_TestFixture(test_rbuf_add__overlap_lhs),
         new_TestFixture(test_rbuf_add__overlap_rhs),
         new_TestFixture(test_rbuf_exists),
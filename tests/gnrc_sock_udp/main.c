@@ -421,6 +421,73 @@ static void test_sock_udp_recv__non_blocking(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_recv_buf(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    sock_udp_ep_t result;
+    void *data = NULL, *ctx = NULL;
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF));
+    assert(sizeof("ABCD") == sock_udp_recv_buf(&_sock, &data, &ctx,
+                                               SOCK_NO_TIMEOUT, &result));
+    assert(data != NULL);
+    assert(ctx != NULL);
+    assert(memcmp(data, "ABCD", sizeof("ABCD")) == 0);
+    assert(AF_INET6 == result.family);
+    assert(memcmp(&result.addr, &src_addr, sizeof(result.addr)) == 0);
+    assert(_TEST_PORT_REMOTE == result.port);
+    assert(_TEST_NETIF == result.netif);
+    assert(0 == sock_udp_recv_buf(&_sock, &data, &ctx, SOCK_NO_TIMEOUT,
+                                  &result));
+    assert(data == NULL);
+    assert(ctx == NULL);
+    assert(_check_net());
+}
+
+static void test_sock_udp_recv_batch(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const sock_udp_ep_t local = { .family = AF_INET6,
+                                         .port = _TEST_PORT_LOCAL };
+    sock_udp_ep_t remotes[3];
+    sock_udp_msg_t msgs[] = {
+        { .data = &_test_buffer[0], .len = 8, .remote = &remotes[0] },
+        { .data = &_test_buffer[8], .len = 8, .remote = &remotes[1] },
+        { .data = &_test_buffer[16], .len = 8, .remote = &remotes[2] },
+    };
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "ABCD", sizeof("ABCD"),
+                          _TEST_NETIF));
+    /* does not fit into its slot and is dropped */
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE,
+                          _TEST_PORT_LOCAL, "ABCDEFGHIJ", sizeof("ABCDEFGHIJ"),
+                          _TEST_NETIF));
+    assert(_inject_packet(&src_addr, &dst_addr, _TEST_PORT_REMOTE + 1,
+                          _TEST_PORT_LOCAL, "EFG", sizeof("EFG"),
+                          _TEST_NETIF));
+    assert(2 == sock_udp_recv_batch(&_sock, msgs, ARRAY_SIZE(msgs),
+                                    SOCK_NO_TIMEOUT));
+    assert(sizeof("ABCD") == msgs[0].len);
+    assert(memcmp(msgs[0].data, "ABCD", sizeof("ABCD")) == 0);
+    assert(_TEST_PORT_REMOTE == remotes[0].port);
+    assert(sizeof("EFG") == msgs[1].len);
+    assert(memcmp(msgs[1].data, "EFG", sizeof("EFG")) == 0);
+    assert(_TEST_PORT_REMOTE + 1 == remotes[1].port);
+    assert(memcmp(&remotes[1].addr, &src_addr, sizeof(remotes[1].addr)) == 0);
+    assert(8 == msgs[2].len);
+    assert(-EAGAIN == sock_udp_recv_batch(&_sock, msgs, ARRAY_SIZE(msgs), 0));
+    assert(_check_net());
+}
+
 static void test_sock_udp_send__EAFNOSUPPORT(void)
 {
     static const sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
@@ -557,6 +624,47 @@ static void test_sock_udp_send__socketed(void)
     assert(_check_net());
 }
 
+static void test_sock_udp_send_batch(void)
+{
+    static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_LOCAL };
+    static const ipv6_addr_t dst_addr = { .u8 = _TEST_ADDR_REMOTE };
+    static const sock_udp_ep_t local = { .addr = { .ipv6 = _TEST_ADDR_LOCAL },
+                                         .family = AF_INET6,
+                                         .netif = _TEST_NETIF,
+                                         .port = _TEST_PORT_LOCAL };
+    static sock_udp_ep_t remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                    .family = AF_INET6,
+                                    .port = _TEST_PORT_REMOTE + 1 };
+    static const sock_udp_msg_t msgs[] = {
+        { .data = "ABCD", .len = sizeof("ABCD") },
+        { .data = "EFG", .len = sizeof("EFG"), .remote = &remote },
+    };
+
+    assert(0 == sock_udp_create(&_sock, &local, NULL, SOCK_FLAGS_REUSE_EP));
+    /* no remote for the first message */
+    assert(-ENOTCONN == sock_udp_send_batch(&_sock, msgs, ARRAY_SIZE(msgs)));
+    assert(1 == sock_udp_send_batch(&_sock, &msgs[1], 1));
+    assert(_check_packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE + 1, "EFG", sizeof("EFG"),
+                         _TEST_NETIF, false));
+    sock_udp_close(&_sock);
+
+    static const sock_udp_ep_t default_remote = { .addr = { .ipv6 = _TEST_ADDR_REMOTE },
+                                                  .family = AF_INET6,
+                                                  .port = _TEST_PORT_REMOTE };
+    assert(0 == sock_udp_create(&_sock, &local, &default_remote,
+                                SOCK_FLAGS_REUSE_EP));
+    assert(2 == sock_udp_send_batch(&_sock, msgs, ARRAY_SIZE(msgs)));
+    assert(_check_packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE, "ABCD", sizeof("ABCD"),
+                         _TEST_NETIF, false));
+    assert(_check_packet(&src_addr, &dst_addr, _TEST_PORT_LOCAL,
+                         _TEST_PORT_REMOTE + 1, "EFG", sizeof("EFG"),
+                         _TEST_NETIF, false));
+    xtimer_usleep(1000);    /* let GNRC stack finish */
+    assert(_check_net());
+}
+
 static void test_sock_udp_send__socketed_other_remote(void)
 {
     static const ipv6_addr_t src_addr = { .u8 = _TEST_ADDR_LOCAL };
@@ -724,6 +832,8 @@ int main(void)
     CALL(test_sock_udp_recv__unsocketed_with_remote());
     CALL(test_sock_udp_recv__with_timeout());
     CALL(test_sock_udp_recv__non_blocking());
+    CALL(test_sock_udp_recv_buf());
+    CALL(test_sock_udp_recv_batch());
     _prepare_send_checks();
     CALL(test_sock_udp_send__EAFNOSUPPORT());
     CALL(test_sock_udp_send__EINVAL_addr());
@@ -741,6 +851,7 @@ int main(void)
     CALL(test_sock_udp_send__unsocketed());
     CALL(test_sock_udp_send__no_sock_no_netif());
     CALL(test_sock_udp_send__no_sock());
+    CALL(test_sock_udp_send_batch());
 
     puts("ALL TESTS SUCCESSFUL");
 
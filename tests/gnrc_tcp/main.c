@@ -16,10 +16,12 @@
 
 #define MAIN_QUEUE_SIZE (8)
 #define BUFFER_SIZE (2049)
+#define RCV_BUFFER_SIZE (4096)
 
 static msg_t main_msg_queue[MAIN_QUEUE_SIZE];
 static gnrc_tcp_tcb_t tcb;
 static char buffer[BUFFER_SIZE];
+static char rcv_buffer[RCV_BUFFER_SIZE];
 
 void dump_args(int argc, char **argv)
 {
@@ -98,6 +100,30 @@ int gnrc_tcp_tcb_init_cmd(int argc, char **argv)
     return 0;
 }
 
+int gnrc_tcp_tcb_set_rcv_buf_cmd(int argc, char **argv)
+{
+    dump_args(argc, argv);
+    size_t size = atol(argv[1]);
+
+    if (size > RCV_BUFFER_SIZE) {
+        size = RCV_BUFFER_SIZE;
+    }
+    int err = gnrc_tcp_tcb_set_rcv_buf(&tcb, rcv_buffer, size);
+    switch (err) {
+        case -EINVAL:
+            printf("%s: returns -EINVAL\n", argv[0]);
+            break;
+
+        case -EISCONN:
+            printf("%s: returns -EISCONN\n", argv[0]);
+            break;
+
+        default:
+            printf("%s: returns %u\n", argv[0], (unsigned)size);
+    }
+    return err;
+}
+
 int gnrc_tcp_open_active_cmd(int argc, char **argv)
 {
     dump_args(argc, argv);
@@ -276,6 +302,8 @@ int gnrc_tcp_abort_cmd(int argc, char **argv)
 /* Exporting GNRC TCP Api to for shell usage */
 static const shell_command_t shell_commands[] = {
     { "gnrc_tcp_tcb_init", "gnrc_tcp: init tcb", gnrc_tcp_tcb_init_cmd },
+    { "gnrc_tcp_tcb_set_rcv_buf", "gnrc_tcp: use receive buffer of given size",
+      gnrc_tcp_tcb_set_rcv_buf_cmd },
     { "gnrc_tcp_open_active", "gnrc_tcp: open active connection",
       gnrc_tcp_open_active_cmd },
     { "gnrc_tcp_open_passive", "gnrc_tcp: open passive connection",
@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import os
+import sys
+import threading
+
+from testrunner import run
+from shared_func import TcpServer, generate_port_number, get_host_tap_device, \
+                        get_host_ll_addr, get_riot_if_id, setup_internal_buffer, \
+                        read_data_from_internal_buffer, verify_pktbuf_empty, \
+                        sudo_guard
+
+# Share of packets dropped on their way from the host system to RIOT
+LOSS_PERCENT = 20
+RCV_BUF_SIZE = 4096
+ROUNDS = 5
+
+
+def set_link_loss(percent):
+    # Packets sent from the host to RIOT leave through the tap device
+    tap = os.environ["TAPDEV"]
+    if percent:
+        cmd = 'tc qdisc add dev {} root netem loss {}%'.format(tap, percent)
+    else:
+        cmd = 'tc qdisc del dev {} root netem'.format(tap)
+    assert os.system(cmd) == 0
+
+
+def tcp_server(port, shutdown_event, data):
+    with TcpServer(port, shutdown_event) as tcp_srv:
+        for _ in range(ROUNDS):
+            tcp_srv.send(data)
+
+
+def testfunc(child):
+    port = generate_port_number()
+    shutdown_event = threading.Event()
+
+    # Try to receive several 2000 byte chunks over a link dropping packets
+    data = '0123456789' * 200
+    data_len = len(data)
+
+    # Verify that RIOT Applications internal buffer can hold test data.
+    assert setup_internal_buffer(child) >= data_len
+
+    server_handle = threading.Thread(target=tcp_server, args=(port, shutdown_event, data))
+    server_handle.start()
+
+    target_addr = get_host_ll_addr(get_host_tap_device()) + '%' + get_riot_if_id(child)
+
+    # Setup RIOT Node with a receive window spanning multiple segments and connect
+    child.sendline('gnrc_tcp_tcb_init')
+    child.sendline('gnrc_tcp_tcb_set_rcv_buf ' + str(RCV_BUF_SIZE))
+    child.expect_exact('gnrc_tcp_tcb_set_rcv_buf: returns ' + str(RCV_BUF_SIZE))
+    child.sendline('gnrc_tcp_open_active AF_INET6 ' + target_addr + " " + str(port) + ' 0')
+    child.expect_exact('gnrc_tcp_open_active: returns 0')
+
+    # Accept data sent by the host system while the link drops packets.
+    # Segments behind a lost one must be kept and reported via SACK.
+    set_link_loss(LOSS_PERCENT)
+    try:
+        for _ in range(ROUNDS):
+            child.sendline('buffer_init')
+            child.sendline('gnrc_tcp_recv 1000000 ' + str(data_len))
+            child.expect_exact('gnrc_tcp_recv: received ' + str(data_len), timeout=60)
+            assert read_data_from_internal_buffer(child, data_len) == data
+    finally:
+        set_link_loss(0)
+
+    # Close connection and verify that pktbuf is cleared
+    shutdown_event.set()
+    child.sendline('gnrc_tcp_close')
+    server_handle.join()
+
+    verify_pktbuf_empty(child)
+
+    print(os.path.basename(sys.argv[0]) + ': success')
+
+
+if __name__ == '__main__':
+    sudo_guard(uses_netem=True)
+    sys.exit(run(testfunc, timeout=5, echo=False, traceback=True))
@@ -107,12 +107,14 @@ def verify_pktbuf_empty(child):
     child.expect(r'~ unused: {} \(next: (\(nil\)|0), size: {}\) ~'.format(pktbuf_addr, pktbuf_size))
 
 
-def sudo_guard(uses_scapy=False):
-    sudo_required = uses_scapy or (os.environ.get("BOARD", "") != "native")
+def sudo_guard(uses_scapy=False, uses_netem=False):
+    sudo_required = uses_scapy or uses_netem or (os.environ.get("BOARD", "") != "native")
     if sudo_required and os.geteuid() != 0:
         print("\x1b[1;31mThis test requires root privileges.\n"
               "It uses `./dist/tools/ethos/start_networking.sh` as term" +
               (" and it's constructing and sending Ethernet frames."
-               if uses_scapy else "") + "\x1b[0m\n",
+               if uses_scapy else "") +
+              (" and it's configuring packet loss on the tap device via `tc`."
+               if uses_netem else "") + "\x1b[0m\n",
               file=sys.stderr)
         sys.exit(1)
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the per-thread and per-priority counters
+ *              of schedstatistics_ext
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "msg.h"
+#include "ps.h"
+#include "schedstatistics.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define PRIO_HIGH       (THREAD_PRIORITY_MAIN - 1)
+#define MSG_NUMOF       (10U)
+#define SPIN_US         (1000U)
+
+static char _high_stack[THREAD_STACKSIZE_DEFAULT];
+static char _peer_stack[THREAD_STACKSIZE_DEFAULT];
+
+static void *_high(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        msg_t m;
+
+        /* blocks every time, so it gives up the CPU voluntarily */
+        msg_receive(&m);
+    }
+
+    return NULL;
+}
+
+static void *_peer(void *arg)
+{
+    (void)arg;
+
+    return NULL;
+}
+
+static int _check(const char *what, unsigned value, unsigned min)
+{
+    printf("%s: %u\n", what, value);
+    if (value < min) {
+        printf("expected at least %u\n", min);
+        return 1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    kernel_pid_t main_pid = thread_getpid();
+    kernel_pid_t high_pid, peer_pid;
+    schedstat_prio_t prio_main, prio_high;
+    schedstat_t main_stat, peer_stat;
+    int res = 0;
+
+    puts("schedstatistics_ext test");
+
+    high_pid = thread_create(_high_stack, sizeof(_high_stack), PRIO_HIGH,
+                             THREAD_CREATE_STACKTEST, _high, NULL, "high");
+    /* every message wakes the thread of higher priority and preempts main */
+    for (unsigned i = 0; i < MSG_NUMOF; i++) {
+        msg_t m = { .type = i };
+
+        msg_send(&m, high_pid);
+    }
+    /* the peer waits on the run queue of main while main spins, until main
+     * yields to it */
+    peer_pid = thread_create(_peer_stack, sizeof(_peer_stack),
+                             THREAD_PRIORITY_MAIN,
+                             THREAD_CREATE_WOUT_YIELD | THREAD_CREATE_STACKTEST,
+                             _peer, NULL, "peer");
+    xtimer_spin(xtimer_ticks_from_usec(SPIN_US));
+    thread_yield();
+
+    schedstatistics_get(main_pid, &main_stat);
+    schedstatistics_get(peer_pid, &peer_stat);
+    schedstatistics_get_prio(PRIO_HIGH, &prio_high);
+    schedstatistics_get_prio(THREAD_PRIORITY_MAIN, &prio_main);
+
+    res |= _check("main preempted", main_stat.preemptions, MSG_NUMOF);
+    res |= _check("main voluntary", main_stat.voluntary, 1);
+    res |= _check("high prio switches", prio_high.schedules, MSG_NUMOF);
+    res |= _check("high prio voluntary", prio_high.voluntary, MSG_NUMOF);
+    res |= _check("main prio preempted", prio_main.preemptions, MSG_NUMOF);
+    res |= _check("main prio max queue", prio_main.max_depth, 2);
+    res |= _check("peer max latency us",
+                  xtimer_usec_from_ticks(
+                      (xtimer_ticks32_t){ peer_stat.max_latency_ticks }),
+                  SPIN_US);
+    res |= _check("main prio max latency us",
+                  xtimer_usec_from_ticks(
+                      (xtimer_ticks32_t){ prio_main.max_latency_ticks }),
+                  SPIN_US);
+    printf("longest time in scheduler: %" PRIu32 " us\n",
+           xtimer_usec_from_ticks(
+               (xtimer_ticks32_t){ schedstatistics_sched_run_max() }));
+
+    schedstatistics_reset_max();
+    schedstatistics_get_prio(THREAD_PRIORITY_MAIN, &prio_main);
+    if ((prio_main.max_latency_ticks != 0) || (prio_main.max_depth != 0)) {
+        puts("maximum values not reset");
+        res = 1;
+    }
+
+    ps();
+    puts(res ? "FAILURE" : "SUCCESS");
+
+    return 0;
+}
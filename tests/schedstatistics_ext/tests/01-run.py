@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect_exact("schedstatistics_ext test")
+    child.expect(r"\tLongest time in scheduler: \d+ us")
+    child.expect_exact("\tpri | runtime  | switches | preempted | voluntary "
+                       "| max latency | max queue")
+    child.expect(r"\t  6 \| +\d+\.\d+% \| +\d+ \| +\d+ \| +\d+ \| +\d+ us "
+                 r"\| +\d+")
+    child.expect_exact("SUCCESS")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   Test application for msg_send_int() being preempted by another
+ *          interrupt sending to the same thread
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include "periph/timer.h"
+#include "random.h"
+#include "thread.h"
+#include "msg.h"
+
+#define MSG_TYPE_THREAD     (0x2b10)
+#define MSG_TYPE_ISR        (0x2b11)
+#define MSG_TYPE_DONE       (0x2b12)
+
+#define TIMER_FREQ          (1000000LU)
+#define TIMER_TIMEOUT_MIN   (1U)
+#define TIMER_TIMEOUT_MAX   (100U)
+
+#ifndef TEST_SENDS
+#define TEST_SENDS          (10000U)
+#endif
+
+#define QUEUE_SIZE          (4U)
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _queue[QUEUE_SIZE];
+
+static kernel_pid_t _pid_main = KERNEL_PID_UNDEF;
+static volatile uint32_t _isr_seq = 0;
+static volatile unsigned _done = 0;
+
+/**
+ * @brief   Schedule next timer event in TIMER_TIMEOUT_MIN to TIMER_TIMEOUT_MAX
+ *          ticks.
+ */
+static void _sched_next(void)
+{
+    timer_set(TIMER_DEV(0), 0, random_uint32_range(TIMER_TIMEOUT_MIN,
+                                                   TIMER_TIMEOUT_MAX));
+}
+
+/**
+ * @brief   The timer interrupt, sending numbered messages
+ */
+static void _timer(void *arg, int channel)
+{
+    (void)arg;
+    (void)channel;
+
+    if (_done) {
+        return;
+    }
+    msg_t msg = { .type = MSG_TYPE_ISR, .content = { .value = _isr_seq } };
+
+    if (msg_send_int(&msg, _pid_main) == 1) {
+        _isr_seq++;
+    }
+    _sched_next();
+}
+
+/**
+ * @brief   The sending thread
+ *
+ * It calls msg_send_int() with interrupts enabled, so it stands in for an
+ * interrupt handler that the timer interrupt preempts.
+ */
+static void *_thread(void *arg)
+{
+    (void)arg;
+    msg_t msg = { .type = MSG_TYPE_THREAD };
+    uint32_t seq = 0;
+
+    while (seq < TEST_SENDS) {
+        msg.content.value = seq;
+        if (msg_send_int(&msg, _pid_main) == 1) {
+            seq++;
+        }
+        else {
+            /* queue is full, let the receiver empty it */
+            thread_yield_higher();
+        }
+    }
+    _done = 1;
+    msg.type = MSG_TYPE_DONE;
+    msg_send(&msg, _pid_main);
+
+    return NULL;
+}
+
+int main(void)
+{
+    uint32_t next[] = { 0, 0 };
+    kernel_pid_t pid;
+
+    timer_init(TIMER_DEV(0), TIMER_FREQ, _timer, NULL);
+    random_init(timer_read(TIMER_DEV(0)));
+    msg_init_queue(_queue, QUEUE_SIZE);
+    _pid_main = sched_active_pid;
+
+    puts("Each sender numbers its messages. A message lost or delivered twice\n"
+         "because both senders claimed the same queue slot, or handed over\n"
+         "to the receiver at the same time, breaks the sequence");
+    _sched_next();
+    pid = thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN + 1,
+                        THREAD_CREATE_WOUT_YIELD | THREAD_CREATE_STACKTEST,
+                        _thread, NULL, "sender");
+    assert(pid != KERNEL_PID_UNDEF);
+
+    while (1) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        if (msg.type == MSG_TYPE_DONE) {
+            break;
+        }
+        unsigned src = (msg.type == MSG_TYPE_ISR);
+
+        if (msg.content.value != next[src]) {
+            printf("%s message %" PRIu32 " received, expected %" PRIu32 "\n",
+                   src ? "ISR" : "thread", msg.content.value, next[src]);
+            return 1;
+        }
+        next[src]++;
+    }
+    if (next[1] != _isr_seq) {
+        printf("%" PRIu32 " of %" PRIu32 " ISR messages received\n",
+               next[1], _isr_seq);
+        return 1;
+    }
+    printf("{ \"thread\" : %" PRIu32 ", \"isr\" : %" PRIu32 " }\n",
+           next[0], next[1]);
+    puts("SUCCESS");
+    return 0;
+}
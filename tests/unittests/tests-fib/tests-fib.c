@@ -976,6 +976,63 @@ static void test_fib_20_replace_prefix(void)
     fib_deinit(&test_fib_table);
 }
 
+/*
+* @brief testing nested prefixes
+* It is expected to receive the next hop of the longest matching prefix,
+* and the one of the shorter prefix once the longer one is removed
+*/
+static void test_fib_21_longest_prefix_match(void)
+{
+    size_t add_buf_size = 16;
+    uint8_t addr_short[] = { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+                             0, 0, 0, 0, 0, 0, 0, 0 };
+    uint8_t addr_long[] = { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01, 0, 0,
+                            0, 0, 0, 0, 0, 0, 0, 0 };
+    uint8_t addr_lookup[] = { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01, 0, 0,
+                              0, 0, 0, 0, 0, 0, 0, 0x05 };
+    uint8_t nxt_short[16] = { 0xfe, 0x80, [15] = 0x01 };
+    uint8_t nxt_long[16] = { 0xfe, 0x80, [15] = 0x02 };
+    uint8_t addr_nxt[16];
+    kernel_pid_t iface_id = KERNEL_PID_UNDEF;
+    uint32_t next_hop_flags = 0;
+
+    TEST_ASSERT_EQUAL_INT(0, fib_add_entry(&test_fib_table, 42, addr_short,
+                          add_buf_size, ((32 << FIB_FLAG_NET_PREFIX_SHIFT) | 0x1),
+                          nxt_short, add_buf_size, 0x1, 100000));
+    TEST_ASSERT_EQUAL_INT(0, fib_add_entry(&test_fib_table, 42, addr_long,
+                          add_buf_size, ((48 << FIB_FLAG_NET_PREFIX_SHIFT) | 0x1),
+                          nxt_long, add_buf_size, 0x1, 100000));
+
+    TEST_ASSERT_EQUAL_INT(0, fib_get_next_hop(&test_fib_table, &iface_id,
+                          addr_nxt, &add_buf_size, &next_hop_flags,
+                          addr_lookup, sizeof(addr_lookup), 0x1));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(nxt_long, addr_nxt, sizeof(addr_nxt)));
+
+    /* only covered by the shorter prefix */
+    add_buf_size = 16;
+    addr_lookup[5] = 0x02;
+    TEST_ASSERT_EQUAL_INT(0, fib_get_next_hop(&test_fib_table, &iface_id,
+                          addr_nxt, &add_buf_size, &next_hop_flags,
+                          addr_lookup, sizeof(addr_lookup), 0x1));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(nxt_short, addr_nxt, sizeof(addr_nxt)));
+
+    add_buf_size = 16;
+    addr_lookup[5] = 0x01;
+    fib_remove_entry(&test_fib_table, addr_long, sizeof(addr_long));
+    TEST_ASSERT_EQUAL_INT(0, fib_get_next_hop(&test_fib_table, &iface_id,
+                          addr_nxt, &add_buf_size, &next_hop_flags,
+                          addr_lookup, sizeof(addr_lookup), 0x1));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(nxt_short, addr_nxt, sizeof(addr_nxt)));
+
+    add_buf_size = 16;
+    fib_remove_entry(&test_fib_table, addr_short, sizeof(addr_short));
+    TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH, fib_get_next_hop(&test_fib_table, &iface_id,
+                          addr_nxt, &add_buf_size, &next_hop_flags,
+                          addr_lookup, sizeof(addr_lookup), 0x1));
+
+    fib_deinit(&test_fib_table);
+}
+
 Test *tests_fib_tests(void)
 {
     fib_init(&test_fib_table);
@@ -1000,6 +1057,7 @@ Test *tests_fib_tests(void)
                         new_TestFixture(test_fib_18_get_next_hop_invalid_parameters),
                         new_TestFixture(test_fib_19_default_gateway),
                         new_TestFixture(test_fib_20_replace_prefix),
+                        new_TestFixture(test_fib_21_longest_prefix_match),
     };
 
     EMB_UNIT_TESTCALLER(fib_tests, NULL, NULL, fixtures);
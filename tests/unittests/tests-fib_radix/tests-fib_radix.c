@@ -0,0 +1,308 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "kernel_defines.h"
+#include "net/fib.h"
+#include "xtimer.h"
+
+#include "tests-fib_radix.h"
+
+#define ADDR_SIZE           (16U)
+#define TABLE_SIZE          (20U)
+#define LOOKUPS             (200U)
+
+static fib_entry_t _entries[TABLE_SIZE];
+static fib_table_t _table = { .data.entries = _entries,
+                              .table_type = FIB_TABLE_TYPE_SH,
+                              .size = TABLE_SIZE,
+                              .mtx_access = MUTEX_INIT,
+                              .notify_rp_pos = 0 };
+
+/* the entries the table is expected to hold */
+typedef struct {
+    uint8_t addr[ADDR_SIZE];
+    unsigned len;
+    bool used;
+} _ref_entry_t;
+
+static _ref_entry_t _ref[TABLE_SIZE];
+static uint32_t _rand_state;
+
+static uint32_t _rand(void)
+{
+    /* xorshift32, the same sequence on every run */
+    _rand_state ^= _rand_state << 13;
+    _rand_state ^= _rand_state >> 17;
+    _rand_state ^= _rand_state << 5;
+    return _rand_state;
+}
+
+static bool _prefix_equal(const uint8_t *a, const uint8_t *b, unsigned len)
+{
+    for (unsigned i = 0; i < len; i++) {
+        if (((a[i >> 3] ^ b[i >> 3]) >> (7 - (i & 0x7))) & 0x1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void _next_hop(uint8_t *next_hop, unsigned idx)
+{
+    memset(next_hop, 0, ADDR_SIZE);
+    next_hop[0] = 0xfe;
+    next_hop[1] = 0x80;
+    next_hop[15] = idx + 1;
+}
+
+static void _add(unsigned idx, const uint8_t *addr, unsigned len,
+                 uint32_t lifetime)
+{
+    uint8_t next_hop[ADDR_SIZE];
+
+    _next_hop(next_hop, idx);
+    memcpy(_ref[idx].addr, addr, ADDR_SIZE);
+    _ref[idx].len = len;
+    _ref[idx].used = true;
+    TEST_ASSERT_EQUAL_INT(0, fib_add_entry(&_table, 42, _ref[idx].addr,
+                          ADDR_SIZE, len << FIB_FLAG_NET_PREFIX_SHIFT,
+                          next_hop, ADDR_SIZE, 0, lifetime));
+}
+
+static void _remove(unsigned idx)
+{
+    fib_remove_entry(&_table, _ref[idx].addr, ADDR_SIZE);
+    _ref[idx].used = false;
+}
+
+/* adds a random prefix below 2001::/16 that is not in the table yet */
+static void _add_random(unsigned idx)
+{
+    uint8_t addr[ADDR_SIZE];
+    unsigned len;
+    bool unique;
+
+    do {
+        memset(addr, 0, sizeof(addr));
+        addr[0] = 0x20;
+        addr[1] = 0x01;
+        /* few random bits, so that many prefixes nest */
+        addr[2] = _rand() & 0xc3;
+        addr[3] = _rand() & 0x81;
+        len = 16 + (_rand() % 17);
+        for (unsigned i = len; i < 32; i++) {
+            addr[i >> 3] &= ~(0x80 >> (i & 0x7));
+        }
+        unique = true;
+        for (unsigned i = 0; i < TABLE_SIZE; i++) {
+            if (_ref[i].used && (memcmp(_ref[i].addr, addr, ADDR_SIZE) == 0)) {
+                unique = false;
+            }
+        }
+    } while (!unique);
+    _add(idx, addr, len, (uint32_t)FIB_LIFETIME_NO_EXPIRE);
+}
+
+/* returns the entry of the longest prefix matching dst, -1 if none */
+static int _ref_lookup(const uint8_t *dst)
+{
+    int match = -1;
+
+    for (unsigned i = 0; i < TABLE_SIZE; i++) {
+        if (_ref[i].used && _prefix_equal(_ref[i].addr, dst, _ref[i].len)
+                && ((match < 0) || (_ref[i].len > _ref[match].len))) {
+            match = i;
+        }
+    }
+    return match;
+}
+
+static void _check_lookup(uint8_t *dst)
+{
+    uint8_t next_hop[ADDR_SIZE];
+    uint8_t expected[ADDR_SIZE];
+    size_t next_hop_size = sizeof(next_hop);
+    kernel_pid_t iface_id = KERNEL_PID_UNDEF;
+    uint32_t next_hop_flags = 0;
+    int match = _ref_lookup(dst);
+    int res = fib_get_next_hop(&_table, &iface_id, next_hop, &next_hop_size,
+                               &next_hop_flags, dst, ADDR_SIZE, 0);
+
+    if (match < 0) {
+        TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH, res);
+    }
+    else {
+        TEST_ASSERT_EQUAL_INT(0, res);
+        _next_hop(expected, match);
+        TEST_ASSERT_EQUAL_INT(0, memcmp(expected, next_hop, ADDR_SIZE));
+    }
+}
+
+static void _check_random_lookups(void)
+{
+    uint8_t dst[ADDR_SIZE];
+
+    for (unsigned i = 0; i < LOOKUPS; i++) {
+        dst[0] = 0x20;
+        dst[1] = (i % 8) ? 0x01 : 0x02;
+        for (unsigned j = 2; j < ADDR_SIZE; j++) {
+            dst[j] = _rand();
+        }
+        _check_lookup(dst);
+    }
+}
+
+static void set_up(void)
+{
+    memset(_ref, 0, sizeof(_ref));
+    _rand_state = 0x20200101U;
+}
+
+static void tear_down(void)
+{
+    fib_deinit(&_table);
+}
+
+/*
+ * @brief nested prefixes, added from the shortest and from the longest
+ * It is expected to always receive the next hop of the longest match
+ */
+static void test_fib_radix_01_nested_prefixes(void)
+{
+    static const unsigned lens[] = { 0, 16, 32, 33, 48, 64, 127, 128 };
+    /* the last bit of each prefix is set, so that all of them differ */
+    uint8_t addr[ADDR_SIZE] = { 0x20, 0x01, 0x0d, 0xb9, 0xc0, 0x01, 0x00, 0x01,
+                                0, 0, 0, 0, 0, 0, 0, 0x03 };
+    uint8_t dst[ADDR_SIZE];
+
+    for (unsigned n = 0; n < 2; n++) {
+        for (unsigned i = 0; i < ARRAY_SIZE(lens); i++) {
+            unsigned idx = n ? (ARRAY_SIZE(lens) - 1 - i) : i;
+            uint8_t prefix[ADDR_SIZE] = { 0 };
+
+            /* the default route has the all-zero address */
+            for (unsigned j = 0; j < lens[idx]; j++) {
+                prefix[j >> 3] |= addr[j >> 3] & (0x80 >> (j & 0x7));
+            }
+            _add(idx, prefix, lens[idx], (uint32_t)FIB_LIFETIME_NO_EXPIRE);
+        }
+        /* flip the bit after each prefix in turn */
+        for (unsigned i = 0; i < ARRAY_SIZE(lens); i++) {
+            memcpy(dst, addr, sizeof(dst));
+            if (lens[i] < 128) {
+                dst[lens[i] >> 3] ^= 0x80 >> (lens[i] & 0x7);
+            }
+            _check_lookup(dst);
+        }
+        /* take the prefixes out from the longest */
+        for (unsigned i = ARRAY_SIZE(lens); i > 0; i--) {
+            _remove(i - 1);
+            _check_lookup(addr);
+        }
+        TEST_ASSERT_EQUAL_INT(0, fib_get_num_used_entries(&_table));
+    }
+}
+
+/*
+ * @brief random nested prefixes compared with a linear search, while
+ * entries are removed and the default route is added
+ */
+static void test_fib_radix_02_random_prefixes(void)
+{
+    uint8_t all_zero[ADDR_SIZE] = { 0 };
+
+    for (unsigned i = 0; i < TABLE_SIZE; i++) {
+        _add_random(i);
+    }
+    TEST_ASSERT_EQUAL_INT(TABLE_SIZE, fib_get_num_used_entries(&_table));
+    _check_random_lookups();
+
+    for (unsigned i = 0; i < TABLE_SIZE; i += 2) {
+        _remove(i);
+    }
+    _check_random_lookups();
+
+    _add(0, all_zero, 0, (uint32_t)FIB_LIFETIME_NO_EXPIRE);
+    _check_random_lookups();
+
+    /* replace the other half, so that freed nodes are reused */
+    for (unsigned i = 1; i < TABLE_SIZE; i += 2) {
+        _remove(i);
+        _add_random(i);
+    }
+    _check_random_lookups();
+}
+
+/*
+ * @brief flushing the table empties the tree, which is then refilled
+ */
+static void test_fib_radix_03_flush(void)
+{
+    for (unsigned n = 0; n < 3; n++) {
+        for (unsigned i = 0; i < TABLE_SIZE; i++) {
+            _add_random(i);
+        }
+        _check_random_lookups();
+        fib_flush(&_table, KERNEL_PID_UNDEF);
+        memset(_ref, 0, sizeof(_ref));
+        TEST_ASSERT_EQUAL_INT(0, fib_get_num_used_entries(&_table));
+        _check_random_lookups();
+    }
+}
+
+/*
+ * @brief an expired longer prefix is taken out on lookup
+ * It is expected to receive the next hop of the shorter prefix afterwards
+ */
+static void test_fib_radix_04_expired_prefix(void)
+{
+    uint8_t addr_short[ADDR_SIZE] = { 0x20, 0x01, 0x0d, 0xb8 };
+    uint8_t addr_long[ADDR_SIZE] = { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01 };
+    uint8_t dst[ADDR_SIZE] = { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01,
+                               [15] = 0x05 };
+
+    _add(0, addr_short, 32, (uint32_t)FIB_LIFETIME_NO_EXPIRE);
+    _add(1, addr_long, 48, 1);
+    _check_lookup(dst);
+
+    xtimer_usleep(2 * US_PER_MS);
+    _ref[1].used = false;
+    _check_lookup(dst);
+    TEST_ASSERT_EQUAL_INT(1, fib_get_num_used_entries(&_table));
+}
+
+Test *tests_fib_radix_tests(void)
+{
+    fib_init(&_table);
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_fib_radix_01_nested_prefixes),
+        new_TestFixture(test_fib_radix_02_random_prefixes),
+        new_TestFixture(test_fib_radix_03_flush),
+        new_TestFixture(test_fib_radix_04_expired_prefix),
+    };
+
+    EMB_UNIT_TESTCALLER(fib_radix_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&fib_radix_tests;
+}
+
+void tests_fib_radix(void)
+{
+    TESTS_RUN(tests_fib_radix_tests());
+}
+/** @} */
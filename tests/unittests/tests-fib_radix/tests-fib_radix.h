@@ -0,0 +1,41 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the ``fib`` module with the ``fib_radix`` index
+ */
+#ifndef TESTS_FIB_RADIX_H
+#define TESTS_FIB_RADIX_H
+#include "embUnit/embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+*  @brief   The entry point of this test suite.
+*/
+void tests_fib_radix(void);
+
+/**
+ * @brief   Generates tests for the FIB radix tree
+ *
+ * @return  embUnit tests if successful, NULL if not.
+ */
+Test *tests_fib_radix_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_FIB_RADIX_H */
+/** @} */
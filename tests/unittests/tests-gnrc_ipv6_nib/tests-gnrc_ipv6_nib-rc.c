@@ -0,0 +1,257 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <string.h>
+
+#include "net/ipv6/addr.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/ipv6/nib/ft.h"
+#include "net/gnrc/ipv6/nib/nc.h"
+#include "net/gnrc/ipv6/nib/pl.h"
+#include "net/gnrc/ipv6/nib/rc.h"
+
+#include "_nib-internal.h"
+
+#include "unittests-constants.h"
+
+#include "tests-gnrc_ipv6_nib.h"
+
+#define LINK_LOCAL_PREFIX   { 0xfe, 0x80, 0, 0, 0, 0, 0, 0 }
+#define GLOBAL_PREFIX       { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0 }
+#define GLOBAL_PREFIX_LEN   (64)
+#define L2ADDR              { 0x90, 0xd5, 0x8e, 0x8c, 0x92, 0x43, 0x73, 0x5c }
+#define IFACE               (6)
+
+static const uint8_t _l2addr[] = L2ADDR;
+
+static void set_up(void)
+{
+    evtimer_event_t *tmp;
+
+    for (evtimer_event_t *ptr = _nib_evtimer.events;
+         (ptr != NULL) && (tmp = (ptr->next), 1);
+         ptr = tmp) {
+        evtimer_del((evtimer_t *)(&_nib_evtimer), ptr);
+    }
+    _nib_init();
+}
+
+/* fe80::<TEST_UINT64 with the last byte replaced by id> */
+static void _nbr_addr(ipv6_addr_t *addr, uint8_t id)
+{
+    const ipv6_addr_t nbr = { .u64 = { { .u8 = LINK_LOCAL_PREFIX },
+                                       { .u64 = TEST_UINT64 } } };
+
+    memcpy(addr, &nbr, sizeof(*addr));
+    addr->u8[15] = id;
+}
+
+/* 2001:db8::<id>, within the global prefix */
+static void _gb_addr(ipv6_addr_t *addr, uint8_t id)
+{
+    const ipv6_addr_t gb = { .u64 = { { .u8 = GLOBAL_PREFIX } } };
+
+    memcpy(addr, &gb, sizeof(*addr));
+    addr->u8[15] = id;
+}
+
+/* caches next_hop as next hop to dst, the way
+ * gnrc_ipv6_nib_get_next_hop_l2addr() does after resolving it */
+static void _cache(const ipv6_addr_t *dst, const ipv6_addr_t *next_hop,
+                   const gnrc_ipv6_nib_ft_t *route)
+{
+    gnrc_ipv6_nib_nc_t nce;
+    _nib_onl_entry_t *node = _nib_onl_get(next_hop, IFACE);
+
+    TEST_ASSERT_NOT_NULL(node);
+    _nib_nc_get(node, &nce);
+    _nib_rc_add(dst, 0, &nce, node, route);
+}
+
+static bool _cached(const ipv6_addr_t *dst)
+{
+    gnrc_ipv6_nib_nc_t nce;
+
+    return _nib_rc_get(dst, 0, &nce);
+}
+
+/*
+ * Caches a neighbor, then looks it up with and without the interface the
+ * look-up was restricted to.
+ * Expected result: only the look-up for the same interface is a hit and
+ * returns the neighbor cache entry of the neighbor
+ */
+static void test_nib_rc_get__success(void)
+{
+    gnrc_ipv6_nib_rc_stats_t before, after;
+    gnrc_ipv6_nib_nc_t nce;
+    ipv6_addr_t nbr;
+
+    _nbr_addr(&nbr, 1);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_nc_set(&nbr, IFACE, _l2addr,
+                                                  sizeof(_l2addr)));
+    _cache(&nbr, &nbr, NULL);
+    gnrc_ipv6_nib_rc_get_stats(&before);
+    TEST_ASSERT(!_nib_rc_get(&nbr, IFACE, &nce));
+    TEST_ASSERT(_nib_rc_get(&nbr, 0, &nce));
+    gnrc_ipv6_nib_rc_get_stats(&after);
+    TEST_ASSERT(ipv6_addr_equal(&nbr, &nce.ipv6));
+    TEST_ASSERT_EQUAL_INT(IFACE, gnrc_ipv6_nib_nc_get_iface(&nce));
+    TEST_ASSERT_EQUAL_INT(sizeof(_l2addr), nce.l2addr_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_l2addr, nce.l2addr, sizeof(_l2addr)));
+    TEST_ASSERT_EQUAL_INT(before.hits + 1, after.hits);
+    TEST_ASSERT_EQUAL_INT(before.misses + 1, after.misses);
+}
+
+/*
+ * Caches a neighbor whose address resolution is still incomplete.
+ * Expected result: the neighbor is not cached
+ */
+static void test_nib_rc_add__incomplete(void)
+{
+    ipv6_addr_t nbr;
+
+    _nbr_addr(&nbr, 1);
+    TEST_ASSERT_NOT_NULL(_nib_nc_add(&nbr, IFACE,
+                                     GNRC_IPV6_NIB_NC_INFO_NUD_STATE_INCOMPLETE));
+    _cache(&nbr, &nbr, NULL);
+    TEST_ASSERT(!_cached(&nbr));
+}
+
+/*
+ * Caches two neighbors and a destination routed via the first, then changes
+ * the link-layer address of the first and removes the second.
+ * Expected result: each change only removes the entries to or via the
+ * neighbor that changed, the cache is not flushed
+ */
+static void test_nib_rc_del__nc_change(void)
+{
+    static const uint8_t l2addr2[] = { 0x02, 0x00, 0x5e, 0x10, 0x00, 0x01 };
+    gnrc_ipv6_nib_rc_stats_t before, after;
+    gnrc_ipv6_nib_ft_t route;
+    ipv6_addr_t nbr1, nbr2, dst;
+
+    _nbr_addr(&nbr1, 1);
+    _nbr_addr(&nbr2, 2);
+    _gb_addr(&dst, 1);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_nc_set(&nbr1, IFACE, _l2addr,
+                                                  sizeof(_l2addr)));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_nc_set(&nbr2, IFACE, _l2addr,
+                                                  sizeof(_l2addr)));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&dst, GLOBAL_PREFIX_LEN,
+                                                  &nbr1, IFACE, 0));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_get(&dst, NULL, &route));
+    _cache(&nbr1, &nbr1, NULL);
+    _cache(&nbr2, &nbr2, NULL);
+    _cache(&dst, &nbr1, &route);
+    TEST_ASSERT(_cached(&nbr1));
+    TEST_ASSERT(_cached(&nbr2));
+    TEST_ASSERT(_cached(&dst));
+
+    gnrc_ipv6_nib_rc_get_stats(&before);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_nc_set(&nbr1, IFACE, l2addr2,
+                                                  sizeof(l2addr2)));
+    TEST_ASSERT(!_cached(&nbr1));
+    TEST_ASSERT(!_cached(&dst));
+    TEST_ASSERT(_cached(&nbr2));
+    gnrc_ipv6_nib_nc_del(&nbr2, IFACE);
+    TEST_ASSERT(!_cached(&nbr2));
+    gnrc_ipv6_nib_rc_get_stats(&after);
+    TEST_ASSERT_EQUAL_INT(before.flushes, after.flushes);
+}
+
+/*
+ * Caches a destination routed via a neighbor, then adds the same route again,
+ * adds another route and removes that route again.
+ * Expected result: adding the same route keeps the cache, adding and
+ * removing another route flush it once each
+ */
+static void test_nib_rc_flush__ft_change(void)
+{
+    gnrc_ipv6_nib_rc_stats_t before, after;
+    gnrc_ipv6_nib_ft_t route;
+    ipv6_addr_t nbr, dst, other = { .u64 = { { .u8 = GLOBAL_PREFIX } } };
+
+    _nbr_addr(&nbr, 1);
+    _gb_addr(&dst, 1);
+    other.u8[7] = 1;
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_nc_set(&nbr, IFACE, _l2addr,
+                                                  sizeof(_l2addr)));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&dst, GLOBAL_PREFIX_LEN,
+                                                  &nbr, IFACE, 0));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_get(&dst, NULL, &route));
+    _cache(&dst, &nbr, &route);
+
+    gnrc_ipv6_nib_rc_get_stats(&before);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&dst, GLOBAL_PREFIX_LEN,
+                                                  &nbr, IFACE, 0));
+    TEST_ASSERT(_cached(&dst));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&other, GLOBAL_PREFIX_LEN,
+                                                  &nbr, IFACE, 0));
+    TEST_ASSERT(!_cached(&dst));
+    _cache(&dst, &nbr, &route);
+    gnrc_ipv6_nib_ft_del(&other, GLOBAL_PREFIX_LEN);
+    TEST_ASSERT(!_cached(&dst));
+    gnrc_ipv6_nib_rc_get_stats(&after);
+    TEST_ASSERT_EQUAL_INT(before.flushes + 2, after.flushes);
+}
+
+/*
+ * Caches a neighbor, then adds a prefix, adds the same prefix again and
+ * removes the prefix.
+ * Expected result: adding the same prefix keeps the cache, adding and
+ * removing the prefix flush it once each
+ */
+static void test_nib_rc_flush__pl_change(void)
+{
+    gnrc_ipv6_nib_rc_stats_t before, after;
+    ipv6_addr_t nbr, pfx;
+
+    _nbr_addr(&nbr, 1);
+    _gb_addr(&pfx, 0);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_nc_set(&nbr, IFACE, _l2addr,
+                                                  sizeof(_l2addr)));
+    _cache(&nbr, &nbr, NULL);
+
+    gnrc_ipv6_nib_rc_get_stats(&before);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_pl_set(IFACE, &pfx,
+                                                  GLOBAL_PREFIX_LEN,
+                                                  UINT32_MAX, UINT32_MAX));
+    TEST_ASSERT(!_cached(&nbr));
+    _cache(&nbr, &nbr, NULL);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_pl_set(IFACE, &pfx,
+                                                  GLOBAL_PREFIX_LEN,
+                                                  UINT32_MAX, UINT32_MAX));
+    TEST_ASSERT(_cached(&nbr));
+    gnrc_ipv6_nib_pl_del(IFACE, &pfx, GLOBAL_PREFIX_LEN);
+    TEST_ASSERT(!_cached(&nbr));
+    gnrc_ipv6_nib_rc_get_stats(&after);
+    TEST_ASSERT_EQUAL_INT(before.flushes + 2, after.flushes);
+}
+
+Test *tests_gnrc_ipv6_nib_rc_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_nib_rc_get__success),
+        new_TestFixture(test_nib_rc_add__incomplete),
+        new_TestFixture(test_nib_rc_del__nc_change),
+        new_TestFixture(test_nib_rc_flush__ft_change),
+        new_TestFixture(test_nib_rc_flush__pl_change),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, set_up, NULL,
+                        fixtures);
+
+    return (Test *)&tests;
+}
@@ -36,13 +36,11 @@
  * reference for forwarding) so an uninitialized one is enough */
 static gnrc_netif_t _dummy_netif;
 
-static const gnrc_sixlowpan_frag_rb_int_t _interval = {
-    .next = NULL,
-    .start = 0,
-    .end = 116U,
-};
+/* 8-octet units 0 to 14 received, i.e. bytes 0 to 116 */
+#define TEST_RECEIVED_UNITS (15U)
+
 static const gnrc_sixlowpan_frag_rb_base_t _base = {
-    .ints = (gnrc_sixlowpan_frag_rb_int_t *)&_interval,
+    .received = { 0xff, 0xfe },
     .src = TEST_SRC,
     .dst = TEST_DST,
     .src_len = TEST_SRC_LEN,
@@ -68,13 +66,13 @@ static void test_vrb_add__success(void)
                                                             &_dummy_netif,
                                                             _out_dst,
                                                             sizeof(_out_dst))));
-    TEST_ASSERT_NOT_NULL(res->super.ints);
-    TEST_ASSERT_NULL(res->super.ints->next);
     /* make sure _base and res->super are distinct*/
     TEST_ASSERT((&_base) != (&res->super));
     /* but that the values are the same */
-    TEST_ASSERT_EQUAL_INT(_interval.start, res->super.ints->start);
-    TEST_ASSERT_EQUAL_INT(_interval.end, res->super.ints->end);
+    for (unsigned i = 0; i < GNRC_SIXLOWPAN_FRAG_RB_UNITS; i++) {
+        TEST_ASSERT_EQUAL_INT(i < TEST_RECEIVED_UNITS,
+                              bf_isset(res->super.received, i));
+    }
     TEST_ASSERT_EQUAL_INT(_base.src_len, res->super.src_len);
     TEST_ASSERT_MESSAGE(memcmp(_base.src, res->super.src, TEST_SRC_LEN) == 0,
                         "TEST_SRC != res->super.src");
@@ -13,6 +13,7 @@
  */
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "embUnit.h"
 
@@ -165,6 +166,86 @@ static void test_inet_csum__empty_app_buffer(void)
     TEST_ASSERT_EQUAL_INT(hdr_expected, pyld_sum);
 }
 
+static void test_inet_csum__unaligned(void)
+{
+    /* source: https://www.cloudshark.org/captures/ea72fbab241b (No. 1) */
+    static const uint8_t data[] = {
+        0xc0, 0xa8, 0x01, 0x91, 0x4b, 0x4b, 0x4b, 0x4b, /* IPv4 source + dest*/
+        0xf6, 0xfb, 0x00, 0x35, 0x00, 0x27, 0xd1, 0xa2, /* UDP header */
+        0xa5, 0x6f, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, /* DNS payload */
+        0x00, 0x00, 0x00, 0x00, 0x09, 0x74, 0x65, 0x73,
+        0x74, 0x2d, 0x69, 0x70, 0x76, 0x36, 0x03, 0x63,
+        0x6f, 0x6d, 0x00, 0x00, 0x01, 0x00, 0x01,
+    };
+    uint32_t buf[(sizeof(data) / sizeof(uint32_t)) + 2];
+
+    /* result must not depend on the alignment of the buffer */
+    for (unsigned offset = 0; offset < sizeof(uint32_t); offset++) {
+        uint8_t *start = ((uint8_t *)buf) + offset;
+
+        memcpy(start, data, sizeof(data));
+        TEST_ASSERT_EQUAL_INT(0xffff, inet_csum(17 + 39, start, sizeof(data)));
+    }
+}
+
+static void test_inet_csum__all_slices(void)
+{
+    /* source: https://www.cloudshark.org/captures/ea72fbab241b (No. 1) */
+    static const uint8_t data[] = {
+        0xc0, 0xa8, 0x01, 0x91, 0x4b, 0x4b, 0x4b, 0x4b, /* IPv4 source + dest*/
+        0xf6, 0xfb, 0x00, 0x35, 0x00, 0x27, 0xd1, 0xa2, /* UDP header */
+        0xa5, 0x6f, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, /* DNS payload */
+        0x00, 0x00, 0x00, 0x00, 0x09, 0x74, 0x65, 0x73,
+        0x74, 0x2d, 0x69, 0x70, 0x76, 0x36, 0x03, 0x63,
+        0x6f, 0x6d, 0x00, 0x00, 0x01, 0x00, 0x01,
+    };
+
+    /* result must not depend on where the checksum domain is split */
+    for (unsigned split = 0; split <= sizeof(data); split++) {
+        uint16_t sum = inet_csum_slice(17 + 39, data, split, 0);
+
+        sum = inet_csum_slice(sum, &data[split], sizeof(data) - split, split);
+        TEST_ASSERT_EQUAL_INT(0xffff, sum);
+    }
+}
+
+/* byte-by-byte reference implementation */
+static uint16_t _csum_bytewise(uint16_t sum, const uint8_t *buf, uint16_t len,
+                               size_t accum_len)
+{
+    uint32_t csum = sum;
+
+    for (unsigned i = 0; i < len; i++) {
+        csum += ((accum_len + i) & 1) ? buf[i] : (buf[i] << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+static void test_inet_csum__large_buffer(void)
+{
+    static uint8_t data[1280 + 3];
+
+    for (unsigned i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)((i * 7) ^ (i >> 3));
+    }
+    for (unsigned offset = 0; offset < 4; offset++) {
+        uint16_t len = sizeof(data) - offset;
+
+        for (size_t accum_len = 0; accum_len < 2; accum_len++) {
+            TEST_ASSERT_EQUAL_INT(_csum_bytewise(0x1234, &data[offset], len,
+                                                 accum_len),
+                                  inet_csum_slice(0x1234, &data[offset], len,
+                                                  accum_len));
+        }
+    }
+    /* all ones must not wrap to 0 */
+    memset(data, 0xff, sizeof(data));
+    TEST_ASSERT_EQUAL_INT(0xffff, inet_csum(0, data, 1280));
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -176,6 +257,9 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__odd_len),
         new_TestFixture(test_inet_csum__two_app_snips),
         new_TestFixture(test_inet_csum__empty_app_buffer),
+        new_TestFixture(test_inet_csum__unaligned),
+        new_TestFixture(test_inet_csum__all_slices),
+        new_TestFixture(test_inet_csum__large_buffer),
     };
 
     EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
@@ -102,12 +102,46 @@ static int power(mtd_dev_t *dev, enum mtd_power_state power)
     return 0;
 }
 
+/* polls until the mock device is idle again after a started erase */
+static unsigned busy_polls;
+
+static int erase_start(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    int ret;
+
+    if (size > (PAGE_PER_SECTOR * PAGE_SIZE)) {
+        /* one sector per step */
+        if ((ret = erase(dev, addr, PAGE_PER_SECTOR * PAGE_SIZE)) < 0) {
+            return ret;
+        }
+    }
+    else if ((ret = erase(dev, addr, size)) < 0) {
+        return ret;
+    }
+    busy_polls = 2;
+
+    return PAGE_PER_SECTOR * PAGE_SIZE;
+}
+
+static int busy(mtd_dev_t *dev)
+{
+    (void)dev;
+
+    if (busy_polls) {
+        busy_polls--;
+        return 1;
+    }
+    return 0;
+}
+
 static const mtd_desc_t driver = {
     .init = init,
     .read = read,
     .write = write,
     .erase = erase,
     .power = power,
+    .erase_start = erase_start,
+    .busy = busy,
 };
 
 static mtd_dev_t _dev = {
@@ -226,6 +260,82 @@ static void test_mtd_write_read(void)
     TEST_ASSERT_EQUAL_INT(-EOVERFLOW, ret);
 }
 
+static unsigned async_calls;
+static int async_res;
+
+static void async_cb(void *arg, int res)
+{
+    (void)arg;
+    async_calls++;
+    async_res = res;
+}
+
+static void test_mtd_erase_async(void)
+{
+    const char buf[] = "ABCDEFGH";
+    uint8_t buf_read[sizeof(buf)];
+    uint8_t expected[sizeof(buf)];
+    const uint32_t sector_size = dev->pages_per_sector * dev->page_size;
+    mtd_async_t op;
+
+    int ret = mtd_write(dev, buf, sector_size, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), ret);
+
+    /* Erase 1st - 2nd sector */
+    async_calls = 0;
+    ret = mtd_erase_async(dev, &op, 0, sector_size * 2, async_cb, NULL);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+#ifndef MTD_0
+    /* the mock device is busy after every step */
+    TEST_ASSERT_EQUAL_INT(-EINPROGRESS, mtd_async_poll(&op));
+    TEST_ASSERT_EQUAL_INT(0, async_calls);
+#endif
+    ret = mtd_async_wait(&op);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(1, async_calls);
+    TEST_ASSERT_EQUAL_INT(0, async_res);
+
+    /* Polling a completed operation does not call the callback again */
+    ret = mtd_async_poll(&op);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    TEST_ASSERT_EQUAL_INT(1, async_calls);
+
+    memset(expected, 0xff, sizeof(expected));
+    ret = mtd_read(dev, buf_read, sector_size, sizeof(buf_read));
+    TEST_ASSERT_EQUAL_INT(sizeof(buf_read), ret);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(expected, buf_read, sizeof(buf_read)));
+
+    /* Unaligned erase fails on start, without callback */
+    ret = mtd_erase_async(dev, &op, dev->page_size, sector_size, async_cb, NULL);
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, ret);
+    TEST_ASSERT_EQUAL_INT(1, async_calls);
+}
+
+static void test_mtd_write_async(void)
+{
+    const char buf[] = "ABCDEFGH";
+    char buf_read[sizeof(buf)];
+    mtd_async_t op;
+
+    async_calls = 0;
+    int ret = mtd_write_async(dev, &op, buf, 0, sizeof(buf), async_cb, NULL);
+    TEST_ASSERT_EQUAL_INT(0, ret);
+    ret = mtd_async_wait(&op);
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), ret);
+    TEST_ASSERT_EQUAL_INT(1, async_calls);
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), async_res);
+
+    ret = mtd_read(dev, buf_read, 0, sizeof(buf_read));
+    TEST_ASSERT_EQUAL_INT(sizeof(buf_read), ret);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, buf_read, sizeof(buf)));
+
+    /* pages overlap write */
+    ret = mtd_write_async(dev, &op, buf, dev->page_size - (sizeof(buf) / 2),
+                          sizeof(buf), async_cb, NULL);
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, ret);
+    TEST_ASSERT_EQUAL_INT(1, async_calls);
+}
+
 #ifdef MTD_0
 static void test_mtd_write_read_flash(void)
 {
@@ -287,6 +397,8 @@ Test *tests_mtd_tests(void)
         new_TestFixture(test_mtd_erase),
         new_TestFixture(test_mtd_write_erase),
         new_TestFixture(test_mtd_write_read),
+        new_TestFixture(test_mtd_erase_async),
+        new_TestFixture(test_mtd_write_async),
 #ifdef MTD_0
         new_TestFixture(test_mtd_write_read_flash),
 #endif
@@ -0,0 +1,346 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <string.h>
+#include <errno.h>
+
+#include "embUnit.h"
+
+#include "mtd.h"
+#include "mtd_cache.h"
+
+#include "tests-mtd_cache.h"
+
+#define SECTOR_COUNT    (4U)
+#define PAGE_PER_SECTOR (4U)
+#define PAGE_SIZE       (64U)
+#define SECTOR_SIZE     (PAGE_PER_SECTOR * PAGE_SIZE)
+#define SLOTS           (4U)
+
+/* RAM-based flash mock that counts the accesses of the cache */
+static uint8_t _memory[SECTOR_COUNT * SECTOR_SIZE];
+static unsigned _reads, _writes;
+static uint32_t _write_addr, _write_size;
+
+static int _mock_init(mtd_dev_t *dev)
+{
+    (void)dev;
+
+    memset(_memory, 0xff, sizeof(_memory));
+    return 0;
+}
+
+static int _mock_read(mtd_dev_t *dev, void *buff, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    if (addr + size > sizeof(_memory)) {
+        return -EOVERFLOW;
+    }
+    _reads++;
+    memcpy(buff, _memory + addr, size);
+    return size;
+}
+
+static int _mock_write(mtd_dev_t *dev, const void *buff, uint32_t addr,
+                       uint32_t size)
+{
+    (void)dev;
+
+    if (((addr % PAGE_SIZE) + size) > PAGE_SIZE) {
+        return -EOVERFLOW;
+    }
+    _writes++;
+    _write_addr = addr;
+    _write_size = size;
+    for (uint32_t i = 0; i < size; i++) {
+        _memory[addr + i] &= ((const uint8_t *)buff)[i];
+    }
+    return size;
+}
+
+static int _mock_erase(mtd_dev_t *dev, uint32_t addr, uint32_t size)
+{
+    (void)dev;
+
+    memset(_memory + addr, 0xff, size);
+    return 0;
+}
+
+static const mtd_desc_t _mock_driver = {
+    .init = _mock_init,
+    .read = _mock_read,
+    .write = _mock_write,
+    .erase = _mock_erase,
+};
+
+static mtd_dev_t _mock = {
+    .driver = &_mock_driver,
+    .sector_count = SECTOR_COUNT,
+    .pages_per_sector = PAGE_PER_SECTOR,
+    .page_size = PAGE_SIZE,
+};
+
+static uint8_t _buf[SLOTS * PAGE_SIZE];
+static mtd_cache_slot_t _slots[SLOTS];
+static uint32_t _erase_counts[SECTOR_COUNT];
+
+static mtd_cache_t _cache = {
+    .base.driver = &mtd_cache_driver,
+    .mtd = &_mock,
+    .buf = _buf,
+    .slots = _slots,
+    .slots_numof = SLOTS,
+    .erase_counts = _erase_counts,
+};
+
+static mtd_dev_t *dev = &_cache.base;
+
+static void set_up(void)
+{
+    memset(_erase_counts, 0, sizeof(_erase_counts));
+    _cache.write_size = 0;
+    mtd_init(dev);
+    _reads = 0;
+    _writes = 0;
+}
+
+static void test_mtd_cache_init(void)
+{
+    TEST_ASSERT_EQUAL_INT(SECTOR_COUNT, dev->sector_count);
+    TEST_ASSERT_EQUAL_INT(PAGE_PER_SECTOR, dev->pages_per_sector);
+    TEST_ASSERT_EQUAL_INT(PAGE_SIZE, dev->page_size);
+}
+
+static void test_mtd_cache_write_coalesce(void)
+{
+    uint8_t buf[PAGE_SIZE / 4];
+    uint8_t buf_read[PAGE_SIZE];
+
+    /* a page written in small chunks is written back at once */
+    for (unsigned i = 0; i < 4; i++) {
+        memset(buf, i, sizeof(buf));
+        TEST_ASSERT_EQUAL_INT(sizeof(buf),
+                              mtd_write(dev, buf, PAGE_SIZE + (i * sizeof(buf)),
+                                        sizeof(buf)));
+    }
+    TEST_ASSERT_EQUAL_INT(0, _writes);
+    TEST_ASSERT_EQUAL_INT(0, _reads);
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+    TEST_ASSERT_EQUAL_INT(1, _writes);
+    TEST_ASSERT_EQUAL_INT(1, _cache.stats.writes);
+    for (unsigned i = 0; i < PAGE_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(i / sizeof(buf), _memory[PAGE_SIZE + i]);
+    }
+
+    /* the previous content of the page was never read */
+    TEST_ASSERT_EQUAL_INT(sizeof(buf_read),
+                          mtd_read(dev, buf_read, PAGE_SIZE, sizeof(buf_read)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf_read, &_memory[PAGE_SIZE], PAGE_SIZE));
+    TEST_ASSERT_EQUAL_INT(1, _reads);
+    TEST_ASSERT_EQUAL_INT(1, _writes);
+}
+
+static void test_mtd_cache_write_partial(void)
+{
+    const char buf[] = "ABCDEFGH";
+    uint8_t buf_read[PAGE_SIZE];
+
+    /* only the modified runs are written back, each on its own */
+    _memory[0] = 0x42;
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), mtd_write(dev, buf, 8, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), mtd_write(dev, buf, 24, sizeof(buf)));
+
+    /* reading the page writes it back first as its content is not known */
+    TEST_ASSERT_EQUAL_INT(sizeof(buf_read),
+                          mtd_read(dev, buf_read, 0, sizeof(buf_read)));
+    TEST_ASSERT_EQUAL_INT(2, _writes);
+    TEST_ASSERT_EQUAL_INT(1, _reads);
+    TEST_ASSERT_EQUAL_INT(0x42, buf_read[0]);
+    TEST_ASSERT_EQUAL_INT(0xff, buf_read[7]);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, &buf_read[8], sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0xff, buf_read[8 + sizeof(buf)]);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, &buf_read[24], sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_memory, buf_read, sizeof(buf_read)));
+}
+
+static void test_mtd_cache_write_runs(void)
+{
+    const uint8_t buf[] = {0x11, 0x22, 0x33};
+
+    /* runs are widened to the write granularity */
+    _cache.write_size = 4;
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), mtd_write(dev, buf, 5, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+    TEST_ASSERT_EQUAL_INT(1, _writes);
+    TEST_ASSERT_EQUAL_INT(4, _write_addr);
+    TEST_ASSERT_EQUAL_INT(4, _write_size);
+    TEST_ASSERT_EQUAL_INT(0x33, _memory[7]);
+    TEST_ASSERT_EQUAL_INT(0xff, _memory[8]);
+
+    /* touching runs are merged, separate ones take a run each */
+    for (unsigned i = 0; i < MTD_CACHE_DIRTY_RUNS; i++) {
+        TEST_ASSERT_EQUAL_INT(sizeof(buf),
+                              mtd_write(dev, buf, PAGE_SIZE + (i * 12),
+                                        sizeof(buf)));
+        TEST_ASSERT_EQUAL_INT(sizeof(buf),
+                              mtd_write(dev, buf, PAGE_SIZE + (i * 12) + 4,
+                                        sizeof(buf)));
+    }
+    TEST_ASSERT_EQUAL_INT(1, _writes);
+    TEST_ASSERT_EQUAL_INT(MTD_CACHE_DIRTY_RUNS, _slots[1].dirty_runs);
+
+    /* a write that needs another run writes the page back first */
+    TEST_ASSERT_EQUAL_INT(sizeof(buf),
+                          mtd_write(dev, buf, (2 * PAGE_SIZE) - 4, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(1 + MTD_CACHE_DIRTY_RUNS, _writes);
+    TEST_ASSERT_EQUAL_INT(PAGE_SIZE, _write_addr);
+    TEST_ASSERT_EQUAL_INT(8, _write_size);
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+    TEST_ASSERT_EQUAL_INT(2 + MTD_CACHE_DIRTY_RUNS, _writes);
+    TEST_ASSERT_EQUAL_INT((2 * PAGE_SIZE) - 4, _write_addr);
+    TEST_ASSERT_EQUAL_INT(4, _write_size);
+    TEST_ASSERT_EQUAL_INT(0x22, _memory[PAGE_SIZE + 5]);
+    TEST_ASSERT_EQUAL_INT(0xff, _memory[PAGE_SIZE + 8]);
+}
+
+static void test_mtd_cache_write_flash(void)
+{
+    const uint8_t buf1[] = {0xee, 0xdd, 0xcc};
+    const uint8_t buf2[] = {0x33, 0x33, 0x33};
+    const uint8_t buf_expected[] = {0x22, 0x11, 0x0};
+    uint8_t buf_read[sizeof(buf_expected)];
+
+    /* writing clears bits as on flash */
+    TEST_ASSERT_EQUAL_INT(sizeof(buf1), mtd_write(dev, buf1, 0, sizeof(buf1)));
+    TEST_ASSERT_EQUAL_INT(sizeof(buf2), mtd_write(dev, buf2, 0, sizeof(buf2)));
+    TEST_ASSERT_EQUAL_INT(sizeof(buf_read),
+                          mtd_read(dev, buf_read, 0, sizeof(buf_read)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf_expected, buf_read, sizeof(buf_read)));
+}
+
+static void test_mtd_cache_write_overflow(void)
+{
+    uint8_t buf[8] = { 0 };
+
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_write(dev, buf, PAGE_SIZE - 4, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_write(dev, buf, sizeof(_memory), sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_read(dev, buf, sizeof(_memory) - 4, sizeof(buf)));
+}
+
+static void test_mtd_cache_readahead(void)
+{
+    uint8_t buf_read[16];
+
+    for (unsigned i = 0; i < sizeof(_memory); i++) {
+        _memory[i] = i;
+    }
+    /* small sequential reads load the following pages, too */
+    for (unsigned addr = 0; addr < (SLOTS * PAGE_SIZE); addr += sizeof(buf_read)) {
+        TEST_ASSERT_EQUAL_INT(sizeof(buf_read),
+                              mtd_read(dev, buf_read, addr, sizeof(buf_read)));
+        TEST_ASSERT_EQUAL_INT(0, memcmp(&_memory[addr], buf_read, sizeof(buf_read)));
+    }
+    TEST_ASSERT_EQUAL_INT(((SLOTS - 1) / MTD_CACHE_READAHEAD) + 1, _reads);
+}
+
+static void test_mtd_cache_read_pages(void)
+{
+    uint8_t buf_read[3 * PAGE_SIZE];
+
+    for (unsigned i = 0; i < sizeof(_memory); i++) {
+        _memory[i] = i;
+    }
+    /* whole pages go straight to the device */
+    TEST_ASSERT_EQUAL_INT(sizeof(buf_read),
+                          mtd_read(dev, buf_read, PAGE_SIZE, sizeof(buf_read)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&_memory[PAGE_SIZE], buf_read, sizeof(buf_read)));
+    TEST_ASSERT_EQUAL_INT(1, _reads);
+}
+
+static void test_mtd_cache_evict(void)
+{
+    uint8_t buf[PAGE_SIZE];
+    uint8_t buf_read[PAGE_SIZE];
+
+    /* more pages than the cache holds */
+    for (unsigned page = 0; page < (2 * SLOTS); page++) {
+        memset(buf, page, sizeof(buf));
+        TEST_ASSERT_EQUAL_INT(sizeof(buf),
+                              mtd_write(dev, buf, page * PAGE_SIZE, sizeof(buf)));
+    }
+    TEST_ASSERT_EQUAL_INT(SLOTS, _writes);
+    for (unsigned page = 0; page < (2 * SLOTS); page++) {
+        memset(buf, page, sizeof(buf));
+        TEST_ASSERT_EQUAL_INT(sizeof(buf_read),
+                              mtd_read(dev, buf_read, page * PAGE_SIZE, sizeof(buf_read)));
+        TEST_ASSERT_EQUAL_INT(0, memcmp(buf, buf_read, sizeof(buf)));
+    }
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+    TEST_ASSERT_EQUAL_INT(2 * SLOTS, _writes);
+}
+
+static void test_mtd_cache_erase(void)
+{
+    const char buf[] = "ABCDEFGH";
+    uint8_t buf_read[sizeof(buf)];
+    uint8_t expected[sizeof(buf)];
+
+    /* pending writes to an erased sector are dropped */
+    TEST_ASSERT_EQUAL_INT(sizeof(buf), mtd_write(dev, buf, SECTOR_SIZE, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, mtd_erase(dev, SECTOR_SIZE, 2 * SECTOR_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_flush(&_cache));
+    TEST_ASSERT_EQUAL_INT(0, _writes);
+    TEST_ASSERT_EQUAL_INT(sizeof(buf_read),
+                          mtd_read(dev, buf_read, SECTOR_SIZE, sizeof(buf_read)));
+    memset(expected, 0xff, sizeof(expected));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(expected, buf_read, sizeof(buf_read)));
+    TEST_ASSERT_EQUAL_INT(0, _reads);
+
+    TEST_ASSERT_EQUAL_INT(0, mtd_erase(dev, SECTOR_SIZE, SECTOR_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_erase_count(&_cache, 0));
+    TEST_ASSERT_EQUAL_INT(2, mtd_cache_erase_count(&_cache, 1));
+    TEST_ASSERT_EQUAL_INT(1, mtd_cache_erase_count(&_cache, 2));
+    TEST_ASSERT_EQUAL_INT(0, mtd_cache_erase_count(&_cache, 3));
+    TEST_ASSERT_EQUAL_INT(2, _cache.stats.erases);
+
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_erase(dev, PAGE_SIZE, SECTOR_SIZE));
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_erase(dev, 0, PAGE_SIZE));
+    TEST_ASSERT_EQUAL_INT(-EOVERFLOW, mtd_erase(dev, sizeof(_memory), SECTOR_SIZE));
+}
+
+Test *tests_mtd_cache_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_mtd_cache_init),
+        new_TestFixture(test_mtd_cache_write_coalesce),
+        new_TestFixture(test_mtd_cache_write_partial),
+        new_TestFixture(test_mtd_cache_write_runs),
+        new_TestFixture(test_mtd_cache_write_flash),
+        new_TestFixture(test_mtd_cache_write_overflow),
+        new_TestFixture(test_mtd_cache_readahead),
+        new_TestFixture(test_mtd_cache_read_pages),
+        new_TestFixture(test_mtd_cache_evict),
+        new_TestFixture(test_mtd_cache_erase),
+    };
+
+    EMB_UNIT_TESTCALLER(mtd_cache_tests, set_up, NULL, fixtures);
+
+    return (Test *)&mtd_cache_tests;
+}
+
+void tests_mtd_cache(void)
+{
+    TESTS_RUN(tests_mtd_cache_tests());
+}
+/** @} */
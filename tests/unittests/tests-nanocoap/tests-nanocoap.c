@@ -19,6 +19,7 @@
 
 #include "embUnit.h"
 
+#include "kernel_defines.h"
 #include "net/nanocoap.h"
 
 #include "unittests-constants.h"
@@ -650,6 +651,63 @@ static void test_nanocoap__options_get_opaque(void)
     TEST_ASSERT_EQUAL_INT(-ENOENT, optlen);
 }
 
+/*
+ * Tests coap_resources_indexable() on ordered, unordered, and subtree
+ * resources.
+ */
+static void test_nanocoap__resources_indexable(void)
+{
+    const coap_resource_t ordered[] = {
+        { .path = "/act/switch", .methods = COAP_GET },
+        { .path = "/sensor/temp", .methods = COAP_GET },
+        { .path = "/sensor/temp", .methods = COAP_POST },
+    };
+    const coap_resource_t unordered[] = {
+        { .path = "/sensor/temp", .methods = COAP_GET },
+        { .path = "/act/switch", .methods = COAP_GET },
+    };
+    const coap_resource_t subtree[] = {
+        { .path = "/act/", .methods = COAP_GET | COAP_MATCH_SUBTREE },
+        { .path = "/sensor/temp", .methods = COAP_GET },
+    };
+
+    TEST_ASSERT(coap_resources_indexable(ordered, ARRAY_SIZE(ordered)));
+    TEST_ASSERT(coap_resources_indexable(ordered, 0));
+    TEST_ASSERT(!coap_resources_indexable(unordered, ARRAY_SIZE(unordered)));
+    TEST_ASSERT(!coap_resources_indexable(subtree, ARRAY_SIZE(subtree)));
+}
+
+/*
+ * Tests coap_resources_bsearch() finds the first resource not sorting before
+ * a URI.
+ */
+static void test_nanocoap__resources_bsearch(void)
+{
+    const coap_resource_t resources[] = {
+        { .path = "/act/switch", .methods = COAP_GET },
+        { .path = "/sensor/hum", .methods = COAP_GET },
+        { .path = "/sensor/temp", .methods = COAP_GET },
+        { .path = "/sensor/temp", .methods = COAP_POST },
+        { .path = "/test/info/all", .methods = COAP_GET },
+    };
+    const size_t numof = ARRAY_SIZE(resources);
+
+    TEST_ASSERT_EQUAL_INT(0, coap_resources_bsearch(resources, numof,
+                                                    (uint8_t *)"/"));
+    TEST_ASSERT_EQUAL_INT(0, coap_resources_bsearch(resources, numof,
+                                                    (uint8_t *)"/act/switch"));
+    TEST_ASSERT_EQUAL_INT(1, coap_resources_bsearch(resources, numof,
+                                                    (uint8_t *)"/sensor"));
+    TEST_ASSERT_EQUAL_INT(2, coap_resources_bsearch(resources, numof,
+                                                    (uint8_t *)"/sensor/temp"));
+    TEST_ASSERT_EQUAL_INT(4, coap_resources_bsearch(resources, numof,
+                                                    (uint8_t *)"/sensor/temp/"));
+    TEST_ASSERT_EQUAL_INT(5, coap_resources_bsearch(resources, numof,
+                                                    (uint8_t *)"/zzz"));
+    TEST_ASSERT_EQUAL_INT(0, coap_resources_bsearch(resources, 0,
+                                                    (uint8_t *)"/act/switch"));
+}
+
 Test *tests_nanocoap_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -672,6 +730,8 @@ Test *tests_nanocoap_tests(void)
         new_TestFixture(test_nanocoap__server_reply_simple_con),
         new_TestFixture(test_nanocoap__server_option_count_overflow_check),
         new_TestFixture(test_nanocoap__server_option_count_overflow),
+        new_TestFixture(test_nanocoap__resources_indexable),
+        new_TestFixture(test_nanocoap__resources_bsearch),
     };
 
     EMB_UNIT_TESTCALLER(nanocoap_tests, NULL, NULL, fixtures);
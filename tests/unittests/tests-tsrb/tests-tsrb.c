@@ -162,6 +162,80 @@ static void test_add(void)
     }
 }
 
+static void test_add_get_wrap(void)
+{
+    for (int i = 0; i < (int)sizeof(_io_buffer); i++) {
+        _io_buffer[i] = TEST_INPUT + i;
+    }
+    /* move start of ringbuffer close to the end of the buffer */
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - 2,
+                          tsrb_add(&_tsrb, _io_buffer, BUFFER_SIZE - 2));
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - 2,
+                          tsrb_drop(&_tsrb, BUFFER_SIZE - 2));
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE, tsrb_add(&_tsrb, _io_buffer,
+                                                sizeof(_io_buffer)));
+    TEST_ASSERT_EQUAL_INT(1, tsrb_full(&_tsrb));
+    memset(_io_buffer, IO_BUFFER_CANARY, sizeof(_io_buffer));
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE, tsrb_get(&_tsrb, _io_buffer,
+                                                sizeof(_io_buffer)));
+    for (int i = 0; i < BUFFER_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT((uint8_t)(TEST_INPUT + i), _io_buffer[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(IO_BUFFER_CANARY, _io_buffer[BUFFER_SIZE]);
+}
+
+static void test_peek_write(void)
+{
+    uint8_t *data;
+
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE, tsrb_peek_write(&_tsrb, &data));
+    TEST_ASSERT(&_tsrb_buffer[0] == data);
+    memset(data, TEST_INPUT, BUFFER_SIZE - 2);
+    tsrb_commit_write(&_tsrb, BUFFER_SIZE - 2);
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - 2, tsrb_avail(&_tsrb));
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - 2,
+                          tsrb_drop(&_tsrb, BUFFER_SIZE - 2));
+    /* region ends at the end of the buffer */
+    TEST_ASSERT_EQUAL_INT(2, tsrb_peek_write(&_tsrb, &data));
+    TEST_ASSERT(&_tsrb_buffer[BUFFER_SIZE - 2] == data);
+    data[0] = TEST_INPUT;
+    data[1] = TEST_INPUT + 1;
+    tsrb_commit_write(&_tsrb, 2);
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE - 2, tsrb_peek_write(&_tsrb, &data));
+    TEST_ASSERT(&_tsrb_buffer[0] == data);
+    data[0] = TEST_INPUT + 2;
+    tsrb_commit_write(&_tsrb, 1);
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT(TEST_INPUT + i, tsrb_get_one(&_tsrb));
+    }
+    TEST_ASSERT_EQUAL_INT(1, tsrb_empty(&_tsrb));
+}
+
+static void test_peek_read(void)
+{
+    const uint8_t *data;
+
+    TEST_ASSERT_EQUAL_INT(0, tsrb_peek_read(&_tsrb, &data));
+    for (int i = 0; i < BUFFER_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(0, tsrb_add_one(&_tsrb, TEST_INPUT + i));
+    }
+    TEST_ASSERT_EQUAL_INT(BUFFER_SIZE, tsrb_peek_read(&_tsrb, &data));
+    TEST_ASSERT_EQUAL_INT(TEST_INPUT, data[0]);
+    /* peeking does not remove bytes */
+    TEST_ASSERT_EQUAL_INT(1, tsrb_full(&_tsrb));
+    tsrb_commit_read(&_tsrb, BUFFER_SIZE - 1);
+    TEST_ASSERT_EQUAL_INT(0, tsrb_add_one(&_tsrb, TEST_INPUT));
+    /* region ends at the end of the buffer */
+    TEST_ASSERT_EQUAL_INT(1, tsrb_peek_read(&_tsrb, &data));
+    TEST_ASSERT_EQUAL_INT((uint8_t)(TEST_INPUT + BUFFER_SIZE - 1), data[0]);
+    tsrb_commit_read(&_tsrb, 1);
+    TEST_ASSERT_EQUAL_INT(1, tsrb_peek_read(&_tsrb, &data));
+    TEST_ASSERT(&_tsrb_buffer[0] == data);
+    TEST_ASSERT_EQUAL_INT(TEST_INPUT, data[0]);
+    tsrb_commit_read(&_tsrb, 1);
+    TEST_ASSERT_EQUAL_INT(1, tsrb_empty(&_tsrb));
+}
+
 static Test *tests_tsrb_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -174,6 +248,9 @@ static Test *tests_tsrb_tests(void)
         new_TestFixture(test_drop),
         new_TestFixture(test_add_one),
         new_TestFixture(test_add),
+        new_TestFixture(test_add_get_wrap),
+        new_TestFixture(test_peek_write),
+        new_TestFixture(test_peek_read),
     };
 
     EMB_UNIT_TESTCALLER(tsrb_tests, NULL, tear_down, fixtures);